@@ -173,6 +173,10 @@ CONF_Bool(compress_rowbatches, "true");
 // Compress ratio when shuffle row_batches in network, not in storage engine.
 // If ratio is less than this value, use uncompressed data instead.
 CONF_mDouble(rpc_compress_ratio_threshold, "1.1");
+// Whether to encode the columns of the chunks sent by exchange with lightweight encodings, i.e. bit-packing,
+// dictionary and run-length encoding of null flags. The BEs of old versions can't receive the encoded chunks,
+// so only enable it after all the BEs are upgraded.
+CONF_mBool(enable_exchange_column_encoding, "false");
 // Serialize and deserialize each returned row batch.
 CONF_Bool(serialize_batch, "false");
 // Interval between profile reports; in seconds.
@@ -252,6 +256,14 @@ CONF_Int64(index_stream_cache_capacity, "10737418240");
 CONF_String(storage_page_cache_limit, "0");
 // whether to disable page cache feature in storage
 CONF_Bool(disable_storage_page_cache, "true");
+// Persistent second tier of the storage page cache on local disk, see storage/page_disk_cache.h.
+// Disabled if the path is empty.
+CONF_String(storage_page_cache_disk_path, "");
+CONF_Int64(storage_page_cache_disk_size, /*100GB=*/"107374182400");
+CONF_Int64(storage_page_cache_disk_region_size, /*64MB=*/"67108864");
+// Eviction policy of the storage page cache, "lru" or "2q". With "2q", the pages hit more than once
+// are protected from being flushed by large scans.
+CONF_String(storage_page_cache_eviction_policy, "lru");
 // whether to disable column pool
 CONF_Bool(disable_column_pool, "false");
 
@@ -280,6 +292,18 @@ CONF_mInt32(cumulative_compaction_skip_window_seconds, "30");
 CONF_mInt32(update_compaction_check_interval_seconds, "60");
 CONF_Int32(update_compaction_num_threads_per_disk, "1");
 CONF_Int32(update_compaction_per_tablet_min_interval_seconds, "120"); // 2min
+// The number of threads to read the primary keys of segments, probe the shards of the persistent index and
+// generate delete vectors concurrently when applying a rowset of a primary key tablet, 0 means the number of
+// cpu cores.
+CONF_Int32(update_apply_worker_thread_num, "0");
+// Whether to apply a rowset of a primary key tablet with the threads of update_apply_worker_thread_num.
+CONF_mBool(enable_parallel_update_apply, "true");
+// Whether to apply a partial update of a primary key tablet in column mode, which writes only the updated
+// columns into delta column files of the updated segments instead of rewriting the full rows.
+CONF_mBool(enable_column_mode_partial_update, "false");
+// A partial update is applied in column mode only if all its rows update existing keys and the updated columns
+// are no more than this percent of the non-key columns.
+CONF_mInt32(column_mode_partial_update_max_column_percent, "30");
 
 CONF_mInt32(repair_compaction_interval_seconds, "600"); // 10 min
 
@@ -308,6 +332,14 @@ CONF_mInt64(min_cumulative_compaction_size, "5368709120");
 // 20GB
 CONF_mInt64(min_base_compaction_size, "21474836480");
 
+// For the tablets using size tiered compaction policy, which merges the adjacent rowsets of similar size.
+// Rowsets are grouped into levels by size, the size range of each level is `size_tiered_level_multiple`
+// times of the previous level, and all rowsets smaller than `size_tiered_min_level_size` are in the lowest level.
+CONF_mInt64(size_tiered_min_level_size, "131072");
+CONF_mInt64(size_tiered_level_multiple, "5");
+// A level is compacted only when it has at least this number of adjacent rowsets.
+CONF_mInt64(size_tiered_min_level_rowsets, "5");
+
 // Max row source mask memory bytes, default is 200M.
 // Should be smaller than compaction_mem_limit.
 // When the row source mask buffer exceeds this, it will be persisted to a temporary file on the disk.
@@ -368,6 +400,13 @@ CONF_Int32(fragment_pool_queue_size, "2048");
 // Spill to disk when query
 // Writable scratch directories, splitted by ";"
 CONF_String(query_scratch_dirs, "${STARROCKS_HOME}");
+// When enable_spilling is set, spillable operators start to spill once the query memory
+// consumption reaches this ratio of the query mem limit.
+CONF_mDouble(spill_mem_limit_threshold, "0.8");
+// Spillable operators whose memory usage is smaller than this size never spill.
+CONF_mInt64(spill_operator_min_bytes, "52428800");
+// Number of threads restoring spilled data in the background, 0 restores it on the pipeline driver threads.
+CONF_Int32(spill_io_thread_num, "8");
 
 // Control the number of disks on the machine.  If 0, this comes from the system settings.
 CONF_Int32(num_disks, "0");
@@ -408,6 +447,27 @@ CONF_String(pprof_profile_dir, "${STARROCKS_HOME}/log");
 // for partition
 // CONF_Bool(enable_partitioned_hash_join, "false")
 CONF_Bool(enable_partitioned_aggregation, "true");
+// The max number of keys that the hash table of aggregation is pre-sized for, according to the
+// number of groups estimated by FE. 0 means the hash table is never pre-sized.
+CONF_mInt64(aggregate_hash_table_max_reserved_keys, "1048576");
+// Whether streaming pre-aggregation in AUTO mode passes through the input without building the hash table,
+// when the reduction ratio (input rows / output rows) of a window of input rows is lower than
+// `streaming_preaggregation_min_reduction`. It switches back to aggregating to probe the locality of data
+// after passing through some rows, which doubles after every failed probing until
+// `streaming_preaggregation_max_bypass_rows`.
+CONF_mBool(enable_adaptive_streaming_preaggregation, "true");
+CONF_mInt64(streaming_preaggregation_window_rows, "65536");
+CONF_mDouble(streaming_preaggregation_min_reduction, "1.2");
+CONF_mInt64(streaming_preaggregation_max_bypass_rows, "4194304");
+
+// Whether the build side of broadcast join is built by all the pipeline drivers in parallel. The build side is
+// shuffled by the join keys locally, every build driver builds the hash table of a partition, and every probe
+// driver looks up the hash table of the partition of each probe row.
+CONF_mBool(enable_hash_join_partitioned_build, "false");
+// Whether the hot join keys of the probe side of shuffle join are spread over all the probe drivers by the local
+// shuffle, to balance the load of probe drivers on skewed data. Every probe driver looks up the hash tables of all
+// the partitions, which costs an extra hash of the probe keys.
+CONF_mBool(enable_hash_join_skew_aware_local_shuffle, "false");
 
 // to forward compatibility, will be removed later
 CONF_mBool(enable_token_check, "true");
@@ -644,6 +704,13 @@ CONF_Int16(tablet_max_versions, "1000");
 // The maximum number of pending versions allowed for a primary key tablet
 CONF_mInt32(tablet_max_pending_versions, "1000");
 
+// Whether to build a bloom filter of the keys of each shard of the L1 file of the persistent index when it's
+// flushed or compacted. The filters are memory resident, so that the lookups of the keys not in the L1 file,
+// e.g. the new keys inserted, are answered without reading the shards from disk.
+CONF_mBool(enable_persistent_index_bloom_filter, "true");
+// The false positive probability of the bloom filters of the L1 file of the persistent index.
+CONF_mDouble(persistent_index_bloom_filter_fpp, "0.05");
+
 // NOTE: it will be deleted.
 CONF_mBool(enable_bitmap_union_disk_format_with_set, "false");
 
@@ -664,6 +731,25 @@ CONF_Int64(pipeline_sink_brpc_dop, "64");
 // Used to reject coming fragment instances, when the number of running drivers
 // exceeds it*pipeline_exec_thread_pool_thread_num.
 CONF_Int64(pipeline_max_num_drivers_per_exec_thread, "10240");
+// Whether each execution thread of pipeline engine has its own driver queue and steals drivers from the others
+// when its queue is empty. It only takes effect for the queries not in resource groups.
+CONF_Bool(enable_pipeline_work_stealing_driver_queue, "false");
+// Whether the blocked drivers waiting for exchange receivers, sink buffers, local exchangers and scan chunk buffers
+// are only checked by the poller when these components signal them.
+CONF_Bool(enable_pipeline_event_driven_poller, "true");
+// The interval in milliseconds the poller checks all the blocked drivers including the event-driven ones,
+// to handle query cancellation, expiration and the state changes not signalled.
+CONF_mInt64(pipeline_poller_full_check_interval_ms, "10");
+// Whether the degree of parallelism of pipeline fragments is adapted to the estimated number of rows to scan
+// and the number of running drivers. It doesn't take effect for the fragments whose scan ranges are assigned
+// to driver sequences by FE, e.g. colocate join.
+CONF_mBool(enable_pipeline_adaptive_dop, "true");
+// The number of rows to scan a scan driver is created for, when the adaptive dop is enabled.
+CONF_mInt64(pipeline_adaptive_dop_rows_per_driver, "1000000");
+// Whether the execution threads of pipeline engine and scan are bound to the NUMA nodes in turn, the drivers
+// are kept on the execution threads of the NUMA node of their driver sequence, and ChunkAllocator prefers the
+// free chunks of the same NUMA node. The placement of drivers requires enable_pipeline_work_stealing_driver_queue.
+CONF_Bool(enable_numa_aware_execution, "false");
 CONF_mBool(pipeline_print_profile, "false");
 
 /// For parallel scan on the single tablet.
@@ -678,6 +764,10 @@ CONF_Int64(tablet_internal_parallel_max_splitted_scan_bytes, "536870912");
 // Only when scan_dop is not less than min_scan_dop, this table can use tablet internal parallel,
 // where scan_dop = estimated_scan_rows / splitted_scan_rows.
 CONF_Int64(tablet_internal_parallel_min_scan_dop, "4");
+// Whether an idle scan operator takes over the second half of the unread rows of a morsel being read by another
+// one, after all the segments are picked up. Each half has at least tablet_internal_parallel_min_splitted_scan_rows
+// rows. It only takes effect for the tablets split physically.
+CONF_mBool(enable_tablet_internal_parallel_dynamic_split, "true");
 
 // The bitmap serialize version.
 CONF_Int16(bitmap_serialize_version, "1");
@@ -722,6 +812,11 @@ CONF_Bool(parquet_late_materialization_enable, "true");
 
 CONF_Int32(io_coalesce_read_max_buffer_size, "8388608");
 CONF_Int32(io_coalesce_read_max_distance_size, "1048576");
+// Number of threads fetching the coalesced io ranges of parquet/orc files in the background,
+// 0 disables prefetching.
+CONF_Int32(io_prefetch_thread_num, "16");
+// Max bytes fetched ahead of the reader by one file.
+CONF_mInt64(io_prefetch_max_buffer_size, "67108864");
 
 CONF_Int32(connector_io_tasks_per_scan_operator, "16");
 
@@ -750,6 +845,17 @@ CONF_Int64(deliver_broadcast_rf_passthrough_bytes_limit, "131072");
 // in passthrough style, the number of inflight RPCs of parallel deliveries are issued is not exceeds this limit.
 CONF_Int64(deliver_broadcast_rf_passthrough_inflight_num, "10");
 CONF_Int64(send_rpc_runtime_filter_timeout_ms, "1000");
+// The runtime filters keeping more than this ratio of rows on the sampled chunks are not evaluated on the other
+// chunks, until they become selective on the later samples.
+CONF_mDouble(runtime_filter_max_keep_ratio, "0.5");
+// The selectivity and cost of a runtime filter are measured over about the recent this number of sampled rows.
+CONF_mInt64(runtime_filter_sample_window_rows, "65536");
+// Whether to prune the segments not opened yet of olap scan by the zone maps of the join runtime filters
+// arrived after the scan is prepared.
+CONF_mBool(enable_runtime_filter_range_pruning, "true");
+// Whether to partition the join runtime filters of colocate and bucket shuffle joins by bucket, so that the
+// rows are only tested against the filter of their own bucket, and each node only receives its buckets.
+CONF_mBool(enable_bucket_local_runtime_filter, "true");
 
 // enable optimized implementation of schema change
 CONF_Bool(enable_schema_change_v2, "true");
@@ -777,12 +883,22 @@ CONF_String(starlet_cache_dir, "");
 #endif
 
 CONF_Int64(lake_metadata_cache_limit, /*2GB=*/"2147483648");
+// Eviction policy of the lake metadata cache, "lru" or "2q".
+CONF_String(lake_metadata_cache_eviction_policy, "lru");
 CONF_Int64(lake_gc_metadata_max_versions, "10");
 CONF_Int64(lake_gc_metadata_check_interval, /*10 minutes=*/"600");
 CONF_Int64(lake_gc_segment_check_interval, /*60 minutes=*/"3600");
 // This value should be much larger than the maximum timeout of loading/compaction/schema change jobs.
 CONF_Int64(lake_gc_segment_expire_seconds, /*1 day=*/"86400");
 
+// Local disk cache of the segment files of lake tablets, see fs/block_cache.h.
+CONF_Bool(block_cache_enable, "false");
+CONF_String(block_cache_disk_path, "${STARROCKS_HOME}/block_cache");
+CONF_Int64(block_cache_disk_size, /*20GB=*/"21474836480");
+CONF_Int64(block_cache_block_size, /*1MB=*/"1048576");
+// Number of threads writing the missed blocks into the cache.
+CONF_Int32(block_cache_populate_threads, "2");
+
 CONF_mBool(dependency_librdkafka_debug_enable, "false");
 
 // A comma-separated list of debug contexts to enable.
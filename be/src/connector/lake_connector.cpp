@@ -120,6 +120,8 @@ private:
     RuntimeProfile::Counter* _index_load_timer = nullptr;
     RuntimeProfile::Counter* _read_pages_num_counter = nullptr;
     RuntimeProfile::Counter* _cached_pages_num_counter = nullptr;
+    RuntimeProfile::Counter* _block_cache_hit_bytes_counter = nullptr;
+    RuntimeProfile::Counter* _block_cache_miss_bytes_counter = nullptr;
     RuntimeProfile::Counter* _bi_filtered_counter = nullptr;
     RuntimeProfile::Counter* _bi_filter_timer = nullptr;
     RuntimeProfile::Counter* _pushdown_predicates_counter = nullptr;
@@ -203,12 +205,14 @@ Status LakeDataSource::open(RuntimeState* state) {
 }
 
 void LakeDataSource::close(RuntimeState* state) {
-    if (_reader) {
-        update_counter();
-    }
+    // Close the iterators before updating counters, segment iterators report their block cache
+    // statistics on close.
     if (_prj_iter) {
         _prj_iter->close();
     }
+    if (_reader) {
+        update_counter();
+    }
     if (_reader) {
         _reader.reset();
     }
@@ -496,6 +500,10 @@ void LakeDataSource::init_counter(RuntimeState* state) {
 
     // IOTime
     _io_timer = ADD_TIMER(_runtime_profile, "IOTime");
+    _block_cache_hit_bytes_counter =
+            ADD_CHILD_COUNTER(_runtime_profile, "BlockCacheHitBytes", TUnit::BYTES, "IOTime");
+    _block_cache_miss_bytes_counter =
+            ADD_CHILD_COUNTER(_runtime_profile, "BlockCacheMissBytes", TUnit::BYTES, "IOTime");
 }
 
 void LakeDataSource::update_realtime_counter(vectorized::Chunk* chunk) {
@@ -544,6 +552,8 @@ void LakeDataSource::update_counter() {
 
     COUNTER_UPDATE(_read_pages_num_counter, _reader->stats().total_pages_num);
     COUNTER_UPDATE(_cached_pages_num_counter, _reader->stats().cached_pages_num);
+    COUNTER_UPDATE(_block_cache_hit_bytes_counter, _reader->stats().block_cache_hit_bytes);
+    COUNTER_UPDATE(_block_cache_miss_bytes_counter, _reader->stats().block_cache_miss_bytes);
 
     COUNTER_UPDATE(_bi_filtered_counter, _reader->stats().rows_bitmap_index_filtered);
     COUNTER_UPDATE(_bi_filter_timer, _reader->stats().bitmap_index_filter_timer);
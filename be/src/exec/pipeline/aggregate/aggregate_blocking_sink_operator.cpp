@@ -20,6 +20,11 @@ void AggregateBlockingSinkOperator::close(RuntimeState* state) {
 Status AggregateBlockingSinkOperator::set_finishing(RuntimeState* state) {
     _is_finished = true;
 
+    if (_aggregator->has_spilled()) {
+        // Spill the remaining data and load the first spilled partition back into hash map.
+        RETURN_IF_ERROR(_aggregator->finish_spill());
+    }
+
     if (!_aggregator->is_none_group_by_exprs()) {
         COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
         // If hash map is empty, we don't need to return value
@@ -96,6 +101,9 @@ Status AggregateBlockingSinkOperator::push_chunk(RuntimeState* state, const vect
     }
     _aggregator->update_num_input_rows(chunk_size);
     RETURN_IF_ERROR(_aggregator->check_has_error());
+    if (!_aggregator->is_none_group_by_exprs()) {
+        RETURN_IF_ERROR(_aggregator->try_spill());
+    }
 
     return Status::OK();
 }
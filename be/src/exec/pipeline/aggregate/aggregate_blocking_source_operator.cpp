@@ -41,6 +41,11 @@ StatusOr<vectorized::ChunkPtr> AggregateBlockingSourceOperator::pull_chunk(Runti
                     *_aggregator->hash_map_variant().NAME, chunk_size, &chunk);
         APPLY_FOR_AGG_VARIANT_ALL(HASH_MAP_METHOD)
 #undef HASH_MAP_METHOD
+
+        // Current partition has been output, go on with the next spilled partition.
+        if (_aggregator->is_ht_eos() && _aggregator->has_spilled()) {
+            RETURN_IF_ERROR(_aggregator->restore_next_spilled_partition());
+        }
     }
 
     size_t old_size = chunk->num_rows();
@@ -87,6 +87,14 @@ Status AggregateStreamingSinkOperator::_push_chunk_by_force_preaggregation(const
 }
 
 Status AggregateStreamingSinkOperator::_push_chunk_by_auto(const size_t chunk_size) {
+    if (!_aggregator->should_preaggregate()) {
+        // The aggregation reduces nothing recently, pass through the chunk without probing the hash table.
+        RETURN_IF_ERROR(_push_chunk_by_force_streaming());
+        _aggregator->update_preagg_controller(chunk_size, chunk_size);
+        return Status::OK();
+    }
+
+    size_t num_output_rows = 0;
     // TODO: calc the real capacity of hashtable, will add one interface in the class of habletable
     size_t real_capacity = _aggregator->hash_map_variant().capacity() - _aggregator->hash_map_variant().capacity() / 8;
     size_t remain_size = real_capacity - _aggregator->hash_map_variant().size();
@@ -97,6 +105,7 @@ Status AggregateStreamingSinkOperator::_push_chunk_by_auto(const size_t chunk_si
                                                       _aggregator->hash_map_variant().size())) {
         // hash table is not full or allow expand the hash table according reduction rate
         SCOPED_TIMER(_aggregator->agg_compute_timer());
+        size_t ht_size = _aggregator->hash_map_variant().size();
         if (false) {
         }
 #define HASH_MAP_METHOD(NAME)                                                                                          \
@@ -120,6 +129,7 @@ Status AggregateStreamingSinkOperator::_push_chunk_by_auto(const size_t chunk_si
         TRY_CATCH_BAD_ALLOC(_aggregator->try_convert_to_two_level_map());
 
         COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
+        num_output_rows = _aggregator->hash_map_variant().size() - ht_size;
     } else {
         {
             SCOPED_TIMER(_aggregator->agg_compute_timer());
@@ -139,6 +149,8 @@ Status AggregateStreamingSinkOperator::_push_chunk_by_auto(const size_t chunk_si
         }
 
         size_t zero_count = SIMD::count_zero(_aggregator->streaming_selection());
+        // Rows not found in hash table are streamed out.
+        num_output_rows = _aggregator->streaming_selection().size() - zero_count;
         // very poor aggregation
         if (zero_count == 0) {
             SCOPED_TIMER(_aggregator->streaming_timer());
@@ -167,6 +179,7 @@ Status AggregateStreamingSinkOperator::_push_chunk_by_auto(const size_t chunk_si
         COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
     }
 
+    _aggregator->update_preagg_controller(chunk_size, num_output_rows);
     return Status::OK();
 }
 } // namespace starrocks::pipeline
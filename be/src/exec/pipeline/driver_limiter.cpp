@@ -2,6 +2,8 @@
 
 #include "exec/pipeline/driver_limiter.h"
 
+#include <algorithm>
+
 namespace starrocks::pipeline {
 
 StatusOr<DriverLimiter::TokenPtr> DriverLimiter::try_acquire(int num_drivers) {
@@ -14,4 +16,18 @@ StatusOr<DriverLimiter::TokenPtr> DriverLimiter::try_acquire(int num_drivers) {
     return std::make_unique<DriverLimiter::Token>(_num_total_drivers, num_drivers);
 }
 
+int DriverLimiter::adjust_dop_by_load(int dop) const {
+    if (dop <= 1 || _max_num_drivers <= 0) {
+        return dop;
+    }
+    int64_t num_free_drivers = _max_num_drivers - num_total_drivers();
+    if (num_free_drivers * 2 >= _max_num_drivers) {
+        return dop;
+    }
+    if (num_free_drivers <= 0) {
+        return 1;
+    }
+    return std::max<int>(1, dop * num_free_drivers * 2 / _max_num_drivers);
+}
+
 } // namespace starrocks::pipeline
@@ -38,6 +38,13 @@ public:
     // `num_drivers` drivers back to the limiter.
     StatusOr<TokenPtr> try_acquire(int num_drivers);
 
+    // Return the degree of parallelism to use for a fragment instance requesting `dop` under the current load.
+    // `dop` is kept until half of the drivers are used, and then shrinks linearly with the free drivers, down to 1.
+    int adjust_dop_by_load(int dop) const;
+
+    int num_total_drivers() const { return _num_total_drivers.load(std::memory_order_relaxed); }
+    int max_num_drivers() const { return _max_num_drivers; }
+
 private:
     const int _max_num_drivers;
     std::atomic<int> _num_total_drivers{0};
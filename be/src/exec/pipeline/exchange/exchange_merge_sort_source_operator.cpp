@@ -29,6 +29,11 @@ bool ExchangeMergeSortSourceOperator::has_output() const {
     return _stream_recvr->is_data_ready();
 }
 
+bool ExchangeMergeSortSourceOperator::attach_observer(PipelineObserver* observer) {
+    _stream_recvr->attach_observer(observer);
+    return true;
+}
+
 bool ExchangeMergeSortSourceOperator::is_finished() const {
     if (_limit < 0) {
         return _is_finished;
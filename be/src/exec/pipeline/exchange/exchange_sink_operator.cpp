@@ -406,6 +406,14 @@ bool ExchangeSinkOperator::need_input() const {
     return !is_finished() && _buffer != nullptr && !_buffer->is_full();
 }
 
+bool ExchangeSinkOperator::attach_observer(PipelineObserver* observer) {
+    if (_buffer == nullptr) {
+        return false;
+    }
+    _buffer->attach_observer(observer);
+    return true;
+}
+
 bool ExchangeSinkOperator::pending_finish() const {
     return _buffer != nullptr && !_buffer->is_finished();
 }
@@ -599,12 +607,13 @@ Status ExchangeSinkOperator::serialize_chunk(const vectorized::Chunk* src, Chunk
         SCOPED_TIMER(_serialize_chunk_timer);
         // We only serialize chunk meta for first chunk
         if (*is_first_chunk) {
-            StatusOr<ChunkPB> res = serde::ProtobufChunkSerde::serialize(*src);
+            StatusOr<ChunkPB> res = serde::ProtobufChunkSerde::serialize(*src, config::enable_exchange_column_encoding);
             RETURN_IF_ERROR(res);
             res->Swap(dst);
             *is_first_chunk = false;
         } else {
-            StatusOr<ChunkPB> res = serde::ProtobufChunkSerde::serialize_without_meta(*src);
+            StatusOr<ChunkPB> res = serde::ProtobufChunkSerde::serialize_without_meta(
+                    *src, config::enable_exchange_column_encoding);
             RETURN_IF_ERROR(res);
             res->Swap(dst);
         }
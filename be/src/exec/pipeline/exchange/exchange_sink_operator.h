@@ -53,6 +53,8 @@ public:
 
     bool pending_finish() const override;
 
+    bool attach_observer(PipelineObserver* observer) override;
+
     Status set_finishing(RuntimeState* state) override;
 
     Status set_cancelled(RuntimeState* state) override;
@@ -19,6 +19,11 @@ bool ExchangeSourceOperator::has_output() const {
     return _stream_recvr->has_output_for_pipeline(_driver_sequence);
 }
 
+bool ExchangeSourceOperator::attach_observer(PipelineObserver* observer) {
+    _stream_recvr->attach_observer(observer);
+    return true;
+}
+
 bool ExchangeSourceOperator::is_finished() const {
     return _stream_recvr->is_finished();
 }
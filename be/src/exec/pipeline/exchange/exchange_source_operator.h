@@ -23,6 +23,8 @@ public:
 
     bool is_finished() const override;
 
+    bool attach_observer(PipelineObserver* observer) override;
+
     Status set_finishing(RuntimeState* state) override;
 
     StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
@@ -0,0 +1,63 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#include "exec/pipeline/exchange/heavy_hitter_sampler.h"
+
+#include <algorithm>
+
+namespace starrocks::pipeline {
+
+HeavyHitterSampler::HeavyHitterSampler(size_t sample_stride, size_t window_samples, double min_hot_ratio)
+        : _sample_stride(std::max<size_t>(sample_stride, 1)),
+          _window_samples(std::max<size_t>(window_samples, 1)),
+          _min_hot_ratio(min_hot_ratio) {
+    _counters.reserve(kNumCounters);
+}
+
+void HeavyHitterSampler::sample(const std::vector<uint32_t>& hash_values, size_t num_rows) {
+    size_t i = _next_sample_offset;
+    for (; i < num_rows; i += _sample_stride) {
+        _count(hash_values[i]);
+        if (++_num_window_samples >= _window_samples) {
+            _finish_window();
+        }
+    }
+    _next_sample_offset = i - num_rows;
+}
+
+bool HeavyHitterSampler::is_hot(uint32_t hash) const {
+    return std::binary_search(_hot_hashes.begin(), _hot_hashes.end(), hash);
+}
+
+void HeavyHitterSampler::_count(uint32_t hash) {
+    auto min_iter = _counters.end();
+    for (auto iter = _counters.begin(); iter != _counters.end(); ++iter) {
+        if (iter->hash == hash) {
+            iter->count++;
+            return;
+        }
+        if (min_iter == _counters.end() || iter->count < min_iter->count) {
+            min_iter = iter;
+        }
+    }
+    if (_counters.size() < kNumCounters) {
+        _counters.push_back({hash, 1, 0});
+        return;
+    }
+    // Replace the least frequent key, which may have appeared min_iter->count times before.
+    *min_iter = {hash, min_iter->count + 1, min_iter->count};
+}
+
+void HeavyHitterSampler::_finish_window() {
+    const double min_count = _min_hot_ratio * _num_window_samples;
+    _hot_hashes.clear();
+    for (const auto& counter : _counters) {
+        if (counter.count - counter.error >= min_count) {
+            _hot_hashes.push_back(counter.hash);
+        }
+    }
+    std::sort(_hot_hashes.begin(), _hot_hashes.end());
+    _counters.clear();
+    _num_window_samples = 0;
+}
+
+} // namespace starrocks::pipeline
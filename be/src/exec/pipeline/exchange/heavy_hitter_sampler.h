@@ -0,0 +1,53 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace starrocks::pipeline {
+
+// HeavyHitterSampler finds the hot keys of a stream of rows by the hash values of their keys.
+//
+// One of every |sample_stride| rows is sampled and counted by the Space-Saving algorithm with a fixed number
+// of counters. After every |window_samples| sampled rows, the keys whose guaranteed frequency in the window
+// is at least |min_hot_ratio| become the hot keys of the following window, and the counters are reset, so the
+// hot keys follow the change of data distribution.
+class HeavyHitterSampler {
+public:
+    HeavyHitterSampler(size_t sample_stride, size_t window_samples, double min_hot_ratio);
+
+    void sample(const std::vector<uint32_t>& hash_values, size_t num_rows);
+
+    bool has_hot_keys() const { return !_hot_hashes.empty(); }
+    // REQUIRES: has_hot_keys() is true, otherwise it's a waste of CPU.
+    bool is_hot(uint32_t hash) const;
+    size_t num_hot_keys() const { return _hot_hashes.size(); }
+
+private:
+    struct Counter {
+        uint32_t hash;
+        uint32_t count;
+        // The upper bound of the overestimation of count.
+        uint32_t error;
+    };
+
+    static constexpr size_t kNumCounters = 32;
+
+    void _count(uint32_t hash);
+    void _finish_window();
+
+    const size_t _sample_stride;
+    const size_t _window_samples;
+    const double _min_hot_ratio;
+
+    // Offset of the next sampled row in the next chunk.
+    size_t _next_sample_offset = 0;
+    size_t _num_window_samples = 0;
+    std::vector<Counter> _counters;
+    // Sorted.
+    std::vector<uint32_t> _hot_hashes;
+};
+
+} // namespace starrocks::pipeline
@@ -5,6 +5,7 @@
 #include "column/chunk.h"
 #include "exec/pipeline/exchange/shuffler.h"
 #include "exprs/expr_context.h"
+#include "util/runtime_profile.h"
 
 namespace starrocks::pipeline {
 
@@ -16,6 +17,11 @@ Status PartitionExchanger::Partitioner::partition_chunk(const vectorized::ChunkP
     if (_shuffler == nullptr) {
         _shuffler = std::make_unique<Shuffler>(_source->runtime_state()->func_version() <= 3, false, _part_type,
                                                _source->get_sources().size(), 1);
+        if (_spread_hot_keys && num_partitions > 1) {
+            // A key is hot if its rows alone make the load of its source 1.5 times of the average.
+            _hot_key_sampler = std::make_unique<HeavyHitterSampler>(kHotKeySampleStride, kHotKeyWindowSamples,
+                                                                    0.5 / num_partitions);
+        }
     }
 
     for (size_t i = 0; i < _partitions_columns.size(); ++i) {
@@ -41,6 +47,9 @@ Status PartitionExchanger::Partitioner::partition_chunk(const vectorized::ChunkP
     _shuffle_channel_id.resize(num_rows);
 
     _shuffler->local_exchange_shuffle(_shuffle_channel_id, _hash_values, num_rows);
+    if (_hot_key_sampler != nullptr) {
+        _spread_hot_key_rows(num_rows);
+    }
 
     _partition_row_indexes_start_points.assign(num_partitions + 1, 0);
     for (size_t i = 0; i < num_rows; ++i) {
@@ -59,13 +68,29 @@ Status PartitionExchanger::Partitioner::partition_chunk(const vectorized::ChunkP
     return Status::OK();
 }
 
+void PartitionExchanger::Partitioner::_spread_hot_key_rows(size_t num_rows) {
+    // The hot keys detected by the previous chunks are spread, so the first window of the input is never spread.
+    if (_hot_key_sampler->has_hot_keys()) {
+        const uint32_t num_partitions = _source->get_sources().size();
+        for (size_t i = 0; i < num_rows; ++i) {
+            if (_hot_key_sampler->is_hot(_hash_values[i])) {
+                _shuffle_channel_id[i] = _next_spread_partition;
+                _next_spread_partition = (_next_spread_partition + 1) % num_partitions;
+                _num_spread_rows++;
+            }
+        }
+    }
+    _hot_key_sampler->sample(_hash_values, num_rows);
+}
+
 PartitionExchanger::PartitionExchanger(const std::shared_ptr<LocalExchangeMemoryManager>& memory_manager,
                                        LocalExchangeSourceOperatorFactory* source, const TPartitionType::type part_type,
-                                       const std::vector<ExprContext*>& partition_expr_ctxs, const size_t num_sinks)
-        : LocalExchanger("Partition", memory_manager, source) {
+                                       const std::vector<ExprContext*>& partition_expr_ctxs, const size_t num_sinks,
+                                       bool spread_hot_keys)
+        : LocalExchanger(spread_hot_keys ? "SkewAwarePartition" : "Partition", memory_manager, source) {
     _partitioners.reserve(num_sinks);
     for (size_t i = 0; i < num_sinks; i++) {
-        _partitioners.emplace_back(source, part_type, partition_expr_ctxs);
+        _partitioners.emplace_back(source, part_type, partition_expr_ctxs, spread_hot_keys);
     }
 }
 
@@ -97,6 +122,13 @@ Status PartitionExchanger::accept(const vectorized::ChunkPtr& chunk, const int32
     return Status::OK();
 }
 
+void PartitionExchanger::update_sink_profile(int32_t sink_driver_sequence, RuntimeProfile* profile) {
+    int64_t num_spread_rows = _partitioners[sink_driver_sequence].num_spread_rows();
+    if (num_spread_rows > 0) {
+        COUNTER_SET(ADD_COUNTER(profile, "SpreadHotKeyRows", TUnit::UNIT), num_spread_rows);
+    }
+}
+
 Status BroadcastExchanger::accept(const vectorized::ChunkPtr& chunk, const int32_t sink_driver_sequence) {
     for (auto* source : _source->get_sources()) {
         source->add_chunk(chunk);
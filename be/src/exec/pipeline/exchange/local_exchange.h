@@ -6,6 +6,7 @@
 #include <utility>
 
 #include "column/vectorized_fwd.h"
+#include "exec/pipeline/exchange/heavy_hitter_sampler.h"
 #include "exec/pipeline/exchange/local_exchange_memory_manager.h"
 #include "exec/pipeline/exchange/local_exchange_source_operator.h"
 #include "exec/pipeline/exchange/shuffler.h"
@@ -13,6 +14,7 @@
 
 namespace starrocks {
 class ExprContext;
+class RuntimeProfile;
 class RuntimeState;
 
 namespace pipeline {
@@ -26,6 +28,9 @@ public:
 
     virtual Status accept(const vectorized::ChunkPtr& chunk, int32_t sink_driver_sequence) = 0;
 
+    // Add the statistics of the sink |sink_driver_sequence| to its profile, called when the sink is finishing.
+    virtual void update_sink_profile(int32_t sink_driver_sequence, RuntimeProfile* profile) {}
+
     virtual void finish(RuntimeState* state) {
         if (decrement_sink_number() == 1) {
             for (auto* source : _source->get_sources()) {
@@ -48,6 +53,8 @@ public:
 
     bool need_input() const;
 
+    void attach_sink_observer(PipelineObserver* observer) { _memory_manager->attach_observer(observer); }
+
     void increment_sink_number() { _sink_number++; }
 
     int32_t decrement_sink_number() { return _sink_number--; }
@@ -59,13 +66,21 @@ protected:
     LocalExchangeSourceOperatorFactory* _source;
 };
 
-// Exchange the local data for shuffle
+// Exchange the local data for shuffle.
+//
+// If |spread_hot_keys| is true, the consumer doesn't require the rows of the same key to be delivered to the same
+// source, e.g. the probe of the partitioned build of hash join. Every partitioner samples the heavy hitters of its
+// sink, and spreads the rows of the hot keys over all the sources in a round-robin way instead of delivering them
+// to the source of their hash values, so that a few dominating keys don't overload one downstream driver.
 class PartitionExchanger final : public LocalExchanger {
     class Partitioner {
     public:
         Partitioner(LocalExchangeSourceOperatorFactory* source, const TPartitionType::type part_type,
-                    const std::vector<ExprContext*>& partition_expr_ctxs)
-                : _source(source), _part_type(part_type), _partition_expr_ctxs(partition_expr_ctxs) {
+                    const std::vector<ExprContext*>& partition_expr_ctxs, bool spread_hot_keys)
+                : _source(source),
+                  _part_type(part_type),
+                  _partition_expr_ctxs(partition_expr_ctxs),
+                  _spread_hot_keys(spread_hot_keys) {
             _partitions_columns.resize(partition_expr_ctxs.size());
             _hash_values.reserve(source->runtime_state()->chunk_size());
         }
@@ -83,7 +98,15 @@ class PartitionExchanger final : public LocalExchanger {
             return _partition_row_indexes_start_points[partition_id + 1];
         }
 
+        int64_t num_spread_rows() const { return _num_spread_rows; }
+
     private:
+        static constexpr size_t kHotKeySampleStride = 16;
+        static constexpr size_t kHotKeyWindowSamples = 1024;
+
+        // Deliver the rows of the hot keys to the sources in a round-robin way.
+        void _spread_hot_key_rows(size_t num_rows);
+
         LocalExchangeSourceOperatorFactory* _source;
         const TPartitionType::type _part_type;
         // Compute per-row partition values.
@@ -98,15 +121,24 @@ class PartitionExchanger final : public LocalExchanger {
         // _partition_row_indexes_start_points[i + 1] - _partition_row_indexes_start_points[i]
         std::vector<size_t> _partition_row_indexes_start_points;
         std::unique_ptr<Shuffler> _shuffler;
+
+        const bool _spread_hot_keys;
+        // Only used if the hot keys are spread.
+        std::unique_ptr<HeavyHitterSampler> _hot_key_sampler;
+        uint32_t _next_spread_partition = 0;
+        int64_t _num_spread_rows = 0;
     };
 
 public:
     PartitionExchanger(const std::shared_ptr<LocalExchangeMemoryManager>& memory_manager,
                        LocalExchangeSourceOperatorFactory* source, const TPartitionType::type part_type,
-                       const std::vector<ExprContext*>& _partition_expr_ctxs, size_t num_sinks);
+                       const std::vector<ExprContext*>& _partition_expr_ctxs, size_t num_sinks,
+                       bool spread_hot_keys = false);
 
     Status accept(const vectorized::ChunkPtr& chunk, int32_t sink_driver_sequence) override;
 
+    void update_sink_profile(int32_t sink_driver_sequence, RuntimeProfile* profile) override;
+
 private:
     // Used for local shuffle exchanger.
     // The sink_driver_sequence-th local sink operator exclusively uses the sink_driver_sequence-th partitioner.
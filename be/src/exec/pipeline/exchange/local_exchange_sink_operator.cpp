@@ -22,6 +22,7 @@ StatusOr<vectorized::ChunkPtr> LocalExchangeSinkOperator::pull_chunk(RuntimeStat
 
 Status LocalExchangeSinkOperator::set_finishing(RuntimeState* state) {
     _is_finished = true;
+    _exchanger->update_sink_profile(_driver_sequence, _unique_metrics.get());
     _exchanger->finish(state);
     return Status::OK();
 }
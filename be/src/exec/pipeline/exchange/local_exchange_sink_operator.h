@@ -30,6 +30,11 @@ public:
     // In either case,  LocalExchangeSinkOperator is finished.
     bool is_finished() const override { return _is_finished || _exchanger->is_all_sources_finished(); }
 
+    bool attach_observer(PipelineObserver* observer) override {
+        _exchanger->attach_sink_observer(observer);
+        return true;
+    }
+
     Status set_finishing(RuntimeState* state) override;
 
     StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
@@ -10,12 +10,15 @@ namespace starrocks::pipeline {
 // Used for PassthroughExchanger.
 // The input chunk is most likely full, so we don't merge it to avoid copying chunk data.
 Status LocalExchangeSourceOperator::add_chunk(vectorized::ChunkPtr chunk) {
-    std::lock_guard<std::mutex> l(_chunk_lock);
-    if (_is_finished) {
-        return Status::OK();
+    {
+        std::lock_guard<std::mutex> l(_chunk_lock);
+        if (_is_finished) {
+            return Status::OK();
+        }
+        _memory_manager->update_row_count(chunk->num_rows());
+        _full_chunk_queue.emplace(std::move(chunk));
     }
-    _memory_manager->update_row_count(chunk->num_rows());
-    _full_chunk_queue.emplace(std::move(chunk));
+    _observable.notify_observers();
 
     return Status::OK();
 }
@@ -25,13 +28,16 @@ Status LocalExchangeSourceOperator::add_chunk(vectorized::ChunkPtr chunk) {
 Status LocalExchangeSourceOperator::add_chunk(vectorized::ChunkPtr chunk,
                                               std::shared_ptr<std::vector<uint32_t>> indexes, uint32_t from,
                                               uint32_t size) {
-    std::lock_guard<std::mutex> l(_chunk_lock);
-    if (_is_finished) {
-        return Status::OK();
+    {
+        std::lock_guard<std::mutex> l(_chunk_lock);
+        if (_is_finished) {
+            return Status::OK();
+        }
+        _memory_manager->update_row_count(size);
+        _partition_chunk_queue.emplace(std::move(chunk), std::move(indexes), from, size);
+        _partition_rows_num += size;
     }
-    _memory_manager->update_row_count(size);
-    _partition_chunk_queue.emplace(std::move(chunk), std::move(indexes), from, size);
-    _partition_rows_num += size;
+    _observable.notify_observers();
 
     return Status::OK();
 }
@@ -66,6 +72,8 @@ Status LocalExchangeSourceOperator::set_finished(RuntimeState* state) {
     // Subtract the number of rows of buffered chunks from row_count of _memory_manager and make it unblocked.
     _memory_manager->update_row_count(-(full_rows_num + _partition_rows_num));
     _partition_rows_num = 0;
+    // The sinks are finished if all the sources are finished.
+    _memory_manager->notify_observers();
     return Status::OK();
 }
 
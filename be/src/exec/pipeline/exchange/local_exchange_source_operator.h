@@ -44,11 +44,19 @@ public:
 
     Status set_finished(RuntimeState* state) override;
     Status set_finishing(RuntimeState* state) override {
-        std::lock_guard<std::mutex> l(_chunk_lock);
-        _is_finished = true;
+        {
+            std::lock_guard<std::mutex> l(_chunk_lock);
+            _is_finished = true;
+        }
+        _observable.notify_observers();
         return Status::OK();
     }
 
+    bool attach_observer(PipelineObserver* observer) override {
+        _observable.add_observer(observer);
+        return true;
+    }
+
     StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
 
 private:
@@ -64,6 +72,8 @@ private:
     // TODO(KKS): make it lock free
     mutable std::mutex _chunk_lock;
     const std::shared_ptr<LocalExchangeMemoryManager>& _memory_manager;
+    // Signalled when chunks are added or the sinks finish.
+    Observable _observable;
 };
 
 class LocalExchangeSourceOperatorFactory final : public SourceOperatorFactory {
@@ -292,6 +292,7 @@ void SinkBuffer::_try_to_send_rpc(const TUniqueId& instance_id, std::function<vo
                 ++_num_finished_rpcs[ctx.instance_id.lo];
                 --_num_in_flight_rpcs[ctx.instance_id.lo];
             }
+            _observable.notify_observers();
             --_total_in_flight_rpc;
             std::string err_msg = fmt::format("transmit chunk rpc failed:{}", print_id(ctx.instance_id));
             _fragment_ctx->cancel(Status::InternalError(err_msg));
@@ -315,6 +316,7 @@ void SinkBuffer::_try_to_send_rpc(const TUniqueId& instance_id, std::function<vo
                     _update_network_time(ctx.instance_id, ctx.send_timestamp, result.receive_timestamp());
                 });
             }
+            _observable.notify_observers();
             --_total_in_flight_rpc;
         });
 
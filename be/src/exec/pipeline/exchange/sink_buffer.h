@@ -17,6 +17,7 @@ DIAGNOSTIC_POP
 
 #include "column/chunk.h"
 #include "exec/pipeline/fragment_context.h"
+#include "exec/pipeline/pipeline_observer.h"
 #include "gen_cpp/BackendService.h"
 #include "runtime/current_thread.h"
 #include "runtime/runtime_state.h"
@@ -86,6 +87,9 @@ public:
     // the rest chunk request and EOS request needn't be sent anymore.
     void cancel_one_sinker();
 
+    // Observers are signalled when the response of a request is received, which may make the buffer not full.
+    void attach_observer(PipelineObserver* observer) { _observable.add_observer(observer); }
+
 private:
     using Mutex = bthread::Mutex;
 
@@ -165,6 +169,9 @@ private:
     int64_t _pending_timestamp = -1;
     mutable std::atomic<int64_t> _last_full_timestamp = -1;
     mutable std::atomic<int64_t> _full_time = 0;
+
+    // Must be notified before decreasing _total_in_flight_rpc, after which the drivers may be destroyed.
+    Observable _observable;
 }; // namespace starrocks::pipeline
 
 } // namespace starrocks::pipeline
@@ -31,6 +31,7 @@
 #include "runtime/exec_env.h"
 #include "runtime/multi_cast_data_stream_sink.h"
 #include "runtime/result_sink.h"
+#include "util/cpu_info.h"
 #include "util/debug/query_trace.h"
 #include "util/pretty_printer.h"
 #include "util/time.h"
@@ -60,6 +61,24 @@ UnifiedExecPlanFragmentParams::per_driver_seq_scan_ranges_of_node(TPlanNodeId no
                            _no_scan_ranges_per_driver_seq);
 }
 
+bool UnifiedExecPlanFragmentParams::has_pipeline_level_shuffle_receiver() const {
+    for (const auto& node : _common_request.fragment.plan.nodes) {
+        if (node.node_type != TPlanNodeType::EXCHANGE_NODE) {
+            continue;
+        }
+        // The partition type of the senders is unknown if not set by FE.
+        if (!node.__isset.exchange_node || !node.exchange_node.__isset.partition_type) {
+            return true;
+        }
+        auto partition_type = node.exchange_node.partition_type;
+        if (partition_type == TPartitionType::HASH_PARTITIONED ||
+            partition_type == TPartitionType::BUCKET_SHUFFLE_HASH_PARTITIONED) {
+            return true;
+        }
+    }
+    return false;
+}
+
 const TDataSink& UnifiedExecPlanFragmentParams::output_sink() const {
     if (_unique_request.fragment.__isset.output_sink) {
         return _unique_request.fragment.output_sink;
@@ -236,9 +255,19 @@ Status FragmentExecutor::_prepare_runtime_state(ExecEnv* exec_env, const Unified
     return Status::OK();
 }
 
-int32_t FragmentExecutor::_calc_dop(ExecEnv* exec_env, const UnifiedExecPlanFragmentParams& request) const {
-    int32_t degree_of_parallelism = request.pipeline_dop();
-    return exec_env->calc_pipeline_dop(degree_of_parallelism);
+int32_t FragmentExecutor::_calc_dop(ExecEnv* exec_env, const UnifiedExecPlanFragmentParams& request) {
+    if (_dop > 0) {
+        return _dop;
+    }
+    int32_t degree_of_parallelism = exec_env->calc_pipeline_dop(request.pipeline_dop());
+    // The scan ranges assigned to driver sequences by FE require the exact dop, and so do the senders of a
+    // pipeline level shuffle, which split the rows by the dop FE requested for this fragment.
+    if (config::enable_pipeline_adaptive_dop && !request.has_per_driver_seq_scan_ranges() &&
+        !request.has_pipeline_level_shuffle_receiver()) {
+        degree_of_parallelism = exec_env->driver_limiter()->adjust_dop_by_load(degree_of_parallelism);
+    }
+    _dop = degree_of_parallelism;
+    return _dop;
 }
 
 int FragmentExecutor::_calc_delivery_expired_seconds(const UnifiedExecPlanFragmentParams& request) const {
@@ -274,7 +303,7 @@ Status FragmentExecutor::_prepare_exec_plan(ExecEnv* exec_env, const UnifiedExec
     const DescriptorTbl& desc_tbl = runtime_state->desc_tbl();
     const auto& params = request.common().params;
     const auto& fragment = request.common().fragment;
-    const auto dop = _calc_dop(exec_env, request);
+    auto dop = _calc_dop(exec_env, request);
     const auto& query_options = request.common().query_options;
 
     bool enable_shared_scan = request.common().__isset.enable_shared_scan && request.common().enable_shared_scan;
@@ -318,6 +347,21 @@ Status FragmentExecutor::_prepare_exec_plan(ExecEnv* exec_env, const UnifiedExec
         morsel_queue_factories.emplace(scan_node->id(), std::move(morsel_queue_factory));
     }
 
+    // The data of a fragment without exchange nodes all comes from its scan nodes, so the pipelines above them
+    // don't need more drivers than the scan pipelines, whose dop is adapted to the morsels and rows to scan.
+    if (config::enable_pipeline_adaptive_dop && exch_nodes.empty() && !scan_nodes.empty() &&
+        !request.has_per_driver_seq_scan_ranges()) {
+        size_t max_scan_dop = 1;
+        for (const auto& [_, morsel_queue_factory] : morsel_queue_factories) {
+            max_scan_dop = std::max(max_scan_dop, morsel_queue_factory->size());
+        }
+        if (max_scan_dop < dop) {
+            VLOG_ROW << "Adapt dop of fragment instance " << print_id(request.fragment_instance_id()) << " from "
+                     << dop << " to " << max_scan_dop;
+            dop = _dop = max_scan_dop;
+        }
+    }
+
     int64_t logical_scan_limit = 0;
     int64_t physical_scan_limit = 0;
     for (auto& i : scan_nodes) {
@@ -378,6 +422,9 @@ Status FragmentExecutor::_prepare_pipeline_driver(ExecEnv* exec_env, const Unifi
     }
     RETURN_IF_ERROR(_fragment_ctx->prepare_all_pipelines());
 
+    // The drivers of the same sequence in different pipelines usually pass chunks to each other,
+    // so they are placed on the same NUMA node.
+    const int num_numa_nodes = CpuInfo::num_execution_numa_nodes();
     size_t driver_id = 0;
     for (auto n = 0; n < pipelines.size(); ++n) {
         const auto& pipeline = pipelines[n];
@@ -403,6 +450,9 @@ Status FragmentExecutor::_prepare_pipeline_driver(ExecEnv* exec_env, const Unifi
                 DriverPtr driver = std::make_shared<PipelineDriver>(std::move(operators), _query_ctx,
                                                                     _fragment_ctx.get(), driver_id++);
                 driver->set_morsel_queue(morsel_queue_factory->create(i));
+                if (num_numa_nodes > 1) {
+                    driver->set_numa_node(i % num_numa_nodes);
+                }
                 if (auto* scan_operator = driver->source_scan_operator()) {
                     scan_operator->set_workgroup(_wg);
                     if (dynamic_cast<ConnectorScanOperator*>(scan_operator) != nullptr) {
@@ -428,6 +478,9 @@ Status FragmentExecutor::_prepare_pipeline_driver(ExecEnv* exec_env, const Unifi
                 auto&& operators = pipeline->create_operators(cur_pipeline_dop, i);
                 DriverPtr driver = std::make_shared<PipelineDriver>(std::move(operators), _query_ctx,
                                                                     _fragment_ctx.get(), driver_id++);
+                if (num_numa_nodes > 1) {
+                    driver->set_numa_node(i % num_numa_nodes);
+                }
                 setup_profile_hierarchy(pipeline, driver);
                 drivers.emplace_back(std::move(driver));
             }
@@ -55,6 +55,13 @@ public:
     const std::vector<TScanRangeParams>& scan_ranges_of_node(TPlanNodeId node_id) const;
     const std::map<int32_t, std::vector<TScanRangeParams>>& per_driver_seq_scan_ranges_of_node(
             TPlanNodeId node_id) const;
+    bool has_per_driver_seq_scan_ranges() const {
+        return _unique_request.params.__isset.node_to_per_driver_seq_scan_ranges &&
+               !_unique_request.params.node_to_per_driver_seq_scan_ranges.empty();
+    }
+    // Whether the fragment has an exchange node whose senders shuffle the rows to the driver sequences of the
+    // receiver, by the dop of the receiver requested by FE.
+    bool has_pipeline_level_shuffle_receiver() const;
 
     bool isset_output_sink() const {
         return _common_request.fragment.__isset.output_sink || _unique_request.fragment.__isset.output_sink;
@@ -78,7 +85,7 @@ public:
 
 private:
     void _fail_cleanup();
-    int32_t _calc_dop(ExecEnv* exec_env, const UnifiedExecPlanFragmentParams& request) const;
+    int32_t _calc_dop(ExecEnv* exec_env, const UnifiedExecPlanFragmentParams& request);
     int _calc_delivery_expired_seconds(const UnifiedExecPlanFragmentParams& request) const;
     int _calc_query_expired_seconds(const UnifiedExecPlanFragmentParams& request) const;
 
@@ -105,6 +112,8 @@ private:
     QueryContext* _query_ctx = nullptr;
     FragmentContextPtr _fragment_ctx = nullptr;
     workgroup::WorkGroupPtr _wg = nullptr;
+    // The degree of parallelism of this fragment instance, calculated once by _calc_dop.
+    int32_t _dop = 0;
 };
 } // namespace pipeline
 } // namespace starrocks
@@ -26,6 +26,12 @@ Status HashJoinBuildOperator::push_chunk(RuntimeState* state, const vectorized::
 Status HashJoinBuildOperator::prepare(RuntimeState* state) {
     RETURN_IF_ERROR(Operator::prepare(state));
 
+    // All the operators of a fragment are created before any of them is prepared, so every other probe driver of the
+    // partitioned build has registered its prober of this partition by now, see
+    // HashJoinerFactory::create_partition_probers. The probers added later would never see the hash table.
+    auto* factory = (HashJoinBuildOperatorFactory*)_factory;
+    DCHECK(!factory->is_partitioned_build() || _read_only_join_probers.size() + 1 == factory->num_build_partitions());
+
     _join_builder->ref();
     for (auto& read_only_join_prober : _read_only_join_probers) {
         read_only_join_prober->ref();
@@ -55,8 +61,9 @@ Status HashJoinBuildOperator::set_finishing(RuntimeState* state) {
     RETURN_IF_ERROR(_join_builder->build_ht(state));
 
     size_t merger_index = _driver_sequence;
-    // Broadcast Join only has one build operator.
-    DCHECK(_distribution_mode != TJoinDistributionMode::BROADCAST || _driver_sequence == 0);
+    // Broadcast Join only has one build operator, unless it's built in partitions.
+    DCHECK(_distribution_mode != TJoinDistributionMode::BROADCAST || _driver_sequence == 0 ||
+           ((HashJoinBuildOperatorFactory*)_factory)->is_partitioned_build());
 
     RETURN_IF_ERROR(_join_builder->create_runtime_filters(state));
 
@@ -92,6 +99,8 @@ Status HashJoinBuildOperator::set_finishing(RuntimeState* state) {
     }
     {
         TRY_CATCH_ALLOC_SCOPE_START()
+        // The same probers as the ones referenced in prepare(), no prober is registered after the operators are
+        // created.
         for (auto& read_only_join_prober : _read_only_join_probers) {
             read_only_join_prober->reference_hash_table(_join_builder.get());
         }
@@ -130,7 +139,7 @@ OperatorPtr HashJoinBuildOperatorFactory::create(int32_t degree_of_parallelism,
     }
     return std::make_shared<HashJoinBuildOperator>(
             this, _id, _name, _plan_node_id, driver_sequence, _hash_joiner_factory->create_builder(driver_sequence),
-            _hash_joiner_factory->get_read_only_probers(), _partial_rf_merger.get(), _distribution_mode);
+            _hash_joiner_factory->get_read_only_probers(driver_sequence), _partial_rf_merger.get(), _distribution_mode);
 }
 
 void HashJoinBuildOperatorFactory::retain_string_key_columns(int32_t driver_sequence, vectorized::Columns&& columns) {
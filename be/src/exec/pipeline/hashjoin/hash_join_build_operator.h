@@ -49,6 +49,7 @@ private:
     HashJoinerPtr _join_builder;
     // Assign the readable hash table from _join_builder to each only probe hash_joiner,
     // when _join_builder finish building the hash tbale.
+    // It's filled by HashJoinerFactory while the probe operators are created, which may be after this operator.
     const std::vector<HashJoinerPtr>& _read_only_join_probers;
     PartialRuntimeFilterMerger* _partial_rf_merger;
     bool _is_finished = false;
@@ -66,6 +67,8 @@ public:
     void close(RuntimeState* state) override;
     OperatorPtr create(int32_t degree_of_parallelism, int32_t driver_sequence) override;
     void retain_string_key_columns(int32_t driver_sequence, vectorized::Columns&& columns);
+    bool is_partitioned_build() const { return _hash_joiner_factory->is_partitioned_build(); }
+    int num_build_partitions() const { return _hash_joiner_factory->num_build_partitions(); }
 
 private:
     HashJoinerFactoryPtr _hash_joiner_factory;
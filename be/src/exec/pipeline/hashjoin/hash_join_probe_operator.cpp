@@ -2,20 +2,32 @@
 
 #include "exec/pipeline/hashjoin/hash_join_probe_operator.h"
 
+#include <algorithm>
+
+#include "exprs/expr_context.h"
+
 namespace starrocks {
 namespace pipeline {
 
 HashJoinProbeOperator::HashJoinProbeOperator(OperatorFactory* factory, int32_t id, const string& name,
-                                             int32_t plan_node_id, int32_t driver_sequence, HashJoinerPtr join_prober,
-                                             HashJoinerPtr join_builder)
+                                             int32_t plan_node_id, int32_t driver_sequence, HashJoiners join_probers,
+                                             HashJoiners join_builders, std::vector<ExprContext*> probe_expr_ctxs)
         : OperatorWithDependency(factory, id, name, plan_node_id, driver_sequence),
-          _join_prober(std::move(join_prober)),
-          _join_builder(std::move(join_builder)) {}
+          _join_probers(std::move(join_probers)),
+          _join_builders(std::move(join_builders)),
+          _probe_expr_ctxs(std::move(probe_expr_ctxs)) {
+    DCHECK(!_join_probers.empty());
+    DCHECK(!_is_partitioned() || !_probe_expr_ctxs.empty());
+}
 
 void HashJoinProbeOperator::close(RuntimeState* state) {
-    _join_prober->unref(state);
-    if (_join_builder != _join_prober) {
-        _join_builder->unref(state);
+    for (auto& join_prober : _join_probers) {
+        join_prober->unref(state);
+    }
+    for (auto& join_builder : _join_builders) {
+        if (std::find(_join_probers.begin(), _join_probers.end(), join_builder) == _join_probers.end()) {
+            join_builder->unref(state);
+        }
     }
 
     OperatorWithDependency::close(state);
@@ -24,51 +36,137 @@ void HashJoinProbeOperator::close(RuntimeState* state) {
 Status HashJoinProbeOperator::prepare(RuntimeState* state) {
     RETURN_IF_ERROR(OperatorWithDependency::prepare(state));
 
-    if (_join_builder != _join_prober) {
-        _join_builder->ref();
+    for (auto& join_builder : _join_builders) {
+        if (std::find(_join_probers.begin(), _join_probers.end(), join_builder) == _join_probers.end()) {
+            join_builder->ref();
+        }
+    }
+    for (auto& join_prober : _join_probers) {
+        join_prober->ref();
     }
-    _join_prober->ref();
 
-    RETURN_IF_ERROR(_join_prober->prepare_prober(state, _unique_metrics.get()));
+    for (auto& join_prober : _join_probers) {
+        RETURN_IF_ERROR(join_prober->prepare_prober(state, _unique_metrics.get()));
+    }
+
+    if (_is_partitioned()) {
+        // Must be the same as the local shuffle of build side.
+        _shuffler = std::make_unique<Shuffler>(state->func_version() <= 3, false, TPartitionType::HASH_PARTITIONED,
+                                               _join_probers.size(), 1);
+        _partition_row_indexes.resize(_join_probers.size());
+        _partition_chunks.resize(_join_probers.size());
+    }
 
     return Status::OK();
 }
 
 bool HashJoinProbeOperator::has_output() const {
-    return _join_prober->has_output();
+    return _num_partition_chunks > 0 ||
+           std::any_of(_join_probers.begin(), _join_probers.end(), [](const auto& p) { return p->has_output(); });
 }
 
 bool HashJoinProbeOperator::need_input() const {
-    return _join_prober->need_input();
+    if (!_is_partitioned()) {
+        return _join_probers[0]->need_input();
+    }
+    // Probers of empty hash tables may finish in short-circuit style.
+    return _num_partition_chunks == 0 &&
+           std::all_of(_join_probers.begin(), _join_probers.end(),
+                       [](const auto& p) { return p->need_input() || p->is_done(); }) &&
+           std::any_of(_join_probers.begin(), _join_probers.end(), [](const auto& p) { return p->need_input(); });
 }
 
 bool HashJoinProbeOperator::is_finished() const {
-    return _join_prober->is_done();
+    return std::all_of(_join_probers.begin(), _join_probers.end(), [](const auto& p) { return p->is_done(); });
 }
 
 Status HashJoinProbeOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
-    _join_prober->push_chunk(state, std::move(const_cast<vectorized::ChunkPtr&>(chunk)));
+    if (!_is_partitioned()) {
+        return _join_probers[0]->push_chunk(state, std::move(const_cast<vectorized::ChunkPtr&>(chunk)));
+    }
+    return _partition_chunk(state, chunk);
+}
+
+Status HashJoinProbeOperator::_partition_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    size_t num_rows = chunk->num_rows();
+    _hash_values.assign(num_rows, HashUtil::FNV_SEED);
+    for (auto* expr_ctx : _probe_expr_ctxs) {
+        ASSIGN_OR_RETURN(auto column, expr_ctx->evaluate(chunk.get()));
+        column->fnv_hash(_hash_values.data(), 0, num_rows);
+    }
+    _partition_ids.resize(num_rows);
+    _shuffler->local_exchange_shuffle(_partition_ids, _hash_values, num_rows);
+
+    for (auto& indexes : _partition_row_indexes) {
+        indexes.clear();
+    }
+    for (uint32_t i = 0; i < num_rows; i++) {
+        _partition_row_indexes[_partition_ids[i]].push_back(i);
+    }
+    for (size_t i = 0; i < _join_probers.size(); i++) {
+        const auto& indexes = _partition_row_indexes[i];
+        // The rows of a finished prober produce nothing, its hash table is empty for inner and semi join.
+        if (indexes.empty() || _join_probers[i]->is_done()) {
+            continue;
+        }
+        if (indexes.size() == num_rows) {
+            _partition_chunks[i] = chunk;
+        } else {
+            _partition_chunks[i] = chunk->clone_empty_with_slot(indexes.size());
+            _partition_chunks[i]->append_selective(*chunk, indexes.data(), 0, indexes.size());
+        }
+        _num_partition_chunks++;
+    }
     return Status::OK();
 }
 
 StatusOr<vectorized::ChunkPtr> HashJoinProbeOperator::pull_chunk(RuntimeState* state) {
-    return _join_prober->pull_chunk(state);
+    if (!_is_partitioned()) {
+        return _join_probers[0]->pull_chunk(state);
+    }
+    // Finish the probe chunk being probed first.
+    for (auto& join_prober : _join_probers) {
+        if (join_prober->has_probe_input()) {
+            return join_prober->pull_chunk(state);
+        }
+    }
+    // Then the probe chunks waiting to be probed, which must be pushed before the probers enter the post probe phase.
+    for (size_t i = 0; i < _join_probers.size() && _num_partition_chunks > 0; i++) {
+        if (_partition_chunks[i] != nullptr) {
+            _num_partition_chunks--;
+            RETURN_IF_ERROR(_join_probers[i]->push_chunk(state, std::move(_partition_chunks[i])));
+            _partition_chunks[i] = nullptr;
+            return _join_probers[i]->pull_chunk(state);
+        }
+    }
+    for (auto& join_prober : _join_probers) {
+        if (join_prober->has_output()) {
+            return join_prober->pull_chunk(state);
+        }
+    }
+    return std::make_shared<vectorized::Chunk>();
 }
 
 Status HashJoinProbeOperator::set_finishing(RuntimeState* state) {
     _is_finished = true;
-    _join_prober->enter_post_probe_phase();
+    for (auto& join_prober : _join_probers) {
+        join_prober->enter_post_probe_phase();
+    }
     return Status::OK();
 }
 
 Status HashJoinProbeOperator::set_finished(RuntimeState* state) {
-    _join_prober->enter_eos_phase();
-    _join_builder->set_prober_finished();
+    for (auto& join_prober : _join_probers) {
+        join_prober->enter_eos_phase();
+    }
+    for (auto& join_builder : _join_builders) {
+        join_builder->set_prober_finished();
+    }
     return Status::OK();
 }
 
 bool HashJoinProbeOperator::is_ready() const {
-    return _join_prober->is_build_done();
+    return std::all_of(_join_probers.begin(), _join_probers.end(), [](const auto& p) { return p->is_build_done(); });
 }
 
 HashJoinProbeOperatorFactory::HashJoinProbeOperatorFactory(int32_t id, int32_t plan_node_id,
@@ -83,9 +181,19 @@ void HashJoinProbeOperatorFactory::close(RuntimeState* state) {
 }
 
 OperatorPtr HashJoinProbeOperatorFactory::create(int32_t degree_of_parallelism, int32_t driver_sequence) {
+    if (_hash_joiner_factory->is_partitioned_build()) {
+        HashJoiners join_builders;
+        for (int i = 0; i < _hash_joiner_factory->num_build_partitions(); i++) {
+            join_builders.emplace_back(_hash_joiner_factory->create_builder(i));
+        }
+        return std::make_shared<HashJoinProbeOperator>(
+                this, _id, _name, _plan_node_id, driver_sequence,
+                _hash_joiner_factory->create_partition_probers(driver_sequence), std::move(join_builders),
+                _hash_joiner_factory->probe_expr_ctxs());
+    }
     return std::make_shared<HashJoinProbeOperator>(this, _id, _name, _plan_node_id, driver_sequence,
-                                                   _hash_joiner_factory->create_prober(driver_sequence),
-                                                   _hash_joiner_factory->create_builder(driver_sequence));
+                                                   HashJoiners{_hash_joiner_factory->create_prober(driver_sequence)},
+                                                   HashJoiners{_hash_joiner_factory->create_builder(driver_sequence)});
 }
 
 } // namespace pipeline
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "exec/pipeline/exchange/shuffler.h"
 #include "exec/pipeline/hashjoin/hash_joiner_factory.h"
 #include "exec/pipeline/operator.h"
 #include "exec/pipeline/operator_with_dependency.h"
@@ -15,8 +16,11 @@ using HashJoiner = starrocks::vectorized::HashJoiner;
 
 class HashJoinProbeOperator final : public OperatorWithDependency {
 public:
+    // |join_probers| has one prober, or one prober of each partition for the partitioned build,
+    // whose hash tables are built by |join_builders|. |probe_expr_ctxs| is used to partition the probe chunks.
     HashJoinProbeOperator(OperatorFactory* factory, int32_t id, const string& name, int32_t plan_node_id,
-                          int32_t driver_sequence, HashJoinerPtr join_prober, HashJoinerPtr join_builder);
+                          int32_t driver_sequence, HashJoiners join_probers, HashJoiners join_builders,
+                          std::vector<ExprContext*> probe_expr_ctxs = {});
     ~HashJoinProbeOperator() override = default;
 
     Status prepare(RuntimeState* state) override;
@@ -32,19 +36,33 @@ public:
 
     bool is_ready() const override;
     std::string get_name() const override {
-        return strings::Substitute("$0(HashJoiner=$1)", Operator::get_name(), _join_prober.get());
+        return strings::Substitute("$0(HashJoiner=$1)", Operator::get_name(), _join_probers[0].get());
     }
 
     Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk);
     StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state);
 
 private:
-    const HashJoinerPtr _join_prober;
-    // For non-broadcast join, _join_builder is identical to _join_prober.
-    // For broadcast join, _join_prober references the hash table owned by _join_builder,
-    // so increase the reference number of _join_builder to prevent it closing early.
-    const HashJoinerPtr _join_builder;
+    bool _is_partitioned() const { return _join_probers.size() > 1; }
+    // Split |chunk| by the partition of probe keys into _partition_chunks.
+    Status _partition_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk);
+
+    const HashJoiners _join_probers;
+    // For non-broadcast join, _join_builders is identical to _join_probers.
+    // For broadcast join, _join_probers reference the hash tables owned by _join_builders,
+    // so increase the reference number of _join_builders to prevent them closing early.
+    const HashJoiners _join_builders;
     bool _is_finished = false;
+
+    // Only used by the partitioned build.
+    const std::vector<ExprContext*> _probe_expr_ctxs;
+    std::unique_ptr<Shuffler> _shuffler;
+    std::vector<uint32_t> _hash_values;
+    std::vector<uint32_t> _partition_ids;
+    std::vector<std::vector<uint32_t>> _partition_row_indexes;
+    // Probe chunks of each partition waiting to be pushed to the probers.
+    std::vector<vectorized::ChunkPtr> _partition_chunks;
+    size_t _num_partition_chunks = 0;
 };
 
 class HashJoinProbeOperatorFactory final : public OperatorFactory {
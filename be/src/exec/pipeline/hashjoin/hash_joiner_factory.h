@@ -16,9 +16,20 @@ using HashJoiners = std::vector<HashJoinerPtr>;
 class HashJoinerFactory;
 using HashJoinerFactoryPtr = std::shared_ptr<HashJoinerFactory>;
 
+// For the partitioned build (|num_build_partitions| > 1) of broadcast join, or of shuffle join whose probe side
+// spreads the hot keys over all the drivers, the build side is shuffled into |num_build_partitions| partitions by
+// the join keys, the i-th builder builds the hash table of the i-th partition, and every probe driver has
+// |num_build_partitions| probers, the i-th of which probes the hash table of the i-th partition.
+// The number of partitions must be equal to the degree of parallelism.
 class HashJoinerFactory {
 public:
-    HashJoinerFactory(starrocks::vectorized::HashJoinerParam& param, int dop) : _param(param), _hash_joiners(dop) {}
+    HashJoinerFactory(starrocks::vectorized::HashJoinerParam& param, int dop, int num_build_partitions = 1)
+            : _param(param),
+              _hash_joiners(dop),
+              _num_build_partitions(num_build_partitions),
+              _partition_read_only_probers(num_build_partitions) {
+        DCHECK(num_build_partitions == 1 || num_build_partitions == dop);
+    }
 
     Status prepare(RuntimeState* state);
     void close(RuntimeState* state);
@@ -37,23 +48,50 @@ public:
     }
 
     HashJoinerPtr create_builder(int driver_sequence) {
-        if (_param._distribution_mode == TJoinDistributionMode::BROADCAST) {
+        if (_param._distribution_mode == TJoinDistributionMode::BROADCAST && !is_partitioned_build()) {
             driver_sequence = BROADCAST_BUILD_DRIVER_SEQUENCE;
         }
         if (!_hash_joiners[driver_sequence]) {
             _param._is_buildable = true;
-            _hash_joiners[driver_sequence] = std::make_shared<HashJoiner>(_param, _read_only_probers);
+            _hash_joiners[driver_sequence] =
+                    std::make_shared<HashJoiner>(_param, get_read_only_probers(driver_sequence));
         }
 
         return _hash_joiners[driver_sequence];
     }
 
+    // Create the probers of all the partitions for the probe driver |driver_sequence| of the partitioned build.
+    // The prober of its own partition is the builder itself, the others reference the hash tables of other builders.
+    // It must be called for all the probe drivers before any HashJoinBuildOperator is prepared, which holds the
+    // read-only probers of its partition by reference.
+    HashJoiners create_partition_probers(int driver_sequence) {
+        DCHECK(is_partitioned_build());
+        HashJoiners probers(_num_build_partitions);
+        for (int i = 0; i < _num_build_partitions; i++) {
+            if (i == driver_sequence) {
+                probers[i] = create_builder(i);
+            } else {
+                _param._is_buildable = false;
+                probers[i] = std::make_shared<HashJoiner>(_param, _partition_read_only_probers[i]);
+                _partition_read_only_probers[i].emplace_back(probers[i]);
+            }
+        }
+        return probers;
+    }
+
     bool is_buildable(int driver_sequence) const {
         return _param._distribution_mode != TJoinDistributionMode::BROADCAST ||
                driver_sequence == BROADCAST_BUILD_DRIVER_SEQUENCE;
     }
 
-    const HashJoiners& get_read_only_probers() const { return _read_only_probers; }
+    bool is_partitioned_build() const { return _num_build_partitions > 1; }
+    int num_build_partitions() const { return _num_build_partitions; }
+    const std::vector<ExprContext*>& probe_expr_ctxs() const { return _param._probe_expr_ctxs; }
+
+    // The read-only probers referencing the hash table built by the builder |driver_sequence|.
+    const HashJoiners& get_read_only_probers(int driver_sequence) const {
+        return is_partitioned_build() ? _partition_read_only_probers[driver_sequence] : _read_only_probers;
+    }
 
 private:
     // Broadcast join need only create one hash table, because all the HashJoinProbeOperators
@@ -63,6 +101,10 @@ private:
     starrocks::vectorized::HashJoinerParam _param;
     HashJoiners _hash_joiners;
     HashJoiners _read_only_probers;
+
+    const int _num_build_partitions;
+    // The read-only probers of each partition for the partitioned build.
+    std::vector<HashJoiners> _partition_read_only_probers;
 };
 
 } // namespace pipeline
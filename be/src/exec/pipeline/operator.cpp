@@ -171,6 +171,9 @@ void Operator::_init_rf_counters(bool init_bloom) {
                 ADD_COUNTER(_common_metrics, "JoinRuntimeFilterOutputRows", TUnit::UNIT);
         _bloom_filter_eval_context.join_runtime_filter_eval_counter =
                 ADD_COUNTER(_common_metrics, "JoinRuntimeFilterEvaluate", TUnit::UNIT);
+        _bloom_filter_eval_context.join_runtime_filter_disabled_counter =
+                ADD_COUNTER(_common_metrics, "JoinRuntimeFilterDisabled", TUnit::UNIT);
+        _bloom_filter_eval_context.runtime_profile = _common_metrics.get();
     }
 }
 
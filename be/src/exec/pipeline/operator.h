@@ -21,6 +21,7 @@ using RuntimeFilterProbeCollector = starrocks::vectorized::RuntimeFilterProbeCol
 namespace pipeline {
 class Operator;
 class OperatorFactory;
+class PipelineObserver;
 using OperatorPtr = std::shared_ptr<Operator>;
 using Operators = std::vector<OperatorPtr>;
 using LocalRFWaitingSet = std::set<TPlanNodeId>;
@@ -93,6 +94,12 @@ public:
     // Only source and sink operator may return true, and other operators always return false.
     virtual bool pending_finish() const { return false; }
 
+    // Attach the observer of the driver to the components this operator waits for, which signal the observer
+    // once has_output(), need_input() or is_finished() of this operator may change.
+    // It is called after prepare(), and only for the source and sink operator of a driver. Return false if this
+    // operator cannot be observed, then the driver blocked on it is checked by the poller in every round.
+    virtual bool attach_observer(PipelineObserver* observer) { return false; }
+
     // Pull chunk from this operator
     // Use shared_ptr, because in some cases (local broadcast exchange),
     // the chunk need to be shared
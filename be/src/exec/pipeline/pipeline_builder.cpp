@@ -77,7 +77,7 @@ OpFactories PipelineBuilderContext::maybe_interpolate_local_passthrough_exchange
 
 OpFactories PipelineBuilderContext::maybe_interpolate_local_shuffle_exchange(
         RuntimeState* state, OpFactories& pred_operators, const std::vector<ExprContext*>& partition_expr_ctxs,
-        const TPartitionType::type part_type) {
+        const TPartitionType::type part_type, bool spread_hot_keys) {
     DCHECK(!pred_operators.empty() && pred_operators[0]->is_source());
 
     // If DOP is one, we needn't partition input chunks.
@@ -97,7 +97,7 @@ OpFactories PipelineBuilderContext::maybe_interpolate_local_shuffle_exchange(
     local_shuffle_source->set_runtime_state(state);
     auto local_shuffle =
             std::make_shared<PartitionExchanger>(mem_mgr, local_shuffle_source.get(), part_type, partition_expr_ctxs,
-                                                 pred_source_op->degree_of_parallelism());
+                                                 pred_source_op->degree_of_parallelism(), spread_hot_keys);
 
     // Append local shuffle sink to the tail of the current pipeline, which comes to end.
     auto local_shuffle_sink =
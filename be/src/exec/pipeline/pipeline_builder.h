@@ -35,9 +35,12 @@ public:
     // It is used to parallelize complex operators. For example, the build Hash Table (HT) operator can partition
     // the input chunks to build multiple partition HTs, and the probe HT operator can also partition the input chunks
     // and probe on multiple partition HTs in parallel.
+    // If the post operators don't require the rows of the same key to be in the same driver, |spread_hot_keys|
+    // can be set to spread the rows of the hot keys over all the drivers, see PartitionExchanger.
     OpFactories maybe_interpolate_local_shuffle_exchange(
             RuntimeState* state, OpFactories& pred_operators, const std::vector<ExprContext*>& partition_expr_ctxs,
-            const TPartitionType::type part_type = TPartitionType::type::HASH_PARTITIONED);
+            const TPartitionType::type part_type = TPartitionType::type::HASH_PARTITIONED,
+            bool spread_hot_keys = false);
 
     // Uses local exchange to gather the output chunks of multiple predecessor pipelines
     // into a new pipeline, which the successor operator belongs to.
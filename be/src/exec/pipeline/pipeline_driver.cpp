@@ -88,6 +88,11 @@ Status PipelineDriver::prepare(RuntimeState* runtime_state) {
         _operator_stages[op->get_id()] = OperatorStage::PREPARED;
     }
 
+    if (config::enable_pipeline_event_driven_poller) {
+        _is_source_observable = source_operator()->attach_observer(&_observer);
+        _is_sink_observable = sink_operator()->attach_observer(&_observer);
+    }
+
     // Driver has no dependencies always sets _all_dependencies_ready to true;
     _all_dependencies_ready = _dependencies.empty();
     // Driver has no local rf to wait for completion always sets _all_local_rf_ready to true;
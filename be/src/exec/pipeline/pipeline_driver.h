@@ -11,6 +11,7 @@
 #include "exec/pipeline/operator.h"
 #include "exec/pipeline/operator_with_dependency.h"
 #include "exec/pipeline/pipeline_fwd.h"
+#include "exec/pipeline/pipeline_observer.h"
 #include "exec/pipeline/query_context.h"
 #include "exec/pipeline/runtime_filter_types.h"
 #include "exec/pipeline/scan/morsel.h"
@@ -352,6 +353,26 @@ public:
     size_t get_driver_queue_level() const { return _driver_queue_level; }
     void set_driver_queue_level(size_t driver_queue_level) { _driver_queue_level = driver_queue_level; }
 
+    PipelineObserver* observer() { return &_observer; }
+
+    // Whether the poller needn't check this blocked driver until its observer is signalled, that is,
+    // the operator it is blocked on can be observed.
+    bool is_event_driven() const {
+        return (_state == DriverState::INPUT_EMPTY && _is_source_observable) ||
+               (_state == DriverState::OUTPUT_FULL && _is_sink_observable);
+    }
+
+    int get_driver_queue_index() const { return _driver_queue_index; }
+    void set_driver_queue_index(int driver_queue_index) { _driver_queue_index = driver_queue_index; }
+
+    // The id of the executor thread which runs this driver last time, -1 if it hasn't been run yet.
+    int last_worker_id() const { return _last_worker_id; }
+    void set_last_worker_id(int worker_id) { _last_worker_id = worker_id; }
+
+    // The NUMA node this driver prefers to run on, -1 if it has no preference.
+    int numa_node() const { return _numa_node; }
+    void set_numa_node(int numa_node) { _numa_node = numa_node; }
+
     inline bool is_in_ready_queue() const { return _in_ready_queue.load(std::memory_order_acquire); }
     void set_in_ready_queue(bool v) { _in_ready_queue.store(v, std::memory_order_release); }
 
@@ -407,8 +428,16 @@ private:
     workgroup::WorkGroupPtr _workgroup = nullptr;
     // The index of QuerySharedDriverQueue._queues which this driver belongs to.
     size_t _driver_queue_level = 0;
+    // The index of WorkStealingDriverQueue._local_queues which this driver belongs to.
+    int _driver_queue_index = 0;
+    int _last_worker_id = -1;
+    int _numa_node = -1;
     std::atomic<bool> _in_ready_queue{false};
 
+    PipelineObserver _observer;
+    bool _is_source_observable = false;
+    bool _is_sink_observable = false;
+
     // metrics
     RuntimeProfile::Counter* _total_timer = nullptr;
     RuntimeProfile::Counter* _active_timer = nullptr;
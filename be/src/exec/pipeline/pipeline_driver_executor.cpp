@@ -4,10 +4,12 @@
 
 #include <memory>
 
+#include "common/config.h"
 #include "exec/workgroup/work_group.h"
 #include "gen_cpp/Types_types.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/current_thread.h"
+#include "util/cpu_info.h"
 #include "util/debug/query_trace.h"
 #include "util/defer_op.h"
 
@@ -17,12 +19,21 @@ GlobalDriverExecutor::GlobalDriverExecutor(std::string name, std::unique_ptr<Thr
                                            bool enable_resource_group)
         : Base(name),
           _enable_resource_group(enable_resource_group),
-          _driver_queue(enable_resource_group ? std::unique_ptr<DriverQueue>(std::make_unique<WorkGroupDriverQueue>())
-                                              : std::make_unique<QuerySharedDriverQueue>()),
+          _driver_queue(_create_driver_queue(enable_resource_group, thread_pool->max_threads())),
           _thread_pool(std::move(thread_pool)),
           _blocked_driver_poller(new PipelineDriverPoller(_driver_queue.get())),
           _exec_state_reporter(new ExecStateReporter()) {}
 
+std::unique_ptr<DriverQueue> GlobalDriverExecutor::_create_driver_queue(bool enable_resource_group, int max_threads) {
+    if (enable_resource_group) {
+        return std::make_unique<WorkGroupDriverQueue>();
+    }
+    if (config::enable_pipeline_work_stealing_driver_queue) {
+        return std::make_unique<WorkStealingDriverQueue>(max_threads);
+    }
+    return std::make_unique<QuerySharedDriverQueue>();
+}
+
 GlobalDriverExecutor::~GlobalDriverExecutor() {
     {
         // unregist hook
@@ -49,6 +60,12 @@ void GlobalDriverExecutor::initialize(int num_threads) {
         regist_metric("driver_queue_len", _driver_queue_len, [this]() { return _driver_queue->size(); });
         regist_metric("poller_block_queue_len", _driver_poller_block_queue_len,
                       [this]() { return _blocked_driver_poller->blocked_driver_queue_len(); });
+        if (CpuInfo::num_execution_numa_nodes() > 1) {
+            _numa_local_driver_count = std::make_unique<IntCounter>(MetricUnit::NOUNIT);
+            _numa_remote_driver_count = std::make_unique<IntCounter>(MetricUnit::NOUNIT);
+            metrics->register_metric(_name + "_numa_local_driver_count", _numa_local_driver_count.get());
+            metrics->register_metric(_name + "_numa_remote_driver_count", _numa_remote_driver_count.get());
+        }
     }
 
     _blocked_driver_poller->start();
@@ -75,6 +92,11 @@ void GlobalDriverExecutor::_finalize_driver(DriverRawPtr driver, RuntimeState* r
 
 void GlobalDriverExecutor::_worker_thread() {
     const int worker_id = _next_id++;
+    const int num_numa_nodes = CpuInfo::num_execution_numa_nodes();
+    const int numa_node = worker_id % num_numa_nodes;
+    if (num_numa_nodes > 1) {
+        CpuInfo::bind_current_thread_to_numa_node(numa_node);
+    }
     while (true) {
         if (_num_threads_setter.should_shrink()) {
             break;
@@ -84,7 +106,7 @@ void GlobalDriverExecutor::_worker_thread() {
         CurrentThread::current().set_fragment_instance_id({});
         CurrentThread::current().set_pipeline_driver_id(0);
 
-        auto maybe_driver = this->_driver_queue->take();
+        auto maybe_driver = this->_driver_queue->take(worker_id);
         if (maybe_driver.status().is_cancelled()) {
             return;
         }
@@ -121,6 +143,14 @@ void GlobalDriverExecutor::_worker_thread() {
                 _finalize_driver(driver, runtime_state, driver->driver_state());
                 continue;
             }
+            driver->set_last_worker_id(worker_id);
+            if (num_numa_nodes > 1 && driver->numa_node() >= 0) {
+                if (driver->numa_node() == numa_node) {
+                    _numa_local_driver_count->increment(1);
+                } else {
+                    _numa_remote_driver_count->increment(1);
+                }
+            }
             auto maybe_state = driver->process(runtime_state, worker_id);
             Status status = maybe_state.status();
             this->_driver_queue->update_statistics(driver);
@@ -54,6 +54,7 @@ public:
 
 private:
     using Base = FactoryMethod<DriverExecutor, GlobalDriverExecutor>;
+    static std::unique_ptr<DriverQueue> _create_driver_queue(bool enable_resource_group, int max_threads);
     void _worker_thread();
     void _finalize_driver(DriverRawPtr driver, RuntimeState* runtime_state, DriverState state);
     void _update_profile_by_level(FragmentContext* fragment_ctx, bool done);
@@ -74,6 +75,9 @@ private:
     // metrics
     std::unique_ptr<UIntGauge> _driver_queue_len;
     std::unique_ptr<UIntGauge> _driver_poller_block_queue_len;
+    // The number of times a driver with a preferred NUMA node is run by a thread on or off that node.
+    std::unique_ptr<IntCounter> _numa_local_driver_count;
+    std::unique_ptr<IntCounter> _numa_remote_driver_count;
 };
 
 } // namespace pipeline
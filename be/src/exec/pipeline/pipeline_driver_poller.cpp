@@ -3,6 +3,10 @@
 #include "pipeline_driver_poller.h"
 
 #include <chrono>
+
+#include "common/config.h"
+#include "util/time.h"
+
 namespace starrocks::pipeline {
 
 void PipelineDriverPoller::start() {
@@ -30,6 +34,7 @@ void PipelineDriverPoller::run_internal() {
     DriverList local_blocked_drivers;
     int spin_count = 0;
     std::vector<DriverRawPtr> ready_drivers;
+    int64_t next_full_check_ns = 0;
     while (!_is_shutdown.load(std::memory_order_acquire)) {
         {
             std::unique_lock<std::mutex> lock(this->_mutex);
@@ -49,10 +54,27 @@ void PipelineDriverPoller::run_internal() {
             }
         }
 
+        // The event-driven drivers are only checked when they are signalled, except in the periodic full check.
+        const int64_t event_seq = _event_seq.load();
+        const int64_t now_ns = MonotonicNanos();
+        const bool full_check = now_ns >= next_full_check_ns;
+        if (full_check) {
+            next_full_check_ns = now_ns + config::pipeline_poller_full_check_interval_ms * 1'000'000L;
+        }
+        // The number of blocked drivers which must be checked in every round.
+        size_t num_polled_drivers = 0;
+
         auto driver_it = local_blocked_drivers.begin();
         while (driver_it != local_blocked_drivers.end()) {
             auto* driver = *driver_it;
 
+            // Always consume the signal, otherwise the following signals won't wake up the poller.
+            const bool signalled = driver->observer()->consume_event();
+            if (!full_check && !signalled && driver->is_event_driven()) {
+                ++driver_it;
+                continue;
+            }
+
             if (driver->query_ctx()->is_query_expired()) {
                 // there are not any drivers belonging to a query context can make progress for an expiration period
                 // indicates that some fragments are missing because of failed exec_plan_fragment invocation. in
@@ -67,6 +89,7 @@ void PipelineDriverPoller::run_internal() {
                 driver->cancel_operators(driver->fragment_ctx()->runtime_state());
                 if (driver->is_still_pending_finish()) {
                     driver->set_driver_state(DriverState::PENDING_FINISH);
+                    ++num_polled_drivers;
                     ++driver_it;
                 } else {
                     driver->set_driver_state(DriverState::FINISH);
@@ -79,6 +102,7 @@ void PipelineDriverPoller::run_internal() {
                 driver->cancel_operators(driver->fragment_ctx()->runtime_state());
                 if (driver->is_still_pending_finish()) {
                     driver->set_driver_state(DriverState::PENDING_FINISH);
+                    ++num_polled_drivers;
                     ++driver_it;
                 } else {
                     driver->set_driver_state(DriverState::CANCELED);
@@ -87,6 +111,7 @@ void PipelineDriverPoller::run_internal() {
                 }
             } else if (driver->pending_finish()) {
                 if (driver->is_still_pending_finish()) {
+                    ++num_polled_drivers;
                     ++driver_it;
                 } else {
                     // driver->pending_finish() return true means that when a driver's sink operator is finished,
@@ -108,10 +133,20 @@ void PipelineDriverPoller::run_internal() {
                 remove_blocked_driver(local_blocked_drivers, driver_it);
                 ready_drivers.emplace_back(driver);
             } else {
+                if (!driver->is_event_driven()) {
+                    ++num_polled_drivers;
+                }
                 ++driver_it;
             }
         }
 
+        if (ready_drivers.empty() && num_polled_drivers == 0 && !local_blocked_drivers.empty()) {
+            // All the blocked drivers are waiting for signals, so needn't spin.
+            _wait_for_event(event_seq, next_full_check_ns);
+            spin_count = 0;
+            continue;
+        }
+
         if (ready_drivers.empty()) {
             spin_count += 1;
         } else {
@@ -136,7 +171,31 @@ void PipelineDriverPoller::run_internal() {
     }
 }
 
+void PipelineDriverPoller::_wait_for_event(int64_t event_seq, int64_t deadline_ns) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    // _is_waiting_for_event is set before checking _event_seq, and notify_event() increases _event_seq before
+    // checking _is_waiting_for_event, so at least one of them sees the other.
+    _is_waiting_for_event.store(true);
+    int64_t wait_ns = deadline_ns - MonotonicNanos();
+    if (wait_ns > 0) {
+        _cond.wait_for(lock, std::chrono::nanoseconds(wait_ns), [this, event_seq] {
+            return _is_shutdown.load(std::memory_order_acquire) || !_blocked_drivers.empty() ||
+                   _event_seq.load() != event_seq;
+        });
+    }
+    _is_waiting_for_event.store(false);
+}
+
+void PipelineDriverPoller::notify_event() {
+    _event_seq.fetch_add(1);
+    if (_is_waiting_for_event.load()) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _cond.notify_one();
+    }
+}
+
 void PipelineDriverPoller::add_blocked_driver(const DriverRawPtr driver) {
+    driver->observer()->set_poller(this);
     std::unique_lock<std::mutex> lock(_mutex);
     _blocked_drivers.push_back(driver);
     driver->_pending_timer_sw->reset();
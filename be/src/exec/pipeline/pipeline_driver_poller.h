@@ -34,6 +34,8 @@ public:
     void shutdown();
     // add blocked driver to poller
     void add_blocked_driver(const DriverRawPtr driver);
+    // Wake up the poller when an observer of a blocked driver is signalled.
+    void notify_event();
     // remove blocked driver from poller
     void remove_blocked_driver(DriverList& local_blocked_drivers, DriverList::iterator& driver_it);
     // only used for collect metrics
@@ -44,6 +46,9 @@ public:
 
 private:
     void run_internal();
+    // Wait until an observer is signalled, a new blocked driver comes or the deadline, when all the blocked drivers
+    // are event-driven. |event_seq| is the value of _event_seq before the last round of checking.
+    void _wait_for_event(int64_t event_seq, int64_t deadline_ns);
     PipelineDriverPoller(const PipelineDriverPoller&) = delete;
     PipelineDriverPoller& operator=(const PipelineDriverPoller&) = delete;
 
@@ -55,6 +60,10 @@ private:
     scoped_refptr<Thread> _polling_thread;
     std::atomic<bool> _is_polling_thread_initialized;
     std::atomic<bool> _is_shutdown;
+
+    // Increased every time an observer is signalled.
+    std::atomic<int64_t> _event_seq{0};
+    std::atomic<bool> _is_waiting_for_event{false};
 };
 } // namespace pipeline
 } // namespace starrocks
@@ -5,25 +5,24 @@
 #include "exec/pipeline/source_operator.h"
 #include "exec/workgroup/work_group.h"
 #include "gutil/strings/substitute.h"
+#include "util/cpu_info.h"
 
 namespace starrocks::pipeline {
 
 /// QuerySharedDriverQueue.
 QuerySharedDriverQueue::QuerySharedDriverQueue() {
+    init_level_queues(_queues);
+}
+
+void QuerySharedDriverQueue::init_level_queues(SubQuerySharedDriverQueue* queues) {
     double factor = 1;
     for (int i = QUEUE_SIZE - 1; i >= 0; --i) {
         // initialize factor for every sub queue,
         // Higher priority queues have more execution time,
         // so they have a larger factor.
-        _queues[i].factor_for_normal = factor;
+        queues[i].factor_for_normal = factor;
         factor *= RATIO_OF_ADJACENT_QUEUE;
     }
-
-    int64_t time_slice = 0;
-    for (int i = 0; i < QUEUE_SIZE; ++i) {
-        time_slice += LEVEL_TIME_SLICE_BASE_NS * (i + 1);
-        _level_time_slices[i] = time_slice;
-    }
 }
 
 void QuerySharedDriverQueue::close() {
@@ -33,7 +32,7 @@ void QuerySharedDriverQueue::close() {
 }
 
 void QuerySharedDriverQueue::put_back(const DriverRawPtr driver) {
-    int level = _compute_driver_level(driver);
+    int level = compute_driver_level(driver);
     driver->set_driver_queue_level(level);
     {
         std::lock_guard<std::mutex> lock(_global_mutex);
@@ -47,7 +46,7 @@ void QuerySharedDriverQueue::put_back(const DriverRawPtr driver) {
 void QuerySharedDriverQueue::put_back(const std::vector<DriverRawPtr>& drivers) {
     std::vector<int> levels(drivers.size());
     for (int i = 0; i < drivers.size(); i++) {
-        levels[i] = _compute_driver_level(drivers[i]);
+        levels[i] = compute_driver_level(drivers[i]);
         drivers[i]->set_driver_queue_level(levels[i]);
     }
     std::lock_guard<std::mutex> lock(_global_mutex);
@@ -64,10 +63,9 @@ void QuerySharedDriverQueue::put_back_from_executor(const DriverRawPtr driver) {
     put_back(driver);
 }
 
-StatusOr<DriverRawPtr> QuerySharedDriverQueue::take() {
+StatusOr<DriverRawPtr> QuerySharedDriverQueue::take(int worker_id) {
     // -1 means no candidates; else has candidate.
     int queue_idx = -1;
-    double target_accu_time = 0;
     DriverRawPtr driver_ptr;
 
     {
@@ -77,18 +75,7 @@ StatusOr<DriverRawPtr> QuerySharedDriverQueue::take() {
                 return Status::Cancelled("Shutdown");
             }
 
-            // Find the queue with the smallest execution time.
-            for (int i = 0; i < QUEUE_SIZE; ++i) {
-                // we just search for queue has element
-                if (!_queues[i].empty()) {
-                    double local_target_time = _queues[i].accu_time_after_divisor();
-                    if (queue_idx < 0 || local_target_time < target_accu_time) {
-                        target_accu_time = local_target_time;
-                        queue_idx = i;
-                    }
-                }
-            }
-
+            queue_idx = pick_level_queue(_queues);
             if (queue_idx >= 0) {
                 break;
             }
@@ -130,10 +117,12 @@ void QuerySharedDriverQueue::update_statistics(const DriverRawPtr driver) {
     _queues[driver->get_driver_queue_level()].update_accu_time(driver);
 }
 
-int QuerySharedDriverQueue::_compute_driver_level(const DriverRawPtr driver) const {
+int QuerySharedDriverQueue::compute_driver_level(const DriverRawPtr driver) {
     int time_spent = driver->driver_acct().get_accumulated_time_spent();
     for (int i = driver->get_driver_queue_level(); i < QUEUE_SIZE; ++i) {
-        if (time_spent < _level_time_slices[i]) {
+        // The time slice of the i-th level is the sum of (j+1)*LEVEL_TIME_SLICE_BASE_NS for j in [0, i].
+        int64_t level_time_slice = LEVEL_TIME_SLICE_BASE_NS * (i + 1) * (i + 2) / 2;
+        if (time_spent < level_time_slice) {
             return i;
         }
     }
@@ -141,6 +130,23 @@ int QuerySharedDriverQueue::_compute_driver_level(const DriverRawPtr driver) con
     return QUEUE_SIZE - 1;
 }
 
+int QuerySharedDriverQueue::pick_level_queue(SubQuerySharedDriverQueue* queues) {
+    int queue_idx = -1;
+    double target_accu_time = 0;
+    // Find the queue with the smallest execution time.
+    for (int i = 0; i < QUEUE_SIZE; ++i) {
+        // we just search for queue has element
+        if (!queues[i].empty()) {
+            double local_target_time = queues[i].accu_time_after_divisor();
+            if (queue_idx < 0 || local_target_time < target_accu_time) {
+                target_accu_time = local_target_time;
+                queue_idx = i;
+            }
+        }
+    }
+    return queue_idx;
+}
+
 void SubQuerySharedDriverQueue::put(const DriverRawPtr driver) {
     if (driver->driver_state() == DriverState::CANCELED) {
         queue.emplace_front(driver);
@@ -181,6 +187,166 @@ DriverRawPtr SubQuerySharedDriverQueue::take() {
     return nullptr;
 }
 
+/// WorkStealingDriverQueue.
+WorkStealingDriverQueue::WorkStealingDriverQueue(int num_workers)
+        : _num_local_queues(std::max(num_workers, 1)),
+          _local_queues(new LocalQueue[_num_local_queues]),
+          _num_numa_nodes(std::min(CpuInfo::num_execution_numa_nodes(), _num_local_queues)) {
+    for (int i = 0; i < _num_local_queues; ++i) {
+        QuerySharedDriverQueue::init_level_queues(_local_queues[i].queues);
+    }
+}
+
+void WorkStealingDriverQueue::close() {
+    std::lock_guard<std::mutex> lock(_idle_mutex);
+    _is_closed = true;
+    _cv.notify_all();
+}
+
+void WorkStealingDriverQueue::put_back(const DriverRawPtr driver) {
+    _put_back(driver);
+    _notify_idle_workers(1);
+}
+
+void WorkStealingDriverQueue::put_back(const std::vector<DriverRawPtr>& drivers) {
+    for (auto* driver : drivers) {
+        _put_back(driver);
+    }
+    _notify_idle_workers(drivers.size());
+}
+
+void WorkStealingDriverQueue::put_back_from_executor(const DriverRawPtr driver) {
+    // The driver is put back to the local queue of current worker, which is likely to take it again soon.
+    put_back(driver);
+}
+
+void WorkStealingDriverQueue::_put_back(const DriverRawPtr driver) {
+    int idx = driver->last_worker_id() >= 0
+                      ? _local_queue_index(driver->last_worker_id())
+                      : _next_local_queue.fetch_add(1, std::memory_order_relaxed) % (uint32_t)_num_local_queues;
+    // Keep the driver on its NUMA node, even if it has been stolen by a worker of another node.
+    if (_num_numa_nodes > 1 && driver->numa_node() >= 0) {
+        int numa_node = driver->numa_node() % _num_numa_nodes;
+        if (driver->last_worker_id() < 0 || _numa_node_of_local_queue(idx) != numa_node) {
+            idx = _next_local_queue_of_numa_node(numa_node);
+        }
+    }
+    int level = QuerySharedDriverQueue::compute_driver_level(driver);
+    driver->set_driver_queue_level(level);
+
+    auto& local_queue = _local_queues[idx];
+    std::lock_guard<std::mutex> lock(local_queue.mutex);
+    local_queue.queues[level].put(driver);
+    driver->set_driver_queue_index(idx);
+    driver->set_in_ready_queue(true);
+    local_queue.num_drivers++;
+    // Must be increased before checking the number of idle workers, see _notify_idle_workers().
+    _num_drivers++;
+}
+
+StatusOr<DriverRawPtr> WorkStealingDriverQueue::take(int worker_id) {
+    int idx = _local_queue_index(std::max(worker_id, 0));
+    while (true) {
+        if (_is_closed) {
+            return Status::Cancelled("Shutdown");
+        }
+
+        if (auto* driver = _take_local(_local_queues[idx]); driver != nullptr) {
+            return driver;
+        }
+        if (auto* driver = _steal(idx); driver != nullptr) {
+            _num_steals.fetch_add(1, std::memory_order_relaxed);
+            return driver;
+        }
+
+        std::unique_lock<std::mutex> lock(_idle_mutex);
+        // The idle worker is registered before checking _num_drivers, and the producer increases _num_drivers
+        // before checking _num_idle_workers, so at least one of them sees the other.
+        _num_idle_workers++;
+        _cv.wait(lock, [this] { return _is_closed || _num_drivers > 0; });
+        _num_idle_workers--;
+    }
+}
+
+DriverRawPtr WorkStealingDriverQueue::_take_local(LocalQueue& local_queue) {
+    if (local_queue.num_drivers == 0) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(local_queue.mutex);
+    int level = QuerySharedDriverQueue::pick_level_queue(local_queue.queues);
+    if (level < 0) {
+        return nullptr;
+    }
+    auto* driver = local_queue.queues[level].take();
+    driver->set_in_ready_queue(false);
+    local_queue.num_drivers--;
+    _num_drivers--;
+    return driver;
+}
+
+int WorkStealingDriverQueue::_next_local_queue_of_numa_node(int numa_node) {
+    int num_queues_of_node = (_num_local_queues - numa_node + _num_numa_nodes - 1) / _num_numa_nodes;
+    uint32_t seq = _next_local_queue.fetch_add(1, std::memory_order_relaxed);
+    return numa_node + _num_numa_nodes * (int)(seq % (uint32_t)num_queues_of_node);
+}
+
+DriverRawPtr WorkStealingDriverQueue::_steal(int local_queue_index) {
+    // Steal from the local queues of the same NUMA node first, and then from the other nodes.
+    for (int pass = _num_numa_nodes > 1 ? 0 : 1; pass < 2; ++pass) {
+        for (int i = 1; i < _num_local_queues; ++i) {
+            int victim_index = (local_queue_index + i) % _num_local_queues;
+            if (_num_numa_nodes > 1 && (_numa_node_of_local_queue(victim_index) ==
+                                        _numa_node_of_local_queue(local_queue_index)) != (pass == 0)) {
+                continue;
+            }
+            if (auto* driver = _take_local(_local_queues[victim_index]); driver != nullptr) {
+                return driver;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void WorkStealingDriverQueue::_notify_idle_workers(size_t num_drivers) {
+    // Avoid the global lock in the common case where all the workers are busy.
+    if (_num_idle_workers == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_idle_mutex);
+    if (num_drivers == 1) {
+        _cv.notify_one();
+    } else {
+        _cv.notify_all();
+    }
+}
+
+void WorkStealingDriverQueue::cancel(DriverRawPtr driver) {
+    if (_is_closed) {
+        return;
+    }
+    while (driver->is_in_ready_queue()) {
+        int idx = driver->get_driver_queue_index();
+        auto& local_queue = _local_queues[idx];
+        std::lock_guard<std::mutex> lock(local_queue.mutex);
+        if (!driver->is_in_ready_queue()) {
+            return;
+        }
+        // The driver has been moved to another local queue, retry.
+        if (driver->get_driver_queue_index() != idx) {
+            continue;
+        }
+        local_queue.queues[driver->get_driver_queue_level()].cancel(driver);
+        return;
+    }
+}
+
+void WorkStealingDriverQueue::update_statistics(const DriverRawPtr driver) {
+    // The execution time is accounted to the local queue of the worker which ran the driver.
+    int idx = _local_queue_index(std::max(driver->last_worker_id(), 0));
+    _local_queues[idx].queues[driver->get_driver_queue_level()].update_accu_time(driver);
+}
+
 /// WorkGroupDriverQueue.
 bool WorkGroupDriverQueue::WorkGroupDriverSchedEntityComparator::operator()(
         const WorkGroupDriverSchedEntityPtr& lhs, const WorkGroupDriverSchedEntityPtr& rhs) const {
@@ -210,7 +376,7 @@ void WorkGroupDriverQueue::put_back_from_executor(const DriverRawPtr driver) {
     _put_back<true>(driver);
 }
 
-StatusOr<DriverRawPtr> WorkGroupDriverQueue::take() {
+StatusOr<DriverRawPtr> WorkGroupDriverQueue::take(int worker_id) {
     std::unique_lock<std::mutex> lock(_global_mutex);
 
     workgroup::WorkGroupDriverSchedEntity* wg_entity = nullptr;
@@ -241,7 +407,7 @@ StatusOr<DriverRawPtr> WorkGroupDriverQueue::take() {
         _dequeue_workgroup(wg_entity);
     }
 
-    return wg_entity->queue()->take();
+    return wg_entity->queue()->take(worker_id);
 }
 
 void WorkGroupDriverQueue::cancel(DriverRawPtr driver) {
@@ -24,7 +24,8 @@ public:
     // *from_executor* means that the executor thread puts the driver back to the queue.
     virtual void put_back_from_executor(const DriverRawPtr driver) = 0;
 
-    virtual StatusOr<DriverRawPtr> take() = 0;
+    // |worker_id| is the id of the executor thread which takes the driver.
+    virtual StatusOr<DriverRawPtr> take(int worker_id) = 0;
     virtual void cancel(DriverRawPtr driver) = 0;
 
     // Update statistics of the driver's workgroup,
@@ -98,7 +99,7 @@ public:
     void update_statistics(const DriverRawPtr driver) override;
 
     // Return cancelled status, if the queue is closed.
-    StatusOr<DriverRawPtr> take() override;
+    StatusOr<DriverRawPtr> take(int worker_id) override;
 
     void cancel(DriverRawPtr driver) override;
 
@@ -109,10 +110,12 @@ public:
     static constexpr size_t QUEUE_SIZE = 8;
     static constexpr double RATIO_OF_ADJACENT_QUEUE = 1.2;
 
-private:
-    // When the driver at the i-th level costs _level_time_slices[i],
-    // it will move to (i+1)-th level.
-    int _compute_driver_level(const DriverRawPtr driver) const;
+    // Initialize the normalization factors of the sub queues of a level.
+    static void init_level_queues(SubQuerySharedDriverQueue* queues);
+    // When the driver at the i-th level costs level_time_slice(i), it will move to (i+1)-th level.
+    static int compute_driver_level(const DriverRawPtr driver);
+    // Return the index of the non-empty sub queue with the smallest normalized execution time, or -1 if all are empty.
+    static int pick_level_queue(SubQuerySharedDriverQueue* queues);
 
 private:
     // The time slice of the i-th level is (i+1)*LEVEL_TIME_SLICE_BASE ns,
@@ -121,8 +124,6 @@ private:
     static constexpr int64_t LEVEL_TIME_SLICE_BASE_NS = 200'000'000L;
 
     SubQuerySharedDriverQueue _queues[QUEUE_SIZE];
-    // The time slice of the i-th level is (i+1)*LEVEL_TIME_SLICE_BASE ns.
-    int64_t _level_time_slices[QUEUE_SIZE];
 
     size_t _num_drivers = 0;
 
@@ -131,6 +132,77 @@ private:
     bool _is_closed = false;
 };
 
+// WorkStealingDriverQueue keeps a local QuerySharedDriverQueue-like multi-level queue for each executor thread,
+// to avoid the contention on a single global lock and to keep a driver running on the same core.
+//
+// - A driver is put back to the local queue of the worker which ran it last time, and a new driver is
+//   distributed to the local queues in round-robin.
+// - A worker takes the driver from its own local queue first, by the same multi-level priority as
+//   QuerySharedDriverQueue. The execution time of each level is accumulated per local queue.
+// - If its local queue is empty, the worker steals a driver from the local queues of the other workers,
+//   and sleeps only when all the local queues are empty.
+class WorkStealingDriverQueue : public FactoryMethod<DriverQueue, WorkStealingDriverQueue> {
+    friend class FactoryMethod<DriverQueue, WorkStealingDriverQueue>;
+
+public:
+    explicit WorkStealingDriverQueue(int num_workers);
+    ~WorkStealingDriverQueue() override = default;
+    void close() override;
+    void put_back(const DriverRawPtr driver) override;
+    void put_back(const std::vector<DriverRawPtr>& drivers) override;
+    void put_back_from_executor(const DriverRawPtr driver) override;
+
+    void update_statistics(const DriverRawPtr driver) override;
+
+    // Return cancelled status, if the queue is closed.
+    StatusOr<DriverRawPtr> take(int worker_id) override;
+
+    void cancel(DriverRawPtr driver) override;
+
+    size_t size() const override { return _num_drivers.load(); }
+
+    bool should_yield(const DriverRawPtr driver, int64_t unaccounted_runtime_ns) const override { return false; }
+
+    int num_local_queues() const { return _num_local_queues; }
+    int64_t num_steals() const { return _num_steals.load(std::memory_order_relaxed); }
+
+private:
+    struct LocalQueue {
+        mutable std::mutex mutex;
+        SubQuerySharedDriverQueue queues[QuerySharedDriverQueue::QUEUE_SIZE];
+        // Read without lock to skip the empty queues when stealing.
+        std::atomic<size_t> num_drivers = 0;
+    };
+
+    int _local_queue_index(int worker_id) const { return worker_id % _num_local_queues; }
+    // The workers are bound to the NUMA nodes in turn, so is the local queue of each worker.
+    int _numa_node_of_local_queue(int local_queue_index) const { return local_queue_index % _num_numa_nodes; }
+    // Pick a local queue of |numa_node| in turn.
+    int _next_local_queue_of_numa_node(int numa_node);
+    // Put the driver to its preferred local queue, return without notifying the idle workers.
+    void _put_back(const DriverRawPtr driver);
+    DriverRawPtr _take_local(LocalQueue& local_queue);
+    DriverRawPtr _steal(int local_queue_index);
+    void _notify_idle_workers(size_t num_drivers);
+
+private:
+    const int _num_local_queues;
+    std::unique_ptr<LocalQueue[]> _local_queues;
+    // Larger than 1 only if the NUMA aware execution is enabled.
+    const int _num_numa_nodes;
+    // Unsigned, so that the round-robin index stays non-negative when the counter wraps around.
+    std::atomic<uint32_t> _next_local_queue = 0;
+
+    std::atomic<size_t> _num_drivers = 0;
+    std::atomic<int> _num_idle_workers = 0;
+    std::atomic<int64_t> _num_steals = 0;
+
+    // Only used to park the idle workers.
+    std::mutex _idle_mutex;
+    std::condition_variable _cv;
+    std::atomic<bool> _is_closed = false;
+};
+
 // WorkGroupDriverQueue contains two levels of queues.
 // The first level is the work group queue, and the second level is the driver queue in a work group.
 class WorkGroupDriverQueue : public FactoryMethod<DriverQueue, WorkGroupDriverQueue> {
@@ -151,7 +223,7 @@ public:
     // Return cancelled status, if the queue is closed.
     // Firstly, select the work group with the minimum vruntime.
     // Secondly, select the proper driver from the driver queue of this work group.
-    StatusOr<DriverRawPtr> take() override;
+    StatusOr<DriverRawPtr> take(int worker_id) override;
 
     void cancel(DriverRawPtr driver) override;
 
@@ -0,0 +1,36 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#include "exec/pipeline/pipeline_observer.h"
+
+#include "exec/pipeline/pipeline_driver_poller.h"
+
+namespace starrocks::pipeline {
+
+void PipelineObserver::notify() {
+    // Only the first signal since the last check needs to wake up the poller.
+    if (_has_event.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    if (auto* poller = _poller.load(std::memory_order_acquire); poller != nullptr) {
+        poller->notify_event();
+    }
+}
+
+void Observable::add_observer(PipelineObserver* observer) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _observers.emplace_back(observer);
+}
+
+void Observable::remove_observers() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _observers.clear();
+}
+
+void Observable::notify_observers() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto* observer : _observers) {
+        observer->notify();
+    }
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,55 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace starrocks::pipeline {
+
+class PipelineDriverPoller;
+
+// PipelineObserver is owned by a PipelineDriver, and is signalled by the components the driver may be blocked on,
+// when their states change. PipelineDriverPoller only re-checks the blocked drivers which are signalled,
+// instead of checking all of them in every round.
+class PipelineObserver {
+public:
+    PipelineObserver() = default;
+    PipelineObserver(const PipelineObserver&) = delete;
+    PipelineObserver& operator=(const PipelineObserver&) = delete;
+
+    // Set by the poller when the driver is added to it.
+    void set_poller(PipelineDriverPoller* poller) { _poller.store(poller, std::memory_order_release); }
+
+    // Signal that the state the driver is blocked on may have changed, and wake up the poller.
+    void notify();
+
+    // Return whether the observer is signalled since the last call, and clear the signal.
+    bool consume_event() { return _has_event.exchange(false, std::memory_order_acq_rel); }
+
+private:
+    // True at first, so the driver is always checked once after blocked.
+    std::atomic<bool> _has_event{true};
+    std::atomic<PipelineDriverPoller*> _poller{nullptr};
+};
+
+// Observable is held by the components which drivers may be blocked on, such as exchange receivers, sink buffers,
+// local exchangers and scan chunk buffers, to signal the observers of the blocked drivers.
+class Observable {
+public:
+    Observable() = default;
+    Observable(const Observable&) = delete;
+    Observable& operator=(const Observable&) = delete;
+
+    void add_observer(PipelineObserver* observer);
+    // Observers are not signalled anymore after removed.
+    void remove_observers();
+    void notify_observers() const;
+
+private:
+    mutable std::mutex _mutex;
+    std::vector<PipelineObserver*> _observers;
+};
+
+} // namespace starrocks::pipeline
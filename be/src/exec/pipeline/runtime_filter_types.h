@@ -35,8 +35,12 @@ using OptRuntimeBloomFilterBuildParams = std::vector<std::optional<RuntimeBloomF
 // Parameters used to build runtime bloom-filters.
 struct RuntimeBloomFilterBuildParam {
     RuntimeBloomFilterBuildParam(bool eq_null, const ColumnPtr& column) : eq_null(eq_null), column(column) {}
+    // The build side has spilled, and |filter| is already built from all of its rows instead of a key column.
+    RuntimeBloomFilterBuildParam(bool eq_null, vectorized::JoinRuntimeFilter* filter)
+            : eq_null(eq_null), filter(filter) {}
     bool eq_null;
     ColumnPtr column;
+    vectorized::JoinRuntimeFilter* filter = nullptr;
 };
 
 // RuntimeFilterCollector contains runtime in-filters and bloom-filters, it is stored in RuntimeFilerHub
@@ -304,7 +308,8 @@ public:
         for (auto count : _ht_row_counts) {
             row_count += count;
         }
-        for (auto& desc : _bloom_filter_descriptors) {
+        for (size_t i = 0; i < _bloom_filter_descriptors.size(); ++i) {
+            auto& desc = _bloom_filter_descriptors[i];
             desc->set_is_pipeline(true);
             // skip if it does not have consumer.
             if (!desc->has_consumer()) continue;
@@ -314,7 +319,12 @@ public:
             vectorized::JoinRuntimeFilter* filter =
                     vectorized::RuntimeFilterHelper::create_runtime_bloom_filter(_pool, build_type);
             if (filter == nullptr) continue;
-            filter->init(row_count);
+            // the filter partitioned by bucket is initialized by the rows of each bucket when it's filled.
+            if (desc->num_buckets() == 0) {
+                // the filters prebuilt by the spilled build sides are merged into this one, so it has their size.
+                const auto* prebuilt_filter = _prebuilt_bloom_filter(i);
+                filter->init(prebuilt_filter != nullptr ? prebuilt_filter->size() : row_count);
+            }
             filter->set_join_mode(desc->join_mode());
             desc->set_runtime_filter(filter);
         }
@@ -354,10 +364,55 @@ public:
                 desc->set_runtime_filter(nullptr);
                 continue;
             }
+            if (desc->num_buckets() > 0) {
+                std::vector<vectorized::ColumnPtr> columns;
+                std::vector<vectorized::JoinRuntimeFilter*> prebuilt_filters;
+                bool eq_null = false;
+                for (auto& opt_params : _partial_bloom_filter_build_params) {
+                    auto& param = opt_params[i].value();
+                    if (param.filter != nullptr) {
+                        prebuilt_filters.emplace_back(param.filter);
+                        continue;
+                    }
+                    if (param.column == nullptr || param.column->empty()) {
+                        continue;
+                    }
+                    columns.emplace_back(param.column);
+                    eq_null = param.eq_null;
+                }
+                Status status;
+                if (prebuilt_filters.empty()) {
+                    status = vectorized::RuntimeFilterHelper::fill_runtime_bloom_filter_by_bucket(
+                            columns, desc->build_expr_type(), desc->runtime_filter(),
+                            vectorized::kHashJoinKeyColumnOffset, eq_null, desc->num_buckets());
+                } else {
+                    // every bucket of the prebuilt filters is initialized with the same size, so they are merged
+                    // first, and then the rows of the other build sides are inserted into the merged buckets.
+                    for (auto* prebuilt_filter : prebuilt_filters) {
+                        desc->runtime_filter()->concat(prebuilt_filter);
+                    }
+                    for (auto& column : columns) {
+                        status = vectorized::RuntimeFilterHelper::insert_into_runtime_bloom_filter(
+                                column, desc->build_expr_type(), desc->runtime_filter(),
+                                vectorized::kHashJoinKeyColumnOffset, eq_null, desc->num_buckets());
+                        if (!status.ok()) {
+                            break;
+                        }
+                    }
+                }
+                if (!status.ok()) {
+                    desc->set_runtime_filter(nullptr);
+                }
+                continue;
+            }
             for (auto& opt_params : _partial_bloom_filter_build_params) {
                 auto& opt_param = opt_params[i];
                 DCHECK(opt_param.has_value());
                 auto& param = opt_param.value();
+                if (param.filter != nullptr) {
+                    desc->runtime_filter()->merge(param.filter);
+                    continue;
+                }
                 if (param.column == nullptr || param.column->empty()) {
                     continue;
                 }
@@ -374,6 +429,16 @@ public:
     }
 
 private:
+    // Any filter of the i-th descriptor prebuilt by a spilled build side, all of which have the same size.
+    const vectorized::JoinRuntimeFilter* _prebuilt_bloom_filter(size_t i) const {
+        for (const auto& opt_params : _partial_bloom_filter_build_params) {
+            if (i < opt_params.size() && opt_params[i].has_value() && opt_params[i]->filter != nullptr) {
+                return opt_params[i]->filter;
+            }
+        }
+        return nullptr;
+    }
+
     ObjectPool* _pool;
     const size_t _limit;
     std::atomic<size_t> _num_active_builders;
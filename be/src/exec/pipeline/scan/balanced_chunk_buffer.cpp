@@ -53,9 +53,14 @@ void BalancedChunkBuffer::close() {
 bool BalancedChunkBuffer::try_get(int buffer_index, vectorized::ChunkPtr* output_chunk) {
     // Will release the token after exiting this scope.
     ChunkWithToken chunk_with_token = std::make_pair(nullptr, nullptr);
+    bool was_full = _limiter->is_full();
     bool ok = _get_sub_buffer(buffer_index)->try_get(&chunk_with_token);
     if (ok) {
         *output_chunk = std::move(chunk_with_token.first);
+        if (was_full) {
+            chunk_with_token.second.reset();
+            _observable.notify_observers();
+        }
     }
     return ok;
 }
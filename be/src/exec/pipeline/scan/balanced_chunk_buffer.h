@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "column/chunk.h"
+#include "exec/pipeline/pipeline_observer.h"
 #include "exec/pipeline/scan/chunk_buffer_limiter.h"
 #include "util/blocking_queue.hpp"
 
@@ -33,6 +34,10 @@ public:
 
     ChunkBufferLimiter* limiter() { return _limiter.get(); }
 
+    // Observers are signalled when the limiter becomes not full, since the scan operators cannot submit io tasks
+    // when it's full.
+    void attach_observer(PipelineObserver* observer) { _observable.add_observer(observer); }
+
 private:
     using ChunkWithToken = std::pair<vectorized::ChunkPtr, ChunkBufferTokenPtr>;
     using QueueT = UnboundedBlockingQueue<ChunkWithToken>;
@@ -47,6 +52,7 @@ private:
     std::atomic_int64_t _output_index = 0;
 
     ChunkBufferLimiterPtr _limiter;
+    Observable _observable;
 };
 
 } // namespace starrocks::pipeline
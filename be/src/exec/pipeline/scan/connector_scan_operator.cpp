@@ -69,6 +69,13 @@ void ConnectorScanOperator::detach_chunk_source(int32_t source_index) {
     active_inputs.erase(key);
 }
 
+bool ConnectorScanOperator::attach_observer(PipelineObserver* observer) {
+    auto* factory = down_cast<ConnectorScanOperatorFactory*>(_factory);
+    _observable.add_observer(observer);
+    factory->get_chunk_buffer().attach_observer(observer);
+    return true;
+}
+
 bool ConnectorScanOperator::has_shared_chunk_source() const {
     auto* factory = down_cast<ConnectorScanOperatorFactory*>(_factory);
     auto& active_inputs = factory->get_active_inputs();
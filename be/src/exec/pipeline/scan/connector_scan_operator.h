@@ -49,6 +49,8 @@ public:
     ChunkSourcePtr create_chunk_source(MorselPtr morsel, int32_t chunk_source_index) override;
     connector::ConnectorType connector_type();
 
+    bool attach_observer(PipelineObserver* observer) override;
+
     // TODO: refactor it into the base class
     void attach_chunk_source(int32_t source_index) override;
     void detach_chunk_source(int32_t source_index) override;
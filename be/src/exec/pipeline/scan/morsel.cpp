@@ -2,6 +2,9 @@
 
 #include "exec/pipeline/scan/morsel.h"
 
+#include <algorithm>
+
+#include "common/config.h"
 #include "exec/olap_utils.h"
 #include "storage/chunk_helper.h"
 #include "storage/range.h"
@@ -114,7 +117,7 @@ StatusOr<MorselPtr> PhysicalSplitMorselQueue::try_get() {
     std::lock_guard<std::mutex> lock(_mutex);
 
     if (_tablet_idx >= _tablets.size()) {
-        return nullptr;
+        return _split_in_flight_morsel();
     }
 
     // When it hasn't initialized any segment,
@@ -124,7 +127,7 @@ StatusOr<MorselPtr> PhysicalSplitMorselQueue::try_get() {
     while (!_has_init_any_segment || _cur_segment() == nullptr || _cur_segment()->num_rows() == 0 ||
            !_segment_range_iter.has_more()) {
         if (!_next_segment()) {
-            return nullptr;
+            return _split_in_flight_morsel();
         }
 
         if (auto status = _init_segment(); !status.ok()) {
@@ -143,14 +146,83 @@ StatusOr<MorselPtr> PhysicalSplitMorselQueue::try_get() {
         _num_segment_rest_rows = 0;
     }
 
-    auto* scan_morsel = _cur_scan_morsel();
-    auto* rowset = _cur_rowset();
-    auto rowid_range = std::make_shared<vectorized::RowidRangeOption>(
-            rowset->rowset_id(), rowset->segments()[_segment_idx]->id(), std::move(taken_range));
-    MorselPtr morsel = std::make_unique<PhysicalSplitScanMorsel>(
-            scan_morsel->get_plan_node_id(), *(scan_morsel->get_scan_range()), std::move(rowid_range));
+    auto* segment = _cur_segment();
+    return _create_morsel(_cur_scan_morsel(), _cur_rowset()->rowset_id(), segment->id(), std::move(taken_range),
+                          segment->num_rows_per_block());
+}
+
+MorselPtr PhysicalSplitMorselQueue::_create_morsel(ScanMorsel* scan_morsel, const RowsetId& rowset_id,
+                                                   uint64_t segment_id, vectorized::SparseRange rowid_range,
+                                                   uint32_t num_rows_per_block) {
+    vectorized::SplittableRowidRangePtr splittable_range = nullptr;
+    if (config::enable_tablet_internal_parallel_dynamic_split && !rowid_range.empty()) {
+        splittable_range = std::make_shared<vectorized::SplittableRowidRange>(rowid_range.begin(), rowid_range.end());
+        _in_flight_morsels.push_back(
+                {scan_morsel, rowset_id, segment_id, rowid_range, num_rows_per_block, splittable_range});
+    }
+    auto rowid_range_option = std::make_shared<vectorized::RowidRangeOption>(rowset_id, segment_id, rowid_range,
+                                                                             std::move(splittable_range));
+    return std::make_unique<PhysicalSplitScanMorsel>(scan_morsel->get_plan_node_id(), *(scan_morsel->get_scan_range()),
+                                                     std::move(rowid_range_option));
+}
+
+MorselPtr PhysicalSplitMorselQueue::_split_in_flight_morsel() {
+    const size_t min_rows = config::tablet_internal_parallel_min_splitted_scan_rows;
+
+    // Forget the morsels whose readers are closed.
+    _in_flight_morsels.erase(std::remove_if(_in_flight_morsels.begin(), _in_flight_morsels.end(),
+                                            [](const auto& morsel) { return morsel.splittable_range.expired(); }),
+                             _in_flight_morsels.end());
+
+    int victim_idx = -1;
+    vectorized::SplittableRowidRangePtr victim_range = nullptr;
+    size_t max_unclaimed_rows = 0;
+    for (int i = 0; i < _in_flight_morsels.size(); ++i) {
+        const auto& morsel = _in_flight_morsels[i];
+        auto range = morsel.splittable_range.lock();
+        if (range == nullptr) {
+            continue;
+        }
+        size_t num_unclaimed_rows = range->num_unclaimed_rows();
+        if (num_unclaimed_rows > max_unclaimed_rows && range->can_split(min_rows, morsel.num_rows_per_block)) {
+            victim_idx = i;
+            victim_range = std::move(range);
+            max_unclaimed_rows = num_unclaimed_rows;
+        }
+    }
+    if (victim_idx < 0) {
+        return nullptr;
+    }
 
-    return morsel;
+    // Copy it, since _create_morsel() appends to _in_flight_morsels.
+    InFlightMorsel victim = _in_flight_morsels[victim_idx];
+    vectorized::Range taken_range = victim_range->split(min_rows, victim.num_rows_per_block);
+    // The reader has claimed the rows in the meantime.
+    if (taken_range.empty()) {
+        return nullptr;
+    }
+    return _create_morsel(victim.scan_morsel, victim.rowset_id, victim.segment_id,
+                          victim.rowid_range.intersection(vectorized::SparseRange(taken_range)),
+                          victim.num_rows_per_block);
+}
+
+bool PhysicalSplitMorselQueue::_has_splittable_morsel() const {
+    if (_no_splittable_morsel) {
+        return false;
+    }
+
+    const size_t min_rows = config::tablet_internal_parallel_min_splitted_scan_rows;
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const auto& morsel : _in_flight_morsels) {
+        auto range = morsel.splittable_range.lock();
+        if (range != nullptr && range->can_split(min_rows, morsel.num_rows_per_block)) {
+            return true;
+        }
+    }
+    if (_tablet_idx >= _tablets.size()) {
+        _no_splittable_morsel = true;
+    }
+    return false;
 }
 
 rowid_t PhysicalSplitMorselQueue::_lower_bound_ordinal(Segment* segment, const vectorized::SeekTuple& key,
@@ -28,6 +28,7 @@ class TabletReaderParams;
 class SeekTuple;
 struct RowidRangeOption;
 using RowidRangeOptionPtr = std::shared_ptr<RowidRangeOption>;
+class SplittableRowidRange;
 struct ShortKeyRangeOption;
 using ShortKeyRangeOptionPtr = std::shared_ptr<ShortKeyRangeOption>;
 struct ShortKeyOption;
@@ -210,12 +211,32 @@ public:
 
     size_t num_original_morsels() const override { return _morsels.size(); }
     size_t max_degree_of_parallelism() const override { return _degree_of_parallelism; }
-    bool empty() const override { return _tablet_idx >= _tablets.size(); }
+    bool empty() const override { return _tablet_idx >= _tablets.size() && !_has_splittable_morsel(); }
     StatusOr<MorselPtr> try_get() override;
 
     std::string name() const override { return "physical_split_morsel_queue"; }
 
 private:
+    // A morsel handed out, the second half of whose unread rows can be taken over by an idle driver
+    // after all the segments are handed out, so that a large segment doesn't bound the scan latency.
+    struct InFlightMorsel {
+        ScanMorsel* scan_morsel;
+        RowsetId rowset_id;
+        uint64_t segment_id;
+        vectorized::SparseRange rowid_range;
+        // The unit of the split points, which is the number of rows per short key index entry.
+        uint32_t num_rows_per_block;
+        // Owned by the morsel and the reader of it, expired when the reader is closed.
+        std::weak_ptr<vectorized::SplittableRowidRange> splittable_range;
+    };
+
+    MorselPtr _create_morsel(ScanMorsel* scan_morsel, const RowsetId& rowset_id, uint64_t segment_id,
+                             vectorized::SparseRange rowid_range, uint32_t num_rows_per_block);
+    // Split the in-flight morsel with the most unread rows, return nullptr if no morsel can be split.
+    // REQUIRES: _mutex is held.
+    MorselPtr _split_in_flight_morsel();
+    bool _has_splittable_morsel() const;
+
     rowid_t _lower_bound_ordinal(Segment* segment, const vectorized::SeekTuple& key, bool lower) const;
     rowid_t _upper_bound_ordinal(Segment* segment, const vectorized::SeekTuple& key, bool lower, rowid_t end) const;
 
@@ -231,7 +252,7 @@ private:
     Status _init_segment();
 
 private:
-    std::mutex _mutex;
+    mutable std::mutex _mutex;
 
     const Morsels _morsels;
     // The number of the morsels before split them to pieces.
@@ -262,6 +283,11 @@ private:
     // The number of unprocessed rows of the current segment.
     size_t _num_segment_rest_rows = 0;
 
+    std::vector<InFlightMorsel> _in_flight_morsels;
+    // Set once all the segments are handed out and no in-flight morsel can be split, it never changes back
+    // since the unread rows of a morsel never grow.
+    mutable std::atomic<bool> _no_splittable_morsel = false;
+
     MemPool _mempool;
 };
 
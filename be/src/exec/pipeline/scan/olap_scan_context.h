@@ -36,7 +36,10 @@ public:
     Status prepare(RuntimeState* state);
     void close(RuntimeState* state) override;
 
-    void set_prepare_finished() { _is_prepare_finished.store(true, std::memory_order_release); }
+    void set_prepare_finished() {
+        _is_prepare_finished.store(true, std::memory_order_release);
+        _observable.notify_observers();
+    }
     bool is_prepare_finished() const { return _is_prepare_finished.load(std::memory_order_acquire); }
 
     Status parse_conjuncts(RuntimeState* state, const std::vector<ExprContext*>& runtime_in_filters,
@@ -48,6 +51,9 @@ public:
     const std::vector<std::unique_ptr<OlapScanRange>>& key_ranges() const { return _key_ranges; }
     BalancedChunkBuffer& get_chunk_buffer() { return _chunk_buffer; }
 
+    // Observers are signalled when the context is prepared.
+    void attach_observer(PipelineObserver* observer) { _observable.add_observer(observer); }
+
     // Shared scan states
     bool is_shared_scan() const { return _shared_scan; }
     // Attach and detach to account the active input for shared chunk buffer
@@ -78,6 +84,7 @@ private:
     int32_t _scan_dop;                  // DOP of scan operator
 
     std::atomic<bool> _is_prepare_finished{false};
+    Observable _observable;
 };
 
 // OlapScanContextFactory creates different contexts for each scan operator, if _shared_scan is false.
@@ -72,6 +72,17 @@ bool OlapScanOperator::is_finished() const {
     return ScanOperator::is_finished();
 }
 
+bool OlapScanOperator::attach_observer(PipelineObserver* observer) {
+    // The chunks of shared scan may be produced by the io tasks of the other scan operators.
+    if (_ctx->is_shared_scan()) {
+        return false;
+    }
+    _observable.add_observer(observer);
+    _ctx->attach_observer(observer);
+    _ctx->get_chunk_buffer().attach_observer(observer);
+    return true;
+}
+
 Status OlapScanOperator::do_prepare(RuntimeState*) {
     bool shared_scan = _ctx->is_shared_scan();
     _unique_metrics->add_info_string("SharedScan", shared_scan ? "True" : "False");
@@ -42,6 +42,8 @@ public:
     bool has_output() const override;
     bool is_finished() const override;
 
+    bool attach_observer(PipelineObserver* observer) override;
+
     Status do_prepare(RuntimeState* state) override;
     void do_close(RuntimeState* state) override;
     ChunkSourcePtr create_chunk_source(MorselPtr morsel, int32_t chunk_source_index) override;
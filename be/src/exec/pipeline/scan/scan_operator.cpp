@@ -279,6 +279,7 @@ void ScanOperator::_finish_chunk_source_task(RuntimeState* state, int chunk_sour
 
         _is_io_task_running[chunk_source_index] = false;
     }
+    _observable.notify_observers();
 }
 
 Status ScanOperator::_trigger_next_scan(RuntimeState* state, int chunk_source_index) {
@@ -111,6 +111,9 @@ protected:
 
     bool _is_finished = false;
 
+    // Signalled when an io task finishes.
+    Observable _observable;
+
 private:
     int32_t _io_task_retry_cnt = 0;
     workgroup::ScanExecutor* _scan_executor = nullptr;
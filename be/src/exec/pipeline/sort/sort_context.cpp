@@ -14,15 +14,20 @@ using vectorized::SortedRun;
 using vectorized::SortedRuns;
 
 void SortContext::close(RuntimeState* state) {
+    // The cursors of merger reference the data of partition sorters.
+    _spilled_runs_merger.reset();
     _chunks_sorter_partions.clear();
     _merged_runs.clear();
 }
 
 StatusOr<ChunkPtr> SortContext::pull_chunk() {
     if (!_is_merge_finish) {
-        _merge_inputs();
+        RETURN_IF_ERROR(_merge_inputs());
         _is_merge_finish = true;
     }
+    if (_merged_runs.num_chunks() == 0 && _spilled_runs_merger != nullptr) {
+        RETURN_IF_ERROR(_fetch_spilled_runs());
+    }
     if (_merged_runs.num_chunks() == 0) {
         return nullptr;
     }
@@ -58,6 +63,22 @@ Status SortContext::_merge_inputs() {
         require_rows = ((_limit < 0) ? total_rows : std::min(_limit + _offset, total_rows));
     }
 
+    bool has_spilled = std::any_of(_chunks_sorter_partions.begin(), _chunks_sorter_partions.end(),
+                                   [](const auto& sorter) { return sorter->has_spilled(); });
+    if (has_spilled) {
+        // Full sort without limit, merge the spilled runs of all partitions in a streaming way.
+        std::vector<std::unique_ptr<vectorized::SimpleChunkSortCursor>> cursors;
+        for (auto& partition_sorter : _chunks_sorter_partions) {
+            partition_sorter->create_sorted_cursors(&cursors, &_spill_read_status);
+        }
+        _spilled_runs_merger = std::make_unique<vectorized::MergeCursorsCascade>();
+        RETURN_IF_ERROR(_spilled_runs_merger->init(_sort_desc, std::move(cursors)));
+        if (!_spilled_runs_merger->is_data_ready()) {
+            return Status::InternalError("spilled sorted runs are not ready");
+        }
+        return Status::OK();
+    }
+
     std::vector<SortedRuns> partial_sorted_runs;
     for (int i = 0; i < _num_partition_sinkers; ++i) {
         auto& partition_sorter = _chunks_sorter_partions[i];
@@ -67,6 +88,21 @@ Status SortContext::_merge_inputs() {
     return merge_sorted_chunks(_sort_desc, &_sort_exprs, partial_sorted_runs, &_merged_runs, require_rows);
 }
 
+Status SortContext::_fetch_spilled_runs() {
+    while (!_spilled_runs_merger->is_eos()) {
+        vectorized::ChunkUniquePtr chunk = _spilled_runs_merger->try_get_next();
+        RETURN_IF_ERROR(_spill_read_status);
+        if (chunk != nullptr && !chunk->is_empty()) {
+            // The order-by columns are useless for output, so they are not evaluated.
+            _merged_runs.chunks.emplace_back(ChunkPtr(chunk.release()), Columns());
+            return Status::OK();
+        }
+    }
+    RETURN_IF_ERROR(_spill_read_status);
+    _spilled_runs_merger.reset();
+    return Status::OK();
+}
+
 SortContextFactory::SortContextFactory(RuntimeState* state, const TTopNType::type topn_type, bool is_merging,
                                        int64_t offset, int64_t limit, int32_t num_right_sinkers,
                                        const std::vector<ExprContext*>& sort_exprs,
@@ -53,13 +53,16 @@ public:
     }
 
     bool is_output_finished() const {
-        return is_partition_sort_finished() && _is_merge_finish && _merged_runs.num_chunks() == 0;
+        return is_partition_sort_finished() && _is_merge_finish && _merged_runs.num_chunks() == 0 &&
+               _spilled_runs_merger == nullptr;
     }
 
     StatusOr<ChunkPtr> pull_chunk();
 
 private:
     Status _merge_inputs();
+    // Fetch the next merged chunk from _spilled_runs_merger into _merged_runs.
+    Status _fetch_spilled_runs();
 
     RuntimeState* _state;
     const TTopNType::type _topn_type;
@@ -76,6 +79,11 @@ private:
     bool _is_merge_finish = false;
 
     SortedRuns _merged_runs;
+
+    // If any partition has spilled, the sorted runs of all partitions are merged in a streaming way
+    // instead of being merged into _merged_runs at once.
+    std::unique_ptr<vectorized::MergeCursorsCascade> _spilled_runs_merger;
+    Status _spill_read_status;
 };
 
 class SortContextFactory {
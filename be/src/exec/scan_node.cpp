@@ -21,6 +21,7 @@
 
 #include "exec/scan_node.h"
 
+#include "common/config.h"
 #include "exec/pipeline/scan/morsel.h"
 
 namespace starrocks {
@@ -81,6 +82,19 @@ StatusOr<pipeline::MorselQueueFactoryPtr> ScanNode::convert_scan_range_to_morsel
                                                     global_scan_ranges, node_id, pipeline_dop,
                                                     enable_tablet_internal_parallel, global_scan_ranges.size()));
         int scan_dop = std::min<int>(std::max<int>(1, morsel_queue->max_degree_of_parallelism()), pipeline_dop);
+        if (config::enable_pipeline_adaptive_dop && scan_dop > 1) {
+            ASSIGN_OR_RETURN(int64_t num_rows, estimated_scan_rows(global_scan_ranges));
+            if (_limit >= 0 && _conjunct_ctxs.empty()) {
+                num_rows = num_rows < 0 ? _limit : std::min(num_rows, _limit);
+            }
+            // A scan driver is created for every pipeline_adaptive_dop_rows_per_driver rows, so that the small
+            // lookups don't pay for the drivers which have nothing to read.
+            if (num_rows >= 0) {
+                int64_t rows_per_driver = std::max<int64_t>(1, config::pipeline_adaptive_dop_rows_per_driver);
+                int64_t dop_by_rows = std::max<int64_t>(1, (num_rows + rows_per_driver - 1) / rows_per_driver);
+                scan_dop = std::min<int64_t>(scan_dop, dop_by_rows);
+            }
+        }
         int io_parallelism = scan_dop * io_tasks_per_scan_operator();
 
         // If not so much morsels, try to assign morsel uniformly among operators to avoid data skew
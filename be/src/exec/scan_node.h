@@ -75,6 +75,12 @@ public:
             const std::vector<TScanRangeParams>& scan_ranges, int node_id, int32_t pipeline_dop,
             bool enable_tablet_internal_parallel, size_t num_total_scan_ranges);
 
+    // Estimate the number of rows to read from |scan_ranges|, return -1 if it's unknown.
+    // It is used to decide the degree of parallelism of the scan pipeline.
+    virtual StatusOr<int64_t> estimated_scan_rows(const std::vector<TScanRangeParams>& scan_ranges) const {
+        return -1;
+    }
+
     // If this scan node accept empty scan ranges.
     virtual bool accept_empty_scan_ranges() const { return true; }
 
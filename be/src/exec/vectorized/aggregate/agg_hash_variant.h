@@ -374,6 +374,18 @@ struct AggHashMapVariant {
         }
     }
 
+    // Release the hash map of current type, `init` must be called before using it again
+    void reset() {
+        switch (type) {
+#define M(NAME)       \
+    case Type::NAME:  \
+        NAME.reset(); \
+        break;
+            APPLY_FOR_AGG_VARIANT_ALL(M)
+#undef M
+        }
+    }
+
     size_t capacity() const {
         switch (type) {
 #define M(NAME)      \
@@ -385,6 +397,18 @@ struct AggHashMapVariant {
         return 0;
     }
 
+    // Pre-size the hash table so that |num_keys| keys can be inserted without rehashing.
+    void reserve(size_t num_keys) {
+        switch (type) {
+#define M(NAME)                           \
+    case Type::NAME:                      \
+        NAME->hash_map.reserve(num_keys); \
+        break;
+            APPLY_FOR_AGG_VARIANT_ALL(M)
+#undef M
+        }
+    }
+
     size_t size() const {
         switch (type) {
 #define M(NAME)      \
@@ -674,6 +698,18 @@ struct AggHashSetVariant {
         return 0;
     }
 
+    // Pre-size the hash table so that |num_keys| keys can be inserted without rehashing.
+    void reserve(size_t num_keys) {
+        switch (type) {
+#define M(NAME)                           \
+    case Type::NAME:                      \
+        NAME->hash_set.reserve(num_keys); \
+        break;
+            APPLY_FOR_AGG_VARIANT_ALL(M)
+#undef M
+        }
+    }
+
     size_t size() const {
         switch (type) {
 #define M(NAME)      \
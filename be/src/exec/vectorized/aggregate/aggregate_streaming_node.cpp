@@ -94,6 +94,12 @@ Status AggregateStreamingNode::get_next(RuntimeState* state, ChunkPtr* chunk, bo
                 COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
 
                 continue;
+            } else if (!_aggregator->should_preaggregate()) {
+                // The aggregation reduces nothing recently, pass through the chunk without probing the hash table.
+                SCOPED_TIMER(_aggregator->streaming_timer());
+                _aggregator->output_chunk_by_streaming(chunk);
+                _aggregator->update_preagg_controller(input_chunk_size, input_chunk_size);
+                break;
             } else {
                 // TODO: calc the real capacity of hashtable, will add one interface in the class of habletable
                 size_t real_capacity =
@@ -116,6 +122,7 @@ Status AggregateStreamingNode::get_next(RuntimeState* state, ChunkPtr* chunk, bo
                     RETURN_IF_ERROR(state->check_mem_limit("AggrNode"));
                     // hash table is not full or allow expand the hash table according reduction rate
                     SCOPED_TIMER(_aggregator->agg_compute_timer());
+                    size_t ht_size = _aggregator->hash_map_variant().size();
                     if (false) {
                     }
 #define HASH_MAP_METHOD(NAME)                                                                                          \
@@ -138,6 +145,8 @@ Status AggregateStreamingNode::get_next(RuntimeState* state, ChunkPtr* chunk, bo
                     _mem_tracker->set(_aggregator->hash_map_variant().reserved_memory_usage(_aggregator->mem_pool()));
                     TRY_CATCH_BAD_ALLOC(_aggregator->try_convert_to_two_level_map());
                     COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
+                    _aggregator->update_preagg_controller(input_chunk_size,
+                                                          _aggregator->hash_map_variant().size() - ht_size);
                     continue;
                 } else {
                     // TODO: direct call the function may affect the performance of some aggregated cases
@@ -159,6 +168,9 @@ Status AggregateStreamingNode::get_next(RuntimeState* state, ChunkPtr* chunk, bo
                     }
 
                     size_t zero_count = SIMD::count_zero(_aggregator->streaming_selection());
+                    // Rows not found in hash table are streamed out.
+                    _aggregator->update_preagg_controller(input_chunk_size,
+                                                          _aggregator->streaming_selection().size() - zero_count);
                     if (zero_count == 0) {
                         SCOPED_TIMER(_aggregator->streaming_timer());
                         _aggregator->output_chunk_by_streaming(chunk);
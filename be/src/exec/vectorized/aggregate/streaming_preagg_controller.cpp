@@ -0,0 +1,56 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#include "exec/vectorized/aggregate/streaming_preagg_controller.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace starrocks::vectorized {
+
+StreamingPreaggController::StreamingPreaggController(size_t window_rows, double min_reduction, size_t max_bypass_rows)
+        : _window_rows(std::max<size_t>(window_rows, 1)),
+          _min_reduction(min_reduction),
+          _max_bypass_rows(std::max(max_bypass_rows, _window_rows)),
+          _bypass_rows(_window_rows) {}
+
+bool StreamingPreaggController::update(size_t num_rows, size_t num_output_rows) {
+    if (_bypassing) {
+        _num_bypassed_rows += num_rows;
+        _bypassed_rows_since_switch += num_rows;
+        if (_bypassed_rows_since_switch < _bypass_rows) {
+            return false;
+        }
+        // Probe the locality of data by aggregating the next window.
+        _bypassing = false;
+        _probing = true;
+        _num_switches++;
+        return true;
+    }
+
+    _window_input_rows += num_rows;
+    _window_output_rows += num_output_rows;
+    if (_window_input_rows < _window_rows) {
+        return false;
+    }
+
+    _reduction_ratio = _window_output_rows == 0 ? std::numeric_limits<double>::max()
+                                                : static_cast<double>(_window_input_rows) / _window_output_rows;
+    _window_input_rows = 0;
+    _window_output_rows = 0;
+    if (_reduction_ratio >= _min_reduction) {
+        _bypass_rows = _window_rows;
+        _probing = false;
+        return false;
+    }
+
+    if (_probing) {
+        _bypass_rows = std::min(_bypass_rows * 2, _max_bypass_rows);
+        _probing = false;
+    }
+    _bypassing = true;
+    _bypassed_rows_since_switch = 0;
+    _num_switches++;
+    return true;
+}
+
+} // namespace starrocks::vectorized
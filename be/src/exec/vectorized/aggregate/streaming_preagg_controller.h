@@ -0,0 +1,57 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace starrocks::vectorized {
+
+// StreamingPreaggController decides whether the input of streaming pre-aggregation is aggregated
+// into the hash table or passed through to the output directly, by the reduction ratio observed
+// over windows of input rows.
+//
+// The reduction ratio of a window is the number of input rows divided by the number of output rows
+// it produces, i.e. the new groups inserted into the hash table plus the rows streamed out. When
+// the ratio of a window is below |min_reduction|, building the hash table is a waste of CPU, so
+// the following input is passed through without probing the hash table. After passing through
+// some rows, another window is aggregated to detect whether the locality of data has improved. The
+// number of rows passed through between two probing windows doubles after every failed probing,
+// until |max_bypass_rows|, and is reset once the aggregation is effective again.
+class StreamingPreaggController {
+public:
+    StreamingPreaggController(size_t window_rows, double min_reduction, size_t max_bypass_rows);
+
+    // Whether the next chunk should be aggregated, otherwise it should be passed through.
+    bool should_aggregate() const { return !_bypassing; }
+
+    // Record a chunk of |num_rows| rows that produced |num_output_rows| rows, including new groups
+    // of hash table and the rows streamed out. Return true if the mode is switched.
+    bool update(size_t num_rows, size_t num_output_rows);
+
+    // Reduction ratio of the last completed window, 0 if no window is completed.
+    double reduction_ratio() const { return _reduction_ratio; }
+    int64_t num_switches() const { return _num_switches; }
+    // Number of rows passed through without probing the hash table.
+    int64_t num_bypassed_rows() const { return _num_bypassed_rows; }
+
+private:
+    const size_t _window_rows;
+    const double _min_reduction;
+    const size_t _max_bypass_rows;
+
+    bool _bypassing = false;
+    // Whether the current window is aggregated to probe the locality after passing through rows.
+    bool _probing = false;
+    size_t _window_input_rows = 0;
+    size_t _window_output_rows = 0;
+    // Number of rows to pass through before aggregating the next window.
+    size_t _bypass_rows;
+    size_t _bypassed_rows_since_switch = 0;
+
+    double _reduction_ratio = 0;
+    int64_t _num_switches = 0;
+    int64_t _num_bypassed_rows = 0;
+};
+
+} // namespace starrocks::vectorized
@@ -5,6 +5,7 @@
 #include <algorithm>
 
 #include "column/chunk.h"
+#include "common/config.h"
 #include "common/status.h"
 #include "exprs/anyval_util.h"
 #include "gen_cpp/PlanNodes_types.h"
@@ -74,9 +75,9 @@ Status Aggregator::open(RuntimeState* state) {
     // For SQL: select distinct id from table or select id from from table group by id;
     // we don't need to allocate memory for agg states.
     if (_is_only_group_by_columns) {
-        TRY_CATCH_BAD_ALLOC(_init_agg_hash_variant(_hash_set_variant));
+        TRY_CATCH_BAD_ALLOC(_init_agg_hash_variant(_hash_set_variant, _estimated_ndv));
     } else {
-        TRY_CATCH_BAD_ALLOC(_init_agg_hash_variant(_hash_map_variant));
+        TRY_CATCH_BAD_ALLOC(_init_agg_hash_variant(_hash_map_variant, _estimated_ndv));
     }
 
     RETURN_IF_ERROR(check_has_error());
@@ -232,6 +233,26 @@ Status Aggregator::prepare(RuntimeState* state, ObjectPool* pool, RuntimeProfile
 
     _is_only_group_by_columns = _agg_expr_ctxs.empty() && !_group_by_expr_ctxs.empty();
 
+    bool use_streaming_preagg =
+            _tnode.agg_node.__isset.use_streaming_preaggregation && _tnode.agg_node.use_streaming_preaggregation;
+    // The hash table of streaming pre-aggregation is not pre-sized, because it's expected to be small and is
+    // expanded only if it reduces the rows well, see `should_expand_preagg_hash_tables`.
+    if (_tnode.agg_node.__isset.estimated_ndv && _tnode.agg_node.estimated_ndv > 0 && !_group_by_expr_ctxs.empty() &&
+        !use_streaming_preagg) {
+        // FE estimates the groups of the whole aggregation, which are spread over the aggregators of all the
+        // fragment instances.
+        int64_t num_aggregators = std::max<int64_t>(state->num_per_fragment_instances(), 1) *
+                                  std::max<int64_t>(_degree_of_parallelism, 1);
+        int64_t ndv = (_tnode.agg_node.estimated_ndv + num_aggregators - 1) / num_aggregators;
+        ndv = std::min<int64_t>(ndv, config::aggregate_hash_table_max_reserved_keys);
+        // The hash table stops growing once it has enough groups for the limit.
+        if (_limit != -1) {
+            ndv = std::min(ndv, _limit);
+        }
+        _estimated_ndv = std::max<int64_t>(ndv, 0);
+        _runtime_profile->add_info_string("EstimatedNDV", std::to_string(_tnode.agg_node.estimated_ndv));
+    }
+
     _get_results_timer = ADD_TIMER(_runtime_profile, "GetResultsTime");
     _iter_timer = ADD_TIMER(_runtime_profile, "ResultIteratorTime");
     _agg_append_timer = ADD_TIMER(_runtime_profile, "ResultAggAppendTime");
@@ -244,8 +265,29 @@ Status Aggregator::prepare(RuntimeState* state, ObjectPool* pool, RuntimeProfile
 
     _input_row_count = ADD_COUNTER(_runtime_profile, "InputRowCount", TUnit::UNIT);
     _hash_table_size = ADD_COUNTER(_runtime_profile, "HashTableSize", TUnit::UNIT);
+    _hash_table_rehash_count = ADD_COUNTER(_runtime_profile, "HashTableRehashCount", TUnit::UNIT);
+    _hash_table_rehash_timer = ADD_TIMER(_runtime_profile, "HashTableRehashTime");
     _pass_through_row_count = ADD_COUNTER(_runtime_profile, "PassThroughRowCount", TUnit::UNIT);
 
+    if (use_streaming_preagg && _streaming_preaggregation_mode == TStreamingPreaggregationMode::AUTO &&
+        !_group_by_expr_ctxs.empty() && config::enable_adaptive_streaming_preaggregation) {
+        _preagg_controller = std::make_unique<vectorized::StreamingPreaggController>(
+                config::streaming_preaggregation_window_rows, config::streaming_preaggregation_min_reduction,
+                config::streaming_preaggregation_max_bypass_rows);
+        _preagg_switch_count = ADD_COUNTER(_runtime_profile, "PreaggModeSwitchCount", TUnit::UNIT);
+        _preagg_bypassed_rows = ADD_COUNTER(_runtime_profile, "PreaggBypassedRowCount", TUnit::UNIT);
+        _preagg_reduction_ratio = ADD_COUNTER(_runtime_profile, "PreaggReductionRatio", TUnit::DOUBLE_VALUE);
+    }
+
+    if (_can_spill()) {
+        _spill_name = strings::Substitute("agg-$0", _tnode.node_id);
+        _spill_timer = ADD_TIMER(_runtime_profile, "SpillTime");
+        _restore_timer = ADD_TIMER(_runtime_profile, "SpillRestoreTime");
+        _spill_count = ADD_COUNTER(_runtime_profile, "SpillCount", TUnit::UNIT);
+        _spilled_rows = ADD_COUNTER(_runtime_profile, "SpilledRows", TUnit::UNIT);
+        _spilled_bytes = ADD_COUNTER(_runtime_profile, "SpilledBytes", TUnit::BYTES);
+    }
+
     SCOPED_TIMER(_runtime_profile->total_time_counter());
 
     _intermediate_tuple_desc = state->desc_tbl().get_tuple_descriptor(_intermediate_tuple_id);
@@ -307,6 +349,8 @@ void Aggregator::close(RuntimeState* state) {
 
             _mem_pool->free_all();
         }
+        // Remove spill files
+        _spill_writer.reset();
 
         // AggregateFunction::destroy depends FunctionContext.
         // so we close function context after destroy stage
@@ -351,6 +395,20 @@ void Aggregator::offer_chunk_to_buffer(const vectorized::ChunkPtr& chunk) {
     _buffer.push(chunk);
 }
 
+void Aggregator::update_preagg_controller(size_t num_rows, size_t num_output_rows) {
+    if (_preagg_controller == nullptr) {
+        return;
+    }
+    if (_preagg_controller->update(num_rows, num_output_rows)) {
+        VLOG(2) << "streaming pre-aggregation switches to "
+                << (_preagg_controller->should_aggregate() ? "aggregating" : "passing through")
+                << ", reduction ratio: " << _preagg_controller->reduction_ratio();
+    }
+    COUNTER_SET(_preagg_switch_count, _preagg_controller->num_switches());
+    COUNTER_SET(_preagg_bypassed_rows, _preagg_controller->num_bypassed_rows());
+    _preagg_reduction_ratio->set(_preagg_controller->reduction_ratio());
+}
+
 bool Aggregator::should_expand_preagg_hash_tables(size_t prev_row_returned, size_t input_chunk_size, int64_t ht_mem,
                                                   int64_t ht_rows) const {
     // Need some rows in tables to have valid statistics.
@@ -590,6 +648,139 @@ Status Aggregator::check_has_error() {
 
 #undef CONVERT_TO_TWO_LEVEL
 
+bool Aggregator::_can_spill() const {
+    // Java UDAF keeps its states in JVM, which could not be released by resetting the mem pool.
+    // Aggregate with limit may stop inserting new keys once it has enough groups, which conflicts
+    // with restoring partitions.
+    return _state->enable_spill() && !_group_by_expr_ctxs.empty() && !_is_only_group_by_columns && !_has_udaf &&
+           _limit == -1;
+}
+
+Status Aggregator::try_spill() {
+    if (!_can_spill()) {
+        return Status::OK();
+    }
+    if (!vectorized::need_spill(_state, _hash_map_variant.reserved_memory_usage(_mem_pool.get()))) {
+        return Status::OK();
+    }
+    return _spill_hash_map_variant();
+}
+
+Status Aggregator::finish_spill() {
+    DCHECK(has_spilled());
+    if (_hash_map_variant.size() > 0) {
+        RETURN_IF_ERROR(_spill_hash_map_variant());
+    }
+    RETURN_IF_ERROR(_spill_writer->finish());
+    COUNTER_SET(_spilled_bytes, (int64_t)_spill_writer->spilled_bytes());
+    return restore_next_spilled_partition();
+}
+
+Status Aggregator::restore_next_spilled_partition() {
+    DCHECK(has_spilled());
+    SCOPED_TIMER(_restore_timer);
+    _reset_hash_map_variant();
+    while (_next_restore_partition < _spill_writer->num_partitions()) {
+        auto& partition = _spill_writer->partition(_next_restore_partition++);
+        if (partition == nullptr) {
+            continue;
+        }
+        while (true) {
+            auto chunk_or = partition->read_next();
+            if (chunk_or.status().is_end_of_file()) {
+                break;
+            }
+            RETURN_IF_ERROR(chunk_or.status());
+            RETURN_IF_ERROR(_merge_spilled_chunk(*chunk_or.value()));
+        }
+        // The partition has been merged into hash map, remove its file as soon as possible.
+        partition.reset();
+
+        if (_hash_map_variant.size() > 0) {
+            _it_hash = _state_allocator.begin();
+            _is_ht_eos = false;
+            return Status::OK();
+        }
+    }
+    _is_ht_eos = true;
+    return Status::OK();
+}
+
+Status Aggregator::_spill_hash_map_variant() {
+    SCOPED_TIMER(_spill_timer);
+    if (_spill_writer == nullptr) {
+        _spill_writer = std::make_unique<vectorized::PartitionedSpillWriter>(_state, _spill_name, kSpillPartitionBits);
+    }
+    size_t spilled_rows = _hash_map_variant.size();
+
+    Status st;
+    if (false) {
+    }
+#define HASH_MAP_METHOD(NAME)                                                     \
+    else if (_hash_map_variant.type == vectorized::AggHashMapVariant::Type::NAME) \
+            st = _spill_hash_map<decltype(_hash_map_variant.NAME)::element_type>(*_hash_map_variant.NAME);
+    APPLY_FOR_AGG_VARIANT_ALL(HASH_MAP_METHOD)
+#undef HASH_MAP_METHOD
+    RETURN_IF_ERROR(st);
+
+    _reset_hash_map_variant();
+    COUNTER_UPDATE(_spill_count, 1);
+    COUNTER_UPDATE(_spilled_rows, spilled_rows);
+    return Status::OK();
+}
+
+Status Aggregator::_merge_spilled_chunk(const vectorized::Chunk& chunk) {
+    const size_t chunk_size = chunk.num_rows();
+    const size_t num_group_by_columns = _group_by_columns.size();
+    DCHECK_LE(chunk_size, _state->chunk_size());
+    DCHECK_EQ(num_group_by_columns + _agg_fn_ctxs.size(), chunk.num_columns());
+
+    for (size_t i = 0; i < num_group_by_columns; i++) {
+        _group_by_columns[i] = chunk.get_column_by_index(i);
+    }
+    if (false) {
+    }
+#define HASH_MAP_METHOD(NAME)                                                               \
+    else if (_hash_map_variant.type == vectorized::AggHashMapVariant::Type::NAME) {         \
+        TRY_CATCH_BAD_ALLOC(build_hash_map<decltype(_hash_map_variant.NAME)::element_type>( \
+                *_hash_map_variant.NAME, chunk_size));                                      \
+    }
+    APPLY_FOR_AGG_VARIANT_ALL(HASH_MAP_METHOD)
+#undef HASH_MAP_METHOD
+
+    // Spilled agg columns are always in intermediate format, so merge them whatever the phase is.
+    for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+        _agg_functions[i]->merge_batch(_agg_fn_ctxs[i], chunk_size, _agg_states_offsets[i],
+                                       chunk.get_column_by_index(num_group_by_columns + i).get(),
+                                       _tmp_agg_states.data());
+    }
+    for (size_t i = 0; i < num_group_by_columns; i++) {
+        _group_by_columns[i] = nullptr;
+    }
+
+    _mem_tracker->set(_hash_map_variant.reserved_memory_usage(_mem_pool.get()));
+    TRY_CATCH_BAD_ALLOC(try_convert_to_two_level_map());
+    return check_has_error();
+}
+
+void Aggregator::_reset_hash_map_variant() {
+    if (false) {
+    }
+#define HASH_MAP_METHOD(NAME)                                                     \
+    else if (_hash_map_variant.type == vectorized::AggHashMapVariant::Type::NAME) \
+            _release_agg_memory<decltype(_hash_map_variant.NAME)::element_type>(_hash_map_variant.NAME.get());
+    APPLY_FOR_AGG_VARIANT_ALL(HASH_MAP_METHOD)
+#undef HASH_MAP_METHOD
+    _hash_map_variant.reset();
+
+    // Keys of hash map and agg states are all allocated from _mem_pool, they are useless now.
+    _state_allocator.vecs.clear();
+    _mem_pool->free_all();
+
+    _init_agg_hash_variant(_hash_map_variant);
+    _mem_tracker->set(_hash_map_variant.reserved_memory_usage(_mem_pool.get()));
+}
+
 // When need finalize, create column by result type
 // otherwise, create column by serde type
 vectorized::Columns Aggregator::_create_agg_result_columns() {
@@ -728,7 +919,7 @@ bool is_group_columns_fixed_size(std::vector<ExprContext*>& group_by_expr_ctxs,
     }
 
 template <typename HashVariantType>
-void Aggregator::_init_agg_hash_variant(HashVariantType& hash_variant) {
+void Aggregator::_init_agg_hash_variant(HashVariantType& hash_variant, size_t reserved_keys) {
     auto type = _aggr_phase == AggrPhase1 ? HashVariantType::Type::phase1_slice : HashVariantType::Type::phase2_slice;
     if (_has_nullable_key) {
         switch (_group_by_expr_ctxs.size()) {
@@ -826,9 +1017,22 @@ void Aggregator::_init_agg_hash_variant(HashVariantType& hash_variant) {
             }
         }
     }
+    // A hash table pre-sized beyond the threshold is two-level from the beginning, rather than
+    // being converted after inserting lots of keys.
+    if (reserved_keys * (sizeof(Slice) + sizeof(vectorized::AggDataPtr) + 1) > two_level_memory_threshold) {
+        if (type == HashVariantType::Type::phase1_slice) {
+            type = HashVariantType::Type::phase1_slice_two_level;
+        } else if (type == HashVariantType::Type::phase2_slice) {
+            type = HashVariantType::Type::phase2_slice_two_level;
+        }
+    }
     VLOG_ROW << "hash type is "
              << static_cast<typename std::underlying_type<typename HashVariantType::Type>::type>(type);
     hash_variant.init(_state, type);
+    if (reserved_keys > 0) {
+        SCOPED_TIMER(_hash_table_rehash_timer);
+        hash_variant.reserve(reserved_keys);
+    }
 
 #define SET_FIXED_SLICE_HASH_MAP_FIELD(TYPE)                  \
     if (type == HashVariantType::Type::TYPE) {                \
@@ -17,6 +17,8 @@
 #include "common/statusor.h"
 #include "exec/pipeline/context_with_dependency.h"
 #include "exec/vectorized/aggregate/agg_hash_variant.h"
+#include "exec/vectorized/aggregate/streaming_preagg_controller.h"
+#include "exec/vectorized/spill/spill_file.h"
 #include "exprs/agg/aggregate_factory.h"
 #include "exprs/expr.h"
 #include "gen_cpp/QueryPlanExtra_constants.h"
@@ -155,6 +157,8 @@ public:
     void update_num_input_rows(int64_t increment) { _num_input_rows += increment; }
     int64_t num_pass_through_rows() { return _num_pass_through_rows; }
     void set_aggr_phase(AggrPhase aggr_phase) { _aggr_phase = aggr_phase; }
+    // Number of the aggregators of the same plan node in a fragment instance, which run in parallel.
+    void set_degree_of_parallelism(size_t degree_of_parallelism) { _degree_of_parallelism = degree_of_parallelism; }
     AggrPhase get_aggr_phase() { return _aggr_phase; }
 
     TStreamingPreaggregationMode::type streaming_preaggregation_mode() { return _streaming_preaggregation_mode; }
@@ -170,6 +174,13 @@ public:
     RuntimeProfile::Counter* hash_table_size() { return _hash_table_size; }
     RuntimeProfile::Counter* pass_through_row_count() { return _pass_through_row_count; }
 
+    // Whether the next chunk of streaming pre-aggregation in AUTO mode should be aggregated.
+    // Always true if the adaptive streaming pre-aggregation is disabled.
+    bool should_preaggregate() const { return _preagg_controller == nullptr || _preagg_controller->should_aggregate(); }
+    // Feed a chunk of |num_rows| input rows to the adaptive streaming pre-aggregation, |num_output_rows| of
+    // them are new groups of hash table or streamed out. Do nothing if it's disabled.
+    void update_preagg_controller(size_t num_rows, size_t num_output_rows);
+
     void sink_complete() { _is_sink_complete.store(true, std::memory_order_release); }
 
     bool is_chunk_buffer_empty();
@@ -209,6 +220,19 @@ public:
 
     Status check_has_error();
 
+    // Spill to disk, only used by blocking aggregate of pipeline engine.
+    // Under memory pressure, the whole hash map is serialized into intermediate format, partitioned
+    // by the hash of group by keys and written into local spill files, then the hash map is reset.
+    // After all input has been consumed, the partitions are merged back into hash map one by one.
+    bool has_spilled() const { return _spill_writer != nullptr; }
+    // Spill the hash map if memory pressure is high.
+    Status try_spill();
+    // Spill the remaining in-memory data and restore the first spilled partition.
+    // REQUIRE: has_spilled()
+    Status finish_spill();
+    // Load the next non-empty spilled partition into hash map, set ht eos if there is no more partition.
+    Status restore_next_spilled_partition();
+
 #ifdef NDEBUG
     static constexpr size_t two_level_memory_threshold = 33554432; // 32M, L3 Cache
     static constexpr size_t streaming_hash_table_size_threshold = 10000000;
@@ -237,6 +261,13 @@ private:
     int64_t _limit = -1;
     int64_t _num_rows_returned = 0;
 
+    size_t _degree_of_parallelism = 1;
+    // Share of this aggregator in the number of groups estimated by FE, capped by
+    // `config::aggregate_hash_table_max_reserved_keys`. The hash table is pre-sized for it when opened.
+    size_t _estimated_ndv = 0;
+    // Number of new keys inserted by the last chunk, used to predict the growth of hash table.
+    size_t _last_num_new_keys = 0;
+
     // only used in pipeline engine
     std::atomic<bool> _is_sink_complete = false;
     // only used in pipeline engine
@@ -316,6 +347,8 @@ private:
     RuntimeProfile::Counter* _input_row_count{};
     RuntimeProfile::Counter* _rows_returned_counter;
     RuntimeProfile::Counter* _hash_table_size{};
+    RuntimeProfile::Counter* _hash_table_rehash_count{};
+    RuntimeProfile::Counter* _hash_table_rehash_timer{};
     RuntimeProfile::Counter* _iter_timer{};
     RuntimeProfile::Counter* _agg_append_timer{};
     RuntimeProfile::Counter* _group_by_append_timer{};
@@ -323,6 +356,25 @@ private:
     RuntimeProfile::Counter* _expr_compute_timer{};
     RuntimeProfile::Counter* _expr_release_timer{};
 
+    // Only created for streaming pre-aggregation in AUTO mode.
+    std::unique_ptr<vectorized::StreamingPreaggController> _preagg_controller;
+    RuntimeProfile::Counter* _preagg_switch_count{};
+    RuntimeProfile::Counter* _preagg_bypassed_rows{};
+    RuntimeProfile::Counter* _preagg_reduction_ratio{};
+
+    // Spilled partitions of hash map, created at the first spill.
+    std::unique_ptr<vectorized::PartitionedSpillWriter> _spill_writer;
+    std::string _spill_name;
+    size_t _next_restore_partition = 0;
+    // 2^4 partitions, each partition is restored into memory as a whole.
+    static constexpr int kSpillPartitionBits = 4;
+
+    RuntimeProfile::Counter* _spill_timer{};
+    RuntimeProfile::Counter* _restore_timer{};
+    RuntimeProfile::Counter* _spill_count{};
+    RuntimeProfile::Counter* _spilled_rows{};
+    RuntimeProfile::Counter* _spilled_bytes{};
+
 public:
     template <typename HashMapWithKey>
     void build_hash_map(HashMapWithKey& hash_map_with_key, size_t chunk_size, bool agg_group_by_with_limit = false) {
@@ -334,8 +386,11 @@ public:
                 _streaming_selection.assign(chunk_size, 0);
             }
         }
+        size_t capacity = hash_map_with_key.hash_map.capacity();
+        size_t size = _grow_hash_table_if_needed(hash_map_with_key.hash_map);
         hash_map_with_key.compute_agg_states(chunk_size, _group_by_columns, _mem_pool.get(),
                                              AllocateState<HashMapWithKey>(this), &_tmp_agg_states);
+        _update_hash_table_growth(hash_map_with_key.hash_map, size, capacity);
     }
 
     template <typename HashMapWithKey>
@@ -346,7 +401,10 @@ public:
 
     template <typename HashSetWithKey>
     void build_hash_set(HashSetWithKey& hash_set, size_t chunk_size) {
+        size_t capacity = hash_set.hash_set.capacity();
+        size_t size = _grow_hash_table_if_needed(hash_set.hash_set);
         hash_set.build_set(chunk_size, _group_by_columns, _mem_pool.get());
+        _update_hash_table_growth(hash_set.hash_set, size, capacity);
     }
 
     template <typename HashSetWithKey>
@@ -528,8 +586,69 @@ private:
     Status _evaluate_exprs(vectorized::Chunk* chunk);
 
     // Choose different agg hash map/set by different group by column's count, type, nullable
+    // Pre-size the hash table for |reserved_keys| keys if it's not 0.
     template <typename HashVariantType>
-    void _init_agg_hash_variant(HashVariantType& hash_variant);
+    void _init_agg_hash_variant(HashVariantType& hash_variant, size_t reserved_keys = 0);
+
+    bool _can_spill() const;
+    Status _spill_hash_map_variant();
+    // Merge the intermediate results read from spill file into hash map.
+    Status _merge_spilled_chunk(const vectorized::Chunk& chunk);
+    // Destroy all agg states and create an empty hash map.
+    void _reset_hash_map_variant();
+
+    // Rehash the hash table before inserting a chunk if it's going to be overloaded, so that the
+    // rehashing is done (and timed) here instead of in the middle of the insertions. The number of
+    // new keys of the chunk is predicted by that of the last chunk. Return the size of hash table.
+    template <typename HashTable>
+    size_t _grow_hash_table_if_needed(HashTable& hash_table) {
+        size_t capacity = hash_table.capacity();
+        size_t expected_size = hash_table.size() + _last_num_new_keys;
+        // phmap rehashes once the load factor reaches 7/8.
+        if (_last_num_new_keys > 0 && expected_size > capacity - capacity / 8) {
+            SCOPED_TIMER(_hash_table_rehash_timer);
+            hash_table.reserve(expected_size);
+        }
+        return hash_table.size();
+    }
+
+    // Count the rehashing happened since the hash table was |size_before| in size and |capacity_before|
+    // in capacity, including the ones done by `_grow_hash_table_if_needed`.
+    template <typename HashTable>
+    void _update_hash_table_growth(HashTable& hash_table, size_t size_before, size_t capacity_before) {
+        _last_num_new_keys = hash_table.size() - size_before;
+        // Allocating the first slots of an empty hash table is not a rehashing.
+        if (capacity_before > 0 && hash_table.capacity() != capacity_before) {
+            COUNTER_UPDATE(_hash_table_rehash_count, 1);
+        }
+    }
+
+    template <typename HashMapWithKey>
+    Status _spill_hash_map(HashMapWithKey& hash_map_with_key) {
+        // Spilled data is merged with other spilled data when restored, so
+        // the agg states are serialized rather than finalized.
+        bool needs_finalize = _needs_finalize;
+        int64_t num_rows_returned = _num_rows_returned;
+        _needs_finalize = false;
+        _it_hash = _state_allocator.begin();
+        _is_ht_eos = false;
+
+        Status st;
+        vectorized::Columns group_by_columns(_group_by_types.size());
+        while (st.ok() && !_is_ht_eos) {
+            vectorized::ChunkPtr chunk;
+            convert_hash_map_to_chunk(hash_map_with_key, _state->chunk_size(), &chunk);
+            for (size_t i = 0; i < group_by_columns.size(); i++) {
+                group_by_columns[i] = chunk->get_column_by_index(i);
+            }
+            st = _spill_writer->append(*chunk, group_by_columns);
+        }
+
+        _needs_finalize = needs_finalize;
+        _num_rows_returned = num_rows_returned;
+        _is_ht_eos = false;
+        return st;
+    }
 
     template <typename HashMapWithKey>
     void _release_agg_memory(HashMapWithKey* hash_map_with_key) {
@@ -589,12 +708,16 @@ public:
             return it->second;
         }
         auto aggregator = std::make_shared<Aggregator>(_tnode);
+        aggregator->set_degree_of_parallelism(_degree_of_parallelism);
         _aggregators[id] = aggregator;
         return aggregator;
     }
 
+    void set_degree_of_parallelism(size_t degree_of_parallelism) { _degree_of_parallelism = degree_of_parallelism; }
+
 private:
     const TPlanNode& _tnode;
+    size_t _degree_of_parallelism = 1;
     std::unordered_map<size_t, AggregatorPtr> _aggregators;
 };
 
@@ -4,6 +4,7 @@
 
 #include "column/column_helper.h"
 #include "column/type_traits.h"
+#include "exec/vectorized/sorting/merge.h"
 #include "exec/vectorized/sorting/sort_permute.h"
 #include "exprs/expr.h"
 #include "gutil/casts.h"
@@ -168,6 +169,11 @@ void ChunksSorter::setup_runtime(RuntimeProfile* profile) {
     profile->add_info_string("SortType", _is_topn ? "TopN" : "All");
 }
 
+void ChunksSorter::create_sorted_cursors(std::vector<std::unique_ptr<SimpleChunkSortCursor>>* cursors,
+                                         Status* status) {
+    cursors->push_back(make_sorted_runs_cursor(get_sorted_runs(), _state->chunk_size(), _sort_exprs));
+}
+
 Status ChunksSorter::finish(RuntimeState* state) {
     TRY_CATCH_BAD_ALLOC(RETURN_IF_ERROR(done(state)));
     _is_sink_complete = true;
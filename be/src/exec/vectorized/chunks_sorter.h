@@ -65,6 +65,7 @@ struct DataSegment {
 using DataSegments = std::vector<DataSegment>;
 
 class SortedRuns;
+class SimpleChunkSortCursor;
 class ChunksSorter;
 using ChunksSorterPtr = std::shared_ptr<ChunksSorter>;
 using ChunksSorters = std::vector<ChunksSorterPtr>;
@@ -103,6 +104,14 @@ public:
     // Return sorted data in multiple runs(Avoid merge them into a big chunk)
     virtual SortedRuns get_sorted_runs() = 0;
 
+    // Whether part of the sorted data has been spilled to disk, then the sorted data can only be read
+    // by get_next() or the cursors from create_sorted_cursors().
+    virtual bool has_spilled() const { return false; }
+
+    // Create cursors over the sorted data, which are merged by the caller in a streaming way.
+    // Errors of reading spilled data are kept in |status|, which must outlive the cursors.
+    virtual void create_sorted_cursors(std::vector<std::unique_ptr<SimpleChunkSortCursor>>* cursors, Status* status);
+
     // Return accurate output rows of this operator
     virtual size_t get_output_rows() const = 0;
 
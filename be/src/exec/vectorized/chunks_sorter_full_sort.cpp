@@ -18,10 +18,24 @@ ChunksSorterFullSort::ChunksSorterFullSort(RuntimeState* state, const std::vecto
 
 ChunksSorterFullSort::~ChunksSorterFullSort() = default;
 
+void ChunksSorterFullSort::setup_runtime(RuntimeProfile* profile) {
+    ChunksSorter::setup_runtime(profile);
+    if (_state->enable_spill()) {
+        _spill_timer = ADD_TIMER(profile, "SpillTime");
+        _spilled_runs_counter = ADD_COUNTER(profile, "SpilledRuns", TUnit::UNIT);
+        _spilled_rows_counter = ADD_COUNTER(profile, "SpilledRows", TUnit::UNIT);
+        _spilled_bytes_counter = ADD_COUNTER(profile, "SpilledBytes", TUnit::BYTES);
+    }
+}
+
 Status ChunksSorterFullSort::update(RuntimeState* state, const ChunkPtr& chunk) {
     _merge_unsorted(state, chunk);
     _partial_sort(state, false);
 
+    int64_t buffered_bytes = _sorted_chunks_bytes + (_unsorted_chunk != nullptr ? _unsorted_chunk->memory_usage() : 0);
+    if (need_spill(state, buffered_bytes)) {
+        RETURN_IF_ERROR(_spill_sorted_run(state));
+    }
     return Status::OK();
 }
 
@@ -60,6 +74,7 @@ Status ChunksSorterFullSort::_partial_sort(RuntimeState* state, bool done) {
         RETURN_IF_ERROR(sorted_chunk->upgrade_if_overflow());
 
         _sorted_chunks.push_back(sorted_chunk);
+        _sorted_chunks_bytes += sorted_chunk->memory_usage();
         _total_rows += _unsorted_chunk->num_rows();
         _unsorted_chunk.reset();
     }
@@ -76,6 +91,47 @@ Status ChunksSorterFullSort::_merge_sorted(RuntimeState* state) {
     return Status::OK();
 }
 
+// Merge the partial sorted chunks into a sorted run and write it to a spill file. The chunks are merged by the
+// cascade merger in a streaming way, so no extra memory is needed to hold the whole merged run.
+Status ChunksSorterFullSort::_spill_sorted_run(RuntimeState* state) {
+    RETURN_IF_ERROR(_partial_sort(state, true));
+    if (_sorted_chunks.empty()) {
+        return Status::OK();
+    }
+    SCOPED_TIMER(_spill_timer);
+
+    ASSIGN_OR_RETURN(auto run, SpillFile::create(state, "sort"));
+    std::vector<std::unique_ptr<SimpleChunkSortCursor>> cursors;
+    for (auto& chunk : _sorted_chunks) {
+        cursors.push_back(make_sorted_runs_cursor(SortedRun(chunk, Columns()), state->chunk_size(), _sort_exprs));
+    }
+    // The cursors hold the chunks now, every chunk is released once it has been merged.
+    _sorted_chunks.clear();
+    _sorted_chunks_bytes = 0;
+
+    Status st;
+    ChunkConsumer consumer = [&st, &run](ChunkUniquePtr chunk) {
+        if (st.ok()) {
+            st = chunk->downgrade();
+        }
+        if (st.ok()) {
+            st = run->append(*chunk);
+        }
+        return st;
+    };
+    SortDescs sort_desc(_sort_order_flag, _null_first_flag);
+    RETURN_IF_ERROR(merge_sorted_cursor_cascade(sort_desc, std::move(cursors), consumer));
+    RETURN_IF_ERROR(st);
+    RETURN_IF_ERROR(run->finish());
+
+    _spilled_rows += run->num_rows();
+    COUNTER_UPDATE(_spilled_runs_counter, 1);
+    COUNTER_UPDATE(_spilled_rows_counter, static_cast<int64_t>(run->num_rows()));
+    COUNTER_UPDATE(_spilled_bytes_counter, static_cast<int64_t>(run->file_size()));
+    _spilled_runs.push_back(std::move(run));
+    return Status::OK();
+}
+
 Status ChunksSorterFullSort::done(RuntimeState* state) {
     RETURN_IF_ERROR(_partial_sort(state, true));
     RETURN_IF_ERROR(_merge_sorted(state));
@@ -84,6 +140,33 @@ Status ChunksSorterFullSort::done(RuntimeState* state) {
 
 Status ChunksSorterFullSort::get_next(ChunkPtr* chunk, bool* eos) {
     SCOPED_TIMER(_output_timer);
+    if (has_spilled()) {
+        if (_spilled_runs_merger == nullptr) {
+            std::vector<std::unique_ptr<SimpleChunkSortCursor>> cursors;
+            create_sorted_cursors(&cursors, &_spill_read_status);
+            _spilled_runs_merger = std::make_unique<MergeCursorsCascade>();
+            RETURN_IF_ERROR(_spilled_runs_merger->init(SortDescs(_sort_order_flag, _null_first_flag),
+                                                       std::move(cursors)));
+            if (!_spilled_runs_merger->is_data_ready()) {
+                return Status::InternalError("spilled sorted runs are not ready");
+            }
+        }
+        while (!_spilled_runs_merger->is_eos()) {
+            ChunkUniquePtr merged = _spilled_runs_merger->try_get_next();
+            RETURN_IF_ERROR(_spill_read_status);
+            if (merged != nullptr && !merged->is_empty()) {
+                *chunk = ChunkPtr(merged.release());
+                RETURN_IF_ERROR((*chunk)->downgrade());
+                *eos = false;
+                return Status::OK();
+            }
+        }
+        RETURN_IF_ERROR(_spill_read_status);
+        *chunk = nullptr;
+        *eos = true;
+        return Status::OK();
+    }
+
     if (_merged_runs.num_chunks() == 0) {
         *chunk = nullptr;
         *eos = true;
@@ -107,7 +190,33 @@ SortedRuns ChunksSorterFullSort::get_sorted_runs() {
 }
 
 size_t ChunksSorterFullSort::get_output_rows() const {
-    return _merged_runs.num_rows();
+    return _merged_runs.num_rows() + _spilled_rows;
+}
+
+void ChunksSorterFullSort::create_sorted_cursors(std::vector<std::unique_ptr<SimpleChunkSortCursor>>* cursors,
+                                                 Status* status) {
+    for (auto& spilled_run : _spilled_runs) {
+        SpillFile* run = spilled_run.get();
+        run->rewind();
+        auto provider = [run, status](ChunkUniquePtr* output, bool* eos) {
+            if (output == nullptr || eos == nullptr) {
+                return true;
+            }
+            auto chunk = run->read_next();
+            if (chunk.ok()) {
+                *output = std::move(chunk.value());
+                return true;
+            }
+            if (!chunk.status().is_end_of_file() && status->ok()) {
+                *status = chunk.status();
+            }
+            *eos = true;
+            return false;
+        };
+        cursors->push_back(std::make_unique<SimpleChunkSortCursor>(std::move(provider), _sort_exprs));
+    }
+    // The last sorted run in memory.
+    ChunksSorter::create_sorted_cursors(cursors, status);
 }
 
 int64_t ChunksSorterFullSort::mem_usage() const {
@@ -4,6 +4,7 @@
 
 #include "exec/vectorized/chunks_sorter.h"
 #include "exec/vectorized/sorting/merge.h"
+#include "exec/vectorized/spill/spill_file.h"
 #include "gtest/gtest_prod.h"
 
 namespace starrocks {
@@ -25,6 +26,8 @@ public:
                          const std::string& sort_keys);
     ~ChunksSorterFullSort() override;
 
+    void setup_runtime(RuntimeProfile* profile) override;
+
     // Append a Chunk for sort.
     Status update(RuntimeState* state, const ChunkPtr& chunk) override;
     Status done(RuntimeState* state) override;
@@ -33,6 +36,9 @@ public:
     SortedRuns get_sorted_runs() override;
     size_t get_output_rows() const override;
 
+    bool has_spilled() const override { return !_spilled_runs.empty(); }
+    void create_sorted_cursors(std::vector<std::unique_ptr<SimpleChunkSortCursor>>* cursors, Status* status) override;
+
     int64_t mem_usage() const override;
 
 private:
@@ -40,15 +46,32 @@ private:
     // 1. Accumulate input chunks into a big chunk(but not exceed the kMaxBufferedChunkSize), to reduce the memory copy during merge
     // 2. Sort the accumulated big chunk partially
     // 3. Merge all big-chunks into global sorted
+    //
+    // External sort: when spilling is enabled and the memory is tight, the partial sorted chunks are merged into a
+    // sorted run and written to a spill file. The spilled runs and the final in-memory run are merged in a streaming
+    // way by the cascade merger when the sorted data is read.
     Status _merge_unsorted(RuntimeState* state, const ChunkPtr& chunk);
     Status _partial_sort(RuntimeState* state, bool done);
     Status _merge_sorted(RuntimeState* state);
+    Status _spill_sorted_run(RuntimeState* state);
 
     size_t _total_rows = 0;               // Total rows of sorting data
     Permutation _sort_permutation;        // Temp permutation for sorting
     ChunkPtr _unsorted_chunk;             // Unsorted chunk, accumulate it to a larger chunk
     std::vector<ChunkPtr> _sorted_chunks; // Partial sorted, but not merged
     SortedRuns _merged_runs;              // After merge
+    int64_t _sorted_chunks_bytes = 0;     // Memory usage of _sorted_chunks
+
+    std::vector<SpillFilePtr> _spilled_runs; // Sorted runs spilled to disk
+    size_t _spilled_rows = 0;
+    // Merge the spilled runs and _merged_runs for get_next().
+    std::unique_ptr<MergeCursorsCascade> _spilled_runs_merger;
+    Status _spill_read_status;
+
+    RuntimeProfile::Counter* _spill_timer = nullptr;
+    RuntimeProfile::Counter* _spilled_runs_counter = nullptr;
+    RuntimeProfile::Counter* _spilled_rows_counter = nullptr;
+    RuntimeProfile::Counter* _spilled_bytes_counter = nullptr;
 
     // TODO: further tunning the buffer parameter
     static constexpr size_t kMaxBufferedChunkSize = 1024000;   // Max buffer 1024000 rows
@@ -9,6 +9,7 @@
 #include "column/column_helper.h"
 #include "column/fixed_length_column.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
 #include "exec/pipeline/chunk_accumulate_operator.h"
 #include "exec/pipeline/exchange/exchange_source_operator.h"
 #include "exec/pipeline/hashjoin/hash_join_build_operator.h"
@@ -407,6 +408,35 @@ Status HashJoinNode::close(RuntimeState* state) {
     return ExecNode::close(state);
 }
 
+bool HashJoinNode::_is_partitionable_join_type() const {
+    // It's not the case for the joins outputting unmatched build rows, and NULL_AWARE_LEFT_ANTI_JOIN,
+    // which needs to know whether the whole build side contains null.
+    return _join_type == TJoinOp::INNER_JOIN || _join_type == TJoinOp::LEFT_OUTER_JOIN ||
+           _join_type == TJoinOp::LEFT_SEMI_JOIN || _join_type == TJoinOp::LEFT_ANTI_JOIN;
+}
+
+bool HashJoinNode::_can_partition_broadcast_build(pipeline::PipelineBuilderContext* context) const {
+    if (!config::enable_hash_join_partitioned_build || _distribution_mode != TJoinDistributionMode::BROADCAST ||
+        context->degree_of_parallelism() <= 1) {
+        return false;
+    }
+    return _is_partitionable_join_type();
+}
+
+bool HashJoinNode::_can_spread_probe_hot_keys(pipeline::PipelineBuilderContext* context,
+                                              const pipeline::OpFactories& rhs_operators,
+                                              const pipeline::OpFactories& lhs_operators) const {
+    if (!config::enable_hash_join_skew_aware_local_shuffle || _distribution_mode == TJoinDistributionMode::BROADCAST ||
+        context->degree_of_parallelism() <= 1) {
+        return false;
+    }
+    // The probe operator finds the partition of a probe row by the same hash function as the local shuffle of
+    // HASH_PARTITIONED, while the partitions of the other shuffles are decided by the remote exchange sink.
+    auto part_type = down_cast<pipeline::SourceOperatorFactory*>(rhs_operators[0].get())->partition_type();
+    return part_type == TPartitionType::HASH_PARTITIONED && context->need_local_shuffle(rhs_operators) &&
+           context->need_local_shuffle(lhs_operators) && _is_partitionable_join_type();
+}
+
 pipeline::OpFactories HashJoinNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
     using namespace pipeline;
 
@@ -414,7 +444,22 @@ pipeline::OpFactories HashJoinNode::decompose_to_pipeline(pipeline::PipelineBuil
     auto lhs_operators = child(0)->decompose_to_pipeline(context);
     size_t num_right_partitions;
     size_t num_left_partitions;
-    if (_distribution_mode == TJoinDistributionMode::BROADCAST) {
+    bool partitioned_build = _can_partition_broadcast_build(context);
+    // The hot keys of the probe side are spread over all the probe drivers, so every probe driver probes the hash
+    // tables of all the partitions, like the partitioned build of broadcast join.
+    bool spread_probe_hot_keys =
+            !partitioned_build && _can_spread_probe_hot_keys(context, rhs_operators, lhs_operators);
+    if (partitioned_build) {
+        // Every build driver builds the hash table of a partition of the build side shuffled by the join keys,
+        // and every probe driver looks up the hash table of the partition of each probe row.
+        num_left_partitions = num_right_partitions = context->degree_of_parallelism();
+        rhs_operators = context->maybe_interpolate_local_shuffle_exchange(runtime_state(), rhs_operators,
+                                                                          _build_expr_ctxs,
+                                                                          TPartitionType::HASH_PARTITIONED);
+        bool force_local_passthrough = false;
+        lhs_operators = context->maybe_interpolate_local_passthrough_exchange(
+                runtime_state(), lhs_operators, num_left_partitions, force_local_passthrough);
+    } else if (_distribution_mode == TJoinDistributionMode::BROADCAST) {
         num_right_partitions = 1;
         // Broadcast join need only create one hash table, because all the HashJoinProbeOperators
         // use the same hash table with their own different probe states.
@@ -464,8 +509,8 @@ pipeline::OpFactories HashJoinNode::decompose_to_pipeline(pipeline::PipelineBuil
                     lhs_operators = context->maybe_interpolate_local_shuffle_exchange(
                             runtime_state(), lhs_operators, _probe_equivalence_partition_expr_ctxs, part_type);
                 } else {
-                    lhs_operators = context->maybe_interpolate_local_shuffle_exchange(runtime_state(), lhs_operators,
-                                                                                      _probe_expr_ctxs, part_type);
+                    lhs_operators = context->maybe_interpolate_local_shuffle_exchange(
+                            runtime_state(), lhs_operators, _probe_expr_ctxs, part_type, spread_probe_hot_keys);
                 }
             }
         }
@@ -476,7 +521,8 @@ pipeline::OpFactories HashJoinNode::decompose_to_pipeline(pipeline::PipelineBuil
                           _other_join_conjunct_ctxs, _conjunct_ctxs, child(1)->row_desc(), child(0)->row_desc(),
                           _row_descriptor, child(1)->type(), child(0)->type(), child(1)->conjunct_ctxs().empty(),
                           _build_runtime_filters, _output_slots, _distribution_mode);
-    auto hash_joiner_factory = std::make_shared<starrocks::pipeline::HashJoinerFactory>(param, num_left_partitions);
+    auto hash_joiner_factory = std::make_shared<starrocks::pipeline::HashJoinerFactory>(
+            param, num_left_partitions, partitioned_build || spread_probe_hot_keys ? num_right_partitions : 1);
 
     // add placeholder into RuntimeFilterHub, HashJoinBuildOperator will generate runtime filters and fill it,
     // Operators consuming the runtime filters will inspect this placeholder.
@@ -906,12 +952,17 @@ Status HashJoinNode::_do_publish_runtime_filters(RuntimeState* state, int64_t li
         JoinRuntimeFilter* filter = RuntimeFilterHelper::create_runtime_bloom_filter(_pool, build_type);
         if (filter == nullptr) continue;
         filter->set_join_mode(rf_desc->join_mode());
-        filter->init(_ht.get_row_count());
         int expr_order = rf_desc->build_expr_order();
         ColumnPtr column = _ht.get_key_columns()[expr_order];
         bool eq_null = _is_null_safes[expr_order];
-        RETURN_IF_ERROR(RuntimeFilterHelper::fill_runtime_bloom_filter(column, build_type, filter,
-                                                                       kHashJoinKeyColumnOffset, eq_null));
+        if (rf_desc->num_buckets() > 0) {
+            RETURN_IF_ERROR(RuntimeFilterHelper::fill_runtime_bloom_filter_by_bucket(
+                    {column}, build_type, filter, kHashJoinKeyColumnOffset, eq_null, rf_desc->num_buckets()));
+        } else {
+            filter->init(_ht.get_row_count());
+            RETURN_IF_ERROR(RuntimeFilterHelper::fill_runtime_bloom_filter(column, build_type, filter,
+                                                                           kHashJoinKeyColumnOffset, eq_null));
+        }
         rf_desc->set_runtime_filter(filter);
     }
 
@@ -40,6 +40,17 @@ public:
 private:
     static bool _has_null(const ColumnPtr& column);
 
+    // Whether the output of every probe row only depends on the rows of its own partition in the hash table,
+    // so the hash table can be built in partitions and probed by any driver.
+    bool _is_partitionable_join_type() const;
+    // Whether the build side of broadcast join can be built by all the pipeline drivers in partitions.
+    bool _can_partition_broadcast_build(pipeline::PipelineBuilderContext* context) const;
+    // Whether the hot keys of the local shuffle of the probe side can be spread over all the probe drivers,
+    // which probe the hash table of every partition built by the shuffled build side.
+    bool _can_spread_probe_hot_keys(pipeline::PipelineBuilderContext* context,
+                                    const pipeline::OpFactories& rhs_operators,
+                                    const pipeline::OpFactories& lhs_operators) const;
+
     void _init_hash_table_param(HashTableParam* param);
     // local join includes: broadcast join and colocate join.
     Status _create_implicit_local_join_runtime_filters(RuntimeState* state);
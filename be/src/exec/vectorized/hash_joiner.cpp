@@ -15,10 +15,12 @@
 #include "exprs/vectorized/runtime_filter_bank.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/current_thread.h"
+#include "runtime/exec_env.h"
 #include "runtime/runtime_filter_worker.h"
 #include "simd/simd.h"
 #include "util/debug_util.h"
 #include "util/runtime_profile.h"
+#include "util/threadpool.h"
 
 namespace starrocks::vectorized {
 
@@ -74,6 +76,12 @@ Status HashJoiner::prepare_builder(RuntimeState* state, RuntimeProfile* runtime_
     _build_conjunct_evaluate_timer = ADD_TIMER(runtime_profile, "BuildConjunctEvaluateTime");
     _build_buckets_counter = ADD_COUNTER(runtime_profile, "BuildBuckets", TUnit::UNIT);
     _runtime_filter_num = ADD_COUNTER(runtime_profile, "RuntimeFilterNum", TUnit::UNIT);
+    if (_can_spill()) {
+        _spill_timer = ADD_TIMER(runtime_profile, "SpillTime");
+        _spill_count = ADD_COUNTER(runtime_profile, "SpillCount", TUnit::UNIT);
+        _spilled_build_rows = ADD_COUNTER(runtime_profile, "SpilledBuildRows", TUnit::UNIT);
+        _spilled_build_bytes = ADD_COUNTER(runtime_profile, "SpilledBuildBytes", TUnit::BYTES);
+    }
 
     HashTableParam param;
     _init_hash_table_param(&param);
@@ -102,6 +110,12 @@ Status HashJoiner::prepare_prober(RuntimeState* state, RuntimeProfile* runtime_p
     _probe_conjunct_evaluate_timer = ADD_TIMER(runtime_profile, "ProbeConjunctEvaluateTime");
     _other_join_conjunct_evaluate_timer = ADD_TIMER(runtime_profile, "OtherJoinConjunctEvaluateTime");
     _where_conjunct_evaluate_timer = ADD_TIMER(runtime_profile, "WhereConjunctEvaluateTime");
+    if (_is_buildable && _can_spill()) {
+        _spill_restore_timer = ADD_TIMER(runtime_profile, "SpillRestoreTime");
+        _spilled_probe_rows = ADD_COUNTER(runtime_profile, "SpilledProbeRows", TUnit::UNIT);
+        _spilled_probe_bytes = ADD_COUNTER(runtime_profile, "SpilledProbeBytes", TUnit::BYTES);
+        _spill_repartition_count = ADD_COUNTER(runtime_profile, "SpillRepartitionCount", TUnit::UNIT);
+    }
 
     return Status::OK();
 }
@@ -156,16 +170,29 @@ Status HashJoiner::append_chunk_to_ht(RuntimeState* state, const ChunkPtr& chunk
         SCOPED_TIMER(_build_conjunct_evaluate_timer);
         _prepare_key_columns(_key_columns, chunk, _build_expr_ctxs);
     }
+    if (_has_spilled()) {
+        RETURN_IF_ERROR(_add_spilled_runtime_filter_rows(_key_columns));
+        return _append_partitioned_build_chunk(state, chunk, _key_columns);
+    }
     {
         // copy chunk of right table
         SCOPED_TIMER(_copy_right_table_chunk_timer);
         TRY_CATCH_BAD_ALLOC(_ht.append_chunk(state, chunk, _key_columns));
     }
+    if (_can_spill() && need_spill(state, _ht.mem_usage())) {
+        RETURN_IF_ERROR(_spill_build_side(state));
+    }
     return Status::OK();
 }
 
 Status HashJoiner::build_ht(RuntimeState* state) {
     if (_phase == HashJoinPhase::BUILD) {
+        if (_has_spilled()) {
+            SCOPED_TIMER(_spill_timer);
+            RETURN_IF_ERROR(_build_spiller->finish());
+            COUNTER_SET(_spilled_build_rows, static_cast<int64_t>(_build_spiller->spilled_rows()));
+            COUNTER_SET(_spilled_build_bytes, static_cast<int64_t>(_build_spiller->spilled_bytes()));
+        }
         RETURN_IF_ERROR(_build(state));
         COUNTER_SET(_build_buckets_counter, static_cast<int64_t>(_ht.get_bucket_size()));
     }
@@ -190,20 +217,25 @@ bool HashJoiner::has_output() const {
 
     if (_phase == HashJoinPhase::POST_PROBE) {
         // Only RIGHT ANTI-JOIN, RIGHT OUTER-JOIN, FULL OUTER-JOIN has HashJoinPhase::POST_PROBE,
-        // in this phase, has_output() returns true until HashJoiner enters into HashJoinPhase::DONE.
-        return true;
+        // in this phase, has_output() returns true until HashJoiner enters into HashJoinPhase::DONE,
+        // except when the spilled partitions are being restored in the background.
+        return !_is_spill_io_running();
     }
 
     return false;
 }
 
-void HashJoiner::push_chunk(RuntimeState* state, ChunkPtr&& chunk) {
+Status HashJoiner::push_chunk(RuntimeState* state, ChunkPtr&& chunk) {
     DCHECK(chunk && !chunk->is_empty());
     DCHECK(!_probe_input_chunk);
 
     _probe_input_chunk = std::move(chunk);
     _ht_has_remain = true;
     _prepare_probe_key_columns();
+    if (_has_spilled()) {
+        RETURN_IF_ERROR(_spill_probe_input_chunk(state));
+    }
+    return Status::OK();
 }
 
 StatusOr<ChunkPtr> HashJoiner::pull_chunk(RuntimeState* state) {
@@ -216,6 +248,18 @@ StatusOr<ChunkPtr> HashJoiner::_pull_probe_output_chunk(RuntimeState* state) {
 
     auto chunk = std::make_shared<Chunk>();
 
+    if (_spill_io_done.valid()) {
+        // The spill io task has finished, the probe input or the remaining rows of the restored partition are
+        // output by the next pull_chunk.
+        DCHECK(!_is_spill_io_running());
+        _spill_io_done = {};
+        ASSIGN_OR_RETURN(bool has_more, std::move(_spill_io_result));
+        if (!has_more) {
+            enter_eos_phase();
+        }
+        return chunk;
+    }
+
     if (_phase == HashJoinPhase::PROBE || _probe_input_chunk != nullptr) {
         DCHECK(_ht_has_remain && _probe_input_chunk);
 
@@ -231,18 +275,24 @@ StatusOr<ChunkPtr> HashJoiner::_pull_probe_output_chunk(RuntimeState* state) {
     }
 
     if (_phase == HashJoinPhase::POST_PROBE) {
-        if (!_need_post_probe()) {
-            enter_eos_phase();
-            return chunk;
-        }
+        if (_need_post_probe() && !_post_probe_eos) {
+            TRY_CATCH_BAD_ALLOC(RETURN_IF_ERROR(_ht.probe_remain(state, &chunk, &_ht_has_remain)));
+            if (!_ht_has_remain) {
+                _post_probe_eos = true;
+            }
 
-        TRY_CATCH_BAD_ALLOC(RETURN_IF_ERROR(_ht.probe_remain(state, &chunk, &_ht_has_remain)));
-        if (!_ht_has_remain) {
-            enter_eos_phase();
-        }
+            RETURN_IF_ERROR(_filter_post_probe_output_chunk(chunk));
 
-        RETURN_IF_ERROR(_filter_post_probe_output_chunk(chunk));
+            if (!_post_probe_eos || _has_spilled()) {
+                return chunk;
+            }
+        }
 
+        if (_has_spilled()) {
+            _submit_spill_io_task(state);
+            return chunk;
+        }
+        enter_eos_phase();
         return chunk;
     }
 
@@ -250,7 +300,23 @@ StatusOr<ChunkPtr> HashJoiner::_pull_probe_output_chunk(RuntimeState* state) {
 }
 
 void HashJoiner::close(RuntimeState* state) {
+    // The spill io task may still be reading the spilled partitions into the hash table.
+    if (_spill_io_done.valid()) {
+        _spill_io_done.wait();
+    }
     _ht.close();
+    _restoring_partition.reset();
+    _spilled_partitions.clear();
+    _build_spiller.reset();
+    _probe_spiller.reset();
+}
+
+static uint64_t get_runtime_join_filter_pushdown_limit(RuntimeState* state) {
+    uint64_t runtime_join_filter_pushdown_limit = 1024000;
+    if (state->query_options().__isset.runtime_join_filter_pushdown_limit) {
+        runtime_join_filter_pushdown_limit = state->query_options().runtime_join_filter_pushdown_limit;
+    }
+    return runtime_join_filter_pushdown_limit;
 }
 
 Status HashJoiner::create_runtime_filters(RuntimeState* state) {
@@ -258,15 +324,12 @@ Status HashJoiner::create_runtime_filters(RuntimeState* state) {
         return Status::OK();
     }
 
-    uint64_t runtime_join_filter_pushdown_limit = 1024000;
-    if (state->query_options().__isset.runtime_join_filter_pushdown_limit) {
-        runtime_join_filter_pushdown_limit = state->query_options().runtime_join_filter_pushdown_limit;
-    }
+    uint64_t runtime_join_filter_pushdown_limit = get_runtime_join_filter_pushdown_limit(state);
 
     if (_is_push_down) {
         if (_probe_node_type == TPlanNodeType::EXCHANGE_NODE && _build_node_type == TPlanNodeType::EXCHANGE_NODE) {
             _is_push_down = false;
-        } else if (_ht.get_row_count() > runtime_join_filter_pushdown_limit) {
+        } else if (_build_row_count() > runtime_join_filter_pushdown_limit) {
             _is_push_down = false;
         }
 
@@ -319,6 +382,375 @@ Status HashJoiner::_build(RuntimeState* state) {
     return Status::OK();
 }
 
+bool HashJoiner::_can_spill() const {
+    // The hash table of broadcast join and partitioned build is shared by read-only probers, which can't see the
+    // spilled partitions, and NULL_AWARE_LEFT_ANTI_JOIN needs to know whether the whole build side contains null.
+    return _runtime_state != nullptr && _runtime_state->enable_spill() &&
+           _hash_join_node.distribution_mode != TJoinDistributionMode::BROADCAST && _read_only_join_probers.empty() &&
+           _join_type != TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN;
+}
+
+void HashJoiner::_reset_hash_table() {
+    HashTableParam param;
+    _init_hash_table_param(&param);
+    _ht.close();
+    _ht.create(param);
+}
+
+void HashJoiner::_split_by_spilled_partition(const ChunkPtr& chunk, const Columns& key_columns, ChunkPtr* resident,
+                                             ChunkPtr* spilled) {
+    size_t num_rows = chunk->num_rows();
+    PartitionedSpillWriter::compute_partition_index(key_columns, num_rows, kSpillPartitionBits, 0, &_partition_index);
+    std::vector<uint32_t> resident_rows;
+    std::vector<uint32_t> spilled_rows;
+    for (uint32_t i = 0; i < num_rows; i++) {
+        if (_partition_spilled[_partition_index[i]]) {
+            spilled_rows.push_back(i);
+        } else {
+            resident_rows.push_back(i);
+        }
+    }
+
+    auto select = [&chunk, num_rows](const std::vector<uint32_t>& rows) -> ChunkPtr {
+        if (rows.empty()) {
+            return nullptr;
+        }
+        if (rows.size() == num_rows) {
+            return chunk;
+        }
+        ChunkPtr part = chunk->clone_empty_with_tuple(rows.size());
+        part->append_selective(*chunk, rows.data(), 0, rows.size());
+        return part;
+    };
+    *resident = select(resident_rows);
+    *spilled = select(spilled_rows);
+}
+
+Status HashJoiner::_spill_build_side(RuntimeState* state) {
+    if (!_has_spilled()) {
+        _build_spiller = std::make_unique<PartitionedSpillWriter>(state, "hash-join-build", kSpillPartitionBits);
+        _partition_spilled.assign(_build_spiller->num_partitions(), true);
+        // Keep the first partition resident, so the probe rows of it are joined without spilling.
+        _partition_spilled[0] = false;
+        RETURN_IF_ERROR(_init_spilled_runtime_filters(state));
+    } else if (!_partition_spilled[0]) {
+        _partition_spilled[0] = true;
+    } else {
+        // All the partitions have been spilled.
+        return Status::OK();
+    }
+    COUNTER_UPDATE(_spill_count, 1);
+
+    // Move the rows in the hash table to the new hash table or the spilled partitions.
+    JoinHashTable ht = std::move(_ht);
+    _reset_hash_table();
+    const ChunkPtr& build_chunk = ht.get_build_chunk();
+    size_t num_rows = build_chunk->num_rows();
+    size_t chunk_size = state->chunk_size();
+    // Skip the reserved row of the hash table.
+    for (size_t offset = kHashJoinKeyColumnOffset; offset < num_rows; offset += chunk_size) {
+        size_t count = std::min(chunk_size, num_rows - offset);
+        ChunkPtr chunk = build_chunk->clone_empty_with_slot(count);
+        chunk->append(*build_chunk, offset, count);
+        Columns key_columns;
+        {
+            SCOPED_TIMER(_build_conjunct_evaluate_timer);
+            _prepare_key_columns(key_columns, chunk, _build_expr_ctxs);
+        }
+        RETURN_IF_ERROR(_append_partitioned_build_chunk(state, chunk, std::move(key_columns)));
+    }
+    ht.close();
+    return Status::OK();
+}
+
+Status HashJoiner::_init_spilled_runtime_filters(RuntimeState* state) {
+    SCOPED_TIMER(_build_runtime_filter_timer);
+    // Every spilled build side sizes the filters by the pushdown limit, so PartialRuntimeFilterMerger can merge
+    // the filters of the same size.
+    size_t filter_size = std::max<uint64_t>(get_runtime_join_filter_pushdown_limit(state), 1);
+    _spilled_runtime_bloom_filters.clear();
+    for (auto* rf_desc : _build_runtime_filters) {
+        JoinRuntimeFilter* filter = nullptr;
+        if (rf_desc->has_consumer()) {
+            filter = RuntimeFilterHelper::create_runtime_bloom_filter(_pool, rf_desc->build_expr_type());
+        }
+        if (filter != nullptr) {
+            size_t num_buckets = rf_desc->num_buckets();
+            if (num_buckets > 0) {
+                size_t bucket_size = std::max<size_t>(filter_size / num_buckets, 1);
+                filter->init_by_bucket(std::vector<size_t>(num_buckets, bucket_size));
+            } else {
+                filter->init(filter_size);
+            }
+            filter->set_join_mode(rf_desc->join_mode());
+        }
+        _spilled_runtime_bloom_filters.emplace_back(filter);
+    }
+
+    // The rows in the hash table so far, and the rows appended later are added by _add_spilled_runtime_filter_rows.
+    const Columns& key_columns = _ht.get_key_columns();
+    if (_ht.get_row_count() <= kMaxRuntimeInFilterRows) {
+        for (const auto& column : key_columns) {
+            _spilled_in_filter_key_columns.emplace_back(column->clone_shared());
+        }
+    }
+    return _insert_into_spilled_runtime_bloom_filters(key_columns, kHashJoinKeyColumnOffset);
+}
+
+Status HashJoiner::_add_spilled_runtime_filter_rows(const Columns& key_columns) {
+    SCOPED_TIMER(_build_runtime_filter_timer);
+    if (!_spilled_in_filter_key_columns.empty()) {
+        size_t num_rows = key_columns.empty() ? 0 : key_columns[0]->size();
+        if (_build_row_count() + num_rows > kMaxRuntimeInFilterRows) {
+            _spilled_in_filter_key_columns.clear();
+        } else {
+            for (size_t i = 0; i < key_columns.size(); i++) {
+                ColumnPtr& column = _spilled_in_filter_key_columns[i];
+                if (!column->is_nullable() && key_columns[i]->is_nullable()) {
+                    column = NullableColumn::create(column, NullColumn::create(column->size(), 0));
+                }
+                column->append(*key_columns[i]);
+            }
+        }
+    }
+    return _insert_into_spilled_runtime_bloom_filters(key_columns, 0);
+}
+
+Status HashJoiner::_insert_into_spilled_runtime_bloom_filters(const Columns& key_columns, size_t offset) {
+    for (size_t i = 0; i < _build_runtime_filters.size(); i++) {
+        JoinRuntimeFilter* filter = _spilled_runtime_bloom_filters[i];
+        if (filter == nullptr) {
+            continue;
+        }
+        auto* rf_desc = _build_runtime_filters[i];
+        int expr_order = rf_desc->build_expr_order();
+        RETURN_IF_ERROR(RuntimeFilterHelper::insert_into_runtime_bloom_filter(
+                key_columns[expr_order], rf_desc->build_expr_type(), filter, offset, _is_null_safes[expr_order],
+                rf_desc->num_buckets()));
+    }
+    return Status::OK();
+}
+
+Status HashJoiner::_append_partitioned_build_chunk(RuntimeState* state, const ChunkPtr& chunk, Columns key_columns) {
+    ChunkPtr resident;
+    ChunkPtr spilled;
+    _split_by_spilled_partition(chunk, key_columns, &resident, &spilled);
+
+    if (spilled != nullptr) {
+        SCOPED_TIMER(_spill_timer);
+        if (spilled != chunk) {
+            _prepare_key_columns(key_columns, spilled, _build_expr_ctxs);
+        }
+        RETURN_IF_ERROR(_build_spiller->append(*spilled, key_columns));
+    }
+
+    if (resident != nullptr) {
+        if (resident != chunk) {
+            SCOPED_TIMER(_build_conjunct_evaluate_timer);
+            _prepare_key_columns(key_columns, resident, _build_expr_ctxs);
+        }
+        {
+            SCOPED_TIMER(_copy_right_table_chunk_timer);
+            TRY_CATCH_BAD_ALLOC(_ht.append_chunk(state, resident, key_columns));
+        }
+        if (need_spill(state, _ht.mem_usage())) {
+            RETURN_IF_ERROR(_spill_build_side(state));
+        }
+    }
+    return Status::OK();
+}
+
+Status HashJoiner::_spill_probe_input_chunk(RuntimeState* state) {
+    ChunkPtr resident;
+    ChunkPtr spilled;
+    _split_by_spilled_partition(_probe_input_chunk, _key_columns, &resident, &spilled);
+    if (spilled == nullptr) {
+        return Status::OK();
+    }
+
+    if (_probe_spiller == nullptr) {
+        _probe_spiller = std::make_unique<PartitionedSpillWriter>(state, "hash-join-probe", kSpillPartitionBits);
+    }
+    if (spilled == _probe_input_chunk) {
+        RETURN_IF_ERROR(_probe_spiller->append(*spilled, _key_columns));
+    } else {
+        Columns key_columns;
+        _prepare_key_columns(key_columns, spilled, _probe_expr_ctxs);
+        RETURN_IF_ERROR(_probe_spiller->append(*spilled, key_columns));
+    }
+
+    _probe_input_chunk = std::move(resident);
+    if (_probe_input_chunk == nullptr) {
+        _ht_has_remain = false;
+    } else {
+        _prepare_probe_key_columns();
+    }
+    return Status::OK();
+}
+
+void HashJoiner::_submit_spill_io_task(RuntimeState* state) {
+    DCHECK(!_spill_io_done.valid());
+    // Kept if the task is dropped by the pool, whose promise is broken then.
+    _spill_io_result = Status::Cancelled("spill io task is dropped");
+    auto promise = std::make_shared<std::promise<void>>();
+    _spill_io_done = promise->get_future();
+    auto task = [this, state, promise]() {
+        SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(state->instance_mem_tracker());
+        _spill_io_result = _next_spilled_probe_input(state);
+        promise->set_value();
+    };
+    ThreadPool* pool = ExecEnv::GetInstance()->spill_io_pool();
+    if (pool == nullptr || !pool->submit_func(task).ok()) {
+        task();
+    }
+}
+
+StatusOr<bool> HashJoiner::_next_spilled_probe_input(RuntimeState* state) {
+    SCOPED_TIMER(_spill_restore_timer);
+    if (_build_spiller != nullptr) {
+        // The in-memory hash table has been probed, collect the spilled partition pairs.
+        if (_probe_spiller != nullptr) {
+            RETURN_IF_ERROR(_probe_spiller->finish());
+            COUNTER_SET(_spilled_probe_rows, static_cast<int64_t>(_probe_spiller->spilled_rows()));
+            COUNTER_SET(_spilled_probe_bytes, static_cast<int64_t>(_probe_spiller->spilled_bytes()));
+        }
+        for (size_t i = 0; i < _partition_spilled.size(); i++) {
+            if (!_partition_spilled[i]) {
+                continue;
+            }
+            SpilledPartition partition;
+            partition.build = std::move(_build_spiller->partition(i));
+            if (_probe_spiller != nullptr) {
+                partition.probe = std::move(_probe_spiller->partition(i));
+            }
+            _spilled_partitions.emplace_back(std::move(partition));
+        }
+        _build_spiller.reset();
+        _probe_spiller.reset();
+    }
+
+    while (true) {
+        if (_restoring_partition != nullptr) {
+            if (_restoring_partition->probe != nullptr) {
+                auto chunk_or = _restoring_partition->probe->read_next();
+                if (chunk_or.ok()) {
+                    _probe_input_chunk = std::move(chunk_or.value());
+                    _ht_has_remain = true;
+                    _prepare_probe_key_columns();
+                    return true;
+                }
+                if (!chunk_or.status().is_end_of_file()) {
+                    return chunk_or.status();
+                }
+            }
+            // All the probe rows of this partition have been joined, output the remaining rows of hash table.
+            _restoring_partition.reset();
+            if (_need_post_probe()) {
+                _post_probe_eos = false;
+                return true;
+            }
+        }
+
+        if (_spilled_partitions.empty()) {
+            return false;
+        }
+        SpilledPartition partition = std::move(_spilled_partitions.back());
+        _spilled_partitions.pop_back();
+        RETURN_IF_ERROR(_restore_build_partition(state, std::move(partition)));
+    }
+}
+
+Status HashJoiner::_restore_build_partition(RuntimeState* state, SpilledPartition&& partition) {
+    // Skip the partitions which can't produce any output.
+    if (partition.probe == nullptr && !_need_post_probe()) {
+        return Status::OK();
+    }
+    if (partition.build == nullptr &&
+        (_join_type == TJoinOp::INNER_JOIN || _join_type == TJoinOp::LEFT_SEMI_JOIN ||
+         _join_type == TJoinOp::RIGHT_SEMI_JOIN || _join_type == TJoinOp::RIGHT_ANTI_JOIN ||
+         _join_type == TJoinOp::RIGHT_OUTER_JOIN)) {
+        return Status::OK();
+    }
+
+    _reset_hash_table();
+    if (partition.build != nullptr) {
+        Columns key_columns;
+        while (true) {
+            auto chunk_or = partition.build->read_next();
+            if (chunk_or.status().is_end_of_file()) {
+                break;
+            }
+            RETURN_IF_ERROR(chunk_or.status());
+            ChunkPtr chunk = std::move(chunk_or.value());
+            if (UNLIKELY(_ht.get_row_count() + chunk->num_rows() >= UINT32_MAX)) {
+                return Status::NotSupported(
+                        strings::Substitute("row count of right table in hash join > $0", UINT32_MAX));
+            }
+            _prepare_key_columns(key_columns, chunk, _build_expr_ctxs);
+            TRY_CATCH_BAD_ALLOC(_ht.append_chunk(state, chunk, key_columns));
+
+            if (partition.level + 1 < kMaxSpillLevel && need_spill(state, _ht.mem_usage())) {
+                // The partition is still too large, partition it again by other bits of the hash value.
+                _reset_hash_table();
+                return _repartition(state, std::move(partition));
+            }
+        }
+    }
+    TRY_CATCH_BAD_ALLOC(RETURN_IF_ERROR(_ht.build(state)));
+    _restoring_partition = std::make_unique<SpilledPartition>(std::move(partition));
+    return Status::OK();
+}
+
+Status HashJoiner::_repartition(RuntimeState* state, SpilledPartition&& partition) {
+    COUNTER_UPDATE(_spill_repartition_count, 1);
+    int level = partition.level + 1;
+    auto repartition = [this](SpillFile* file, const std::vector<ExprContext*>& expr_ctxs,
+                              PartitionedSpillWriter* writer) -> Status {
+        if (file == nullptr) {
+            return Status::OK();
+        }
+        file->rewind();
+        Columns key_columns;
+        while (true) {
+            auto chunk_or = file->read_next();
+            if (chunk_or.status().is_end_of_file()) {
+                break;
+            }
+            RETURN_IF_ERROR(chunk_or.status());
+            ChunkPtr chunk = std::move(chunk_or.value());
+            _prepare_key_columns(key_columns, chunk, expr_ctxs);
+            RETURN_IF_ERROR(writer->append(*chunk, key_columns));
+        }
+        return writer->finish();
+    };
+
+    PartitionedSpillWriter build_writer(state, "hash-join-build", kSpillPartitionBits, level);
+    PartitionedSpillWriter probe_writer(state, "hash-join-probe", kSpillPartitionBits, level);
+    RETURN_IF_ERROR(repartition(partition.build.get(), _build_expr_ctxs, &build_writer));
+    RETURN_IF_ERROR(repartition(partition.probe.get(), _probe_expr_ctxs, &probe_writer));
+    // Release the disk space of the parent partition as soon as possible.
+    partition.build.reset();
+    partition.probe.reset();
+
+    size_t num_build_partitions = 0;
+    for (size_t i = 0; i < build_writer.num_partitions(); i++) {
+        num_build_partitions += build_writer.partition(i) != nullptr;
+    }
+    for (size_t i = 0; i < build_writer.num_partitions(); i++) {
+        SpilledPartition child;
+        child.build = std::move(build_writer.partition(i));
+        child.probe = std::move(probe_writer.partition(i));
+        if (child.build == nullptr && child.probe == nullptr) {
+            continue;
+        }
+        // If all the build rows fall into one partition, e.g. they have the same join key, partitioning
+        // them again is useless.
+        child.level = num_build_partitions > 1 ? level : kMaxSpillLevel;
+        _spilled_partitions.emplace_back(std::move(child));
+    }
+    return Status::OK();
+}
+
 Status HashJoiner::_calc_filter_for_other_conjunct(ChunkPtr* chunk, Column::Filter& filter, bool& filter_all,
                                                    bool& hit_all) {
     filter_all = false;
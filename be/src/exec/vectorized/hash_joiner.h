@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <future>
+
 #include "column/chunk.h"
 #include "column/fixed_length_column.h"
 #include "common/statusor.h"
@@ -10,6 +12,7 @@
 #include "exec/pipeline/runtime_filter_types.h"
 #include "exec/vectorized/hash_join_node.h"
 #include "exec/vectorized/join_hash_map.h"
+#include "exec/vectorized/spill/spill_file.h"
 #include "exprs/vectorized/in_const_predicate.hpp"
 #include "util/phmap/phmap.h"
 
@@ -37,6 +40,12 @@ using HashJoinerPtr = std::shared_ptr<HashJoiner>;
 //   processed.
 // 4.DONE: all input streams have been processed.
 //
+// Grace hash join: when spilling is enabled and the memory of the query is tight, the build side is partitioned by
+// the hash of join keys. Partition 0 stays resident in the hash table and other partitions are spilled to local disk,
+// and partition 0 is spilled too if the memory is still tight. In PROBE phase, probe rows that belong to spilled
+// partitions are spilled in the same way. After the in-memory hash table is probed, the spilled partition pairs are
+// joined one by one in POST_PROBE phase, and a partition which is still too large is partitioned again recursively.
+//
 enum HashJoinPhase {
     BUILD = 0,
     PROBE = 1,
@@ -117,6 +126,8 @@ public:
     bool has_output() const;
     bool is_build_done() const { return _phase != HashJoinPhase::BUILD; }
     bool is_done() const { return _phase == HashJoinPhase::EOS; }
+    // Whether the probe chunk pushed by push_chunk has not been fully probed.
+    bool has_probe_input() const { return _probe_input_chunk != nullptr; }
 
     void enter_probe_phase() {
         _short_circuit_break();
@@ -137,7 +148,7 @@ public:
     Status append_chunk_to_ht(RuntimeState* state, const ChunkPtr& chunk);
     Status build_ht(RuntimeState* state);
     // probe phase
-    void push_chunk(RuntimeState* state, ChunkPtr&& chunk);
+    Status push_chunk(RuntimeState* state, ChunkPtr&& chunk);
     StatusOr<ChunkPtr> pull_chunk(RuntimeState* state);
 
     pipeline::RuntimeInFilters& get_runtime_in_filters() { return _runtime_in_filters; }
@@ -145,7 +156,8 @@ public:
     pipeline::OptRuntimeBloomFilterBuildParams& get_runtime_bloom_filter_build_params() {
         return _runtime_bloom_filter_build_params;
     }
-    size_t get_ht_row_count() { return _ht.get_row_count(); }
+    // Row count of the whole build side, including spilled rows.
+    size_t get_ht_row_count() { return _build_row_count(); }
 
     Status create_runtime_filters(RuntimeState* state);
 
@@ -198,7 +210,7 @@ private:
         }
 
         // special cases of short-circuit break.
-        if (_ht.get_row_count() == 0 &&
+        if (_build_row_count() == 0 &&
             (_join_type == TJoinOp::INNER_JOIN || _join_type == TJoinOp::LEFT_SEMI_JOIN ||
              _join_type == TJoinOp::RIGHT_SEMI_JOIN || _join_type == TJoinOp::RIGHT_ANTI_JOIN ||
              _join_type == TJoinOp::RIGHT_OUTER_JOIN)) {
@@ -267,11 +279,14 @@ private:
     Status _create_runtime_in_filters(RuntimeState* state) {
         SCOPED_TIMER(_build_runtime_filter_timer);
 
-        if (_ht.get_row_count() > 1024) {
+        if (_build_row_count() > kMaxRuntimeInFilterRows) {
             return Status::OK();
         }
 
-        if (_ht.get_row_count() > 0) {
+        if (_build_row_count() > 0) {
+            // The hash table only contains the resident partitions once the build side has spilled.
+            const Columns& key_columns = _has_spilled() ? _spilled_in_filter_key_columns : _ht.get_key_columns();
+            DCHECK_EQ(key_columns.size(), _build_expr_ctxs.size());
             // there is a bug (DSDB-3860) in old planner if probe_expr is not slot-ref, and this fix is workaround.
             size_t size = _build_expr_ctxs.size();
             std::vector<bool> to_build(size, true);
@@ -282,7 +297,7 @@ private:
 
             for (size_t i = 0; i < size; i++) {
                 if (!to_build[i]) continue;
-                ColumnPtr column = _ht.get_key_columns()[i];
+                ColumnPtr column = key_columns[i];
                 Expr* probe_expr = _probe_expr_ctxs[i]->root();
                 // create and fill runtime in filter.
                 VectorizedInConstPredicateBuilder builder(state, _pool, probe_expr);
@@ -306,26 +321,77 @@ private:
     }
 
     Status _create_runtime_bloom_filters(RuntimeState* state, int64_t limit) {
-        for (auto* rf_desc : _build_runtime_filters) {
+        for (size_t i = 0; i < _build_runtime_filters.size(); i++) {
+            auto* rf_desc = _build_runtime_filters[i];
             rf_desc->set_is_pipeline(true);
             // skip if it does not have consumer.
             if (!rf_desc->has_consumer()) {
                 _runtime_bloom_filter_build_params.emplace_back();
                 continue;
             }
-            if (!rf_desc->has_remote_targets() && _ht.get_row_count() > limit) {
+            if (!rf_desc->has_remote_targets() && _build_row_count() > limit) {
                 _runtime_bloom_filter_build_params.emplace_back();
                 continue;
             }
-
             int expr_order = rf_desc->build_expr_order();
-            ColumnPtr column = _ht.get_key_columns()[expr_order];
             bool eq_null = _is_null_safes[expr_order];
+            // The hash table only contains the resident partitions once the build side has spilled, so the filter
+            // built from all the build rows before they were partitioned is used instead.
+            if (_has_spilled()) {
+                JoinRuntimeFilter* filter = _spilled_runtime_bloom_filters[i];
+                if (filter == nullptr) {
+                    _runtime_bloom_filter_build_params.emplace_back();
+                } else {
+                    _runtime_bloom_filter_build_params.emplace_back(
+                            pipeline::RuntimeBloomFilterBuildParam(eq_null, filter));
+                }
+                continue;
+            }
+
+            ColumnPtr column = _ht.get_key_columns()[expr_order];
             _runtime_bloom_filter_build_params.emplace_back(pipeline::RuntimeBloomFilterBuildParam(eq_null, column));
         }
         return Status::OK();
     }
 
+    // Grace hash join.
+    struct SpilledPartition {
+        SpillFilePtr build;
+        SpillFilePtr probe;
+        int level = 0;
+    };
+
+    bool _can_spill() const;
+    bool _has_spilled() const { return !_partition_spilled.empty(); }
+    size_t _build_row_count() const {
+        return _ht.get_row_count() + (_build_spiller != nullptr ? _build_spiller->spilled_rows() : 0);
+    }
+    void _reset_hash_table();
+
+    // Split |chunk| into the rows of resident partitions and the rows of spilled partitions, either of them
+    // is nullptr if it has no rows.
+    void _split_by_spilled_partition(const ChunkPtr& chunk, const Columns& key_columns, ChunkPtr* resident,
+                                     ChunkPtr* spilled);
+    Status _spill_build_side(RuntimeState* state);
+    // |key_columns| are the build keys of |chunk|.
+    Status _append_partitioned_build_chunk(RuntimeState* state, const ChunkPtr& chunk, Columns key_columns);
+    // Start building the runtime filters from all the build rows when the build side spills for the first time,
+    // since the hash table only keeps the resident partitions afterwards.
+    Status _init_spilled_runtime_filters(RuntimeState* state);
+    // Add the build rows whose keys are |key_columns| to the runtime filters once the build side has spilled.
+    Status _add_spilled_runtime_filter_rows(const Columns& key_columns);
+    Status _insert_into_spilled_runtime_bloom_filters(const Columns& key_columns, size_t offset);
+    Status _spill_probe_input_chunk(RuntimeState* state);
+    // Prepare the next probe input from the spilled partitions, return false if all of them have been processed.
+    StatusOr<bool> _next_spilled_probe_input(RuntimeState* state);
+    // Run _next_spilled_probe_input on the spill io pool, the driver is blocked by has_output() until it finishes.
+    void _submit_spill_io_task(RuntimeState* state);
+    bool _is_spill_io_running() const {
+        return _spill_io_done.valid() && _spill_io_done.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+    }
+    Status _restore_build_partition(RuntimeState* state, SpilledPartition&& partition);
+    Status _repartition(RuntimeState* state, SpilledPartition&& partition);
+
 private:
     const THashJoinNode& _hash_join_node;
     ObjectPool* _pool;
@@ -378,6 +444,32 @@ private:
 
     const bool _is_buildable;
 
+    // Runtime in-filters are only built for the build sides with at most so many rows.
+    static constexpr size_t kMaxRuntimeInFilterRows = 1024;
+    // The number of partitions of grace hash join is 2^kSpillPartitionBits.
+    static constexpr int kSpillPartitionBits = 3;
+    static constexpr int kMaxSpillLevel = 32 / kSpillPartitionBits;
+    std::unique_ptr<PartitionedSpillWriter> _build_spiller;
+    std::unique_ptr<PartitionedSpillWriter> _probe_spiller;
+    // Whether the i-th partition is spilled, empty if nothing has been spilled.
+    std::vector<bool> _partition_spilled;
+    std::vector<uint32_t> _partition_index;
+    // Spilled partition pairs waiting to be joined.
+    std::vector<SpilledPartition> _spilled_partitions;
+    // The runtime bloom filters built from all the build rows once the build side has spilled, in the order of
+    // _build_runtime_filters, nullptr if the filter has no consumer.
+    std::vector<JoinRuntimeFilter*> _spilled_runtime_bloom_filters;
+    // The keys of all the build rows, with the reserved row of the hash table, to build the runtime in-filters
+    // once the build side has spilled. They are cleared when the build side has too many rows for in-filters.
+    Columns _spilled_in_filter_key_columns;
+    // The partition pair whose build side is in the hash table now.
+    std::unique_ptr<SpilledPartition> _restoring_partition;
+    // Whether the remaining rows of the current hash table have been output in POST_PROBE phase.
+    bool _post_probe_eos = false;
+    // The pending spill io task and its result, which is valid once the future is ready.
+    std::future<void> _spill_io_done;
+    StatusOr<bool> _spill_io_result;
+
     // These two fields are used only by the hash join builder.
     const std::vector<HashJoinerPtr>& _read_only_join_probers;
     std::atomic<size_t> _num_unfinished_probers = 0;
@@ -389,6 +481,10 @@ private:
     RuntimeProfile::Counter* _output_build_column_timer = nullptr;
     RuntimeProfile::Counter* _build_buckets_counter = nullptr;
     RuntimeProfile::Counter* _runtime_filter_num = nullptr;
+    RuntimeProfile::Counter* _spill_timer = nullptr;
+    RuntimeProfile::Counter* _spill_count = nullptr;
+    RuntimeProfile::Counter* _spilled_build_rows = nullptr;
+    RuntimeProfile::Counter* _spilled_build_bytes = nullptr;
 
     // Profile for hash join prober.
     RuntimeProfile::Counter* _search_ht_timer = nullptr;
@@ -398,6 +494,10 @@ private:
     RuntimeProfile::Counter* _probe_conjunct_evaluate_timer = nullptr;
     RuntimeProfile::Counter* _other_join_conjunct_evaluate_timer = nullptr;
     RuntimeProfile::Counter* _where_conjunct_evaluate_timer = nullptr;
+    RuntimeProfile::Counter* _spill_restore_timer = nullptr;
+    RuntimeProfile::Counter* _spilled_probe_rows = nullptr;
+    RuntimeProfile::Counter* _spilled_probe_bytes = nullptr;
+    RuntimeProfile::Counter* _spill_repartition_count = nullptr;
 };
 
 } // namespace vectorized
@@ -3,12 +3,15 @@
 #include "exec/vectorized/hdfs_scanner.h"
 
 #include <boost/algorithm/string.hpp>
+#include <mutex>
 
 #include "column/column_helper.h"
 #include "exec/exec_node.h"
 
 namespace starrocks::vectorized {
 
+// Counts the io of a scanner. Shared buffers may be prefetched by `pread_fully()` in background
+// threads, so the statistics are updated under a lock.
 class CountedSeekableInputStream : public io::SeekableInputStreamWrapper {
 public:
     explicit CountedSeekableInputStream(std::shared_ptr<io::SeekableInputStream> stream,
@@ -18,32 +21,48 @@ public:
     ~CountedSeekableInputStream() override = default;
 
     StatusOr<int64_t> read(void* data, int64_t size) override {
-        SCOPED_RAW_TIMER(&_stats->io_ns);
-        _stats->io_count += 1;
+        MonotonicStopWatch watch;
+        watch.start();
         ASSIGN_OR_RETURN(auto nread, _stream->read(data, size));
-        _stats->bytes_read += nread;
+        _update_stats(watch.elapsed_time(), nread);
         return nread;
     }
 
     StatusOr<int64_t> read_at(int64_t offset, void* data, int64_t size) override {
-        SCOPED_RAW_TIMER(&_stats->io_ns);
-        _stats->io_count += 1;
+        MonotonicStopWatch watch;
+        watch.start();
         ASSIGN_OR_RETURN(auto nread, _stream->read_at(offset, data, size));
-        _stats->bytes_read += nread;
+        _update_stats(watch.elapsed_time(), nread);
         return nread;
     }
 
     Status read_at_fully(int64_t offset, void* data, int64_t size) override {
-        SCOPED_RAW_TIMER(&_stats->io_ns);
-        _stats->io_count += 1;
+        MonotonicStopWatch watch;
+        watch.start();
         RETURN_IF_ERROR(_stream->read_at_fully(offset, data, size));
-        _stats->bytes_read += size;
+        _update_stats(watch.elapsed_time(), size);
+        return Status::OK();
+    }
+
+    Status pread_fully(int64_t offset, void* data, int64_t size) override {
+        MonotonicStopWatch watch;
+        watch.start();
+        RETURN_IF_ERROR(_stream->pread_fully(offset, data, size));
+        _update_stats(watch.elapsed_time(), size);
         return Status::OK();
     }
 
 private:
+    void _update_stats(int64_t io_ns, int64_t bytes) {
+        std::lock_guard l(_mutex);
+        _stats->io_ns += io_ns;
+        _stats->io_count += 1;
+        _stats->bytes_read += bytes;
+    }
+
     std::shared_ptr<io::SeekableInputStream> _stream;
     vectorized::HdfsScanStats* _stats;
+    std::mutex _mutex;
 };
 
 Status HdfsScanner::init(RuntimeState* runtime_state, const HdfsScannerParams& scanner_params) {
@@ -157,8 +176,9 @@ void HdfsScanner::close(RuntimeState* runtime_state) noexcept {
     DCHECK(!has_pending_token());
     bool expect = false;
     if (!_closed.compare_exchange_strong(expect, true)) return;
-    update_counter();
+    // Close the reader first, which waits for the in-flight prefetching io, so all io is counted.
     do_close(runtime_state);
+    update_counter();
     _file.reset(nullptr);
     _raw_file.reset(nullptr);
     if (_opened && _scanner_params.open_limit != nullptr) {
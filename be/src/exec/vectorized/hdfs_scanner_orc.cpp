@@ -8,6 +8,7 @@
 #include "formats/orc/orc_chunk_reader.h"
 #include "fs/fs.h"
 #include "gen_cpp/orc_proto.pb.h"
+#include "runtime/exec_env.h"
 #include "storage/chunk_helper.h"
 #include "util/buffered_stream.h"
 #include "util/runtime_profile.h"
@@ -23,6 +24,8 @@ public:
                 .max_dist_size = config::io_coalesce_read_max_distance_size,
                 .max_buffer_size = config::io_coalesce_read_max_buffer_size};
         _buffer_stream.set_coalesce_options(options);
+        _buffer_stream.set_prefetch_options(ExecEnv::GetInstance()->io_prefetch_pool(),
+                                            config::io_prefetch_max_buffer_size);
     }
 
     ~ORCHdfsFileStream() override = default;
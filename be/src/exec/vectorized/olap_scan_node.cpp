@@ -379,6 +379,15 @@ StatusOr<pipeline::MorselQueuePtr> OlapScanNode::convert_scan_range_to_morsel_qu
     return std::make_unique<pipeline::LogicalSplitMorselQueue>(std::move(morsels), scan_dop, splitted_scan_rows);
 }
 
+StatusOr<int64_t> OlapScanNode::estimated_scan_rows(const std::vector<TScanRangeParams>& scan_ranges) const {
+    int64_t num_rows = 0;
+    for (const auto& tablet_scan_range : scan_ranges) {
+        ASSIGN_OR_RETURN(TabletSharedPtr tablet, get_tablet(&(tablet_scan_range.scan_range.internal_scan_range)));
+        num_rows += static_cast<int64_t>(tablet->num_rows());
+    }
+    return num_rows;
+}
+
 StatusOr<bool> OlapScanNode::_could_tablet_internal_parallel(const std::vector<TScanRangeParams>& scan_ranges,
                                                              int32_t pipeline_dop, size_t num_total_scan_ranges,
                                                              int64_t* scan_dop, int64_t* splitted_scan_rows) const {
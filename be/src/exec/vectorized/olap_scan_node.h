@@ -76,6 +76,8 @@ public:
 
     int estimated_max_concurrent_chunks() const;
 
+    StatusOr<int64_t> estimated_scan_rows(const std::vector<TScanRangeParams>& scan_ranges) const override;
+
     static StatusOr<TabletSharedPtr> get_tablet(const TInternalScanRange* scan_range);
     static int compute_priority(int32_t num_submitted_tasks);
 
@@ -2,12 +2,14 @@
 
 #include "exec/vectorized/olap_scan_prepare.h"
 
+#include <algorithm>
 #include <variant>
 
 #include "column/type_traits.h"
 #include "exprs/expr_context.h"
 #include "exprs/vectorized/dictmapping_expr.h"
 #include "exprs/vectorized/in_const_predicate.hpp"
+#include "exprs/vectorized/runtime_filter_bank.h"
 #include "gutil/map_util.h"
 #include "runtime/descriptors.h"
 #include "runtime/primitive_type.h"
@@ -384,6 +386,7 @@ void OlapScanConjunctsManager::normalize_join_runtime_filter(const SlotDescripto
         if (!desc->is_probe_slot_ref(&slot_id) || slot_id != slot.id()) continue;
 
         const RuntimeBloomFilter<SlotType>* filter = down_cast<const RuntimeBloomFilter<SlotType>*>(rf);
+        normalized_runtime_filters.insert(desc->filter_id());
         // If this column doesn't have other filter, we use join runtime filter
         // to fast comput row range in storage engine
         if (range->is_init_state()) {
@@ -734,5 +737,74 @@ Status OlapScanConjunctsManager::parse_conjuncts(bool scan_keys_unlimited, int32
     return Status::OK();
 }
 
+RuntimeFilterRangePruner::RuntimeFilterRangePruner(const OlapScanConjunctsManager& cm,
+                                                   const TabletSchema& tablet_schema)
+        : _tuple_desc(cm.tuple_desc),
+          _key_column_names(cm.key_column_names),
+          _runtime_state(cm.runtime_state),
+          _tablet_schema(tablet_schema) {
+    if (cm.runtime_filters == nullptr) {
+        return;
+    }
+    const auto& normalized_filters = cm.get_normalized_runtime_filters();
+    for (const auto& it : cm.runtime_filters->descriptors()) {
+        RuntimeFilterProbeDescriptor* desc = it.second;
+        SlotId slot_id;
+        // Only the filters on columns could be translated into storage predicates.
+        if (normalized_filters.count(desc->filter_id()) > 0 || !desc->is_probe_slot_ref(&slot_id)) {
+            continue;
+        }
+        _pending_filters.push_back(desc);
+    }
+}
+
+RuntimeFilterRangePruner::~RuntimeFilterRangePruner() = default;
+
+StatusOr<const RuntimeRangePruner::PredicatesMap*> RuntimeFilterRangePruner::arrived_predicates() {
+    if (_always_false) {
+        return Status::EndOfFile("EOF, Filter by always false runtime filter");
+    }
+
+    RuntimeFilterProbeCollector arrived_filters;
+    auto iter = std::remove_if(_pending_filters.begin(), _pending_filters.end(), [&](auto* desc) {
+        if (desc->runtime_filter() == nullptr) {
+            return false;
+        }
+        arrived_filters.add_descriptor(desc);
+        return true;
+    });
+    _pending_filters.erase(iter, _pending_filters.end());
+    if (arrived_filters.descriptors().empty()) {
+        return &_predicates_map;
+    }
+
+    // Reuse the normalization of the conjuncts, with only the arrived runtime filters.
+    std::vector<ExprContext*> conjunct_ctxs;
+    OlapScanConjunctsManager cm;
+    cm.conjunct_ctxs_ptr = &conjunct_ctxs;
+    cm.tuple_desc = _tuple_desc;
+    cm.obj_pool = &_obj_pool;
+    cm.key_column_names = _key_column_names;
+    cm.runtime_filters = &arrived_filters;
+    cm.runtime_state = _runtime_state;
+    Status status = cm.parse_conjuncts(true, 1);
+    if (status.is_end_of_file()) {
+        _always_false = true;
+        return status;
+    }
+    RETURN_IF_ERROR(status);
+
+    PredicateParser parser(_tablet_schema);
+    std::vector<std::unique_ptr<ColumnPredicate>> preds;
+    RETURN_IF_ERROR(cm.get_column_predicates(&parser, &preds));
+    for (auto& p : preds) {
+        if (parser.can_pushdown(p.get())) {
+            _predicates_map[p->column_id()].push_back(p.get());
+        }
+        _predicates.emplace_back(std::move(p));
+    }
+    return &_predicates_map;
+}
+
 } // namespace vectorized
 } // namespace starrocks
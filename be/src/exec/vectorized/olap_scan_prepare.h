@@ -6,12 +6,15 @@
 #include "exec/olap_common.h"
 #include "exprs/expr.h"
 #include "exprs/expr_context.h"
+#include "storage/runtime_range_pruner.h"
 
 namespace starrocks {
 class RuntimeState;
+class TabletSchema;
 namespace vectorized {
 
 class RuntimeFilterProbeCollector;
+class RuntimeFilterProbeDescriptor;
 class PredicateParser;
 class ColumnPredicate;
 
@@ -34,6 +37,7 @@ private:
     std::vector<TCondition> olap_filters;                             // from _column_value_ranges
     std::vector<TCondition> is_null_vector;                           // from conjunct_ctxs
     std::map<int, std::vector<ExprContext*>> slot_index_to_expr_ctxs; // from conjunct_ctxs
+    std::set<int32_t> normalized_runtime_filters;                     // from runtime_filters
 
 public:
     static Status eval_const_conjuncts(const std::vector<ExprContext*>& conjunct_ctxs, Status* status);
@@ -44,6 +48,9 @@ public:
 
     void get_not_push_down_conjuncts(std::vector<ExprContext*>* predicates);
 
+    // Ids of the runtime bloom filters which have been translated into value ranges.
+    const std::set<int32_t>& get_normalized_runtime_filters() const { return normalized_runtime_filters; }
+
     Status parse_conjuncts(bool scan_keys_unlimited, int32_t max_scan_key_num,
                            bool enable_column_expr_predicate = false);
 
@@ -78,5 +85,30 @@ private:
     void build_column_expr_predicates();
 };
 
+// RuntimeFilterRangePruner translates the runtime bloom filters of a scan, which had not arrived when
+// the conjuncts were parsed, into the min/max predicates of storage engine once they arrive.
+class RuntimeFilterRangePruner final : public RuntimeRangePruner {
+public:
+    RuntimeFilterRangePruner(const OlapScanConjunctsManager& cm, const TabletSchema& tablet_schema);
+    ~RuntimeFilterRangePruner() override;
+
+    // Whether there is no runtime filter left to wait for.
+    bool empty() const { return _pending_filters.empty() && _predicates_map.empty(); }
+
+    StatusOr<const PredicatesMap*> arrived_predicates() override;
+
+private:
+    const TupleDescriptor* _tuple_desc;
+    const std::vector<std::string>* _key_column_names;
+    RuntimeState* _runtime_state;
+    const TabletSchema& _tablet_schema;
+
+    std::vector<RuntimeFilterProbeDescriptor*> _pending_filters;
+    ObjectPool _obj_pool;
+    std::vector<std::unique_ptr<ColumnPredicate>> _predicates;
+    PredicatesMap _predicates_map;
+    bool _always_false = false;
+};
+
 } // namespace vectorized
 } // namespace starrocks
\ No newline at end of file
@@ -164,6 +164,10 @@ Status merge_sorted_cursor_cascade(const SortDescs& sort_desc,
                                    std::vector<std::unique_ptr<SimpleChunkSortCursor>>&& cursors,
                                    ChunkConsumer consumer);
 
+// Create a cursor which outputs the sorted |runs| by chunks of at most |chunk_size| rows.
+std::unique_ptr<SimpleChunkSortCursor> make_sorted_runs_cursor(SortedRuns runs, size_t chunk_size,
+                                                               const std::vector<ExprContext*>* sort_exprs);
+
 // Merge in rowwise, which is slow and used only in benchmark
 Status merge_sorted_chunks_two_way_rowwise(const SortDescs& descs, const Columns& left, const Columns& right,
                                            Permutation* output, size_t limit);
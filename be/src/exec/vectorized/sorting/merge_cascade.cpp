@@ -253,4 +253,31 @@ Status merge_sorted_cursor_cascade(const SortDescs& sort_desc,
     return Status::OK();
 }
 
+std::unique_ptr<SimpleChunkSortCursor> make_sorted_runs_cursor(SortedRuns runs, size_t chunk_size,
+                                                               const std::vector<ExprContext*>* sort_exprs) {
+    auto remain_runs = std::make_shared<SortedRuns>(std::move(runs));
+    auto provider = [remain_runs, chunk_size](ChunkUniquePtr* output, bool* eos) {
+        if (output == nullptr || eos == nullptr) {
+            return true;
+        }
+        while (remain_runs->num_chunks() > 0 && remain_runs->front().empty()) {
+            remain_runs->pop_front();
+        }
+        if (remain_runs->num_chunks() == 0) {
+            *eos = true;
+            return false;
+        }
+        SortedRun& run = remain_runs->front();
+        size_t rows = std::min(chunk_size, run.num_rows());
+        *output = SortedRun(run, run.start_index(), run.start_index() + rows).clone_slice();
+        run.range.first += rows;
+        if (run.empty()) {
+            // Release the memory of the consumed chunk as soon as possible.
+            remain_runs->pop_front();
+        }
+        return true;
+    };
+    return std::make_unique<SimpleChunkSortCursor>(std::move(provider), sort_exprs);
+}
+
 } // namespace starrocks::vectorized
\ No newline at end of file
@@ -0,0 +1,285 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#include "exec/vectorized/spill/spill_file.h"
+
+#include <fmt/format.h>
+
+#include <atomic>
+#include <mutex>
+
+#include "column/chunk.h"
+#include "common/config.h"
+#include "fs/fs.h"
+#include "gutil/strings/split.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/runtime_state.h"
+#include "serde/column_array_serde.h"
+#include "util/uid_util.h"
+
+namespace starrocks::vectorized {
+
+namespace {
+
+// Spill files are put under the `spill` sub-directory of every scratch dir. Files left by
+// a previous process are useless, so the sub-directory is cleaned up when it's first used.
+class SpillDirs {
+public:
+    static SpillDirs* instance() {
+        static SpillDirs dirs;
+        return &dirs;
+    }
+
+    StatusOr<std::string> pick_dir() {
+        std::call_once(_init_once, [this]() { _init(); });
+        if (_dirs.empty()) {
+            return Status::InternalError(
+                    fmt::format("no available spill dir, query_scratch_dirs: {}", config::query_scratch_dirs));
+        }
+        return _dirs[_next_dir.fetch_add(1, std::memory_order_relaxed) % _dirs.size()];
+    }
+
+    int64_t next_file_id() { return _next_file_id.fetch_add(1, std::memory_order_relaxed); }
+
+private:
+    void _init() {
+        auto fs = FileSystem::Default();
+        for (const auto& dir : strings::Split(config::query_scratch_dirs, ";", strings::SkipWhitespace())) {
+            std::string spill_dir = dir + "/spill";
+            if (fs->path_exists(spill_dir).ok()) {
+                WARN_IF_ERROR(fs->delete_dir_recursive(spill_dir), "fail to clean spill dir " + spill_dir);
+            }
+            auto st = fs->create_dir_recursive(spill_dir);
+            if (!st.ok()) {
+                LOG(WARNING) << "ignore spill dir " << spill_dir << ": " << st;
+                continue;
+            }
+            _dirs.emplace_back(std::move(spill_dir));
+        }
+    }
+
+    std::once_flag _init_once;
+    std::vector<std::string> _dirs;
+    std::atomic<size_t> _next_dir{0};
+    std::atomic<int64_t> _next_file_id{0};
+};
+
+} // namespace
+
+StatusOr<std::unique_ptr<SpillFile>> SpillFile::create(RuntimeState* state, const std::string& name) {
+    ASSIGN_OR_RETURN(auto dir, SpillDirs::instance()->pick_dir());
+    auto path = fmt::format("{}/{}_{}_{}", dir, print_id(state->fragment_instance_id()), name,
+                            SpillDirs::instance()->next_file_id());
+    WritableFileOptions opts;
+    opts.sync_on_close = false;
+    opts.mode = FileSystem::CREATE_OR_OPEN_WITH_TRUNCATE;
+    ASSIGN_OR_RETURN(auto writer, FileSystem::Default()->new_writable_file(opts, path));
+    return std::unique_ptr<SpillFile>(new SpillFile(std::move(path), std::move(writer)));
+}
+
+SpillFile::SpillFile(std::string path, std::unique_ptr<WritableFile> writer)
+        : _path(std::move(path)), _writer(std::move(writer)) {}
+
+SpillFile::~SpillFile() {
+    _reader.reset();
+    if (_writer != nullptr) {
+        WARN_IF_ERROR(_writer->close(), "fail to close spill file " + _path);
+        _writer.reset();
+    }
+    WARN_IF_ERROR(FileSystem::Default()->delete_file(_path), "fail to delete spill file " + _path);
+}
+
+size_t SpillFile::_schema_index(const Chunk& chunk) {
+    auto same_layout = [&chunk](const Chunk& schema) {
+        if (schema.num_columns() != chunk.num_columns()) {
+            return false;
+        }
+        for (size_t i = 0; i < chunk.num_columns(); i++) {
+            if (schema.get_column_by_index(i)->get_name() != chunk.get_column_by_index(i)->get_name()) {
+                return false;
+            }
+        }
+        return true;
+    };
+    // In most cases all chunks have the same layout, so only the last schema is checked.
+    if (_schemas.empty() || !same_layout(*_schemas.back())) {
+        _schemas.emplace_back(chunk.clone_empty_with_tuple(0));
+    }
+    return _schemas.size() - 1;
+}
+
+Status SpillFile::append(const Chunk& chunk) {
+    if (_writer == nullptr) {
+        return Status::InternalError("append to a finished spill file " + _path);
+    }
+    if (chunk.num_rows() == 0) {
+        return Status::OK();
+    }
+
+    size_t max_size = 0;
+    for (const auto& column : chunk.columns()) {
+        int64_t size = serde::ColumnArraySerde::max_serialized_size(*column);
+        if (size <= 0) {
+            return Status::NotSupported("spill column " + column->get_name());
+        }
+        max_size += size;
+    }
+    _buffer.resize(max_size);
+
+    uint8_t* buff = _buffer.data();
+    for (const auto& column : chunk.columns()) {
+        buff = serde::ColumnArraySerde::serialize(*column, buff);
+        if (UNLIKELY(buff == nullptr)) {
+            return Status::InternalError("fail to serialize column " + column->get_name());
+        }
+    }
+    size_t size = buff - _buffer.data();
+    RETURN_IF_ERROR(_writer->append(Slice(_buffer.data(), size)));
+
+    _blocks.push_back({_file_size, size, _schema_index(chunk)});
+    _file_size += size;
+    _num_rows += chunk.num_rows();
+    return Status::OK();
+}
+
+Status SpillFile::finish() {
+    if (_writer == nullptr) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(_writer->close());
+    _writer.reset();
+    // Release the serialization buffer, which may be large.
+    std::vector<uint8_t>().swap(_buffer);
+    return Status::OK();
+}
+
+StatusOr<ChunkUniquePtr> SpillFile::read_next() {
+    if (_writer != nullptr) {
+        return Status::InternalError("read an unfinished spill file " + _path);
+    }
+    if (_read_block_idx >= _blocks.size()) {
+        return Status::EndOfFile("end of spill file");
+    }
+    if (_reader == nullptr) {
+        ASSIGN_OR_RETURN(_reader, FileSystem::Default()->new_random_access_file(_path));
+    }
+
+    const auto& block = _blocks[_read_block_idx++];
+    _buffer.resize(block.size);
+    RETURN_IF_ERROR(_reader->read_at_fully(block.offset, _buffer.data(), block.size));
+
+    auto chunk = _schemas[block.schema_idx]->clone_empty_with_tuple(0);
+    const uint8_t* buff = _buffer.data();
+    for (size_t i = 0; i < chunk->num_columns(); i++) {
+        buff = serde::ColumnArraySerde::deserialize(buff, chunk->get_column_by_index(i).get());
+        if (UNLIKELY(buff == nullptr)) {
+            return Status::Corruption("fail to deserialize spill file " + _path);
+        }
+    }
+    if (UNLIKELY(buff != _buffer.data() + block.size)) {
+        return Status::Corruption("unexpected block size of spill file " + _path);
+    }
+    if (_read_block_idx == _blocks.size()) {
+        std::vector<uint8_t>().swap(_buffer);
+    }
+    return std::move(chunk);
+}
+
+PartitionedSpillWriter::PartitionedSpillWriter(RuntimeState* state, std::string name, int partition_bits, int level)
+        : _state(state),
+          _name(std::move(name)),
+          _partition_bits(partition_bits),
+          _level(level),
+          _partitions(1u << partition_bits) {}
+
+void PartitionedSpillWriter::compute_partition_index(const Columns& key_columns, size_t num_rows, int partition_bits,
+                                                     int level, std::vector<uint32_t>* hash_values) {
+    hash_values->assign(num_rows, 0);
+    for (const auto& column : key_columns) {
+        column->crc32_hash(hash_values->data(), 0, num_rows);
+    }
+    // Use the high bits of hash value, the low bits are usually used to shuffle data
+    // among drivers and instances, they are likely the same for all rows of a driver.
+    int shift = std::max(0, 32 - partition_bits * (level + 1));
+    uint32_t mask = (1u << partition_bits) - 1;
+    for (auto& hash : *hash_values) {
+        hash = (hash >> shift) & mask;
+    }
+}
+
+Status PartitionedSpillWriter::append(const Chunk& chunk, const Columns& key_columns) {
+    size_t num_rows = chunk.num_rows();
+    if (num_rows == 0) {
+        return Status::OK();
+    }
+    compute_partition_index(key_columns, num_rows, _partition_bits, _level, &_hash_values);
+
+    // Counting sort the row indexes by partition.
+    size_t num_partitions = _partitions.size();
+    _partition_row_counts.assign(num_partitions + 1, 0);
+    for (auto partition : _hash_values) {
+        _partition_row_counts[partition + 1]++;
+    }
+    for (size_t i = 1; i <= num_partitions; i++) {
+        _partition_row_counts[i] += _partition_row_counts[i - 1];
+    }
+    _row_indexes.resize(num_rows);
+    {
+        std::vector<uint32_t> cursors(_partition_row_counts.begin(), _partition_row_counts.end() - 1);
+        for (uint32_t i = 0; i < num_rows; i++) {
+            _row_indexes[cursors[_hash_values[i]]++] = i;
+        }
+    }
+
+    for (size_t i = 0; i < num_partitions; i++) {
+        uint32_t from = _partition_row_counts[i];
+        uint32_t size = _partition_row_counts[i + 1] - from;
+        if (size == 0) {
+            continue;
+        }
+        if (_partitions[i] == nullptr) {
+            ASSIGN_OR_RETURN(_partitions[i],
+                             SpillFile::create(_state, fmt::format("{}-L{}-P{}", _name, _level, i)));
+        }
+        if (size == num_rows) {
+            RETURN_IF_ERROR(_partitions[i]->append(chunk));
+        } else {
+            auto part = chunk.clone_empty_with_tuple(size);
+            part->append_selective(chunk, _row_indexes.data(), from, size);
+            RETURN_IF_ERROR(_partitions[i]->append(*part));
+        }
+    }
+    _spilled_rows += num_rows;
+    return Status::OK();
+}
+
+Status PartitionedSpillWriter::finish() {
+    for (auto& partition : _partitions) {
+        if (partition != nullptr) {
+            RETURN_IF_ERROR(partition->finish());
+        }
+    }
+    return Status::OK();
+}
+
+size_t PartitionedSpillWriter::spilled_bytes() const {
+    size_t bytes = 0;
+    for (const auto& partition : _partitions) {
+        if (partition != nullptr) {
+            bytes += partition->file_size();
+        }
+    }
+    return bytes;
+}
+
+bool need_spill(RuntimeState* state, int64_t operator_mem_usage) {
+    if (!state->enable_spill() || operator_mem_usage < config::spill_operator_min_bytes) {
+        return false;
+    }
+    auto* query_tracker = state->query_mem_tracker_ptr().get();
+    if (query_tracker == nullptr || query_tracker->limit() <= 0) {
+        return false;
+    }
+    return query_tracker->consumption() >= query_tracker->limit() * config::spill_mem_limit_threshold;
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,127 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "common/statusor.h"
+
+namespace starrocks {
+
+class RandomAccessFile;
+class RuntimeState;
+class WritableFile;
+
+namespace vectorized {
+
+// SpillFile stores a sequence of chunks in a local scratch file (one of `config::query_scratch_dirs`).
+// The file is write-once: chunks are appended by `append()`, then `finish()` seals the file and
+// chunks can be read back in the order they were appended, any number of times.
+// The underlying file is removed when the SpillFile is destroyed.
+//
+// On-disk layout of a block:
+//      [column_0][column_1]...[column_n]
+// every column is serialized by `serde::ColumnArraySerde`. Block offsets/sizes and the column layout
+// (nullable/const) of every block are kept in memory, so chunks with different column layouts are allowed.
+class SpillFile {
+public:
+    // Create a new spill file, |name| is used to make the file name readable, e.g. "agg-3-0".
+    static StatusOr<std::unique_ptr<SpillFile>> create(RuntimeState* state, const std::string& name);
+
+    ~SpillFile();
+
+    Status append(const Chunk& chunk);
+
+    // Close the writer, no more chunks can be appended after `finish()`.
+    Status finish();
+
+    // Read the next chunk, return Status::EndOfFile when all chunks have been read.
+    // REQUIRE: `finish()` has been called.
+    StatusOr<ChunkUniquePtr> read_next();
+
+    // Restart reading from the first chunk.
+    void rewind() { _read_block_idx = 0; }
+
+    const std::string& path() const { return _path; }
+    size_t num_rows() const { return _num_rows; }
+    size_t num_chunks() const { return _blocks.size(); }
+    // Total bytes written into the file.
+    size_t file_size() const { return _file_size; }
+    bool empty() const { return _blocks.empty(); }
+
+private:
+    struct BlockMeta {
+        size_t offset;
+        size_t size;
+        size_t schema_idx;
+    };
+
+    SpillFile(std::string path, std::unique_ptr<WritableFile> writer);
+
+    // Find or create the schema which has the same column layout with |chunk|.
+    size_t _schema_index(const Chunk& chunk);
+
+    std::string _path;
+    std::unique_ptr<WritableFile> _writer;
+    std::unique_ptr<RandomAccessFile> _reader;
+
+    std::vector<ChunkUniquePtr> _schemas;
+    std::vector<BlockMeta> _blocks;
+    std::vector<uint8_t> _buffer;
+    size_t _read_block_idx = 0;
+    size_t _num_rows = 0;
+    size_t _file_size = 0;
+};
+
+using SpillFilePtr = std::unique_ptr<SpillFile>;
+
+// Split chunks into 2^partition_bits partitions by the hash of key columns and spill every
+// partition into its own SpillFile. Rows with the same key always fall into the same partition,
+// so each partition can be processed independently.
+//
+// |level| selects which bits of the hash value are used, so a partition which is still too large
+// can be partitioned again at the next level.
+class PartitionedSpillWriter {
+public:
+    PartitionedSpillWriter(RuntimeState* state, std::string name, int partition_bits, int level = 0);
+
+    // Spill |chunk| according to the hash of |key_columns|, which have the same number of rows with |chunk|.
+    Status append(const Chunk& chunk, const Columns& key_columns);
+
+    Status finish();
+
+    size_t num_partitions() const { return _partitions.size(); }
+    // Return nullptr if nothing was spilled into the |i|-th partition.
+    SpillFilePtr& partition(size_t i) { return _partitions[i]; }
+
+    size_t spilled_rows() const { return _spilled_rows; }
+    size_t spilled_bytes() const;
+
+    // Compute the partition index of every row.
+    static void compute_partition_index(const Columns& key_columns, size_t num_rows, int partition_bits, int level,
+                                        std::vector<uint32_t>* hash_values);
+
+private:
+    RuntimeState* _state;
+    std::string _name;
+    int _partition_bits;
+    int _level;
+    std::vector<SpillFilePtr> _partitions;
+
+    std::vector<uint32_t> _hash_values;
+    std::vector<uint32_t> _partition_row_counts;
+    std::vector<uint32_t> _row_indexes;
+    size_t _spilled_rows = 0;
+};
+
+// Decide whether a spillable operator should release its memory by spilling.
+// Operators spill when spilling is enabled for the query, the query memory consumption has
+// reached `config::spill_mem_limit_threshold` of its limit, and the operator itself holds at
+// least `config::spill_operator_min_bytes`.
+bool need_spill(RuntimeState* state, int64_t operator_mem_usage);
+
+} // namespace vectorized
+} // namespace starrocks
@@ -4,6 +4,7 @@
 
 #include "exec/workgroup/scan_task_queue.h"
 #include "runtime/exec_env.h"
+#include "util/cpu_info.h"
 
 namespace starrocks::workgroup {
 
@@ -32,6 +33,11 @@ void ScanExecutor::change_num_threads(int32_t num_threads) {
 }
 
 void ScanExecutor::worker_thread() {
+    const int worker_id = _next_id++;
+    const int num_numa_nodes = CpuInfo::num_execution_numa_nodes();
+    if (num_numa_nodes > 1) {
+        CpuInfo::bind_current_thread_to_numa_node(worker_id % num_numa_nodes);
+    }
     while (true) {
         if (_num_threads_setter.should_shrink()) {
             break;
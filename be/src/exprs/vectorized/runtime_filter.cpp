@@ -26,7 +26,7 @@ SimdBlockFilter::SimdBlockFilter(SimdBlockFilter&& bf) noexcept {
 }
 
 size_t SimdBlockFilter::max_serialized_size() const {
-    const size_t alloc_size = get_alloc_size();
+    const size_t alloc_size = initialized() ? get_alloc_size() : 0;
     return sizeof(_log_num_buckets) + sizeof(_directory_mask) + // data size + max data size
            sizeof(int32_t) + alloc_size;
 }
@@ -39,10 +39,12 @@ size_t SimdBlockFilter::serialize(uint8_t* data) const {
     SIMD_BF_COPY_FIELD(_log_num_buckets);
     SIMD_BF_COPY_FIELD(_directory_mask);
 
-    const size_t alloc_size = get_alloc_size();
+    const size_t alloc_size = initialized() ? get_alloc_size() : 0;
     int32_t data_size = alloc_size;
     SIMD_BF_COPY_FIELD(data_size);
-    memcpy(data + offset, _directory, data_size);
+    if (data_size != 0) {
+        memcpy(data + offset, _directory, data_size);
+    }
     offset += data_size;
     return offset;
 #undef SIMD_BF_COPY_FIELD
@@ -59,6 +61,10 @@ size_t SimdBlockFilter::deserialize(const uint8_t* data) {
     SIMD_BF_COPY_FIELD(_directory_mask);
     SIMD_BF_COPY_FIELD(data_size);
 #undef SIMD_BF_COPY_FIELD
+    // uninitialized filter.
+    if (data_size == 0) {
+        return offset;
+    }
     const size_t alloc_size = get_alloc_size();
     DCHECK(data_size == alloc_size);
     const int malloc_failed = posix_memalign(reinterpret_cast<void**>(&(_directory)), 64, alloc_size);
@@ -86,6 +92,39 @@ void SimdBlockFilter::merge(const SimdBlockFilter& bf) {
     }
 }
 
+void SimdBlockFilter::merge_relaxed(const SimdBlockFilter& bf) {
+    if (!bf.initialized()) {
+        return;
+    }
+    if (!initialized()) {
+        _log_num_buckets = bf._log_num_buckets;
+        _directory_mask = bf._directory_mask;
+        const size_t alloc_size = get_alloc_size();
+        const int malloc_failed = posix_memalign(reinterpret_cast<void**>(&_directory), 64, alloc_size);
+        if (malloc_failed) throw ::std::bad_alloc();
+        memcpy(_directory, bf._directory, alloc_size);
+        return;
+    }
+    if (_log_num_buckets == bf._log_num_buckets) {
+        merge(bf);
+        return;
+    }
+    memset(_directory, 0xFF, get_alloc_size());
+}
+
+size_t SimdBlockFilter::max_serialized_size_of_pass_all() {
+    SimdBlockFilter bf;
+    bf.init(1);
+    return bf.max_serialized_size();
+}
+
+size_t SimdBlockFilter::serialize_pass_all(uint8_t* data) {
+    SimdBlockFilter bf;
+    bf.init(1);
+    memset(bf._directory, 0xFF, bf.get_alloc_size());
+    return bf.serialize(data);
+}
+
 static constexpr uint32_t SALT[8] = {0x47b6137b, 0x44974d91, 0x8824ad5b, 0xa2b7289d,
                                      0x705495c7, 0x2df1424b, 0x9efc4947, 0x5c6bfb31};
 
@@ -102,25 +141,72 @@ void SimdBlockFilter::make_mask(uint32_t key, uint32_t* masks) const {
 }
 
 bool SimdBlockFilter::check_equal(const SimdBlockFilter& bf) const {
+    if (!initialized() || !bf.initialized()) {
+        return initialized() == bf.initialized();
+    }
     const size_t alloc_size = get_alloc_size();
     return _log_num_buckets == bf._log_num_buckets && _directory_mask == bf._directory_mask &&
            memcmp(_directory, bf._directory, alloc_size) == 0;
 }
 
-size_t JoinRuntimeFilter::max_serialized_size() const {
+void JoinRuntimeFilter::init_by_bucket(const std::vector<size_t>& bucket_rows) {
+    _partitioned_by_bucket = true;
+    _num_hash_partitions = bucket_rows.size();
+    _hash_partition_bf.clear();
+    _hash_partition_bf.resize(_num_hash_partitions);
+    _size = 0;
+    for (size_t i = 0; i < _num_hash_partitions; i++) {
+        if (bucket_rows[i] > 0) {
+            _hash_partition_bf[i].init(bucket_rows[i]);
+            _size += bucket_rows[i];
+        }
+    }
+}
+
+std::vector<uint8_t> JoinRuntimeFilter::built_buckets() const {
+    std::vector<uint8_t> buckets(_hash_partition_bf.size());
+    for (size_t i = 0; i < _hash_partition_bf.size(); i++) {
+        buckets[i] = _hash_partition_bf[i].initialized();
+    }
+    return buckets;
+}
+
+void JoinRuntimeFilter::_merge_buckets(const JoinRuntimeFilter* rf) {
+    if (!_partitioned_by_bucket) {
+        DCHECK(_hash_partition_bf.empty());
+        _partitioned_by_bucket = true;
+        _num_hash_partitions = rf->_num_hash_partitions;
+        _hash_partition_bf.resize(_num_hash_partitions);
+    }
+    DCHECK_EQ(_num_hash_partitions, rf->_num_hash_partitions);
+    for (size_t i = 0; i < _num_hash_partitions; i++) {
+        _hash_partition_bf[i].merge_relaxed(rf->_hash_partition_bf[i]);
+    }
+}
+
+size_t JoinRuntimeFilter::max_serialized_size(int serialize_version) const {
     // todo(yan): noted that it's not serialize compatible with 32-bit and 64-bit.
     size_t size = sizeof(_has_null) + sizeof(_size) + sizeof(_num_hash_partitions) + sizeof(_join_mode);
+    if (serialize_version >= RF_VERSION_V3) {
+        size += sizeof(_partitioned_by_bucket);
+    }
     if (_num_hash_partitions == 0) {
         size += _bf.max_serialized_size();
     } else {
-        for (const auto& bf : _hash_partition_bf) {
-            size += bf.max_serialized_size();
+        for (size_t i = 0; i < _num_hash_partitions; i++) {
+            if (_shipped_buckets.empty() || _shipped_buckets[i]) {
+                size += _hash_partition_bf[i].max_serialized_size();
+            } else {
+                size += SimdBlockFilter::max_serialized_size_of_pass_all();
+            }
         }
     }
     return size;
 }
 
-size_t JoinRuntimeFilter::serialize(uint8_t* data) const {
+size_t JoinRuntimeFilter::serialize(int serialize_version, uint8_t* data) const {
+    // The filters partitioned by bucket can't be represented in the older versions.
+    DCHECK(!_partitioned_by_bucket || serialize_version >= RF_VERSION_V3);
     size_t offset = 0;
 #define JRF_COPY_FIELD(field)                     \
     memcpy(data + offset, &field, sizeof(field)); \
@@ -129,20 +215,27 @@ size_t JoinRuntimeFilter::serialize(uint8_t* data) const {
     JRF_COPY_FIELD(_size);
     JRF_COPY_FIELD(_num_hash_partitions);
     JRF_COPY_FIELD(_join_mode);
+    if (serialize_version >= RF_VERSION_V3) {
+        JRF_COPY_FIELD(_partitioned_by_bucket);
+    }
 #undef JRF_COPY_FIELD
 
     if (_num_hash_partitions == 0) {
         offset += _bf.serialize(data + offset);
 
     } else {
-        for (const auto& bf : _hash_partition_bf) {
-            offset += bf.serialize(data + offset);
+        for (size_t i = 0; i < _num_hash_partitions; i++) {
+            if (_shipped_buckets.empty() || _shipped_buckets[i]) {
+                offset += _hash_partition_bf[i].serialize(data + offset);
+            } else {
+                offset += SimdBlockFilter::serialize_pass_all(data + offset);
+            }
         }
     }
     return offset;
 }
 
-size_t JoinRuntimeFilter::deserialize(const uint8_t* data) {
+size_t JoinRuntimeFilter::deserialize(int serialize_version, const uint8_t* data) {
     size_t offset = 0;
 #define JRF_COPY_FIELD(field)                     \
     memcpy(&field, data + offset, sizeof(field)); \
@@ -151,6 +244,9 @@ size_t JoinRuntimeFilter::deserialize(const uint8_t* data) {
     JRF_COPY_FIELD(_size);
     JRF_COPY_FIELD(_num_hash_partitions);
     JRF_COPY_FIELD(_join_mode);
+    if (serialize_version >= RF_VERSION_V3) {
+        JRF_COPY_FIELD(_partitioned_by_bucket);
+    }
 #undef JRF_COPY_FIELD
 
     if (_num_hash_partitions == 0) {
@@ -168,7 +264,7 @@ size_t JoinRuntimeFilter::deserialize(const uint8_t* data) {
 
 bool JoinRuntimeFilter::check_equal(const JoinRuntimeFilter& rf) const {
     bool first = (_has_null == rf._has_null && _size == rf._size && _num_hash_partitions == rf._num_hash_partitions &&
-                  _join_mode == rf._join_mode);
+                  _join_mode == rf._join_mode && _partitioned_by_bucket == rf._partitioned_by_bucket);
     if (!first) return false;
     if (_num_hash_partitions == 0) {
         if (!_bf.check_equal(rf._bf)) return false;
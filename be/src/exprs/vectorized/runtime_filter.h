@@ -98,8 +98,17 @@ public:
     size_t serialize(uint8_t* data) const;
     size_t deserialize(const uint8_t* data);
     void merge(const SimdBlockFilter& bf);
+    // Merge a filter which may be uninitialized or of a different size. If the sizes differ, the result
+    // matches every hash, which is still correct but not selective.
+    void merge_relaxed(const SimdBlockFilter& bf);
     bool check_equal(const SimdBlockFilter& bf) const;
     uint32_t directory_mask() const { return _directory_mask; }
+    // An uninitialized filter matches nothing, e.g. the filter of a bucket without any build rows.
+    bool initialized() const { return _directory != nullptr; }
+
+    // Serialize the filter of the minimal size which matches every hash.
+    static size_t max_serialized_size_of_pass_all();
+    static size_t serialize_pass_all(uint8_t* data);
 
 private:
     // The number of bits to set in a tiny Bloom filter block
@@ -130,9 +139,9 @@ private:
 
     // Common:
     // log_num_buckets_ is the log (base 2) of the number of buckets in the directory:
-    int _log_num_buckets;
+    int _log_num_buckets = 0;
     // directory_mask_ is (1 << log_num_buckets_) - 1
-    uint32_t _directory_mask;
+    uint32_t _directory_mask = 0;
     Bucket* _directory = nullptr;
 };
 
@@ -190,6 +199,15 @@ private:
     size_t _capacity = 0;
 };
 
+// Versions of the serialized join runtime filter.
+// 0x1. initial global runtime filter impl
+// 0x2. change simd-block-filter hash function.
+// 0x3. support runtime filters partitioned by bucket.
+// Only the filters partitioned by bucket are serialized in 0x3, so BEs of different versions can still exchange
+// the other filters during a rolling upgrade.
+inline constexpr uint8_t RF_VERSION_V2 = 0x2;
+inline constexpr uint8_t RF_VERSION_V3 = 0x3;
+
 // The runtime filter generated by join right small table
 class JoinRuntimeFilter {
 public:
@@ -207,6 +225,19 @@ public:
         bool compatibility = true;
     };
 
+    // The filter of the joins whose both sides are bucketed by the join keys, i.e. colocate and bucket
+    // shuffle joins, can be partitioned by the bucket of rows, so each probe row is only tested by the
+    // filter built from the rows of its own bucket. |bucket_rows| is the number of build rows of every
+    // bucket, and the filters of the buckets without build rows are left uninitialized.
+    void init_by_bucket(const std::vector<size_t>& bucket_rows);
+    bool is_partitioned_by_bucket() const { return _partitioned_by_bucket; }
+    // Whether the filter of every bucket is built by some rows.
+    std::vector<uint8_t> built_buckets() const;
+    // Only the filters of the buckets set in |buckets| are serialized, and the other buckets are serialized
+    // as the filters matching every row, to reduce the size of the filter sent to the nodes probing only part
+    // of buckets. Empty |buckets| means all the buckets.
+    void set_shipped_buckets(std::vector<uint8_t> buckets) { _shipped_buckets = std::move(buckets); }
+
     virtual void evaluate(Column* input_column, RunningContext* ctx) const = 0;
 
     size_t size() const { return _size; }
@@ -217,9 +248,10 @@ public:
 
     void set_join_mode(int8_t join_mode) { _join_mode = join_mode; }
 
-    virtual size_t max_serialized_size() const;
-    virtual size_t serialize(uint8_t* data) const;
-    virtual size_t deserialize(const uint8_t* data);
+    // |serialize_version| is one of RF_VERSION_V2 and RF_VERSION_V3, see RuntimeFilterHelper.
+    virtual size_t max_serialized_size(int serialize_version) const;
+    virtual size_t serialize(int serialize_version, uint8_t* data) const;
+    virtual size_t deserialize(int serialize_version, const uint8_t* data);
     virtual void merge(const JoinRuntimeFilter* rf) {
         _has_null |= rf->_has_null;
         _bf.merge(rf->_bf);
@@ -227,8 +259,12 @@ public:
 
     virtual void concat(JoinRuntimeFilter* rf) {
         _has_null |= rf->_has_null;
-        _hash_partition_bf.emplace_back(std::move(rf->_bf));
-        _num_hash_partitions = _hash_partition_bf.size();
+        if (rf->_partitioned_by_bucket) {
+            _merge_buckets(rf);
+        } else {
+            _hash_partition_bf.emplace_back(std::move(rf->_bf));
+            _num_hash_partitions = _hash_partition_bf.size();
+        }
         _join_mode = rf->_join_mode;
         _size += rf->_size;
     }
@@ -236,12 +272,17 @@ public:
     virtual JoinRuntimeFilter* create_empty(ObjectPool* pool) = 0;
 
 protected:
+    void _merge_buckets(const JoinRuntimeFilter* rf);
+
     bool _has_null = false;
     size_t _size = 0;
     int8_t _join_mode = 0;
     SimdBlockFilter _bf;
     size_t _num_hash_partitions = 0;
     std::vector<SimdBlockFilter> _hash_partition_bf;
+    // Whether |_hash_partition_bf| is indexed by bucket_seq rather than the partition of instances.
+    bool _partitioned_by_bucket = false;
+    std::vector<uint8_t> _shipped_buckets;
 };
 
 // The join runtime filter implement by bloom filter
@@ -312,6 +353,20 @@ public:
         _max = std::max(*value, _max);
     }
 
+    // REQUIRES: the filter is initialized by init_by_bucket, and |bucket| has build rows.
+    void insert_into_bucket(CppType* value, uint32_t bucket) {
+        if (value == nullptr) {
+            _has_null = true;
+            return;
+        }
+
+        size_t hash = compute_hash(*value);
+        _hash_partition_bf[bucket].insert_hash(hash);
+
+        _min = std::min(*value, _min);
+        _max = std::max(*value, _max);
+    }
+
     CppType min_value() const { return _min; }
 
     CppType max_value() const { return _max; }
@@ -338,8 +393,13 @@ public:
         }
         // module has been done outside, so actually here is bucket idx.
         const uint32_t bucket_idx = shuffle_hash;
+        const SimdBlockFilter& bf = _hash_partition_bf[bucket_idx];
+        // no build rows in this bucket.
+        if (!bf.initialized()) {
+            return false;
+        }
         size_t hash = compute_hash(value);
-        return _hash_partition_bf[bucket_idx].test_hash(hash);
+        return bf.test_hash(hash);
     }
 
     void evaluate(Column* input_column, RunningContext* ctx) const override {
@@ -382,6 +442,11 @@ public:
         case TRuntimeFilterBuildJoinMode::LOCAL_HASH_BUCKET:
         case TRuntimeFilterBuildJoinMode::COLOCATE: {
             hash_values.assign(num_rows, 0);
+            if (_partitioned_by_bucket) {
+                // the grf is partitioned by bucket_seq directly.
+                compute_hash(&Column::crc32_hash, _num_hash_partitions, false);
+                break;
+            }
             // shuffle-aware grf is partitioned into multiple parts the number of whom equals to the number of
             // instances. we can use crc32_hash to compute out bucket_seq that the row belongs to, then use
             // the bucketseq_to_partition array to translate bucket_seq into partition index of the grf.
@@ -479,20 +544,24 @@ public:
         if (bf->_has_min_max) {
             _min = std::min(_min, bf->_min);
             _max = std::max(_max, bf->_max);
+            // maybe we are refering to another runtime filter instance
+            // for security we have to copy that back to our instance.
+            own_min_max();
+        }
+    }
 
-            if constexpr (IsSlice<CppType>) {
-                // maybe we are refering to another runtime filter instance
-                // for security we have to copy that back to our instance.
-                if (_min.size != 0 && _min.data != _slice_min.data()) {
-                    _slice_min.resize(_min.size);
-                    memcpy(_slice_min.data(), _min.data, _min.size);
-                    _min.data = _slice_min.data();
-                }
-                if (_max.size != 0 && _max.data != _slice_max.data()) {
-                    _slice_max.resize(_max.size);
-                    memcpy(_slice_max.data(), _max.data, _max.size);
-                    _max.data = _slice_max.data();
-                }
+    // Copy min/max into this filter if they refer to the memory of another filter or of the inserted column.
+    void own_min_max() {
+        if constexpr (IsSlice<CppType>) {
+            if (_min.size != 0 && _min.data != _slice_min.data()) {
+                _slice_min.resize(_min.size);
+                memcpy(_slice_min.data(), _min.data, _min.size);
+                _min.data = _slice_min.data();
+            }
+            if (_max.size != 0 && _max.data != _slice_max.data()) {
+                _slice_max.resize(_max.size);
+                memcpy(_slice_max.data(), _max.data, _max.size);
+                _max.data = _slice_max.data();
             }
         }
     }
@@ -516,8 +585,8 @@ public:
         return ss.str();
     }
 
-    size_t max_serialized_size() const override {
-        size_t size = sizeof(Type) + JoinRuntimeFilter::max_serialized_size();
+    size_t max_serialized_size(int serialize_version) const override {
+        size_t size = sizeof(Type) + JoinRuntimeFilter::max_serialized_size(serialize_version);
         // _has_min_max. for backward compatibility.
         size += 1;
 
@@ -532,12 +601,12 @@ public:
         return size;
     }
 
-    size_t serialize(uint8_t* data) const override {
+    size_t serialize(int serialize_version, uint8_t* data) const override {
         PrimitiveType ptype = Type;
         size_t offset = 0;
         memcpy(data + offset, &ptype, sizeof(ptype));
         offset += sizeof(ptype);
-        offset += JoinRuntimeFilter::serialize(data + offset);
+        offset += JoinRuntimeFilter::serialize(serialize_version, data + offset);
         memcpy(data + offset, &_has_min_max, sizeof(_has_min_max));
         offset += sizeof(_has_min_max);
 
@@ -565,12 +634,12 @@ public:
         return offset;
     }
 
-    size_t deserialize(const uint8_t* data) override {
+    size_t deserialize(int serialize_version, const uint8_t* data) override {
         PrimitiveType ptype = Type;
         size_t offset = 0;
         memcpy(&ptype, data + offset, sizeof(ptype));
         offset += sizeof(ptype);
-        offset += JoinRuntimeFilter::deserialize(data + offset);
+        offset += JoinRuntimeFilter::deserialize(serialize_version, data + offset);
 
         bool has_min_max = false;
         memcpy(&has_min_max, data + offset, sizeof(has_min_max));
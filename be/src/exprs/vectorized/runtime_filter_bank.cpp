@@ -2,9 +2,11 @@
 
 #include "exprs/vectorized/runtime_filter_bank.h"
 
+#include <iomanip>
 #include <thread>
 
 #include "column/column.h"
+#include "common/config.h"
 #include "exec/pipeline/runtime_filter_types.h"
 #include "exprs/vectorized/in_const_predicate.hpp"
 #include "exprs/vectorized/literal.h"
@@ -15,14 +17,11 @@
 #include "runtime/primitive_type_infra.h"
 #include "runtime/runtime_filter_cache.h"
 #include "simd/simd.h"
+#include "util/stopwatch.hpp"
 #include "util/time.h"
 
 namespace starrocks::vectorized {
 
-// 0x1. initial global runtime filter impl
-// 0x2. change simd-block-filter hash function.
-static const uint8_t RF_VERSION = 0x2;
-
 struct FilterBuilder {
     template <PrimitiveType ptype>
     JoinRuntimeFilter* operator()() {
@@ -39,17 +38,23 @@ JoinRuntimeFilter* RuntimeFilterHelper::create_join_runtime_filter(ObjectPool* p
     }
 }
 
+static uint8_t serialize_version_of(const JoinRuntimeFilter* rf) {
+    return rf->is_partitioned_by_bucket() ? RF_VERSION_V3 : RF_VERSION_V2;
+}
+
 size_t RuntimeFilterHelper::max_runtime_filter_serialized_size(const JoinRuntimeFilter* rf) {
-    size_t size = sizeof(RF_VERSION);
-    size += rf->max_serialized_size();
+    uint8_t version = serialize_version_of(rf);
+    size_t size = sizeof(version);
+    size += rf->max_serialized_size(version);
     return size;
 }
 size_t RuntimeFilterHelper::serialize_runtime_filter(const JoinRuntimeFilter* rf, uint8_t* data) {
     size_t offset = 0;
     // put version at the head.
-    memcpy(data + offset, &RF_VERSION, sizeof(RF_VERSION));
-    offset += sizeof(RF_VERSION);
-    offset += rf->serialize(data + offset);
+    uint8_t version = serialize_version_of(rf);
+    memcpy(data + offset, &version, sizeof(version));
+    offset += sizeof(version);
+    offset += rf->serialize(version, data + offset);
     return offset;
 }
 
@@ -63,7 +68,7 @@ void RuntimeFilterHelper::deserialize_runtime_filter(ObjectPool* pool, JoinRunti
     uint8_t version = 0;
     memcpy(&version, data, sizeof(version));
     offset += sizeof(version);
-    if (version != RF_VERSION) {
+    if (version != RF_VERSION_V2 && version != RF_VERSION_V3) {
         // version mismatch and skip this chunk.
         return;
     }
@@ -74,7 +79,7 @@ void RuntimeFilterHelper::deserialize_runtime_filter(ObjectPool* pool, JoinRunti
     JoinRuntimeFilter* filter = create_join_runtime_filter(pool, type);
     DCHECK(filter != nullptr);
     if (filter != nullptr) {
-        offset += filter->deserialize(data + offset);
+        offset += filter->deserialize(version, data + offset);
         DCHECK(offset == size);
         *rf = filter;
     }
@@ -120,6 +125,93 @@ Status RuntimeFilterHelper::fill_runtime_bloom_filter(const ColumnPtr& column, P
     return Status::OK();
 }
 
+struct FilterBucketIniter {
+    template <PrimitiveType ptype>
+    auto operator()(const ColumnPtr& column, size_t column_offset, JoinRuntimeFilter* expr, bool eq_null,
+                    const std::vector<uint32_t>& buckets) {
+        using ColumnType = typename RunTimeTypeTraits<ptype>::ColumnType;
+        auto* filter = (RuntimeBloomFilter<ptype>*)(expr);
+
+        if (column->is_nullable()) {
+            auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>(column);
+            auto& data_array = ColumnHelper::as_raw_column<ColumnType>(nullable_column->data_column())->get_data();
+            for (size_t j = column_offset; j < data_array.size(); j++) {
+                if (!nullable_column->is_null(j)) {
+                    filter->insert_into_bucket(&data_array[j], buckets[j]);
+                } else {
+                    if (eq_null) {
+                        filter->insert_into_bucket(nullptr, buckets[j]);
+                    }
+                }
+            }
+
+        } else {
+            auto& data_ptr = ColumnHelper::as_raw_column<ColumnType>(column)->get_data();
+            for (size_t j = column_offset; j < data_ptr.size(); j++) {
+                filter->insert_into_bucket(&data_ptr[j], buckets[j]);
+            }
+        }
+        return nullptr;
+    }
+};
+
+Status RuntimeFilterHelper::fill_runtime_bloom_filter_by_bucket(const std::vector<ColumnPtr>& columns,
+                                                                PrimitiveType type, JoinRuntimeFilter* filter,
+                                                                size_t column_offset, bool eq_null,
+                                                                size_t num_buckets) {
+    DCHECK_GT(num_buckets, 0);
+    // The same bucket_seq as the probe side computes by crc32_hash, see compute_hash_values_for_multi_part.
+    std::vector<std::vector<uint32_t>> column_buckets(columns.size());
+    std::vector<size_t> bucket_rows(num_buckets, 0);
+    for (size_t i = 0; i < columns.size(); i++) {
+        const auto& column = columns[i];
+        auto& buckets = column_buckets[i];
+        buckets.assign(column->size(), 0);
+        if (column->size() <= column_offset) {
+            continue;
+        }
+        column->crc32_hash(buckets.data(), column_offset, column->size());
+        for (size_t j = column_offset; j < buckets.size(); j++) {
+            buckets[j] %= num_buckets;
+            bucket_rows[buckets[j]]++;
+        }
+    }
+    filter->init_by_bucket(bucket_rows);
+    for (size_t i = 0; i < columns.size(); i++) {
+        type_dispatch_filter(type, nullptr, FilterBucketIniter(), columns[i], column_offset, filter, eq_null,
+                             column_buckets[i]);
+    }
+    return Status::OK();
+}
+
+struct FilterMinMaxOwner {
+    template <PrimitiveType ptype>
+    auto operator()(JoinRuntimeFilter* expr) {
+        auto* filter = (RuntimeBloomFilter<ptype>*)(expr);
+        filter->own_min_max();
+        return nullptr;
+    }
+};
+
+Status RuntimeFilterHelper::insert_into_runtime_bloom_filter(const ColumnPtr& column, PrimitiveType type,
+                                                             JoinRuntimeFilter* filter, size_t column_offset,
+                                                             bool eq_null, size_t num_buckets) {
+    if (num_buckets > 0) {
+        std::vector<uint32_t> buckets(column->size(), 0);
+        if (column->size() > column_offset) {
+            column->crc32_hash(buckets.data(), column_offset, column->size());
+            for (size_t j = column_offset; j < buckets.size(); j++) {
+                buckets[j] %= num_buckets;
+            }
+        }
+        type_dispatch_filter(type, nullptr, FilterBucketIniter(), column, column_offset, filter, eq_null, buckets);
+    } else {
+        type_dispatch_filter(type, nullptr, FilterIniter(), column, column_offset, filter, eq_null);
+    }
+    type_dispatch_filter(type, nullptr, FilterMinMaxOwner(), filter);
+    return Status::OK();
+}
+
 StatusOr<ExprContext*> RuntimeFilterHelper::rewrite_runtime_filter_in_cross_join_node(ObjectPool* pool,
                                                                                       ExprContext* conjunct,
                                                                                       Chunk* chunk) {
@@ -172,6 +264,11 @@ Status RuntimeFilterBuildDescriptor::init(ObjectPool* pool, const TRuntimeFilter
     _build_expr_order = desc.expr_order;
     _has_remote_targets = desc.has_remote_targets;
     _join_mode = desc.build_join_mode;
+    if (config::enable_bucket_local_runtime_filter && desc.__isset.bucketseq_to_instance &&
+        (_join_mode == TRuntimeFilterBuildJoinMode::COLOCATE ||
+         _join_mode == TRuntimeFilterBuildJoinMode::LOCAL_HASH_BUCKET)) {
+        _num_buckets = desc.bucketseq_to_instance.size();
+    }
 
     if (desc.__isset.runtime_filter_merge_nodes) {
         _merge_nodes = desc.runtime_filter_merge_nodes;
@@ -318,24 +415,60 @@ void RuntimeFilterProbeCollector::close(RuntimeState* state) {
     }
 }
 
+void RuntimeFilterSampleStats::update(int64_t num_input_rows, int64_t num_output_rows, int64_t ns,
+                                      int64_t window_rows) {
+    input_rows += num_input_rows;
+    output_rows += num_output_rows;
+    eval_ns += ns;
+    if (input_rows >= window_rows) {
+        input_rows /= 2;
+        output_rows /= 2;
+        eval_ns /= 2;
+    }
+}
+
+std::vector<int32_t> select_runtime_filters(const std::map<int32_t, RuntimeFilterSampleStats>& stats,
+                                            double max_keep_ratio, size_t max_num_filters) {
+    std::vector<std::pair<double, int32_t>> candidates;
+    for (const auto& [filter_id, filter_stats] : stats) {
+        if (filter_stats.input_rows > 0 && filter_stats.keep_ratio() <= max_keep_ratio) {
+            candidates.emplace_back(filter_stats.rank(), filter_id);
+        }
+    }
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+    std::vector<int32_t> filter_ids;
+    for (size_t i = 0; i < candidates.size() && i < max_num_filters; i++) {
+        filter_ids.push_back(candidates[i].second);
+    }
+    return filter_ids;
+}
+
+size_t RuntimeFilterProbeCollector::_num_arrived_filters() const {
+    size_t num_arrived_filters = 0;
+    for (const auto& [filter_id, rf_desc] : _descriptors) {
+        num_arrived_filters += rf_desc->runtime_filter() != nullptr;
+    }
+    return num_arrived_filters;
+}
+
 // do_evaluate is reentrant, can be called concurrently by multiple operators that shared the same
 // RuntimeFilterProbeCollector.
 void RuntimeFilterProbeCollector::do_evaluate(vectorized::Chunk* chunk, RuntimeBloomFilterEvalContext& eval_context) {
-    if ((eval_context.input_chunk_nums++ & 31) == 0) {
+    size_t num_arrived_filters = _num_arrived_filters();
+    if (eval_context.input_chunk_nums++ % kSampleChunkInterval == 0 ||
+        num_arrived_filters != eval_context.num_arrived_filters) {
+        eval_context.num_arrived_filters = num_arrived_filters;
         update_selectivity(chunk, eval_context);
         return;
     }
-    if (!eval_context.selectivity.empty()) {
+    if (!eval_context.selected_filters.empty()) {
         auto& selection = eval_context.running_context.selection;
         eval_context.running_context.use_merged_selection = false;
         eval_context.running_context.compatibility =
                 _runtime_state->func_version() <= 3 || !_runtime_state->enable_pipeline_engine();
-        for (auto& kv : eval_context.selectivity) {
-            RuntimeFilterProbeDescriptor* rf_desc = kv.second;
+        for (RuntimeFilterProbeDescriptor* rf_desc : eval_context.selected_filters) {
             const JoinRuntimeFilter* filter = rf_desc->runtime_filter();
-            if (filter == nullptr) {
-                continue;
-            }
             auto* ctx = rf_desc->probe_expr_ctx();
             ColumnPtr column = EVALUATE_NULL_IF_ERROR(ctx, ctx->root(), chunk);
             // for colocate grf
@@ -362,6 +495,9 @@ void RuntimeFilterProbeCollector::init_counter() {
             ADD_COUNTER(_runtime_profile, "JoinRuntimeFilterOutputRows", TUnit::UNIT);
     _eval_context.join_runtime_filter_eval_counter =
             ADD_COUNTER(_runtime_profile, "JoinRuntimeFilterEvaluate", TUnit::UNIT);
+    _eval_context.join_runtime_filter_disabled_counter =
+            ADD_COUNTER(_runtime_profile, "JoinRuntimeFilterDisabled", TUnit::UNIT);
+    _eval_context.runtime_profile = _runtime_profile;
 }
 
 void RuntimeFilterProbeCollector::evaluate(vectorized::Chunk* chunk) {
@@ -388,15 +524,17 @@ void RuntimeFilterProbeCollector::evaluate(vectorized::Chunk* chunk, RuntimeBloo
     }
 }
 
+// Evaluate every arrived runtime filter on the sampled chunk respectively, to measure its selectivity and cost,
+// then select the filters for the following chunks.
 void RuntimeFilterProbeCollector::update_selectivity(vectorized::Chunk* chunk,
                                                      RuntimeBloomFilterEvalContext& eval_context) {
-    eval_context.selectivity.clear();
     size_t chunk_size = chunk->num_rows();
     auto& merged_selection = eval_context.running_context.merged_selection;
     auto& use_merged_selection = eval_context.running_context.use_merged_selection;
     eval_context.running_context.compatibility =
             _runtime_state->func_version() <= 3 || !_runtime_state->enable_pipeline_engine();
     use_merged_selection = true;
+    MonotonicStopWatch watch;
     for (auto& it : _descriptors) {
         RuntimeFilterProbeDescriptor* rf_desc = it.second;
         const JoinRuntimeFilter* filter = rf_desc->runtime_filter();
@@ -406,6 +544,7 @@ void RuntimeFilterProbeCollector::update_selectivity(vectorized::Chunk* chunk,
         auto& selection = eval_context.running_context.use_merged_selection
                                   ? eval_context.running_context.merged_selection
                                   : eval_context.running_context.selection;
+        watch.start();
         auto ctx = rf_desc->probe_expr_ctx();
         ColumnPtr column = EVALUATE_NULL_IF_ERROR(ctx, ctx->root(), chunk);
         // for colocate grf
@@ -413,42 +552,67 @@ void RuntimeFilterProbeCollector::update_selectivity(vectorized::Chunk* chunk,
         // true count is not accummulated, it is evaluated for each RF respectively
         filter->evaluate(column.get(), &eval_context.running_context);
         auto true_count = SIMD::count_nonzero(selection);
+        watch.stop();
         eval_context.run_filter_nums += 1;
-        double selectivity = true_count * 1.0 / chunk_size;
-        if (selectivity <= 0.5) {     // useful filter
-            if (selectivity < 0.05) { // very useful filter, could early return
-                eval_context.selectivity.clear();
-                eval_context.selectivity.emplace(selectivity, rf_desc);
-                chunk->filter(selection);
-                return;
-            }
-
-            // Only choose three most selective runtime filters
-            if (eval_context.selectivity.size() < 3) {
-                eval_context.selectivity.emplace(selectivity, rf_desc);
-            } else {
-                auto it = eval_context.selectivity.end();
-                it--;
-                if (selectivity < it->first) {
-                    eval_context.selectivity.erase(it);
-                    eval_context.selectivity.emplace(selectivity, rf_desc);
-                }
-            }
+        eval_context.sample_stats[rf_desc->filter_id()].update(chunk_size, true_count, watch.elapsed_time(),
+                                                               config::runtime_filter_sample_window_rows);
 
-            if (use_merged_selection) {
-                use_merged_selection = false;
-            } else {
-                uint8_t* dest = merged_selection.data();
-                const uint8_t* src = selection.data();
-                for (size_t j = 0; j < chunk_size; ++j) {
-                    dest[j] = src[j] & dest[j];
-                }
+        if (true_count * 1.0 / chunk_size < 0.05) { // very useful filter, could early return
+            chunk->filter(selection);
+            _select_filters(eval_context);
+            return;
+        }
+        if (true_count == chunk_size) {
+            continue;
+        }
+        // The rows filtered by any runtime filter are removed from the sampled chunk.
+        if (use_merged_selection) {
+            use_merged_selection = false;
+        } else {
+            uint8_t* dest = merged_selection.data();
+            const uint8_t* src = selection.data();
+            for (size_t j = 0; j < chunk_size; ++j) {
+                dest[j] = src[j] & dest[j];
             }
         }
     }
-    if (!eval_context.selectivity.empty()) {
+    if (!use_merged_selection) {
         chunk->filter(merged_selection);
     }
+    _select_filters(eval_context);
+}
+
+void RuntimeFilterProbeCollector::_select_filters(RuntimeBloomFilterEvalContext& eval_context) {
+    const double max_keep_ratio = config::runtime_filter_max_keep_ratio;
+    auto filter_ids = select_runtime_filters(eval_context.sample_stats, max_keep_ratio, kMaxSelectedFilters);
+    eval_context.selected_filters.clear();
+    for (int32_t filter_id : filter_ids) {
+        eval_context.selected_filters.push_back(_descriptors[filter_id]);
+    }
+
+    if (eval_context.runtime_profile == nullptr) {
+        return;
+    }
+    // e.g. "selected: 3(keep=0.02), 1(keep=0.31); disabled: 2(keep=0.97)"
+    std::stringstream ss;
+    ss << std::setprecision(2) << "selected: ";
+    for (size_t i = 0; i < filter_ids.size(); i++) {
+        ss << (i > 0 ? ", " : "") << filter_ids[i] << "(keep=" << eval_context.sample_stats[filter_ids[i]].keep_ratio()
+           << ")";
+    }
+    ss << "; disabled: ";
+    int64_t num_disabled = 0;
+    for (const auto& [filter_id, stats] : eval_context.sample_stats) {
+        if (stats.keep_ratio() > max_keep_ratio) {
+            ss << (num_disabled++ > 0 ? ", " : "") << filter_id << "(keep=" << stats.keep_ratio() << ")";
+        }
+    }
+    std::string selection_info = ss.str();
+    if (selection_info != eval_context.selection_info) {
+        eval_context.selection_info = std::move(selection_info);
+        eval_context.runtime_profile->add_info_string("JoinRuntimeFilterSelection", eval_context.selection_info);
+        COUNTER_SET(eval_context.join_runtime_filter_disabled_counter, num_disabled);
+    }
 }
 
 void RuntimeFilterProbeCollector::push_down(RuntimeFilterProbeCollector* parent, const std::vector<TupleId>& tuple_ids,
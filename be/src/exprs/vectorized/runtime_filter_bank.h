@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <map>
 #include <mutex>
 #include <set>
 
@@ -43,6 +45,17 @@ public:
     static JoinRuntimeFilter* create_runtime_bloom_filter(ObjectPool* pool, PrimitiveType type);
     static Status fill_runtime_bloom_filter(const ColumnPtr& column, PrimitiveType type, JoinRuntimeFilter* filter,
                                             size_t column_offset, bool eq_null);
+    // Fill the filter partitioned by bucket with all the build |columns| of the filter, whose rows are put into
+    // the bloom filter of the bucket they belong to, so the probe side only tests the rows against their bucket.
+    static Status fill_runtime_bloom_filter_by_bucket(const std::vector<ColumnPtr>& columns, PrimitiveType type,
+                                                      JoinRuntimeFilter* filter, size_t column_offset, bool eq_null,
+                                                      size_t num_buckets);
+    // Insert the rows of |column| into the |filter| initialized beforehand, by init_by_bucket if |num_buckets| > 0.
+    // Unlike the fill functions above, the filter doesn't refer to the memory of |column| afterwards, so it can be
+    // built incrementally from columns released soon after.
+    static Status insert_into_runtime_bloom_filter(const ColumnPtr& column, PrimitiveType type,
+                                                   JoinRuntimeFilter* filter, size_t column_offset, bool eq_null,
+                                                   size_t num_buckets);
 
     static StatusOr<ExprContext*> rewrite_runtime_filter_in_cross_join_node(ObjectPool* pool, ExprContext* conjunct,
                                                                             Chunk* chunk);
@@ -69,6 +82,8 @@ public:
     bool has_remote_targets() const { return _has_remote_targets; }
     bool has_consumer() const { return _has_consumer; }
     int8_t join_mode() const { return _join_mode; }
+    // Number of buckets of a colocate or bucket shuffle join whose filter is partitioned by bucket, 0 otherwise.
+    size_t num_buckets() const { return _num_buckets; }
     const std::vector<TNetworkAddress>& merge_nodes() const { return _merge_nodes; }
     void set_runtime_filter(JoinRuntimeFilter* rf) { _runtime_filter = rf; }
     JoinRuntimeFilter* runtime_filter() { return _runtime_filter; }
@@ -85,6 +100,7 @@ private:
     bool _has_remote_targets;
     bool _has_consumer;
     int8_t _join_mode;
+    size_t _num_buckets = 0;
     TUniqueId _sender_finst_id;
     std::unordered_set<TUniqueId> _broadcast_grf_senders;
     std::vector<TRuntimeFilterDestination> _broadcast_grf_destinations;
@@ -141,20 +157,49 @@ private:
     std::vector<int32_t> _bucketseq_to_partition;
 };
 
+// The selectivity and cost of a runtime filter measured on the sampled chunks.
+struct RuntimeFilterSampleStats {
+    int64_t input_rows = 0;
+    int64_t output_rows = 0;
+    int64_t eval_ns = 0;
+
+    // Accumulate a sampled chunk, the stats are halved once |window_rows| rows are sampled,
+    // so the stats mostly reflect the recent samples.
+    void update(int64_t num_input_rows, int64_t num_output_rows, int64_t ns, int64_t window_rows);
+    double keep_ratio() const { return input_rows == 0 ? 1.0 : static_cast<double>(output_rows) / input_rows; }
+    // Number of rows filtered out per nanosecond.
+    double rank() const { return (input_rows - output_rows) / static_cast<double>(std::max<int64_t>(eval_ns, 1)); }
+};
+
+// Return the ids of the runtime filters worth evaluating, the ones keeping more than |max_keep_ratio| of rows are
+// disabled. The others are ordered by rank in descending order, i.e. the cheaper and more selective ones first,
+// and at most |max_num_filters| of them are returned.
+std::vector<int32_t> select_runtime_filters(const std::map<int32_t, RuntimeFilterSampleStats>& stats,
+                                            double max_keep_ratio, size_t max_num_filters);
+
 // RuntimeFilterProbeCollector::do_evaluate function apply runtime bloom filter to Operators to filter chunk.
 // this function is non-reentrant, variables inside RuntimeFilterProbeCollector that hinder reentrancy is moved
 // into RuntimeBloomFilterEvalContext and make do_evaluate function can be called concurrently.
 struct RuntimeBloomFilterEvalContext {
     RuntimeBloomFilterEvalContext() = default;
 
-    std::map<double, RuntimeFilterProbeDescriptor*> selectivity;
+    // The runtime filters evaluated on the chunks not sampled, in the order of evaluation.
+    std::vector<RuntimeFilterProbeDescriptor*> selected_filters;
+    // The stats of every arrived runtime filter by filter id.
+    std::map<int32_t, RuntimeFilterSampleStats> sample_stats;
+    // Number of arrived runtime filters when the filters are selected.
+    size_t num_arrived_filters = 0;
+    // The selected and disabled filters shown in the profile, only updated when it's changed.
+    std::string selection_info;
     size_t input_chunk_nums = 0;
     int run_filter_nums = 0;
     JoinRuntimeFilter::RunningContext running_context;
+    RuntimeProfile* runtime_profile = nullptr;
     RuntimeProfile::Counter* join_runtime_filter_timer = nullptr;
     RuntimeProfile::Counter* join_runtime_filter_input_counter = nullptr;
     RuntimeProfile::Counter* join_runtime_filter_output_counter = nullptr;
     RuntimeProfile::Counter* join_runtime_filter_eval_counter = nullptr;
+    RuntimeProfile::Counter* join_runtime_filter_disabled_counter = nullptr;
 };
 
 // The collection of `RuntimeFilterProbeDescriptor`
@@ -190,8 +235,15 @@ public:
     int plan_node_id() { return _plan_node_id; }
 
 private:
+    // The runtime filters are selected by sampling one of every kSampleChunkInterval chunks,
+    // and the chunk after new runtime filters arrive.
+    static constexpr size_t kSampleChunkInterval = 32;
+    static constexpr size_t kMaxSelectedFilters = 3;
+
+    size_t _num_arrived_filters() const;
     void update_selectivity(vectorized::Chunk* chunk);
     void update_selectivity(vectorized::Chunk* chunk, RuntimeBloomFilterEvalContext& eval_context);
+    void _select_filters(RuntimeBloomFilterEvalContext& eval_context);
     // TODO: return a funcion call status
     void do_evaluate(vectorized::Chunk* chunk);
     void do_evaluate(vectorized::Chunk* chunk, RuntimeBloomFilterEvalContext& eval_context);
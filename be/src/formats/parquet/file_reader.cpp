@@ -13,6 +13,7 @@
 #include "fs/fs.h"
 #include "gen_cpp/parquet_types.h"
 #include "gutil/strings/substitute.h"
+#include "runtime/exec_env.h"
 #include "storage/chunk_helper.h"
 #include "util/coding.h"
 #include "util/defer_op.h"
@@ -444,6 +445,8 @@ Status FileReader::_init_group_readers() {
                 .max_dist_size = config::io_coalesce_read_max_distance_size,
                 .max_buffer_size = config::io_coalesce_read_max_buffer_size};
         _sb_stream->set_coalesce_options(options);
+        _sb_stream->set_prefetch_options(ExecEnv::GetInstance()->io_prefetch_pool(),
+                                         config::io_prefetch_max_buffer_size);
 
         std::vector<SharedBufferedInputStream::IORange> ranges;
         for (auto& r : _row_group_readers) {
@@ -0,0 +1,489 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#include "fs/block_cache.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+#include "common/logging.h"
+#include "fs/fs.h"
+#include "util/coding.h"
+#include "util/hash_util.hpp"
+#include "util/threadpool.h"
+
+namespace starrocks {
+
+static constexpr uint32_t kBlockFileMagic = 0x53524243; // "SRBC"
+static constexpr int64_t kBlockFileTrailerSize = 8;
+static constexpr const char* kTmpFileSuffix = ".tmp";
+
+BlockCache* BlockCache::instance() {
+    static BlockCache cache;
+    return &cache;
+}
+
+BlockCache::BlockCache() = default;
+
+BlockCache::~BlockCache() {
+    shutdown();
+}
+
+Status BlockCache::init(const std::string& dir, int64_t capacity, int64_t block_size, int populate_threads) {
+    if (is_enabled()) {
+        return Status::InternalError("block cache has been initialized");
+    }
+    if (capacity <= 0 || block_size <= 0) {
+        return Status::InvalidArgument(
+                fmt::format("invalid block cache capacity {} or block size {}", capacity, block_size));
+    }
+    _dir = dir;
+    _capacity = capacity;
+    _block_size = block_size;
+    RETURN_IF_ERROR(FileSystem::Default()->create_dir_recursive(_dir));
+    RETURN_IF_ERROR(_load_blocks());
+    RETURN_IF_ERROR(ThreadPoolBuilder("block_cache")
+                            .set_min_threads(0)
+                            .set_max_threads(std::max(1, populate_threads))
+                            .set_max_queue_size(kMaxPopulatingBlocks)
+                            .build(&_populate_pool));
+    _enabled.store(true, std::memory_order_release);
+    LOG(INFO) << "Initialized block cache at " << _dir << ", capacity: " << _capacity << ", block size: " << _block_size
+              << ", loaded blocks: " << num_blocks() << ", loaded bytes: " << size();
+    return Status::OK();
+}
+
+void BlockCache::shutdown() {
+    _enabled.store(false, std::memory_order_release);
+    if (_populate_pool != nullptr) {
+        _populate_pool->shutdown();
+        _populate_pool.reset();
+    }
+    std::lock_guard l(_mutex);
+    _entries.clear();
+    _lru.clear();
+    _size = 0;
+    _populating.clear();
+}
+
+std::string BlockCache::_block_key(const std::string& path, int64_t block_offset) {
+    // The hash function must be stable across processes, because the key is persisted as file name.
+    uint64_t hash = HashUtil::murmur_hash64A(path.data(), static_cast<int32_t>(path.size()), 0);
+    return fmt::format("{:016x}_{}", hash, block_offset);
+}
+
+static bool is_block_key(std::string_view name) {
+    if (name.size() < 18 || name[16] != '_') {
+        return false;
+    }
+    for (size_t i = 0; i < name.size(); i++) {
+        if (i == 16) {
+            continue;
+        }
+        bool valid = i < 16 ? isxdigit(name[i]) : isdigit(name[i]);
+        if (!valid) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Status BlockCache::_load_blocks() {
+    auto fs = FileSystem::Default();
+    std::vector<std::string> names;
+    RETURN_IF_ERROR(fs->get_children(_dir, &names));
+
+    std::vector<std::pair<uint64_t, EntryPtr>> loaded;
+    for (const auto& name : names) {
+        auto file = _block_file(name);
+        if (!is_block_key(name)) {
+            // Files written partially by the previous process.
+            if (name.size() > strlen(kTmpFileSuffix) &&
+                name.compare(name.size() - strlen(kTmpFileSuffix), std::string::npos, kTmpFileSuffix) == 0) {
+                WARN_IF_ERROR(fs->delete_file(file), "fail to delete block cache file " + file);
+            }
+            continue;
+        }
+        auto size_or = fs->get_file_size(file);
+        auto mtime_or = fs->get_file_modified_time(file);
+        if (!size_or.ok() || !mtime_or.ok() || size_or.value() <= kBlockFileTrailerSize) {
+            WARN_IF_ERROR(fs->delete_file(file), "fail to delete block cache file " + file);
+            continue;
+        }
+        auto entry = std::make_shared<Entry>();
+        entry->key = name;
+        entry->file_size = size_or.value();
+        loaded.emplace_back(mtime_or.value(), std::move(entry));
+    }
+
+    // Insert the oldest block first, so the newest block is the most recently used one.
+    std::sort(loaded.begin(), loaded.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    std::vector<std::string> evicted;
+    {
+        std::lock_guard l(_mutex);
+        for (auto& [mtime, entry] : loaded) {
+            auto files = _insert(std::move(entry));
+            evicted.insert(evicted.end(), files.begin(), files.end());
+        }
+    }
+    _delete_files(evicted);
+    return Status::OK();
+}
+
+std::vector<std::string> BlockCache::_insert(EntryPtr entry) {
+    auto it = _entries.find(entry->key);
+    if (it != _entries.end()) {
+        _lru.erase(it->second->lru_pos);
+        _size -= it->second->file_size;
+        _entries.erase(it);
+    }
+    _lru.push_front(entry.get());
+    entry->lru_pos = _lru.begin();
+    _size += entry->file_size;
+    _entries.emplace(entry->key, std::move(entry));
+    return _evict_if_needed();
+}
+
+std::vector<std::string> BlockCache::_evict_if_needed() {
+    std::vector<std::string> evicted;
+    while (_size > _capacity && !_lru.empty()) {
+        Entry* victim = _lru.back();
+        _lru.pop_back();
+        _size -= victim->file_size;
+        evicted.emplace_back(_block_file(victim->key));
+        // |victim| is destroyed here unless it's being read.
+        _entries.erase(victim->key);
+    }
+    return evicted;
+}
+
+void BlockCache::_remove(const std::string& key) {
+    {
+        std::lock_guard l(_mutex);
+        auto it = _entries.find(key);
+        if (it == _entries.end()) {
+            return;
+        }
+        _lru.erase(it->second->lru_pos);
+        _size -= it->second->file_size;
+        _entries.erase(it);
+    }
+    _delete_files({_block_file(key)});
+}
+
+void BlockCache::_delete_files(const std::vector<std::string>& files) {
+    for (const auto& file : files) {
+        WARN_IF_ERROR(FileSystem::Default()->delete_file(file), "fail to delete block cache file " + file);
+    }
+}
+
+Status BlockCache::read(const std::string& path, int64_t block_offset, int64_t offset_in_block, void* out,
+                        int64_t count) {
+    if (!is_enabled()) {
+        return Status::NotFound("block cache is disabled");
+    }
+    auto key = _block_key(path, block_offset);
+    EntryPtr entry;
+    std::string cached_path;
+    int64_t data_size = 0;
+    {
+        std::lock_guard l(_mutex);
+        auto it = _entries.find(key);
+        if (it == _entries.end()) {
+            return Status::NotFound(key);
+        }
+        entry = it->second;
+        _lru.splice(_lru.begin(), _lru, entry->lru_pos);
+        cached_path = entry->path;
+        data_size = entry->data_size;
+    }
+
+    // The block file may be evicted concurrently, the opened file can still be read in that case.
+    auto file_or = FileSystem::Default()->new_random_access_file(_block_file(key));
+    if (!file_or.ok()) {
+        return Status::NotFound(file_or.status().get_error_msg());
+    }
+    auto& file = file_or.value();
+    if (cached_path.empty()) {
+        // Verify the block loaded from disk by the path saved in its trailer.
+        uint8_t trailer[kBlockFileTrailerSize];
+        int64_t trailer_offset = entry->file_size - kBlockFileTrailerSize;
+        auto st = file->read_at_fully(trailer_offset, trailer, kBlockFileTrailerSize);
+        uint32_t path_size = decode_fixed32_le(trailer);
+        if (st.ok() && (decode_fixed32_le(trailer + 4) != kBlockFileMagic || path_size > trailer_offset)) {
+            st = Status::Corruption("bad block cache file trailer");
+        }
+        if (st.ok()) {
+            cached_path.resize(path_size);
+            st = file->read_at_fully(trailer_offset - path_size, cached_path.data(), path_size);
+        }
+        if (!st.ok()) {
+            LOG(WARNING) << "Remove block cache file " << _block_file(key) << ": " << st;
+            _remove(key);
+            return Status::NotFound(st.get_error_msg());
+        }
+        data_size = trailer_offset - path_size;
+        std::lock_guard l(_mutex);
+        entry->path = cached_path;
+        entry->data_size = data_size;
+    }
+    // Different paths may have the same hash value.
+    if (cached_path != path || offset_in_block + count > data_size) {
+        return Status::NotFound(key);
+    }
+    RETURN_IF_ERROR(file->read_at_fully(offset_in_block, out, count));
+    _hit_bytes.fetch_add(count, std::memory_order_relaxed);
+    return Status::OK();
+}
+
+void BlockCache::populate(const std::string& path, int64_t block_offset, std::string_view data) {
+    if (!is_enabled() || data.empty()) {
+        return;
+    }
+    auto key = _block_key(path, block_offset);
+    {
+        std::lock_guard l(_mutex);
+        if (_entries.count(key) > 0 || _populating.count(key) > 0 || _populating.size() >= kMaxPopulatingBlocks) {
+            return;
+        }
+        _populating.insert(key);
+    }
+    auto st = _populate_pool->submit_func([this, key, path, data = std::string(data)]() {
+        _do_populate(key, path, data);
+        std::lock_guard l(_mutex);
+        _populating.erase(key);
+    });
+    if (!st.ok()) {
+        std::lock_guard l(_mutex);
+        _populating.erase(key);
+    }
+}
+
+void BlockCache::_do_populate(const std::string& key, const std::string& path, const std::string& data) {
+    auto fs = FileSystem::Default();
+    auto file = _block_file(key);
+    auto tmp_file = file + kTmpFileSuffix;
+    uint8_t trailer[kBlockFileTrailerSize];
+    encode_fixed32_le(trailer, path.size());
+    encode_fixed32_le(trailer + 4, kBlockFileMagic);
+
+    auto st = [&]() -> Status {
+        WritableFileOptions opts;
+        opts.sync_on_close = false;
+        opts.mode = FileSystem::CREATE_OR_OPEN_WITH_TRUNCATE;
+        ASSIGN_OR_RETURN(auto writer, fs->new_writable_file(opts, tmp_file));
+        Slice slices[3] = {Slice(data), Slice(path), Slice(trailer, kBlockFileTrailerSize)};
+        RETURN_IF_ERROR(writer->appendv(slices, 3));
+        RETURN_IF_ERROR(writer->close());
+        return fs->rename_file(tmp_file, file);
+    }();
+    if (!st.ok()) {
+        LOG(WARNING) << "Fail to write block cache file " << file << ": " << st;
+        WARN_IF_ERROR(fs->delete_file(tmp_file), "fail to delete block cache file " + tmp_file);
+        return;
+    }
+
+    auto entry = std::make_shared<Entry>();
+    entry->key = key;
+    entry->path = path;
+    entry->data_size = data.size();
+    entry->file_size = data.size() + path.size() + kBlockFileTrailerSize;
+    std::vector<std::string> evicted;
+    {
+        std::lock_guard l(_mutex);
+        evicted = _insert(std::move(entry));
+    }
+    _delete_files(evicted);
+}
+
+void BlockCache::wait_for_populating() {
+    if (_populate_pool != nullptr) {
+        _populate_pool->wait();
+    }
+}
+
+int64_t BlockCache::size() const {
+    std::lock_guard l(_mutex);
+    return _size;
+}
+
+size_t BlockCache::num_blocks() const {
+    std::lock_guard l(_mutex);
+    return _entries.size();
+}
+
+BlockCacheInputStream::BlockCacheInputStream(std::shared_ptr<io::SeekableInputStream> stream, std::string path,
+                                             BlockCache* cache)
+        : _stream(std::move(stream)), _path(std::move(path)), _cache(cache) {}
+
+StatusOr<int64_t> BlockCacheInputStream::read(void* data, int64_t count) {
+    ASSIGN_OR_RETURN(auto nread, read_at(_offset, data, count));
+    _offset += nread;
+    return nread;
+}
+
+Status BlockCacheInputStream::seek(int64_t position) {
+    if (position < 0) {
+        return Status::InvalidArgument(fmt::format("Invalid position {}", position));
+    }
+    _offset = position;
+    return Status::OK();
+}
+
+StatusOr<int64_t> BlockCacheInputStream::get_size() {
+    if (_size < 0) {
+        ASSIGN_OR_RETURN(_size, _stream->get_size());
+    }
+    return _size;
+}
+
+StatusOr<int64_t> BlockCacheInputStream::read_at(int64_t offset, void* out, int64_t count) {
+    if (offset < 0 || count < 0) {
+        return Status::InvalidArgument(fmt::format("Invalid offset {} or count {}", offset, count));
+    }
+    ASSIGN_OR_RETURN(auto file_size, get_size());
+    count = std::min(count, std::max<int64_t>(0, file_size - offset));
+
+    const int64_t block_size = _cache->block_size();
+    auto* dst = static_cast<uint8_t*>(out);
+    int64_t end = offset + count;
+    while (offset < end) {
+        int64_t block_offset = offset / block_size * block_size;
+        int64_t offset_in_block = offset - block_offset;
+        int64_t len = std::min(end - offset, block_size - offset_in_block);
+        if (_cache->read(_path, block_offset, offset_in_block, dst, len).ok()) {
+            _hit_bytes += len;
+        } else {
+            // Read the whole block, so the following reads of this block can hit the cache.
+            int64_t block_len = std::min(block_size, file_size - block_offset);
+            _buffer.resize(block_len);
+            RETURN_IF_ERROR(_stream->read_at_fully(block_offset, _buffer.data(), block_len));
+            memcpy(dst, _buffer.data() + offset_in_block, len);
+            _cache->populate(_path, block_offset, _buffer);
+            _cache->add_miss_bytes(len);
+            _miss_bytes += len;
+        }
+        dst += len;
+        offset += len;
+    }
+    return count;
+}
+
+Status BlockCacheInputStream::read_at_fully(int64_t offset, void* out, int64_t count) {
+    ASSIGN_OR_RETURN(auto nread, read_at(offset, out, count));
+    if (nread != count) {
+        return Status::IOError(fmt::format("Cannot read {} bytes at offset {} of {}, only {} bytes read", count,
+                                           offset, _path, nread));
+    }
+    return Status::OK();
+}
+
+StatusOr<std::unique_ptr<io::NumericStatistics>> BlockCacheInputStream::get_numeric_statistics() {
+    ASSIGN_OR_RETURN(auto stats, _stream->get_numeric_statistics());
+    if (stats == nullptr) {
+        stats = std::make_unique<io::NumericStatistics>();
+    }
+    stats->append("BlockCacheHitBytes", _hit_bytes);
+    stats->append("BlockCacheMissBytes", _miss_bytes);
+    return std::move(stats);
+}
+
+// Delegates everything to the wrapped file system, except that random access files are read
+// through the block cache.
+class BlockCacheFileSystem final : public FileSystem {
+public:
+    explicit BlockCacheFileSystem(std::shared_ptr<FileSystem> fs) : _fs(std::move(fs)) {}
+
+    Type type() const override { return _fs->type(); }
+
+    StatusOr<std::unique_ptr<SequentialFile>> new_sequential_file(const std::string& fname) override {
+        return _fs->new_sequential_file(fname);
+    }
+
+    StatusOr<std::unique_ptr<RandomAccessFile>> new_random_access_file(const std::string& fname) override {
+        return new_random_access_file(RandomAccessFileOptions(), fname);
+    }
+
+    StatusOr<std::unique_ptr<RandomAccessFile>> new_random_access_file(const RandomAccessFileOptions& opts,
+                                                                       const std::string& fname) override {
+        ASSIGN_OR_RETURN(auto file, _fs->new_random_access_file(opts, fname));
+        auto stream = std::make_shared<BlockCacheInputStream>(file->stream(), fname, BlockCache::instance());
+        return std::make_unique<RandomAccessFile>(std::move(stream), fname);
+    }
+
+    StatusOr<std::unique_ptr<WritableFile>> new_writable_file(const std::string& fname) override {
+        return _fs->new_writable_file(fname);
+    }
+
+    StatusOr<std::unique_ptr<WritableFile>> new_writable_file(const WritableFileOptions& opts,
+                                                              const std::string& fname) override {
+        return _fs->new_writable_file(opts, fname);
+    }
+
+    Status path_exists(const std::string& fname) override { return _fs->path_exists(fname); }
+
+    Status get_children(const std::string& dir, std::vector<std::string>* result) override {
+        return _fs->get_children(dir, result);
+    }
+
+    Status list_path(const std::string& dir, std::vector<FileStatus>* result) override {
+        return _fs->list_path(dir, result);
+    }
+
+    Status iterate_dir(const std::string& dir, const std::function<bool(std::string_view)>& cb) override {
+        return _fs->iterate_dir(dir, cb);
+    }
+
+    Status delete_file(const std::string& fname) override { return _fs->delete_file(fname); }
+
+    Status create_dir(const std::string& dirname) override { return _fs->create_dir(dirname); }
+
+    Status create_dir_if_missing(const std::string& dirname, bool* created) override {
+        return _fs->create_dir_if_missing(dirname, created);
+    }
+
+    Status create_dir_recursive(const std::string& dirname) override { return _fs->create_dir_recursive(dirname); }
+
+    Status delete_dir(const std::string& dirname) override { return _fs->delete_dir(dirname); }
+
+    Status delete_dir_recursive(const std::string& dirname) override { return _fs->delete_dir_recursive(dirname); }
+
+    Status sync_dir(const std::string& dirname) override { return _fs->sync_dir(dirname); }
+
+    StatusOr<bool> is_directory(const std::string& path) override { return _fs->is_directory(path); }
+
+    Status canonicalize(const std::string& path, std::string* result) override {
+        return _fs->canonicalize(path, result);
+    }
+
+    StatusOr<uint64_t> get_file_size(const std::string& fname) override { return _fs->get_file_size(fname); }
+
+    StatusOr<uint64_t> get_file_modified_time(const std::string& fname) override {
+        return _fs->get_file_modified_time(fname);
+    }
+
+    Status rename_file(const std::string& src, const std::string& target) override {
+        return _fs->rename_file(src, target);
+    }
+
+    Status link_file(const std::string& old_path, const std::string& new_path) override {
+        return _fs->link_file(old_path, new_path);
+    }
+
+    StatusOr<SpaceInfo> space(const std::string& path) override { return _fs->space(path); }
+
+private:
+    std::shared_ptr<FileSystem> _fs;
+};
+
+std::shared_ptr<FileSystem> new_fs_block_cache(std::shared_ptr<FileSystem> fs) {
+    if (!BlockCache::instance()->is_enabled() || fs->type() == FileSystem::POSIX ||
+        fs->type() == FileSystem::MEMORY) {
+        return fs;
+    }
+    return std::make_shared<BlockCacheFileSystem>(std::move(fs));
+}
+
+} // namespace starrocks
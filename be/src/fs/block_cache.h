@@ -0,0 +1,163 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "common/statusor.h"
+#include "io/seekable_input_stream.h"
+
+namespace starrocks {
+
+class FileSystem;
+class ThreadPool;
+
+// BlockCache caches fixed-size blocks of remote files on the local disk, it's used to
+// accelerate the reading of lake segments, which are immutable once written.
+//
+// A block is identified by the (path, offset) pair, where offset is a multiple of the block
+// size. Every cached block is stored in its own file under the cache dir, named by the
+// hash of the path and the offset. The path is saved at the tail of the block file:
+//      [block data][path][path length: fixed32][magic: fixed32]
+// so blocks left by the previous process can be loaded (and verified lazily) on startup.
+//
+// Blocks are evicted in LRU order once the total size of the block files exceeds the capacity.
+// Missed blocks are written into the cache by a background thread pool, a block is dropped
+// instead of being queued when too many blocks are waiting to be written. The LRU order of
+// the blocks loaded on startup is approximated by the modification time of the block files.
+class BlockCache {
+public:
+    static BlockCache* instance();
+
+    BlockCache();
+    ~BlockCache();
+
+    BlockCache(const BlockCache&) = delete;
+    void operator=(const BlockCache&) = delete;
+
+    // Load the blocks under |dir| and start the populating threads.
+    Status init(const std::string& dir, int64_t capacity, int64_t block_size, int populate_threads);
+
+    // Wait for the in-flight populating tasks and disable the cache.
+    void shutdown();
+
+    bool is_enabled() const { return _enabled.load(std::memory_order_acquire); }
+
+    int64_t block_size() const { return _block_size; }
+    int64_t capacity() const { return _capacity; }
+
+    // Read |count| bytes at |offset_in_block| of the block (|path|, |block_offset|) into |out|.
+    // Return Status::NotFound if the block has not been cached.
+    Status read(const std::string& path, int64_t block_offset, int64_t offset_in_block, void* out, int64_t count);
+
+    // Write the block (|path|, |block_offset|) into the cache asynchronously, |data| is copied.
+    // Do nothing if the block is already cached or being written.
+    void populate(const std::string& path, int64_t block_offset, std::string_view data);
+
+    // Wait until all submitted populating tasks are done.
+    void wait_for_populating();
+
+    // Total size of the cached block files.
+    int64_t size() const;
+    size_t num_blocks() const;
+
+    int64_t hit_bytes() const { return _hit_bytes.load(std::memory_order_relaxed); }
+    int64_t miss_bytes() const { return _miss_bytes.load(std::memory_order_relaxed); }
+    void add_miss_bytes(int64_t bytes) { _miss_bytes.fetch_add(bytes, std::memory_order_relaxed); }
+
+private:
+    struct Entry {
+        std::string key;
+        int64_t data_size = 0;
+        int64_t file_size = 0;
+        // The path of the cached file. Empty for blocks loaded from disk, filled on the first read.
+        std::string path;
+        std::list<Entry*>::iterator lru_pos;
+    };
+    using EntryPtr = std::shared_ptr<Entry>;
+
+    // At most this number of blocks can be waiting to be written.
+    static constexpr size_t kMaxPopulatingBlocks = 64;
+
+    static std::string _block_key(const std::string& path, int64_t block_offset);
+    std::string _block_file(const std::string& key) const { return _dir + "/" + key; }
+
+    Status _load_blocks();
+    void _do_populate(const std::string& key, const std::string& path, const std::string& data);
+    // Insert |entry| as the most recently used block, return the evicted block files.
+    std::vector<std::string> _insert(EntryPtr entry);
+    std::vector<std::string> _evict_if_needed();
+    void _remove(const std::string& key);
+    void _delete_files(const std::vector<std::string>& files);
+
+    std::atomic<bool> _enabled{false};
+    std::string _dir;
+    int64_t _capacity = 0;
+    int64_t _block_size = 0;
+
+    mutable std::mutex _mutex;
+    std::unordered_map<std::string, EntryPtr> _entries;
+    // Front is the most recently used block.
+    std::list<Entry*> _lru;
+    int64_t _size = 0;
+    // Keys of the blocks being written.
+    std::unordered_set<std::string> _populating;
+
+    std::unique_ptr<ThreadPool> _populate_pool;
+
+    std::atomic<int64_t> _hit_bytes{0};
+    std::atomic<int64_t> _miss_bytes{0};
+};
+
+// BlockCacheInputStream reads |stream| through the BlockCache, every missed block is read from
+// |stream| as a whole and written into the cache.
+//
+// `get_numeric_statistics()` reports "BlockCacheHitBytes" and "BlockCacheMissBytes", which are
+// the requested bytes served by the cache and by the underlying stream respectively.
+class BlockCacheInputStream final : public io::SeekableInputStream {
+public:
+    BlockCacheInputStream(std::shared_ptr<io::SeekableInputStream> stream, std::string path, BlockCache* cache);
+
+    ~BlockCacheInputStream() override = default;
+
+    StatusOr<int64_t> read(void* data, int64_t count) override;
+
+    Status seek(int64_t position) override;
+
+    StatusOr<int64_t> position() override { return _offset; }
+
+    StatusOr<int64_t> read_at(int64_t offset, void* out, int64_t count) override;
+
+    Status read_at_fully(int64_t offset, void* out, int64_t count) override;
+
+    StatusOr<int64_t> get_size() override;
+
+    StatusOr<std::unique_ptr<io::NumericStatistics>> get_numeric_statistics() override;
+
+    int64_t hit_bytes() const { return _hit_bytes; }
+    int64_t miss_bytes() const { return _miss_bytes; }
+
+private:
+    std::shared_ptr<io::SeekableInputStream> _stream;
+    std::string _path;
+    BlockCache* _cache;
+    int64_t _offset = 0;
+    int64_t _size = -1;
+    std::string _buffer;
+    int64_t _hit_bytes = 0;
+    int64_t _miss_bytes = 0;
+};
+
+// Wrap |fs| so that its random access files are read through `BlockCache::instance()`.
+// Return |fs| itself if the block cache is disabled or |fs| is a local file system.
+std::shared_ptr<FileSystem> new_fs_block_cache(std::shared_ptr<FileSystem> fs);
+
+} // namespace starrocks
@@ -30,6 +30,7 @@ public:
     ~HdfsInputStream() override;
 
     StatusOr<int64_t> read(void* data, int64_t size) override;
+    Status pread_fully(int64_t offset, void* data, int64_t size) override;
     StatusOr<int64_t> get_size() override;
     StatusOr<int64_t> position() override { return _offset; }
     StatusOr<std::unique_ptr<io::NumericStatistics>> get_numeric_statistics() override;
@@ -68,6 +69,24 @@ StatusOr<int64_t> HdfsInputStream::read(void* data, int64_t size) {
     return r;
 }
 
+Status HdfsInputStream::pread_fully(int64_t offset, void* data, int64_t size) {
+    auto* buff = static_cast<char*>(data);
+    while (size > 0) {
+        auto to_read = static_cast<tSize>(std::min<int64_t>(size, std::numeric_limits<tSize>::max()));
+        tSize r = hdfsPread(_fs, _file, offset, buff, to_read);
+        if (r == -1) {
+            return Status::IOError(fmt::format("fail to hdfsPread {}: {}", _file_name, get_hdfs_err_msg()));
+        }
+        if (r == 0) {
+            return Status::IOError(fmt::format("cannot read fully from {}", _file_name));
+        }
+        buff += r;
+        offset += r;
+        size -= r;
+    }
+    return Status::OK();
+}
+
 Status HdfsInputStream::seek(int64_t offset) {
     if (offset < 0) return Status::InvalidArgument(fmt::format("Invalid offset {}", offset));
     _offset = offset;
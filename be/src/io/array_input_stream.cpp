@@ -19,6 +19,17 @@ StatusOr<int64_t> ArrayInputStream::read(void* data, int64_t count) {
     return n;
 }
 
+Status ArrayInputStream::pread_fully(int64_t offset, void* data, int64_t count) {
+    if (offset < 0 || count < 0) {
+        return Status::InvalidArgument(fmt::format("Invalid offset {} or count {}", offset, count));
+    }
+    if (offset + count > _size) {
+        return Status::IOError("cannot read fully");
+    }
+    memcpy(data, reinterpret_cast<const char*>(_data) + offset, count);
+    return Status::OK();
+}
+
 Status ArrayInputStream::seek(int64_t offset) {
     if (offset < 0) return Status::InvalidArgument(fmt::format("Invalid offset {}", offset));
     _offset = offset;
@@ -28,6 +28,8 @@ public:
 
     StatusOr<int64_t> read(void* data, int64_t count) override;
 
+    Status pread_fully(int64_t offset, void* data, int64_t count) override;
+
     bool allows_peek() const override { return true; }
 
     StatusOr<std::string_view> peek(int64_t nbytes) override;
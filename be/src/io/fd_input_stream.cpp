@@ -49,6 +49,25 @@ StatusOr<int64_t> FdInputStream::read(void* data, int64_t count) {
     return res;
 }
 
+Status FdInputStream::pread_fully(int64_t offset, void* data, int64_t count) {
+    CHECK_IS_CLOSED(_is_closed);
+    auto* buff = static_cast<char*>(data);
+    while (count > 0) {
+        ssize_t res;
+        RETRY_ON_EINTR(res, ::pread(_fd, buff, count, offset));
+        if (UNLIKELY(res < 0)) {
+            return io_error("pread", errno);
+        }
+        if (UNLIKELY(res == 0)) {
+            return Status::IOError("cannot read fully");
+        }
+        buff += res;
+        offset += res;
+        count -= res;
+    }
+    return Status::OK();
+}
+
 StatusOr<int64_t> FdInputStream::get_size() {
     CHECK_IS_CLOSED(_is_closed);
     struct stat st;
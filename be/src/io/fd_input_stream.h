@@ -20,6 +20,8 @@ public:
 
     StatusOr<int64_t> read(void* data, int64_t count) override;
 
+    Status pread_fully(int64_t offset, void* data, int64_t count) override;
+
     StatusOr<int64_t> get_size() override;
 
     StatusOr<int64_t> position() override { return _offset; }
@@ -39,6 +39,30 @@ StatusOr<int64_t> S3InputStream::read(void* out, int64_t count) {
     }
 }
 
+Status S3InputStream::pread_fully(int64_t offset, void* out, int64_t count) {
+    if (offset < 0 || count < 0) {
+        return Status::InvalidArgument(fmt::format("Invalid offset {} or count {}", offset, count));
+    }
+    if (count == 0) {
+        return Status::OK();
+    }
+    Aws::S3::Model::GetObjectRequest request;
+    request.SetBucket(_bucket);
+    request.SetKey(_object);
+    request.SetRange(fmt::format("bytes={}-{}", offset, offset + count - 1));
+
+    Aws::S3::Model::GetObjectOutcome outcome = _s3client->GetObject(request);
+    if (!outcome.IsSuccess()) {
+        return make_error_status(outcome.GetError());
+    }
+    Aws::IOStream& body = outcome.GetResult().GetBody();
+    body.read(static_cast<char*>(out), count);
+    if (body.gcount() != count) {
+        return Status::IOError(fmt::format("cannot read fully, expect {} bytes but got {}", count, body.gcount()));
+    }
+    return Status::OK();
+}
+
 Status S3InputStream::seek(int64_t offset) {
     if (offset < 0) return Status::InvalidArgument(fmt::format("Invalid offset {}", offset));
     _offset = offset;
@@ -34,6 +34,9 @@ public:
 
     StatusOr<int64_t> read(void* data, int64_t count) override;
 
+    // Issue one ranged GetObject request, no state of the stream is touched.
+    Status pread_fully(int64_t offset, void* data, int64_t count) override;
+
     Status seek(int64_t offset) override;
 
     StatusOr<int64_t> position() override;
@@ -45,6 +45,16 @@ public:
     // ```
     virtual Status read_at_fully(int64_t offset, void* out, int64_t count);
 
+    // Read exactly |count| bytes at position |offset| like `read_at_fully()`, but the current offset
+    // of the stream is neither used nor changed, so it can be called concurrently with the other
+    // methods of the stream, e.g. by a background prefetching thread.
+    //
+    // Return Status::NotSupported if the stream does not support concurrent reading, which is the
+    // default implementation.
+    virtual Status pread_fully(int64_t offset, void* out, int64_t count) {
+        return Status::NotSupported("pread_fully");
+    }
+
     // Return the total file size in bytes, or error.
     virtual StatusOr<int64_t> get_size() = 0;
 
@@ -98,6 +108,10 @@ public:
         return _impl->read_at_fully(offset, out, count);
     }
 
+    Status pread_fully(int64_t offset, void* out, int64_t count) override {
+        return _impl->pread_fully(offset, out, count);
+    }
+
     StatusOr<int64_t> get_size() override { return _impl->get_size(); }
 
     Status seek(int64_t offset) override { return _impl->seek(offset); }
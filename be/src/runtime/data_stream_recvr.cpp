@@ -188,6 +188,7 @@ bool DataStreamRecvr::is_data_ready() {
 Status DataStreamRecvr::add_chunks(const PTransmitChunkParams& request, ::google::protobuf::Closure** done) {
     MemTracker* prev_tracker = tls_thread_status.set_mem_tracker(_instance_mem_tracker.get());
     DeferOp op([&] { tls_thread_status.set_mem_tracker(prev_tracker); });
+    DeferOp notify_op([this] { _observable.notify_observers(); });
 
     SCOPED_TIMER(_process_total_timer);
     SCOPED_TIMER(_sender_total_timer);
@@ -206,18 +207,22 @@ Status DataStreamRecvr::add_chunks(const PTransmitChunkParams& request, ::google
 void DataStreamRecvr::remove_sender(int sender_id, int be_number) {
     int use_sender_id = _is_merging ? sender_id : 0;
     _sender_queues[use_sender_id]->decrement_senders(be_number);
+    _observable.notify_observers();
 }
 
 void DataStreamRecvr::cancel_stream() {
     for (auto& _sender_queue : _sender_queues) {
         _sender_queue->cancel();
     }
+    _observable.notify_observers();
 }
 
 void DataStreamRecvr::close() {
     for (auto& _sender_queue : _sender_queues) {
         _sender_queue->close();
     }
+    // The drivers may be destroyed after the receiver is closed, but chunks may still arrive.
+    _observable.remove_observers();
     // Remove this receiver from the DataStreamMgr that created it.
     // TODO: log error msg
     _mgr->deregister_recvr(fragment_instance_id(), dest_node_id());
@@ -24,6 +24,7 @@
 #include "column/vectorized_fwd.h"
 #include "common/object_pool.h"
 #include "common/status.h"
+#include "exec/pipeline/pipeline_observer.h"
 #include "gen_cpp/Types_types.h" // for TUniqueId
 #include "runtime/descriptors.h"
 #include "runtime/local_pass_through_buffer.h"
@@ -112,6 +113,9 @@ public:
 
     bool is_data_ready();
 
+    // Observers are signalled when chunks arrive or senders finish, only used by pipeline engine.
+    void attach_observer(pipeline::PipelineObserver* observer) { _observable.add_observer(observer); }
+
 private:
     friend class DataStreamMgr;
     class SenderQueue;
@@ -215,6 +219,8 @@ private:
     // if _keep_order is set to true, then receiver will keep the order according sequence
     bool _keep_order;
     PassThroughContext _pass_through_context;
+
+    pipeline::Observable _observable;
 };
 
 } // end namespace starrocks
@@ -684,12 +684,13 @@ Status DataStreamSender::serialize_chunk(const vectorized::Chunk* src, ChunkPB*
         SCOPED_TIMER(_serialize_chunk_timer);
         // We only serialize chunk meta for first chunk
         if (*is_first_chunk) {
-            StatusOr<ChunkPB> res = serde::ProtobufChunkSerde::serialize(*src);
+            StatusOr<ChunkPB> res = serde::ProtobufChunkSerde::serialize(*src, config::enable_exchange_column_encoding);
             if (!res.ok()) return res.status();
             res->Swap(dst);
             *is_first_chunk = false;
         } else {
-            StatusOr<ChunkPB> res = serde::ProtobufChunkSerde::serialize_without_meta(*src);
+            StatusOr<ChunkPB> res = serde::ProtobufChunkSerde::serialize_without_meta(
+                    *src, config::enable_exchange_column_encoding);
             if (!res.ok()) return res.status();
             res->Swap(dst);
         }
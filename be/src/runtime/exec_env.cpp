@@ -34,6 +34,7 @@
 #include "exec/workgroup/scan_executor.h"
 #include "exec/workgroup/work_group.h"
 #include "exec/workgroup/work_group_fwd.h"
+#include "fs/block_cache.h"
 #include "gen_cpp/BackendService.h"
 #include "gen_cpp/FrontendService.h"
 #include "gen_cpp/HeartbeatService_types.h"
@@ -156,6 +157,28 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
     _pipeline_prepare_pool =
             new PriorityThreadPool("pip_prepare", num_prepare_threads, config::pipeline_prepare_thread_pool_queue_size);
 
+    if (config::io_prefetch_thread_num > 0) {
+        std::unique_ptr<ThreadPool> io_prefetch_pool;
+        RETURN_IF_ERROR(ThreadPoolBuilder("io_prefetch")
+                                .set_min_threads(0)
+                                .set_max_threads(config::io_prefetch_thread_num)
+                                .set_max_queue_size(1000)
+                                .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
+                                .build(&io_prefetch_pool));
+        _io_prefetch_pool = io_prefetch_pool.release();
+    }
+
+    if (config::spill_io_thread_num > 0) {
+        std::unique_ptr<ThreadPool> spill_io_pool;
+        RETURN_IF_ERROR(ThreadPoolBuilder("spill_io")
+                                .set_min_threads(0)
+                                .set_max_threads(config::spill_io_thread_num)
+                                .set_max_queue_size(1000)
+                                .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
+                                .build(&spill_io_pool));
+        _spill_io_pool = spill_io_pool.release();
+    }
+
     std::unique_ptr<ThreadPool> driver_executor_thread_pool;
     _max_executor_threads = std::thread::hardware_concurrency();
     if (config::pipeline_exec_thread_pool_thread_num > 0) {
@@ -274,6 +297,18 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
         _lake_location_provider = new lake::StarletLocationProvider();
 #endif
         _lake_tablet_manager = new lake::TabletManager(_lake_location_provider, config::lake_metadata_cache_limit);
+        REGISTER_GAUGE_STARROCKS_METRIC(lake_metacache_lookup_count, [this]() {
+            return _lake_tablet_manager != nullptr ? _lake_tablet_manager->metacache()->get_lookup_count() : 0;
+        });
+        REGISTER_GAUGE_STARROCKS_METRIC(lake_metacache_hit_count, [this]() {
+            return _lake_tablet_manager != nullptr ? _lake_tablet_manager->metacache()->get_hit_count() : 0;
+        });
+        if (config::block_cache_enable) {
+            auto st = BlockCache::instance()->init(config::block_cache_disk_path, config::block_cache_disk_size,
+                                                   config::block_cache_block_size,
+                                                   config::block_cache_populate_threads);
+            LOG_IF(WARNING, !st.ok()) << "Fail to init block cache, disable it: " << st;
+        }
 
         // agent_server is not needed for cn
         _agent_server = new AgentServer(this);
@@ -373,7 +408,22 @@ Status ExecEnv::_init_storage_page_cache() {
         LOG(WARNING) << "Config storage_page_cache_limit is greater than memory size, config="
                      << config::storage_page_cache_limit << ", memory=" << MemInfo::physical_mem();
     }
-    StoragePageCache::create_global_cache(_page_cache_mem_tracker, storage_cache_limit);
+    CacheEvictionPolicy policy = CacheEvictionPolicy::LRU;
+    if (!parse_cache_eviction_policy(config::storage_page_cache_eviction_policy, &policy)) {
+        LOG(WARNING) << "Invalid storage_page_cache_eviction_policy: " << config::storage_page_cache_eviction_policy
+                     << ", use lru instead";
+    }
+    StoragePageCache::create_global_cache(_page_cache_mem_tracker, storage_cache_limit, policy);
+    REGISTER_GAUGE_STARROCKS_METRIC(storage_page_cache_lookup_count,
+                                    []() { return StoragePageCache::instance()->lookup_count(); });
+    REGISTER_GAUGE_STARROCKS_METRIC(storage_page_cache_hit_count,
+                                    []() { return StoragePageCache::instance()->hit_count(); });
+    if (!config::storage_page_cache_disk_path.empty()) {
+        auto st = StoragePageCache::instance()->init_disk_cache(config::storage_page_cache_disk_path,
+                                                                config::storage_page_cache_disk_size,
+                                                                config::storage_page_cache_disk_region_size);
+        LOG_IF(WARNING, !st.ok()) << "Fail to init storage page disk cache, disable it: " << st;
+    }
 
     // TODO(zc): The current memory usage configuration is a bit confusing,
     // we need to sort out the use of memory
@@ -485,6 +535,16 @@ void ExecEnv::_destroy() {
         delete _thread_pool;
         _thread_pool = nullptr;
     }
+    // After the scan executors, whose scanners may still submit prefetching tasks.
+    if (_io_prefetch_pool) {
+        delete _io_prefetch_pool;
+        _io_prefetch_pool = nullptr;
+    }
+    // After the driver executors, whose operators may still submit spill io tasks.
+    if (_spill_io_pool) {
+        delete _spill_io_pool;
+        _spill_io_pool = nullptr;
+    }
     if (_thread_mgr) {
         delete _thread_mgr;
         _thread_mgr = nullptr;
@@ -574,6 +634,10 @@ void ExecEnv::_destroy() {
         delete _external_scan_context_mgr;
         _external_scan_context_mgr = nullptr;
     }
+    BlockCache::instance()->shutdown();
+    if (StoragePageCache::instance() != nullptr) {
+        StoragePageCache::instance()->shutdown_disk_cache();
+    }
     if (_lake_tablet_manager) {
         delete _lake_tablet_manager;
         _lake_tablet_manager = nullptr;
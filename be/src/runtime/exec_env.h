@@ -148,6 +148,10 @@ public:
 
     PriorityThreadPool* udf_call_pool() { return _udf_call_pool; }
     PriorityThreadPool* pipeline_prepare_pool() { return _pipeline_prepare_pool; }
+    // Null if `config::io_prefetch_thread_num` is 0.
+    ThreadPool* io_prefetch_pool() { return _io_prefetch_pool; }
+    // Null if `config::spill_io_thread_num` is 0.
+    ThreadPool* spill_io_pool() { return _spill_io_pool; }
     FragmentMgr* fragment_mgr() { return _fragment_mgr; }
     starrocks::pipeline::DriverExecutor* driver_executor() { return _driver_executor; }
     starrocks::pipeline::DriverExecutor* wg_driver_executor() { return _wg_driver_executor; }
@@ -249,6 +253,8 @@ private:
 
     PriorityThreadPool* _udf_call_pool = nullptr;
     PriorityThreadPool* _pipeline_prepare_pool = nullptr;
+    ThreadPool* _io_prefetch_pool = nullptr;
+    ThreadPool* _spill_io_pool = nullptr;
     FragmentMgr* _fragment_mgr = nullptr;
     pipeline::QueryContextManager* _query_context_mgr = nullptr;
     pipeline::DriverExecutor* _driver_executor = nullptr;
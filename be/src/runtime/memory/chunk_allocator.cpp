@@ -41,6 +41,8 @@ ChunkAllocator* ChunkAllocator::_s_instance = nullptr;
 
 static IntCounter local_core_alloc_count(MetricUnit::NOUNIT);
 static IntCounter other_core_alloc_count(MetricUnit::NOUNIT);
+static IntCounter numa_local_alloc_count(MetricUnit::NOUNIT);
+static IntCounter numa_remote_alloc_count(MetricUnit::NOUNIT);
 static IntCounter system_alloc_count(MetricUnit::NOUNIT);
 static IntCounter system_free_count(MetricUnit::NOUNIT);
 static IntCounter system_alloc_cost_ns(MetricUnit::NANOSECONDS);
@@ -116,6 +118,8 @@ void ChunkAllocator::init_instance(MemTracker* mem_tracker, size_t reserve_limit
 
     REGISTER_METIRC(local_core_alloc_count);
     REGISTER_METIRC(other_core_alloc_count);
+    REGISTER_METIRC(numa_local_alloc_count);
+    REGISTER_METIRC(numa_remote_alloc_count);
     REGISTER_METIRC(system_alloc_count);
     REGISTER_METIRC(system_free_count);
     REGISTER_METIRC(system_alloc_cost_ns);
@@ -126,6 +130,7 @@ ChunkAllocator::ChunkAllocator(MemTracker* mem_tracker, size_t reserve_limit)
         : _mem_tracker(mem_tracker),
           _reserve_bytes_limit(reserve_limit),
           _reserved_bytes(0),
+          _num_numa_nodes(CpuInfo::num_execution_numa_nodes()),
           _arenas(CpuInfo::get_max_num_cores()) {
     for (auto& _arena : _arenas) {
         _arena = std::make_unique<ChunkArena>(_mem_tracker);
@@ -153,18 +158,43 @@ bool ChunkAllocator::allocate(size_t size, Chunk* chunk) {
     if (_arenas[core_id]->pop_free_chunk(size, &chunk->data)) {
         _reserved_bytes.fetch_sub(size);
         local_core_alloc_count.increment(1);
+        if (_num_numa_nodes > 1) {
+            numa_local_alloc_count.increment(1);
+        }
         ret = true;
         return ret;
     }
     if (_reserved_bytes > size) {
+        const int numa_node = CpuInfo::get_numa_node_of_core(core_id);
+        if (_num_numa_nodes > 1) {
+            // try to allocate from the arenas of the other cores in the same NUMA node first
+            for (int other_core_id : CpuInfo::get_cores_of_numa_node(numa_node)) {
+                if (other_core_id != core_id && _arenas[other_core_id]->pop_free_chunk(size, &chunk->data)) {
+                    _reserved_bytes.fetch_sub(size);
+                    other_core_alloc_count.increment(1);
+                    numa_local_alloc_count.increment(1);
+                    chunk->core_id = other_core_id;
+                    ret = true;
+                    return ret;
+                }
+            }
+        }
         // try to allocate from other core's arena
         ++core_id;
         for (int i = 1; i < _arenas.size(); ++i, ++core_id) {
-            if (_arenas[core_id % _arenas.size()]->pop_free_chunk(size, &chunk->data)) {
+            int other_core_id = core_id % _arenas.size();
+            if (_num_numa_nodes > 1 && CpuInfo::get_numa_node_of_core(other_core_id) == numa_node) {
+                // already tried above
+                continue;
+            }
+            if (_arenas[other_core_id]->pop_free_chunk(size, &chunk->data)) {
                 _reserved_bytes.fetch_sub(size);
                 other_core_alloc_count.increment(1);
+                if (_num_numa_nodes > 1) {
+                    numa_remote_alloc_count.increment(1);
+                }
                 // reset chunk's core_id to other
-                chunk->core_id = core_id % _arenas.size();
+                chunk->core_id = other_core_id;
                 ret = true;
                 return ret;
             }
@@ -50,6 +50,10 @@ class MemTracker;
 // ChunkArena will keep a separate free list for each chunk size. In common case, chunk will
 // be allocated from current core arena. In this case, there is no lock contention.
 //
+// When enable_numa_aware_execution is set on a NUMA machine, the arenas of the cores in the same
+// NUMA node are tried before the ones of the other nodes, since a free chunk is returned to the
+// arena it was allocated from, whose memory was most likely first touched on that node.
+//
 // Must call CpuInfo::init() and StarRocksMetrics::instance()->initialize() to achieve good performance
 // before first object is created. And call init_instance() before use instance is called.
 class ChunkAllocator {
@@ -80,6 +84,7 @@ private:
     MemTracker* _mem_tracker = nullptr;
     size_t _reserve_bytes_limit;
     std::atomic<int64_t> _reserved_bytes;
+    const int _num_numa_nodes;
     // each core has a ChunkArena
     std::vector<std::unique_ptr<ChunkArena>> _arenas;
 };
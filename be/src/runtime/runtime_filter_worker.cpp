@@ -248,6 +248,12 @@ void RuntimeFilterMerger::merge_runtime_filter(PTransmitRuntimeFilterParams& par
               << ", be_number = " << be_number;
     status->arrives.insert(be_number);
     status->filters.insert(std::make_pair(be_number, rf));
+    if (params.has_finst_id()) {
+        TUniqueId finst_id;
+        finst_id.hi = params.finst_id().hi();
+        finst_id.lo = params.finst_id().lo();
+        status->builder_finsts.insert(std::make_pair(be_number, finst_id));
+    }
 
     // not ready. still have to wait more filters.
     if (status->filters.size() < status->expect_number) return;
@@ -265,6 +271,25 @@ void RuntimeFilterMerger::_send_total_runtime_filter(int32_t filter_id, RuntimeF
     vectorized::JoinRuntimeFilter* out = nullptr;
     vectorized::JoinRuntimeFilter* first = status->filters.begin()->second;
     ObjectPool* pool = &(status->pool);
+    const bool partitioned_by_bucket = first->is_partitioned_by_bucket();
+    // fragment instance -> buckets built by it, only for the filter partitioned by bucket.
+    std::unordered_map<TUniqueId, std::vector<uint8_t>> finst_to_buckets;
+    for (auto it : status->filters) {
+        vectorized::JoinRuntimeFilter* rf = it.second;
+        if (rf->is_partitioned_by_bucket() != partitioned_by_bucket ||
+            (partitioned_by_bucket && rf->built_buckets().size() != first->built_buckets().size())) {
+            LOG(WARNING) << "RuntimeFilterMerger::merge_runtime_filter. inconsistent partitions of partial filters"
+                         << ", drop it. filter_id = " << filter_id << ", query_id = " << _query_id;
+            pool->clear();
+            return;
+        }
+        if (partitioned_by_bucket) {
+            auto finst_it = status->builder_finsts.find(it.first);
+            if (finst_it != status->builder_finsts.end()) {
+                finst_to_buckets[finst_it->second] = rf->built_buckets();
+            }
+        }
+    }
     out = first->create_empty(pool);
     for (auto it : status->filters) {
         out->concat(it.second);
@@ -282,13 +307,6 @@ void RuntimeFilterMerger::_send_total_runtime_filter(int32_t filter_id, RuntimeF
     query_id->set_hi(_query_id.hi);
     query_id->set_lo(_query_id.lo);
 
-    std::string* send_data = request.mutable_data();
-    size_t max_size = vectorized::RuntimeFilterHelper::max_runtime_filter_serialized_size(out);
-    send_data->resize(max_size);
-
-    size_t actual_size = vectorized::RuntimeFilterHelper::serialize_runtime_filter(
-            out, reinterpret_cast<uint8_t*>(send_data->data()));
-    send_data->resize(actual_size);
     int timeout_ms = config::send_rpc_runtime_filter_timeout_ms;
     if (_query_options.__isset.runtime_filter_send_timeout_ms) {
         timeout_ms = _query_options.runtime_filter_send_timeout_ms;
@@ -315,6 +333,60 @@ void RuntimeFilterMerger::_send_total_runtime_filter(int32_t filter_id, RuntimeF
         it->second.push_back(node.fragment_instance_id);
     }
 
+    auto serialize_filter = [out](std::string* send_data) {
+        size_t max_size = vectorized::RuntimeFilterHelper::max_runtime_filter_serialized_size(out);
+        send_data->resize(max_size);
+        size_t actual_size = vectorized::RuntimeFilterHelper::serialize_runtime_filter(
+                out, reinterpret_cast<uint8_t*>(send_data->data()));
+        send_data->resize(actual_size);
+    };
+
+    // For colocate and bucket shuffle joins, the probe fragment instances on a node only scan the buckets built
+    // on it. If all of them build the filter, only the buckets built by them are sent to the node, and the other
+    // buckets are sent as tiny filters that pass all rows, which is much smaller than the total filter.
+    if (partitioned_by_bucket) {
+        for (auto it = nodes_to_frag_insts.begin(); it != nodes_to_frag_insts.end();) {
+            std::vector<uint8_t> buckets;
+            bool all_builders = true;
+            for (const auto& inst : it->second) {
+                auto buckets_it = finst_to_buckets.find(inst);
+                if (buckets_it == finst_to_buckets.end()) {
+                    all_builders = false;
+                    break;
+                }
+                buckets.resize(buckets_it->second.size(), 0);
+                for (size_t i = 0; i < buckets.size(); i++) {
+                    buckets[i] |= buckets_it->second[i];
+                }
+            }
+            if (!all_builders) {
+                ++it;
+                continue;
+            }
+
+            out->set_shipped_buckets(std::move(buckets));
+            request.clear_probe_finst_ids();
+            request.clear_forward_targets();
+            for (const auto& inst : it->second) {
+                PUniqueId* frag_inst_id = request.add_probe_finst_ids();
+                frag_inst_id->set_hi(inst.hi);
+                frag_inst_id->set_lo(inst.lo);
+            }
+            serialize_filter(request.mutable_data());
+            doris::PBackendService_Stub* stub = _exec_env->brpc_stub_cache()->get_stub(it->first);
+            _exec_env->add_rf_event(
+                    {request.query_id(), request.filter_id(), it->first.hostname, "SEND_BUCKET_LOCAL_RF_RPC"});
+            send_rpc_runtime_filter(stub, rpc_closure, timeout_ms, request);
+            it = nodes_to_frag_insts.erase(it);
+        }
+        out->set_shipped_buckets({});
+        if (nodes_to_frag_insts.empty()) {
+            pool->clear();
+            return;
+        }
+    }
+    serialize_filter(request.mutable_data());
+
     TNetworkAddress local;
     local.hostname = BackendOptions::get_localhost();
     local.port = config::brpc_port;
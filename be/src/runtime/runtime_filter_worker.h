@@ -53,6 +53,7 @@ public:
               expect_number(other.expect_number),
               pool(std::move(other.pool)),
               filters(std::move(other.filters)),
+              builder_finsts(std::move(other.builder_finsts)),
               current_size(other.current_size),
               max_size(other.max_size),
               stop(other.stop),
@@ -66,6 +67,8 @@ public:
     ObjectPool pool;
     // each partitioned rf.
     std::map<int32_t, vectorized::JoinRuntimeFilter*> filters;
+    // which fragment instance builds each partitioned rf.
+    std::map<int32_t, TUniqueId> builder_finsts;
     size_t current_size = 0;
     size_t max_size = 0;
     bool stop = false;
@@ -0,0 +1,465 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#include "serde/encoded_column_serde.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <type_traits>
+
+#include "column/binary_column.h"
+#include "column/column_hash.h"
+#include "column/column_visitor_adapter.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "gutil/casts.h"
+#include "gutil/strings/fastmem.h"
+#include "serde/column_array_serde.h"
+#include "util/bit_packing.inline.h"
+#include "util/coding.h"
+#include "util/phmap/phmap.h"
+#include "util/raw_container.h"
+
+namespace starrocks::serde {
+namespace {
+
+// The encoding of a column, which is the first byte of the serialized column.
+enum ColumnEncoding : uint8_t {
+    // serialized by ColumnArraySerde.
+    kPlain = 0,
+    // the encoding of null flags, followed by the encoded data column.
+    kNullable = 1,
+    // frame of reference and bit-packing.
+    kBitPacked = 2,
+    // dictionary of distinct values and bit-packed codes.
+    kDict = 3,
+};
+
+// The encoding of the null flags of a nullable column.
+enum NullEncoding : uint8_t {
+    // serialized by ColumnArraySerde.
+    kPlainNulls = 0,
+    // there is no null, nothing is serialized.
+    kNoNulls = 1,
+    // the lengths of runs of non-null and null rows alternately, starting with non-null rows.
+    kRleNulls = 2,
+};
+
+uint8_t* write_little_endian_32(uint32_t value, uint8_t* buff) {
+    encode_fixed32_le(buff, value);
+    return buff + sizeof(value);
+}
+
+const uint8_t* read_little_endian_32(const uint8_t* buff, uint32_t* value) {
+    *value = decode_fixed32_le(buff);
+    return buff + sizeof(*value);
+}
+
+uint8_t* write_little_endian_64(uint64_t value, uint8_t* buff) {
+    encode_fixed64_le(buff, value);
+    return buff + sizeof(value);
+}
+
+const uint8_t* read_little_endian_64(const uint8_t* buff, uint64_t* value) {
+    *value = decode_fixed64_le(buff);
+    return buff + sizeof(*value);
+}
+
+int bits_required(uint64_t max_value) {
+    return max_value == 0 ? 0 : 64 - __builtin_clzll(max_value);
+}
+
+size_t packed_size(size_t num_values, int bit_width) {
+    return (num_values * bit_width + 7) / 8;
+}
+
+// Pack the lower |bit_width| bits of every value in the layout of BitPacking, so it can be unpacked by
+// BitPacking::UnpackValues.
+template <typename GetValue>
+uint8_t* pack_values(size_t num_values, int bit_width, uint8_t* buff, const GetValue& get_value) {
+    if (bit_width == 0) {
+        return buff;
+    }
+    uint64_t buffered = 0;
+    int num_buffered_bits = 0;
+    for (size_t i = 0; i < num_values; i++) {
+        uint64_t v = get_value(i);
+        buffered |= v << num_buffered_bits;
+        num_buffered_bits += bit_width;
+        if (num_buffered_bits >= 64) {
+            buff = write_little_endian_64(buffered, buff);
+            num_buffered_bits -= 64;
+            buffered = num_buffered_bits == 0 ? 0 : v >> (bit_width - num_buffered_bits);
+        }
+    }
+    if (num_buffered_bits > 0) {
+        uint8_t tail[sizeof(uint64_t)];
+        encode_fixed64_le(tail, buffered);
+        const size_t tail_bytes = (num_buffered_bits + 7) / 8;
+        strings::memcpy_inlined(buff, tail, tail_bytes);
+        buff += tail_bytes;
+    }
+    return buff;
+}
+
+template <typename OutType>
+const uint8_t* unpack_values(const uint8_t* buff, size_t num_values, int bit_width, OutType* out) {
+    if (bit_width == 0) {
+        std::fill(out, out + num_values, 0);
+        return buff;
+    }
+    const size_t bytes = packed_size(num_values, bit_width);
+    auto [pos, num_read] = BitPacking::UnpackValues(bit_width, buff, bytes, num_values, out);
+    DCHECK_EQ(num_values, num_read);
+    DCHECK_EQ(buff + bytes, pos);
+    return buff + bytes;
+}
+
+// Layout:
+// uint32: number of rows
+// uint8: bit width
+// uint64: the minimum value
+// bit-packed differences between the values and the minimum value
+template <typename T>
+class BitPackedColumnSerde {
+public:
+    using UnsignedT = std::make_unsigned_t<T>;
+    static constexpr size_t kHeaderSize = sizeof(uint32_t) + sizeof(uint8_t) + sizeof(uint64_t);
+
+    // Return the bit width to pack |column|, or -1 if it's not smaller than ColumnArraySerde.
+    static int bit_width(const vectorized::FixedLengthColumnBase<T>& column, T* base) {
+        const auto& data = column.get_data();
+        if (data.empty()) {
+            return -1;
+        }
+        auto [min_iter, max_iter] = std::minmax_element(data.begin(), data.end());
+        uint64_t range =
+                static_cast<UnsignedT>(static_cast<UnsignedT>(*max_iter) - static_cast<UnsignedT>(*min_iter));
+        int width = bits_required(range);
+        if (kHeaderSize + packed_size(data.size(), width) >= sizeof(uint32_t) + sizeof(T) * data.size()) {
+            return -1;
+        }
+        *base = *min_iter;
+        return width;
+    }
+
+    static uint8_t* serialize(const vectorized::FixedLengthColumnBase<T>& column, T base, int bit_width,
+                              uint8_t* buff) {
+        const auto& data = column.get_data();
+        buff = write_little_endian_32(data.size(), buff);
+        *buff++ = static_cast<uint8_t>(bit_width);
+        buff = write_little_endian_64(static_cast<UnsignedT>(base), buff);
+        return pack_values(data.size(), bit_width, buff, [&data, base](size_t i) -> uint64_t {
+            return static_cast<UnsignedT>(static_cast<UnsignedT>(data[i]) - static_cast<UnsignedT>(base));
+        });
+    }
+
+    static const uint8_t* deserialize(const uint8_t* buff, vectorized::FixedLengthColumnBase<T>* column) {
+        uint32_t num_rows = 0;
+        buff = read_little_endian_32(buff, &num_rows);
+        int bit_width = *buff++;
+        uint64_t base = 0;
+        buff = read_little_endian_64(buff, &base);
+
+        auto& data = column->get_data();
+        raw::make_room(&data, num_rows);
+        auto* values = reinterpret_cast<UnsignedT*>(data.data());
+        buff = unpack_values(buff, num_rows, bit_width, values);
+        for (size_t i = 0; i < num_rows; i++) {
+            values[i] = static_cast<UnsignedT>(values[i] + static_cast<UnsignedT>(base));
+        }
+        return buff;
+    }
+};
+
+// Layout:
+// uint32: number of rows
+// uint32: number of distinct values
+// uint8: bit width of codes
+// distinct values: [length1][payload1][length2][payload2]...
+// bit-packed codes
+class DictBinaryColumnSerde {
+public:
+    static constexpr size_t kHeaderSize = sizeof(uint32_t) + sizeof(uint32_t) + sizeof(uint8_t);
+
+    struct Dict {
+        std::vector<Slice> values;
+        std::vector<uint32_t> codes;
+        int bit_width = 0;
+    };
+
+    // Return false if the column has too many distinct values, or the dictionary encoding is not smaller than
+    // ColumnArraySerde.
+    static bool build_dict(const vectorized::BinaryColumn& column, Dict* dict) {
+        const size_t num_rows = column.size();
+        if (num_rows == 0) {
+            return false;
+        }
+        // give up early for the columns of high cardinality, which is the most common case of binary columns.
+        const size_t max_dict_size = std::min<size_t>(num_rows / 4, kMaxDictSize);
+        phmap::flat_hash_map<Slice, uint32_t, SliceHash, SliceEqual> value_to_code;
+        dict->codes.resize(num_rows);
+        size_t dict_bytes = 0;
+        for (size_t i = 0; i < num_rows; i++) {
+            Slice value = column.get_slice(i);
+            auto [iter, inserted] = value_to_code.emplace(value, dict->values.size());
+            if (inserted) {
+                if (dict->values.size() >= max_dict_size) {
+                    return false;
+                }
+                dict->values.emplace_back(value);
+                dict_bytes += sizeof(uint32_t) + value.size;
+            }
+            dict->codes[i] = iter->second;
+        }
+        dict->bit_width = bits_required(dict->values.size() - 1);
+        const size_t plain_size = 2 * sizeof(uint32_t) + column.get_bytes().size() + sizeof(uint32_t) * (num_rows + 1);
+        return kHeaderSize + dict_bytes + packed_size(num_rows, dict->bit_width) < plain_size;
+    }
+
+    static uint8_t* serialize(const Dict& dict, uint8_t* buff) {
+        buff = write_little_endian_32(dict.codes.size(), buff);
+        buff = write_little_endian_32(dict.values.size(), buff);
+        *buff++ = static_cast<uint8_t>(dict.bit_width);
+        for (const auto& value : dict.values) {
+            buff = write_little_endian_32(value.size, buff);
+            strings::memcpy_inlined(buff, value.data, value.size);
+            buff += value.size;
+        }
+        const auto& codes = dict.codes;
+        return pack_values(codes.size(), dict.bit_width, buff, [&codes](size_t i) -> uint64_t { return codes[i]; });
+    }
+
+    static const uint8_t* deserialize(const uint8_t* buff, vectorized::BinaryColumn* column) {
+        uint32_t num_rows = 0;
+        uint32_t dict_size = 0;
+        buff = read_little_endian_32(buff, &num_rows);
+        buff = read_little_endian_32(buff, &dict_size);
+        int bit_width = *buff++;
+
+        std::vector<Slice> values(dict_size);
+        for (auto& value : values) {
+            uint32_t size = 0;
+            buff = read_little_endian_32(buff, &size);
+            value = Slice(buff, size);
+            buff += size;
+        }
+        std::vector<uint32_t> codes(num_rows);
+        buff = unpack_values(buff, num_rows, bit_width, codes.data());
+
+        size_t num_bytes = 0;
+        for (uint32_t code : codes) {
+            num_bytes += values[code].size;
+        }
+        auto& bytes = column->get_bytes();
+        auto& offsets = column->get_offset();
+        bytes.resize(num_bytes);
+        raw::make_room(&offsets, num_rows + 1);
+        offsets[0] = 0;
+        uint8_t* dst = bytes.data();
+        for (size_t i = 0; i < num_rows; i++) {
+            const Slice& value = values[codes[i]];
+            strings::memcpy_inlined(dst, value.data, value.size);
+            dst += value.size;
+            offsets[i + 1] = dst - bytes.data();
+        }
+        column->invalidate_slice_cache();
+        return buff;
+    }
+
+private:
+    static constexpr size_t kMaxDictSize = 1 << 16;
+};
+
+// Layout:
+// uint8: null encoding
+// uint32: number of runs, only for kRleNulls
+// uint32 * number of runs: lengths of runs, only for kRleNulls
+// null column serialized by ColumnArraySerde, only for kPlainNulls
+// data column serialized by EncodedColumnSerde
+class NullableColumnSerde {
+public:
+    static int64_t max_serialized_size(const vectorized::NullableColumn& column) {
+        return sizeof(uint8_t) + ColumnArraySerde::max_serialized_size(*column.null_column()) +
+               EncodedColumnSerde::max_serialized_size(*column.data_column());
+    }
+
+    static uint8_t* serialize(const vectorized::NullableColumn& column, uint8_t* buff) {
+        const auto& nulls = column.null_column()->get_data();
+        if (!column.has_null()) {
+            *buff++ = kNoNulls;
+        } else {
+            size_t num_runs = 1;
+            for (size_t i = 1; i < nulls.size(); i++) {
+                num_runs += nulls[i] != nulls[i - 1];
+            }
+            // the first run is non-null rows, which is empty if the first row is null.
+            num_runs += nulls[0] != 0;
+            if (sizeof(uint32_t) * (num_runs + 1) < sizeof(uint32_t) + nulls.size()) {
+                *buff++ = kRleNulls;
+                buff = write_little_endian_32(num_runs, buff);
+                uint8_t run_value = 0;
+                uint32_t run_length = 0;
+                for (uint8_t null : nulls) {
+                    if (null != run_value) {
+                        buff = write_little_endian_32(run_length, buff);
+                        run_value = null;
+                        run_length = 0;
+                    }
+                    run_length++;
+                }
+                buff = write_little_endian_32(run_length, buff);
+            } else {
+                *buff++ = kPlainNulls;
+                buff = ColumnArraySerde::serialize(*column.null_column(), buff);
+            }
+        }
+        return EncodedColumnSerde::serialize(*column.data_column(), buff);
+    }
+
+    static const uint8_t* deserialize(const uint8_t* buff, vectorized::NullableColumn* column) {
+        auto null_encoding = static_cast<NullEncoding>(*buff++);
+        auto& nulls = column->null_column()->get_data();
+        if (null_encoding == kRleNulls) {
+            uint32_t num_runs = 0;
+            buff = read_little_endian_32(buff, &num_runs);
+            nulls.clear();
+            uint8_t run_value = 0;
+            for (uint32_t i = 0; i < num_runs; i++) {
+                uint32_t run_length = 0;
+                buff = read_little_endian_32(buff, &run_length);
+                nulls.insert(nulls.end(), run_length, run_value);
+                run_value ^= 1;
+            }
+        } else if (null_encoding == kPlainNulls) {
+            buff = ColumnArraySerde::deserialize(buff, column->null_column().get());
+        } else if (null_encoding != kNoNulls) {
+            LOG(WARNING) << "unknown null encoding: " << static_cast<int>(null_encoding);
+            return nullptr;
+        }
+        buff = EncodedColumnSerde::deserialize(buff, column->data_column().get());
+        if (buff == nullptr) {
+            return nullptr;
+        }
+        if (null_encoding == kNoNulls) {
+            nulls.assign(column->data_column()->size(), 0);
+        }
+        column->update_has_null();
+        return buff;
+    }
+};
+
+template <typename ColumnT, typename = void>
+struct IsBitPackable : std::false_type {};
+
+// bit-packing is not worthwhile for 1-byte integers, and BitPacking supports 64 bits at most.
+template <typename ColumnT>
+struct IsBitPackable<ColumnT, std::void_t<typename ColumnT::ValueType>>
+        : std::bool_constant<std::is_integral_v<typename ColumnT::ValueType> &&
+                             sizeof(typename ColumnT::ValueType) >= 2 && sizeof(typename ColumnT::ValueType) <= 8 &&
+                             std::is_base_of_v<vectorized::FixedLengthColumnBase<typename ColumnT::ValueType>,
+                                               ColumnT>> {};
+
+class ColumnEncodingVisitor final : public ColumnVisitorAdapter<ColumnEncodingVisitor> {
+public:
+    explicit ColumnEncodingVisitor(uint8_t* buff) : ColumnVisitorAdapter(this), _cur(buff) {}
+
+    template <typename ColumnT>
+    Status do_visit(const ColumnT& column) {
+        if constexpr (std::is_same_v<ColumnT, vectorized::NullableColumn>) {
+            *_cur++ = kNullable;
+            _cur = NullableColumnSerde::serialize(column, _cur);
+            return Status::OK();
+        } else if constexpr (std::is_same_v<ColumnT, vectorized::BinaryColumn>) {
+            DictBinaryColumnSerde::Dict dict;
+            if (DictBinaryColumnSerde::build_dict(column, &dict)) {
+                *_cur++ = kDict;
+                _cur = DictBinaryColumnSerde::serialize(dict, _cur);
+                return Status::OK();
+            }
+        } else if constexpr (IsBitPackable<ColumnT>::value) {
+            using T = typename ColumnT::ValueType;
+            T base{};
+            int bit_width = BitPackedColumnSerde<T>::bit_width(column, &base);
+            if (bit_width >= 0) {
+                *_cur++ = kBitPacked;
+                _cur = BitPackedColumnSerde<T>::serialize(column, base, bit_width, _cur);
+                return Status::OK();
+            }
+        }
+        *_cur++ = kPlain;
+        _cur = ColumnArraySerde::serialize(column, _cur);
+        return _cur != nullptr ? Status::OK() : Status::NotSupported("unsupported column");
+    }
+
+    uint8_t* cur() const { return _cur; }
+
+private:
+    uint8_t* _cur;
+};
+
+class ColumnDecodingVisitor final : public ColumnVisitorMutableAdapter<ColumnDecodingVisitor> {
+public:
+    ColumnDecodingVisitor(ColumnEncoding encoding, const uint8_t* buff)
+            : ColumnVisitorMutableAdapter(this), _encoding(encoding), _cur(buff) {}
+
+    template <typename ColumnT>
+    Status do_visit(ColumnT* column) {
+        if constexpr (std::is_same_v<ColumnT, vectorized::NullableColumn>) {
+            if (_encoding == kNullable) {
+                _cur = NullableColumnSerde::deserialize(_cur, column);
+                return _cur != nullptr ? Status::OK() : Status::Corruption("invalid nullable column");
+            }
+        } else if constexpr (std::is_same_v<ColumnT, vectorized::BinaryColumn>) {
+            if (_encoding == kDict) {
+                _cur = DictBinaryColumnSerde::deserialize(_cur, column);
+                return Status::OK();
+            }
+        } else if constexpr (IsBitPackable<ColumnT>::value) {
+            if (_encoding == kBitPacked) {
+                _cur = BitPackedColumnSerde<typename ColumnT::ValueType>::deserialize(_cur, column);
+                return Status::OK();
+            }
+        }
+        return Status::Corruption(fmt::format("mismatched column encoding: {}", static_cast<int>(_encoding)));
+    }
+
+    const uint8_t* cur() const { return _cur; }
+
+private:
+    const ColumnEncoding _encoding;
+    const uint8_t* _cur;
+};
+
+} // namespace
+
+int64_t EncodedColumnSerde::max_serialized_size(const vectorized::Column& column) {
+    int64_t size = 0;
+    if (column.is_nullable()) {
+        size = NullableColumnSerde::max_serialized_size(down_cast<const vectorized::NullableColumn&>(column));
+    } else {
+        size = ColumnArraySerde::max_serialized_size(column);
+    }
+    // the encoding is only used if it's smaller than ColumnArraySerde.
+    return size == 0 ? 0 : sizeof(uint8_t) + size;
+}
+
+uint8_t* EncodedColumnSerde::serialize(const vectorized::Column& column, uint8_t* buff) {
+    ColumnEncodingVisitor visitor(buff);
+    auto st = column.accept(&visitor);
+    LOG_IF(WARNING, !st.ok()) << st;
+    return st.ok() ? visitor.cur() : nullptr;
+}
+
+const uint8_t* EncodedColumnSerde::deserialize(const uint8_t* buff, vectorized::Column* column) {
+    auto encoding = static_cast<ColumnEncoding>(*buff++);
+    if (encoding == kPlain) {
+        return ColumnArraySerde::deserialize(buff, column);
+    }
+    ColumnDecodingVisitor visitor(encoding, buff);
+    auto st = column->accept_mutable(&visitor);
+    LOG_IF(WARNING, !st.ok()) << st;
+    return st.ok() ? visitor.cur() : nullptr;
+}
+
+} // namespace starrocks::serde
@@ -0,0 +1,32 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#pragma once
+
+#include <stdint.h>
+
+namespace starrocks::vectorized {
+class Column;
+}
+
+namespace starrocks::serde {
+
+// EncodedColumnSerde used to serialize/deserialize a column to/from an in-memory array like ColumnArraySerde,
+// but every column is encoded by a lightweight encoding chosen by its data, to reduce the bytes transmitted by
+// exchange without the CPU cost of general purpose compression:
+//  - integer columns are bit-packed with the minimum value as the frame of reference.
+//  - binary columns of few distinct values are encoded with a dictionary and bit-packed codes.
+//  - the null flags of nullable columns are omitted if there is no null, or run-length encoded.
+// A column is serialized in the format of ColumnArraySerde if none of the encodings is smaller.
+class EncodedColumnSerde {
+public:
+    // 0 means does not support the type of column
+    static int64_t max_serialized_size(const vectorized::Column& column);
+
+    // Return nullptr on error.
+    static uint8_t* serialize(const vectorized::Column& column, uint8_t* buff);
+
+    // Return nullptr on error.
+    static const uint8_t* deserialize(const uint8_t* buff, vectorized::Column* column);
+};
+
+} //  namespace starrocks::serde
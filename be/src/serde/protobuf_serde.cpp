@@ -6,21 +6,28 @@
 #include "gutil/strings/substitute.h"
 #include "runtime/descriptors.h"
 #include "serde/column_array_serde.h"
+#include "serde/encoded_column_serde.h"
 #include "util/coding.h"
 #include "util/raw_container.h"
 
 namespace starrocks::serde {
 
-int64_t ProtobufChunkSerde::max_serialized_size(const vectorized::Chunk& chunk) {
+// version 1: columns serialized by ColumnArraySerde.
+// version 2: columns serialized by EncodedColumnSerde.
+static constexpr uint32_t kPlainChunkVersion = 1;
+static constexpr uint32_t kEncodedChunkVersion = 2;
+
+int64_t ProtobufChunkSerde::max_serialized_size(const vectorized::Chunk& chunk, bool encode_columns) {
     int64_t serialized_size = 8; // 4 bytes version plus 4 bytes row number
     for (const auto& column : chunk.columns()) {
-        serialized_size += ColumnArraySerde::max_serialized_size(*column);
+        serialized_size += encode_columns ? EncodedColumnSerde::max_serialized_size(*column)
+                                          : ColumnArraySerde::max_serialized_size(*column);
     }
     return serialized_size;
 }
 
-StatusOr<ChunkPB> ProtobufChunkSerde::serialize(const vectorized::Chunk& chunk) {
-    StatusOr<ChunkPB> res = serialize_without_meta(chunk);
+StatusOr<ChunkPB> ProtobufChunkSerde::serialize(const vectorized::Chunk& chunk, bool encode_columns) {
+    StatusOr<ChunkPB> res = serialize_without_meta(chunk, encode_columns);
     if (!res.ok()) return res.status();
 
     const auto& slot_id_to_index = chunk.get_slot_id_to_index_map();
@@ -53,22 +60,32 @@ StatusOr<ChunkPB> ProtobufChunkSerde::serialize(const vectorized::Chunk& chunk)
     return res;
 }
 
-StatusOr<ChunkPB> ProtobufChunkSerde::serialize_without_meta(const vectorized::Chunk& chunk) {
+StatusOr<ChunkPB> ProtobufChunkSerde::serialize_without_meta(const vectorized::Chunk& chunk, bool encode_columns) {
     ChunkPB chunk_pb;
     chunk_pb.set_compress_type(CompressionTypePB::NO_COMPRESSION);
 
     std::string* serialized_data = chunk_pb.mutable_data();
-    raw::stl_string_resize_uninitialized(serialized_data, ProtobufChunkSerde::max_serialized_size(chunk));
+    raw::stl_string_resize_uninitialized(serialized_data,
+                                         ProtobufChunkSerde::max_serialized_size(chunk, encode_columns));
     auto* buff = reinterpret_cast<uint8_t*>(serialized_data->data());
-    encode_fixed32_le(buff + 0, 1);
+    encode_fixed32_le(buff + 0, encode_columns ? kEncodedChunkVersion : kPlainChunkVersion);
     encode_fixed32_le(buff + 4, chunk.num_rows());
     buff = buff + 8;
 
     for (const auto& column : chunk.columns()) {
-        buff = ColumnArraySerde::serialize(*column, buff);
+        if (encode_columns) {
+            buff = EncodedColumnSerde::serialize(*column, buff);
+        } else {
+            buff = ColumnArraySerde::serialize(*column, buff);
+        }
         if (UNLIKELY(buff == nullptr)) return Status::InternalError("has unsupported column");
     }
-    chunk_pb.set_serialized_size(buff - reinterpret_cast<const uint8_t*>(serialized_data->data()));
+    const size_t serialized_size = buff - reinterpret_cast<const uint8_t*>(serialized_data->data());
+    chunk_pb.set_serialized_size(serialized_size);
+    if (encode_columns) {
+        // the encoded columns are usually much smaller than the estimated size.
+        serialized_data->resize(serialized_size);
+    }
     chunk_pb.set_uncompressed_size(serialized_data->size());
     return std::move(chunk_pb);
 }
@@ -115,7 +132,7 @@ StatusOr<vectorized::Chunk> ProtobufChunkDeserializer::deserialize(std::string_v
     auto* cur = reinterpret_cast<const uint8_t*>(buff.data());
 
     uint32_t version = decode_fixed32_le(cur);
-    if (version != 1) {
+    if (version != kPlainChunkVersion && version != kEncodedChunkVersion) {
         return Status::Corruption("invalid version");
     }
     cur += 4;
@@ -130,7 +147,11 @@ StatusOr<vectorized::Chunk> ProtobufChunkDeserializer::deserialize(std::string_v
     }
 
     for (auto& column : columns) {
-        cur = ColumnArraySerde::deserialize(cur, column.get());
+        cur = version == kEncodedChunkVersion ? EncodedColumnSerde::deserialize(cur, column.get())
+                                              : ColumnArraySerde::deserialize(cur, column.get());
+        if (UNLIKELY(cur == nullptr)) {
+            return Status::Corruption("deserialize column failed");
+        }
     }
 
     for (auto& col : columns) {
@@ -19,17 +19,20 @@ class ProtobufChunkDeserializer;
 
 class ProtobufChunkSerde {
 public:
-    static int64_t max_serialized_size(const vectorized::Chunk& chunk);
+    // |encode_columns| see `serialize()`.
+    static int64_t max_serialized_size(const vectorized::Chunk& chunk, bool encode_columns = false);
 
     // Write the contents of |chunk| to ChunkPB
-    static StatusOr<ChunkPB> serialize(const vectorized::Chunk& chunk);
+    // If |encode_columns| is true, the columns are encoded by EncodedColumnSerde, which can only be deserialized
+    // by the BE supporting the version 2 of serialized chunk.
+    static StatusOr<ChunkPB> serialize(const vectorized::Chunk& chunk, bool encode_columns = false);
 
     // Like `serialize()` but leave the following fields of ChunkPB unfilled:
     //  - slot_id_map()
     //  - tuple_id_map()
     //  - is_nulls()
     //  - is_consts()
-    static StatusOr<ChunkPB> serialize_without_meta(const vectorized::Chunk& chunk);
+    static StatusOr<ChunkPB> serialize_without_meta(const vectorized::Chunk& chunk, bool encode_columns = false);
 
     // REQUIRE: the following fields of |chunk_pb| must be non-empty:
     //  - slot_id_map()
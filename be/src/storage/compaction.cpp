@@ -120,6 +120,7 @@ Status Compaction::do_compaction_impl() {
 
     RETURN_IF_ERROR(modify_rowsets());
     TRACE("modify rowsets finished");
+    _tablet->add_compaction_written_bytes(_output_rowset->data_disk_size());
 
     int64_t now = UnixMillis();
     if (compaction_type() == ReaderType::READER_CUMULATIVE_COMPACTION) {
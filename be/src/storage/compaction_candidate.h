@@ -58,7 +58,8 @@ struct CompactionCandidate {
     }
 };
 
-// Comparator should compare tablet by compaction score in descending order
+// Comparator should compare tablet by compaction score in descending order.
+// The scores of all the compaction policies are the multiples of their trigger thresholds, so they are comparable.
 // When compaction scores are equal, put smaller level ahead
 // when compaction score and level are equal, use tablet id(to be unique) instead(ascending)
 struct CompactionCandidateComparator {
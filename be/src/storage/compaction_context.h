@@ -4,6 +4,7 @@
 
 #include <memory>
 #include <set>
+#include <unordered_set>
 #include <vector>
 
 #include "storage/olap_common.h"
@@ -32,6 +33,8 @@ struct CompactionContext {
     double base_score = 0;
     TabletSharedPtr tablet;
     CompactionType chosen_compaction_type = INVALID_COMPACTION;
+    // input rowsets of the running compaction tasks of the tablet, which can not be picked again
+    std::unordered_set<Rowset*> compacting_rowsets;
 
     bool need_compaction(CompactionType compaction_type) {
         if (compaction_type == BASE_COMPACTION) {
@@ -131,6 +131,7 @@ void CompactionTask::_success_callback() {
         StarRocksMetrics::instance()->base_compaction_deltas_total.increment(_input_rowsets.size());
         StarRocksMetrics::instance()->base_compaction_bytes_total.increment(_task_info.input_rowsets_size);
     }
+    _tablet->add_compaction_written_bytes(_output_rowset->data_disk_size());
 
     // preload the rowset
     // warm-up this rowset
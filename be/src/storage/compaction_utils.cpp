@@ -8,6 +8,7 @@
 #include "storage/rowset/rowset_factory.h"
 #include "storage/rowset/rowset_writer.h"
 #include "storage/rowset/rowset_writer_context.h"
+#include "storage/size_tiered_compaction_policy.h"
 #include "storage/storage_engine.h"
 #include "storage/tablet.h"
 
@@ -113,7 +114,10 @@ CompactionAlgorithm CompactionUtils::choose_compaction_algorithm(size_t num_colu
 }
 
 std::unique_ptr<CompactionPolicy> CompactionUtils::create_compaction_policy(CompactionContext* context) {
-    // now only support BaseAndCumulativeCompactionPolicy
+    if (context->tablet != nullptr &&
+        context->tablet->tablet_meta()->compaction_policy() == CompactionPolicyPB::SIZE_TIERED) {
+        return std::make_unique<SizeTieredCompactionPolicy>(context);
+    }
     return std::make_unique<BaseAndCumulativeCompactionPolicy>(context);
 }
 
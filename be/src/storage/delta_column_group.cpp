@@ -0,0 +1,117 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#include "storage/delta_column_group.h"
+
+#include "column/column.h"
+#include "fs/fs.h"
+#include "gen_cpp/olap_file.pb.h"
+#include "gutil/strings/join.h"
+#include "gutil/strings/substitute.h"
+#include "serde/column_array_serde.h"
+#include "util/coding.h"
+
+namespace starrocks {
+
+DeltaColumnGroup::DeltaColumnGroup(int64_t version, std::vector<uint32_t> column_unique_ids, std::string file_name,
+                                   int64_t num_rows)
+        : _version(version),
+          _column_unique_ids(std::move(column_unique_ids)),
+          _file_name(std::move(file_name)),
+          _num_rows(num_rows) {}
+
+int DeltaColumnGroup::column_index(uint32_t unique_id) const {
+    for (int i = 0; i < _column_unique_ids.size(); i++) {
+        if (_column_unique_ids[i] == unique_id) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+Status DeltaColumnGroup::load(int64_t version, const char* data, size_t length) {
+    DeltaColumnGroupPB pb;
+    if (!pb.ParseFromArray(data, length)) {
+        return Status::Corruption("corrupted delta column group");
+    }
+    _version = version;
+    _column_unique_ids.assign(pb.column_unique_ids().begin(), pb.column_unique_ids().end());
+    _file_name = pb.file_name();
+    _num_rows = pb.num_rows();
+    return Status::OK();
+}
+
+std::string DeltaColumnGroup::save() const {
+    DeltaColumnGroupPB pb;
+    for (uint32_t unique_id : _column_unique_ids) {
+        pb.add_column_unique_ids(unique_id);
+    }
+    pb.set_file_name(_file_name);
+    pb.set_num_rows(_num_rows);
+    return pb.SerializeAsString();
+}
+
+std::string DeltaColumnGroup::to_string() const {
+    return strings::Substitute("version:$0 columns:[$1] file:$2 #row:$3", _version,
+                               JoinInts(_column_unique_ids, ","), _file_name, _num_rows);
+}
+
+std::string DeltaColumnGroup::gen_file_name(const RowsetId& rowset_id, uint32_t segment_id, int64_t version) {
+    // starts with the rowset id of the segment, so that it's garbage collected together with the rowset.
+    return strings::Substitute("$0_$1_$2.cols", rowset_id.to_string(), segment_id, version);
+}
+
+Status DeltaColumnGroup::write_file(FileSystem* fs, const std::string& path, const vectorized::Column& rowids,
+                                    const std::vector<const vectorized::Column*>& values,
+                                    const vectorized::Column& pks) {
+    size_t size = sizeof(uint32_t) + serde::ColumnArraySerde::max_serialized_size(rowids) +
+                  serde::ColumnArraySerde::max_serialized_size(pks);
+    for (const auto* value : values) {
+        DCHECK_EQ(rowids.size(), value->size());
+        size += serde::ColumnArraySerde::max_serialized_size(*value);
+    }
+    std::vector<uint8_t> content(size);
+    encode_fixed32_le(content.data(), values.size());
+    uint8_t* p = serde::ColumnArraySerde::serialize(rowids, content.data() + sizeof(uint32_t));
+    for (size_t i = 0; p != nullptr && i < values.size(); i++) {
+        p = serde::ColumnArraySerde::serialize(*values[i], p);
+    }
+    if (p != nullptr) {
+        p = serde::ColumnArraySerde::serialize(pks, p);
+    }
+    if (p == nullptr) {
+        return Status::InternalError("delta column serialize failed");
+    }
+    WritableFileOptions opts{.sync_on_close = true, .mode = FileSystem::CREATE_OR_OPEN_WITH_TRUNCATE};
+    ASSIGN_OR_RETURN(auto wfile, fs->new_writable_file(opts, path));
+    RETURN_IF_ERROR(wfile->append(Slice(content.data(), p - content.data())));
+    return wfile->close();
+}
+
+Status DeltaColumnGroup::read_file(FileSystem* fs, const std::string& path, vectorized::Column* rowids,
+                                   const std::vector<vectorized::Column*>& values, vectorized::Column* pks) {
+    ASSIGN_OR_RETURN(auto read_file, fs->new_random_access_file(path));
+    ASSIGN_OR_RETURN(auto file_size, read_file->get_size());
+    if (file_size < sizeof(uint32_t)) {
+        return Status::Corruption(strings::Substitute("bad delta column file $0, size: $1", path, file_size));
+    }
+    std::vector<uint8_t> content(file_size);
+    RETURN_IF_ERROR(read_file->read_at_fully(0, content.data(), content.size()));
+    uint32_t num_columns = decode_fixed32_le(content.data());
+    if (num_columns != values.size()) {
+        return Status::Corruption(strings::Substitute("bad delta column file $0, #column: $1, expected: $2", path,
+                                                      num_columns, values.size()));
+    }
+    const uint8_t* p = serde::ColumnArraySerde::deserialize(content.data() + sizeof(uint32_t), rowids);
+    for (size_t i = 0; p != nullptr && i < values.size(); i++) {
+        p = serde::ColumnArraySerde::deserialize(p, values[i]);
+    }
+    if (p != nullptr && pks != nullptr) {
+        p = serde::ColumnArraySerde::deserialize(p, pks);
+    }
+    if (p == nullptr) {
+        return Status::Corruption(strings::Substitute("bad delta column file $0, deserialization failed", path));
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks
@@ -0,0 +1,77 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "storage/olap_common.h"
+
+namespace starrocks {
+
+class FileSystem;
+
+namespace vectorized {
+class Column;
+}
+
+// The values of some columns of a segment updated by a column-mode partial update.
+// Instead of rewriting the full rows, a column-mode partial update writes only the updated columns of
+// the rows into a delta column file of each segment it touches, keyed by the rowids of the segment.
+// The delta column files are merged with the segment at read time, the one of larger version takes
+// precedence, until the segment is compacted.
+// Each DeltaColumnGroup is associated with a version, which is EditVersion's major version.
+//
+// Delta column file format:
+// |num columns(fixed32)|rowids|value column 0|...|value column n-1|encoded primary keys|
+// every column is serialized by ColumnArraySerde, and the rowids are sorted without duplicates.
+class DeltaColumnGroup {
+public:
+    DeltaColumnGroup() = default;
+    DeltaColumnGroup(int64_t version, std::vector<uint32_t> column_unique_ids, std::string file_name,
+                     int64_t num_rows);
+
+    int64_t version() const { return _version; }
+
+    const std::vector<uint32_t>& column_unique_ids() const { return _column_unique_ids; }
+
+    // the index of |unique_id| in column_unique_ids(), or -1 if the column is not updated.
+    int column_index(uint32_t unique_id) const;
+
+    // file name relative to the tablet's schema hash path
+    const std::string& file_name() const { return _file_name; }
+
+    int64_t num_rows() const { return _num_rows; }
+
+    Status load(int64_t version, const char* data, size_t length);
+
+    std::string save() const;
+
+    std::string to_string() const;
+
+    static std::string gen_file_name(const RowsetId& rowset_id, uint32_t segment_id, int64_t version);
+
+    // |rowids| must be a UInt32Column sorted in ascending order without duplicates, |values| one column
+    // for each updated column, and |pks| the encoded primary keys of the rows.
+    static Status write_file(FileSystem* fs, const std::string& path, const vectorized::Column& rowids,
+                             const std::vector<const vectorized::Column*>& values, const vectorized::Column& pks);
+
+    // |values| must be empty columns of the types of the updated columns. The primary keys are not read
+    // if |pks| is null.
+    static Status read_file(FileSystem* fs, const std::string& path, vectorized::Column* rowids,
+                            const std::vector<vectorized::Column*>& values, vectorized::Column* pks);
+
+private:
+    int64_t _version = 0;
+    std::vector<uint32_t> _column_unique_ids;
+    std::string _file_name;
+    int64_t _num_rows = 0;
+};
+
+using DeltaColumnGroupPtr = std::shared_ptr<DeltaColumnGroup>;
+// sorted by version in ascending order
+using DeltaColumnGroupList = std::vector<DeltaColumnGroupPtr>;
+
+} // namespace starrocks
@@ -2,6 +2,7 @@
 
 #include "storage/lake/rowset.h"
 
+#include "fs/block_cache.h"
 #include "storage/chunk_helper.h"
 #include "storage/chunk_iterator.h"
 #include "storage/delete_predicates.h"
@@ -27,11 +28,13 @@ Rowset::~Rowset() = default;
 //  2. rowid range and short key range
 StatusOr<ChunkIteratorPtr> Rowset::read(const vectorized::Schema& schema, const RowsetReadOptions& options) {
     vectorized::SegmentReadOptions seg_options;
-    ASSIGN_OR_RETURN(seg_options.fs, FileSystem::CreateSharedFromString(_tablet->root_location()));
+    ASSIGN_OR_RETURN(auto fs, FileSystem::CreateSharedFromString(_tablet->root_location()));
+    seg_options.fs = new_fs_block_cache(std::move(fs));
     seg_options.stats = options.stats;
     seg_options.ranges = options.ranges;
     seg_options.predicates = options.predicates;
     seg_options.predicates_for_zone_map = options.predicates_for_zone_map;
+    seg_options.runtime_range_pruner = options.runtime_range_pruner;
     seg_options.use_page_cache = options.use_page_cache;
     seg_options.profile = options.profile;
     seg_options.reader_type = options.reader_type;
@@ -3,6 +3,7 @@
 #include "storage/lake/tablet.h"
 
 #include "column/schema.h"
+#include "fs/block_cache.h"
 #include "fs/fs.h"
 #include "runtime/exec_env.h"
 #include "storage/lake/general_tablet_writer.h"
@@ -82,6 +83,7 @@ StatusOr<SegmentPtr> Tablet::load_segment(std::string_view segment_name, int seg
     auto location = segment_location(segment_name);
     ASSIGN_OR_RETURN(auto tablet_schema, get_schema());
     ASSIGN_OR_RETURN(auto fs, FileSystem::CreateSharedFromString(location));
+    fs = new_fs_block_cache(std::move(fs));
     ASSIGN_OR_RETURN(segment, Segment::open(ExecEnv::GetInstance()->tablet_meta_mem_tracker(), fs, location, seg_id,
                                             std::move(tablet_schema), footer_size_hint));
     if (fill_cache) {
@@ -41,9 +41,18 @@ static Status publish(Tablet* tablet, int64_t base_version, int64_t new_version,
 static void* metadata_gc_trigger(void* arg);
 static void* segment_gc_trigger(void* arg);
 
+static CacheEvictionPolicy metacache_eviction_policy() {
+    CacheEvictionPolicy policy = CacheEvictionPolicy::LRU;
+    if (!parse_cache_eviction_policy(config::lake_metadata_cache_eviction_policy, &policy)) {
+        LOG(WARNING) << "Invalid lake_metadata_cache_eviction_policy: " << config::lake_metadata_cache_eviction_policy
+                     << ", use lru instead";
+    }
+    return policy;
+}
+
 TabletManager::TabletManager(LocationProvider* location_provider, int64_t cache_capacity)
         : _location_provider(location_provider),
-          _metacache(new_lru_cache(cache_capacity)),
+          _metacache(new_lru_cache(cache_capacity, metacache_eviction_policy())),
           _metadata_gc_tid(INVALID_BTHREAD),
           _segment_gc_tid(INVALID_BTHREAD) {}
 
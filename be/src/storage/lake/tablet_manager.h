@@ -39,6 +39,8 @@ public:
 
     ~TabletManager();
 
+    Cache* metacache() const { return _metacache.get(); }
+
     DISALLOW_COPY_AND_MOVE(TabletManager);
 
     Status create_tablet(const TCreateTabletReq& req);
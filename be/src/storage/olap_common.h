@@ -434,6 +434,8 @@ struct OlapReaderStatistics {
     int64_t segment_create_chunk_ns = 0;
 
     int64_t segment_stats_filtered = 0;
+    // Rows of the segments pruned by the zone maps of the join runtime filters arrived after the reader is opened.
+    int64_t segment_runtime_stats_filtered = 0;
     int64_t rows_key_range_filtered = 0;
     int64_t rows_stats_filtered = 0;
     int64_t rows_bf_filtered = 0;
@@ -445,6 +447,10 @@ struct OlapReaderStatistics {
     int64_t total_pages_num = 0;
     int64_t cached_pages_num = 0;
 
+    // Bytes of lake segments read from the local block cache and from the remote storage.
+    int64_t block_cache_hit_bytes = 0;
+    int64_t block_cache_miss_bytes = 0;
+
     int64_t rows_bitmap_index_filtered = 0;
     int64_t bitmap_index_filter_timer = 0;
 
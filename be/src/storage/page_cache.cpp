@@ -23,8 +23,10 @@
 
 #include <malloc.h>
 
+#include "column/column.h"
 #include "runtime/current_thread.h"
 #include "runtime/mem_tracker.h"
+#include "storage/page_disk_cache.h"
 #include "util/defer_op.h"
 #include "util/metrics.h"
 
@@ -32,9 +34,9 @@ namespace starrocks {
 
 StoragePageCache* StoragePageCache::_s_instance = nullptr;
 
-void StoragePageCache::create_global_cache(MemTracker* mem_tracker, size_t capacity) {
+void StoragePageCache::create_global_cache(MemTracker* mem_tracker, size_t capacity, CacheEvictionPolicy policy) {
     if (_s_instance == nullptr) {
-        _s_instance = new StoragePageCache(mem_tracker, capacity);
+        _s_instance = new StoragePageCache(mem_tracker, capacity, policy);
     }
 }
 
@@ -45,17 +47,46 @@ void StoragePageCache::release_global_cache() {
     }
 }
 
-StoragePageCache::StoragePageCache(MemTracker* mem_tracker, size_t capacity)
-        : _mem_tracker(mem_tracker), _cache(new_lru_cache(capacity)) {}
+StoragePageCache::StoragePageCache(MemTracker* mem_tracker, size_t capacity, CacheEvictionPolicy policy)
+        : _mem_tracker(mem_tracker), _cache(new_lru_cache(capacity, policy)) {}
 
-StoragePageCache::~StoragePageCache() {}
+StoragePageCache::~StoragePageCache() {
+    // The evicted pages can't be written into the disk cache any more.
+    _cache->set_evict_listener(nullptr);
+}
+
+Status StoragePageCache::init_disk_cache(const std::string& dir, int64_t capacity, int64_t region_size) {
+    auto disk_cache = std::make_unique<PageDiskCache>();
+    RETURN_IF_ERROR(disk_cache->init(dir, capacity, region_size, _mem_tracker));
+    _disk_cache = std::move(disk_cache);
+    _cache->set_evict_listener([disk_cache = _disk_cache.get()](const starrocks::CacheKey& key, const Slice& value) {
+        disk_cache->write(std::string_view(key.data(), key.size()), value);
+    });
+    return Status::OK();
+}
+
+void StoragePageCache::shutdown_disk_cache() {
+    if (_disk_cache != nullptr) {
+        _disk_cache->shutdown();
+    }
+}
 
 bool StoragePageCache::lookup(const CacheKey& key, PageCacheHandle* handle) {
-    auto* lru_handle = _cache->lookup(key.encode());
-    if (lru_handle == nullptr) {
+    auto encoded_key = key.encode();
+    auto* lru_handle = _cache->lookup(encoded_key);
+    if (lru_handle != nullptr) {
+        *handle = PageCacheHandle(_cache.get(), lru_handle);
+        return true;
+    }
+    if (_disk_cache == nullptr || !_disk_cache->is_enabled()) {
         return false;
     }
-    *handle = PageCacheHandle(_cache.get(), lru_handle);
+    // Allocate APPEND_OVERFLOW_MAX_SIZE more bytes to make append_strings_overflow work, like PageIO does.
+    auto page_or = _disk_cache->read(encoded_key, vectorized::Column::APPEND_OVERFLOW_MAX_SIZE);
+    if (!page_or.ok()) {
+        return false;
+    }
+    insert(key, page_or.value(), handle);
     return true;
 }
 
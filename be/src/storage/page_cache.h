@@ -34,6 +34,7 @@
 namespace starrocks {
 
 class PageCacheHandle;
+class PageDiskCache;
 class MemTracker;
 
 // Warpper around Cache, and used for cache page of column datas
@@ -62,7 +63,8 @@ public:
     };
 
     // Create global instance of this class
-    static void create_global_cache(MemTracker* mem_tracker, size_t capacity);
+    static void create_global_cache(MemTracker* mem_tracker, size_t capacity,
+                                    CacheEvictionPolicy policy = CacheEvictionPolicy::LRU);
 
     static void release_global_cache();
 
@@ -70,13 +72,23 @@ public:
     // Client should call create_global_cache before.
     static StoragePageCache* instance() { return _s_instance; }
 
-    StoragePageCache(MemTracker* mem_tracker, size_t capacity);
+    StoragePageCache(MemTracker* mem_tracker, size_t capacity, CacheEvictionPolicy policy = CacheEvictionPolicy::LRU);
+
+    // Enable the persistent second tier under |dir| on the local disk, see PageDiskCache.
+    // The pages evicted from memory are written into it, and it's searched when a page is missed
+    // in memory. Must be called before the cache is used.
+    Status init_disk_cache(const std::string& dir, int64_t capacity, int64_t region_size);
+
+    // Seal and disable the second tier.
+    void shutdown_disk_cache();
+
+    PageDiskCache* disk_cache() const { return _disk_cache.get(); }
 
     // Lookup the given page in the cache.
     //
     // If the page is found, the cache entry will be written into handle.
     // PageCacheHandle will release cache entry to cache when it
-    // destructs.
+    // destructs. A page found in the second tier is loaded into memory.
     //
     // Return true if entry is found, otherwise return false.
     bool lookup(const CacheKey& key, PageCacheHandle* handle);
@@ -90,11 +102,15 @@ public:
 
     size_t memory_usage() const { return _cache->get_memory_usage(); }
 
+    uint64_t lookup_count() const { return _cache->get_lookup_count(); }
+    uint64_t hit_count() const { return _cache->get_hit_count(); }
+
 private:
     static StoragePageCache* _s_instance;
 
     MemTracker* _mem_tracker = nullptr;
     std::unique_ptr<Cache> _cache = nullptr;
+    std::unique_ptr<PageDiskCache> _disk_cache;
 };
 
 // A handle for StoragePageCache entry. This class make it easy to handle
@@ -0,0 +1,400 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#include "storage/page_disk_cache.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "common/logging.h"
+#include "fs/fs.h"
+#include "gutil/strings/numbers.h"
+#include "runtime/current_thread.h"
+#include "util/coding.h"
+#include "util/crc32c.h"
+#include "util/hash_util.hpp"
+#include "util/threadpool.h"
+
+namespace starrocks {
+
+static constexpr uint32_t kRegionMagic = 0x53525043; // "SRPC"
+// key length and checksum
+static constexpr int64_t kRecordTrailerSize = 8;
+// hash, offset and size
+static constexpr int64_t kIndexEntrySize = 16;
+// number of index entries, checksum and magic
+static constexpr int64_t kRegionFooterSize = 12;
+static constexpr const char* kRegionFilePrefix = "region_";
+
+PageDiskCache::PageDiskCache() = default;
+
+PageDiskCache::~PageDiskCache() {
+    shutdown();
+}
+
+Status PageDiskCache::init(const std::string& dir, int64_t capacity, int64_t region_size, MemTracker* mem_tracker) {
+    if (is_enabled()) {
+        return Status::InternalError("page disk cache has been initialized");
+    }
+    if (region_size <= 0 || region_size > std::numeric_limits<uint32_t>::max() || capacity < region_size) {
+        return Status::InvalidArgument(
+                fmt::format("invalid page disk cache capacity {} or region size {}", capacity, region_size));
+    }
+    _dir = dir;
+    _capacity = capacity;
+    _region_size = region_size;
+    _mem_tracker = mem_tracker;
+    RETURN_IF_ERROR(FileSystem::Default()->create_dir_recursive(_dir));
+    RETURN_IF_ERROR(_load_regions());
+    // Pages are appended to the current region, so there must be only one writing thread.
+    RETURN_IF_ERROR(ThreadPoolBuilder("page_disk_cache").set_min_threads(0).set_max_threads(1).build(&_write_pool));
+    _enabled.store(true, std::memory_order_release);
+    LOG(INFO) << "Initialized page disk cache at " << _dir << ", capacity: " << _capacity
+              << ", region size: " << _region_size << ", loaded regions: " << num_regions()
+              << ", loaded pages: " << num_pages() << ", loaded bytes: " << size();
+    return Status::OK();
+}
+
+void PageDiskCache::shutdown() {
+    _enabled.store(false, std::memory_order_release);
+    if (_write_pool != nullptr) {
+        _write_pool->shutdown();
+        _write_pool.reset();
+    }
+    // Seal the current region, so its pages can be loaded after restart.
+    if (_active != nullptr) {
+        auto st = _seal_region();
+        if (!st.ok()) {
+            LOG(WARNING) << "Fail to seal page disk cache region: " << st;
+            _drop_active_region();
+        }
+    }
+    std::lock_guard l(_mutex);
+    _index.clear();
+    _regions.clear();
+    _size = 0;
+    _pending_bytes = 0;
+}
+
+uint64_t PageDiskCache::_hash(std::string_view key) {
+    // The hash function must be stable across processes, because the hash is persisted in the region index.
+    return HashUtil::murmur_hash64A(key.data(), static_cast<int32_t>(key.size()), 0);
+}
+
+std::string PageDiskCache::_region_file(uint32_t id) const {
+    return fmt::format("{}/{}{}", _dir, kRegionFilePrefix, id);
+}
+
+Status PageDiskCache::_load_regions() {
+    auto fs = FileSystem::Default();
+    std::vector<std::string> names;
+    RETURN_IF_ERROR(fs->get_children(_dir, &names));
+
+    std::vector<uint32_t> ids;
+    size_t prefix_size = strlen(kRegionFilePrefix);
+    for (const auto& name : names) {
+        uint32_t id = 0;
+        if (name.compare(0, prefix_size, kRegionFilePrefix) == 0 && safe_strtou32(name.substr(prefix_size), &id)) {
+            ids.push_back(id);
+        }
+    }
+    // Load the oldest region first, so the newest page wins if a page is cached in several regions.
+    std::sort(ids.begin(), ids.end());
+    for (auto id : ids) {
+        auto st = _load_region(id);
+        if (!st.ok()) {
+            // Most likely the region being written when the process exited.
+            LOG(WARNING) << "Remove page disk cache region " << _region_file(id) << ": " << st;
+            WARN_IF_ERROR(fs->delete_file(_region_file(id)), "fail to delete page disk cache region");
+        }
+    }
+    _next_region_id = ids.empty() ? 0 : ids.back() + 1;
+
+    std::vector<RegionPtr> evicted;
+    {
+        std::lock_guard l(_mutex);
+        evicted = _evict_if_needed();
+    }
+    _delete_files(evicted);
+    return Status::OK();
+}
+
+Status PageDiskCache::_load_region(uint32_t id) {
+    auto path = _region_file(id);
+    ASSIGN_OR_RETURN(auto reader, FileSystem::Default()->new_random_access_file(path));
+    ASSIGN_OR_RETURN(auto file_size, reader->get_size());
+    if (file_size < kRegionFooterSize) {
+        return Status::Corruption("region is not sealed");
+    }
+    uint8_t footer[kRegionFooterSize];
+    RETURN_IF_ERROR(reader->read_at_fully(file_size - kRegionFooterSize, footer, kRegionFooterSize));
+    if (decode_fixed32_le(footer + 8) != kRegionMagic) {
+        return Status::Corruption("region is not sealed");
+    }
+    int64_t num_entries = decode_fixed32_le(footer);
+    int64_t data_size = file_size - kRegionFooterSize - num_entries * kIndexEntrySize;
+    if (data_size < 0) {
+        return Status::Corruption("bad region index size");
+    }
+    // The checksum covers the index entries and the number of entries.
+    std::string index(num_entries * kIndexEntrySize + 4, '\0');
+    RETURN_IF_ERROR(reader->read_at_fully(data_size, index.data(), index.size()));
+    if (crc32c::Value(index.data(), index.size()) != decode_fixed32_le(footer + 4)) {
+        return Status::Corruption("region index checksum mismatch");
+    }
+
+    auto region = std::make_shared<Region>();
+    region->id = id;
+    region->path = path;
+    region->size = file_size;
+    region->reader = std::move(reader);
+    region->hashes.reserve(num_entries);
+    std::vector<Location> locations;
+    locations.reserve(num_entries);
+    for (int64_t i = 0; i < num_entries; i++) {
+        auto* entry = reinterpret_cast<const uint8_t*>(index.data()) + i * kIndexEntrySize;
+        Location location{id, decode_fixed32_le(entry + 8), decode_fixed32_le(entry + 12)};
+        if (location.offset + static_cast<int64_t>(location.size) > data_size) {
+            return Status::Corruption("bad region index entry");
+        }
+        region->hashes.push_back(decode_fixed64_le(entry));
+        locations.push_back(location);
+    }
+
+    std::lock_guard l(_mutex);
+    for (size_t i = 0; i < locations.size(); i++) {
+        _index[region->hashes[i]] = locations[i];
+    }
+    _size += region->size;
+    _regions.emplace(id, std::move(region));
+    return Status::OK();
+}
+
+StatusOr<Slice> PageDiskCache::read(std::string_view key, size_t padding) {
+    if (!is_enabled()) {
+        return Status::NotFound("page disk cache is disabled");
+    }
+    uint64_t hash = _hash(key);
+    Location location;
+    RegionPtr region;
+    {
+        std::lock_guard l(_mutex);
+        auto it = _index.find(hash);
+        auto region_it = it == _index.end() ? _regions.end() : _regions.find(it->second.region_id);
+        if (region_it == _regions.end()) {
+            _miss_count.fetch_add(1, std::memory_order_relaxed);
+            return Status::NotFound("page not found in disk cache");
+        }
+        location = it->second;
+        region = region_it->second;
+    }
+
+    // The region may be evicted concurrently, the opened file can still be read in that case.
+    std::unique_ptr<char[]> buff(new char[location.size + padding]);
+    uint32_t page_size = 0;
+    auto st = region->reader->pread_fully(location.offset, buff.get(), location.size);
+    if (st.ok()) {
+        auto* trailer = reinterpret_cast<const uint8_t*>(buff.get()) + location.size - kRecordTrailerSize;
+        uint32_t key_size = decode_fixed32_le(trailer);
+        page_size = location.size - kRecordTrailerSize - key_size;
+        if (location.size < key_size + kRecordTrailerSize ||
+            crc32c::Value(buff.get(), location.size - 4) != decode_fixed32_le(trailer + 4)) {
+            st = Status::Corruption("page disk cache record checksum mismatch");
+        } else if (std::string_view(buff.get() + page_size, key_size) != key) {
+            // Different keys may have the same hash value.
+            st = Status::NotFound("page not found in disk cache");
+        }
+    }
+    if (!st.ok()) {
+        LOG_IF(WARNING, !st.is_not_found()) << "Fail to read page disk cache region " << region->path << ": " << st;
+        _miss_count.fetch_add(1, std::memory_order_relaxed);
+        return Status::NotFound(st.get_error_msg());
+    }
+    _hit_count.fetch_add(1, std::memory_order_relaxed);
+    return Slice(buff.release(), page_size);
+}
+
+void PageDiskCache::write(std::string_view key, const Slice& data) {
+    if (!is_enabled() || data.size == 0) {
+        return;
+    }
+    int64_t record_size = data.size + key.size() + kRecordTrailerSize;
+    if (record_size > _region_size) {
+        return;
+    }
+    {
+        std::lock_guard l(_mutex);
+        if (_index.count(_hash(key)) > 0 || _pending_bytes + record_size > kMaxPendingBytes) {
+            return;
+        }
+        _pending_bytes += record_size;
+    }
+    auto st = _write_pool->submit_func([this, record_size, key = std::string(key), data = data.to_string()]() mutable {
+        SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(_mem_tracker);
+        // Release the page inside the scope of the mem tracker.
+        std::string page = std::move(data);
+        _do_write(key, page);
+        std::lock_guard l(_mutex);
+        _pending_bytes -= record_size;
+    });
+    if (!st.ok()) {
+        std::lock_guard l(_mutex);
+        _pending_bytes -= record_size;
+    }
+}
+
+void PageDiskCache::_do_write(const std::string& key, const std::string& data) {
+    int64_t record_size = data.size() + key.size() + kRecordTrailerSize;
+    uint8_t trailer[kRecordTrailerSize];
+    encode_fixed32_le(trailer, key.size());
+    uint32_t checksum = crc32c::Value(data.data(), data.size());
+    checksum = crc32c::Extend(checksum, key.data(), key.size());
+    checksum = crc32c::Extend(checksum, reinterpret_cast<const char*>(trailer), 4);
+    encode_fixed32_le(trailer + 4, checksum);
+
+    auto st = [&]() -> Status {
+        if (_active != nullptr && _active->size + record_size > _region_size) {
+            RETURN_IF_ERROR(_seal_region());
+        }
+        if (_active == nullptr) {
+            RETURN_IF_ERROR(_open_region());
+        }
+        Slice slices[3] = {Slice(data), Slice(key), Slice(trailer, kRecordTrailerSize)};
+        return _writer->appendv(slices, 3);
+    }();
+    if (!st.ok()) {
+        LOG(WARNING) << "Fail to write page disk cache: " << st;
+        _drop_active_region();
+        return;
+    }
+
+    uint64_t hash = _hash(key);
+    auto offset = static_cast<uint32_t>(_active->size);
+    put_fixed64_le(&_active_index, hash);
+    put_fixed32_le(&_active_index, offset);
+    put_fixed32_le(&_active_index, record_size);
+    std::vector<RegionPtr> evicted;
+    {
+        std::lock_guard l(_mutex);
+        _index[hash] = Location{_active->id, offset, static_cast<uint32_t>(record_size)};
+        _active->hashes.push_back(hash);
+        _active->size += record_size;
+        _size += record_size;
+        evicted = _evict_if_needed();
+    }
+    _delete_files(evicted);
+}
+
+Status PageDiskCache::_open_region() {
+    auto fs = FileSystem::Default();
+    auto region = std::make_shared<Region>();
+    region->id = _next_region_id++;
+    region->path = _region_file(region->id);
+    _active = region;
+    _active_index.clear();
+
+    WritableFileOptions opts;
+    opts.sync_on_close = false;
+    opts.mode = FileSystem::CREATE_OR_OPEN_WITH_TRUNCATE;
+    ASSIGN_OR_RETURN(_writer, fs->new_writable_file(opts, region->path));
+    ASSIGN_OR_RETURN(region->reader, fs->new_random_access_file(region->path));
+    std::lock_guard l(_mutex);
+    _regions.emplace(region->id, std::move(region));
+    return Status::OK();
+}
+
+Status PageDiskCache::_seal_region() {
+    std::string footer = std::move(_active_index);
+    _active_index.clear();
+    put_fixed32_le(&footer, _active->hashes.size());
+    // The checksum covers the index entries and the number of entries.
+    put_fixed32_le(&footer, crc32c::Value(footer.data(), footer.size()));
+    put_fixed32_le(&footer, kRegionMagic);
+    RETURN_IF_ERROR(_writer->append(footer));
+    RETURN_IF_ERROR(_writer->close());
+    _writer.reset();
+    std::lock_guard l(_mutex);
+    _active->size += footer.size();
+    _size += footer.size();
+    _active.reset();
+    return Status::OK();
+}
+
+void PageDiskCache::_drop_active_region() {
+    if (_writer != nullptr) {
+        WARN_IF_ERROR(_writer->close(), "fail to close page disk cache region");
+        _writer.reset();
+    }
+    if (_active == nullptr) {
+        return;
+    }
+    {
+        std::lock_guard l(_mutex);
+        _remove_region_locked(_active->id);
+    }
+    _delete_files({_active});
+    _active.reset();
+    _active_index.clear();
+}
+
+std::vector<PageDiskCache::RegionPtr> PageDiskCache::_evict_if_needed() {
+    std::vector<RegionPtr> evicted;
+    while (_size > _capacity && !_regions.empty()) {
+        auto region = _regions.begin()->second;
+        if (_active != nullptr && region->id == _active->id) {
+            break;
+        }
+        evicted.push_back(region);
+        _remove_region_locked(region->id);
+    }
+    return evicted;
+}
+
+void PageDiskCache::_remove_region_locked(uint32_t id) {
+    auto it = _regions.find(id);
+    if (it == _regions.end()) {
+        return;
+    }
+    auto& region = it->second;
+    for (auto hash : region->hashes) {
+        auto index_it = _index.find(hash);
+        // The page may have been written into a newer region again.
+        if (index_it != _index.end() && index_it->second.region_id == id) {
+            _index.erase(index_it);
+        }
+    }
+    _size -= region->size;
+    _regions.erase(it);
+}
+
+void PageDiskCache::_delete_files(const std::vector<RegionPtr>& regions) {
+    for (const auto& region : regions) {
+        WARN_IF_ERROR(FileSystem::Default()->delete_file(region->path),
+                      "fail to delete page disk cache region " + region->path);
+    }
+}
+
+void PageDiskCache::wait_for_writing() {
+    if (_write_pool != nullptr) {
+        _write_pool->wait();
+    }
+}
+
+int64_t PageDiskCache::size() const {
+    std::lock_guard l(_mutex);
+    return _size;
+}
+
+size_t PageDiskCache::num_pages() const {
+    std::lock_guard l(_mutex);
+    return _index.size();
+}
+
+size_t PageDiskCache::num_regions() const {
+    std::lock_guard l(_mutex);
+    return _regions.size();
+}
+
+} // namespace starrocks
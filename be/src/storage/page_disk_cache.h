@@ -0,0 +1,139 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "common/statusor.h"
+#include "util/slice.h"
+
+namespace starrocks {
+
+class MemTracker;
+class RandomAccessFile;
+class ThreadPool;
+class WritableFile;
+
+// PageDiskCache is the second tier of StoragePageCache, the decompressed pages evicted from memory
+// are written into it, so the effective page cache can be much larger than the memory and survives
+// restarts of the process.
+//
+// Pages are appended to region files of about |region_size| bytes under the cache dir, every page is
+// stored as a record:
+//      [page data][key][key length: fixed32][checksum: fixed32]
+// A region is sealed when it's full, by appending the index of its records to the file:
+//      [records][index entry * N][N: fixed32][checksum: fixed32][magic: fixed32]
+// where an index entry is [key hash: fixed64][record offset: fixed32][record size: fixed32].
+// The whole cache is indexed by a compact in-memory map from the hash of page key to the location of
+// its record, it's rebuilt from the index of the sealed regions on startup. The region being written
+// when the process exited is discarded.
+//
+// Regions are evicted in FIFO order once the total size exceeds the capacity. The key and checksum of
+// a record are verified on every read, so a hash collision or a record being evicted is a cache miss.
+class PageDiskCache {
+public:
+    PageDiskCache();
+    ~PageDiskCache();
+
+    PageDiskCache(const PageDiskCache&) = delete;
+    void operator=(const PageDiskCache&) = delete;
+
+    // Load the sealed regions under |dir| and start the writing thread.
+    // The memory of the pages waiting to be written is accounted to |mem_tracker| if it's not null.
+    Status init(const std::string& dir, int64_t capacity, int64_t region_size, MemTracker* mem_tracker = nullptr);
+
+    // Wait for the page being written, seal the current region and disable the cache.
+    void shutdown();
+
+    bool is_enabled() const { return _enabled.load(std::memory_order_acquire); }
+
+    int64_t capacity() const { return _capacity; }
+
+    // Read the page of |key| into a buffer allocated by new[], the buffer is |padding| bytes larger
+    // than the page and is owned by the caller. Return Status::NotFound if the page is not cached.
+    StatusOr<Slice> read(std::string_view key, size_t padding = 0);
+
+    // Write the page of |key| into the cache asynchronously, |data| is copied.
+    // Do nothing if the page is already cached or too many bytes are waiting to be written.
+    void write(std::string_view key, const Slice& data);
+
+    // Wait until all submitted pages are written.
+    void wait_for_writing();
+
+    // Total size of the region files.
+    int64_t size() const;
+    size_t num_pages() const;
+    size_t num_regions() const;
+
+    int64_t hit_count() const { return _hit_count.load(std::memory_order_relaxed); }
+    int64_t miss_count() const { return _miss_count.load(std::memory_order_relaxed); }
+
+private:
+    struct Location {
+        uint32_t region_id;
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    struct Region {
+        uint32_t id = 0;
+        std::string path;
+        int64_t size = 0;
+        // Hash of the pages in this region, used to clean up the index when the region is evicted.
+        std::vector<uint64_t> hashes;
+        std::shared_ptr<RandomAccessFile> reader;
+    };
+    using RegionPtr = std::shared_ptr<Region>;
+
+    // Pages are dropped when this number of bytes are waiting to be written.
+    static constexpr int64_t kMaxPendingBytes = 64 * 1024 * 1024;
+
+    static uint64_t _hash(std::string_view key);
+    std::string _region_file(uint32_t id) const;
+
+    Status _load_regions();
+    Status _load_region(uint32_t id);
+
+    void _do_write(const std::string& key, const std::string& data);
+    Status _open_region();
+    Status _seal_region();
+    void _drop_active_region();
+    // Evict the oldest regions until the total size fits the capacity, return the evicted regions.
+    // REQUIRES: _mutex is held.
+    std::vector<RegionPtr> _evict_if_needed();
+    void _remove_region_locked(uint32_t id);
+    void _delete_files(const std::vector<RegionPtr>& regions);
+
+    std::atomic<bool> _enabled{false};
+    std::string _dir;
+    int64_t _capacity = 0;
+    int64_t _region_size = 0;
+    MemTracker* _mem_tracker = nullptr;
+
+    mutable std::mutex _mutex;
+    std::unordered_map<uint64_t, Location> _index;
+    // Ordered by region id, the first one is the oldest region.
+    std::map<uint32_t, RegionPtr> _regions;
+    int64_t _size = 0;
+    int64_t _pending_bytes = 0;
+
+    // The region being written, only accessed by the writing thread.
+    RegionPtr _active;
+    std::unique_ptr<WritableFile> _writer;
+    std::string _active_index;
+    uint32_t _next_region_id = 0;
+
+    std::unique_ptr<ThreadPool> _write_pool;
+
+    std::atomic<int64_t> _hit_count{0};
+    std::atomic<int64_t> _miss_count{0};
+};
+
+} // namespace starrocks
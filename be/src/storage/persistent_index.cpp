@@ -5,15 +5,19 @@
 #include <cstring>
 #include <numeric>
 
+#include "common/config.h"
 #include "fs/fs.h"
 #include "gutil/strings/substitute.h"
 #include "storage/chunk_helper.h"
 #include "storage/chunk_iterator.h"
 #include "storage/primary_key_encoder.h"
+#include "storage/rowset/bloom_filter.h"
 #include "storage/rowset/rowset.h"
+#include "storage/storage_engine.h"
 #include "storage/tablet.h"
 #include "storage/tablet_meta_manager.h"
 #include "storage/tablet_updates.h"
+#include "storage/update_manager.h"
 #include "util/bit_util.h"
 #include "util/coding.h"
 #include "util/crc32c.h"
@@ -74,6 +78,16 @@ struct IndexHash {
     uint64_t hash;
 };
 
+// The shard of a key is decided by the most significant bits of its hash, which are also used by the block split
+// bloom filter to choose the block, so the hash is remixed before being added to or tested by the bloom filter of
+// a shard, otherwise only a fraction of the blocks would be used.
+static inline uint64_t bloom_filter_hash(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
 MutableIndex::MutableIndex() {}
 
 MutableIndex::~MutableIndex() {}
@@ -516,6 +530,9 @@ public:
         auto ptr_meta = shard_meta->mutable_data();
         ptr_meta->set_offset(pos_before);
         ptr_meta->set_size(pos_after - pos_before);
+        if (config::enable_persistent_index_bloom_filter && !kvs.empty()) {
+            RETURN_IF_ERROR(_write_bloom_filter(kvs, shard_meta->mutable_bloom_filter()));
+        }
         _total += kvs.size();
         _total_moved += shard->num_entry_moved;
         if (key_size != 0) {
@@ -542,9 +559,9 @@ public:
 
     Status finish() {
         LOG(INFO) << strings::Substitute(
-                "finish writing immutable index $0 #shard:$1 #kv:$2 #moved:$3($4) bytes:$5 usage:$6",
+                "finish writing immutable index $0 #shard:$1 #kv:$2 #moved:$3($4) bytes:$5 usage:$6 bf_bytes:$7",
                 _idx_file_path_tmp, _nshard, _total, _total_moved, _total_moved * 1000 / std::max(_total, 1UL) / 1000.0,
-                _total_bytes, _total_kv_size * 1000 / std::max(_total_bytes, 1UL) / 1000.0);
+                _total_bytes, _total_kv_size * 1000 / std::max(_total_bytes, 1UL) / 1000.0, _total_bloom_filter_bytes);
         _version.to_pb(_meta.mutable_version());
         _meta.set_size(_total);
         //TODO(zhangqiang)
@@ -575,6 +592,22 @@ public:
     }
 
 private:
+    // build the bloom filter of the hashes of |kvs| and write it right after the shard
+    Status _write_bloom_filter(const std::vector<KVRef>& kvs, PagePointerPB* ptr_meta) {
+        std::unique_ptr<BloomFilter> bf;
+        RETURN_IF_ERROR(BloomFilter::create(BLOCK_BLOOM_FILTER, &bf));
+        RETURN_IF_ERROR(bf->init(kvs.size(), config::persistent_index_bloom_filter_fpp, HASH_MURMUR3_X64_64));
+        for (const auto& kv : kvs) {
+            bf->add_hash(bloom_filter_hash(kv.hash));
+        }
+        size_t pos_before = _wb->size();
+        RETURN_IF_ERROR(_wb->append(Slice(bf->data(), bf->size())));
+        ptr_meta->set_offset(pos_before);
+        ptr_meta->set_size(bf->size());
+        _total_bloom_filter_bytes += bf->size();
+        return Status::OK();
+    }
+
     EditVersion _version;
     string _idx_file_path_tmp;
     string _idx_file_path;
@@ -588,6 +621,7 @@ private:
     size_t _total_moved = 0;
     size_t _total_kv_size = 0;
     size_t _total_bytes = 0;
+    size_t _total_bloom_filter_bytes = 0;
     ImmutableIndexMetaPB _meta;
 };
 
@@ -1154,19 +1188,52 @@ Status ImmutableIndex::_get_in_varlen_shard(size_t shard_idx, size_t n, const Sl
     return Status::OK();
 }
 
+ImmutableIndex::~ImmutableIndex() = default;
+
+void ImmutableIndex::clear() {
+    if (_file != nullptr) {
+        _file.reset();
+    }
+    _bloom_filters.clear();
+    _bloom_filter_bytes = 0;
+}
+
+bool ImmutableIndex::_filter_by_bloom_filter(size_t shard_idx, const KeysInfo& keys_info, KeysInfo* filtered) const {
+    if (shard_idx >= _bloom_filters.size() || _bloom_filters[shard_idx] == nullptr) {
+        return false;
+    }
+    const auto& bf = _bloom_filters[shard_idx];
+    for (size_t i = 0; i < keys_info.size(); i++) {
+        if (bf->test_hash(bloom_filter_hash(keys_info.hashes[i]))) {
+            filtered->key_idxes.emplace_back(keys_info.key_idxes[i]);
+            filtered->hashes.emplace_back(keys_info.hashes[i]);
+        }
+    }
+    return true;
+}
+
 Status ImmutableIndex::_get_in_shard(size_t shard_idx, size_t n, const Slice* keys, const KeysInfo& keys_info,
                                      IndexValue* values, size_t* num_found) const {
     const auto& shard_info = _shards[shard_idx];
     if (shard_info.size == 0 || shard_info.npage == 0 || keys_info.size() == 0) {
         return Status::OK();
     }
+    // skip reading the shard if none of the keys can exist in it
+    KeysInfo filtered;
+    const KeysInfo* probe_keys_info = &keys_info;
+    if (_filter_by_bloom_filter(shard_idx, keys_info, &filtered)) {
+        if (filtered.size() == 0) {
+            return Status::OK();
+        }
+        probe_keys_info = &filtered;
+    }
     std::unique_ptr<ImmutableIndexShard> shard = std::make_unique<ImmutableIndexShard>(shard_info.npage);
     CHECK(shard->pages.size() * kPageSize == shard_info.bytes) << "illegal shard size";
     RETURN_IF_ERROR(_file->read_at_fully(shard_info.offset, shard->pages.data(), shard_info.bytes));
     if (shard_info.key_size != 0) {
-        return _get_in_fixlen_shard(shard_idx, n, keys, keys_info, values, num_found, &shard);
+        return _get_in_fixlen_shard(shard_idx, n, keys, *probe_keys_info, values, num_found, &shard);
     } else {
-        return _get_in_varlen_shard(shard_idx, n, keys, keys_info, values, num_found, &shard);
+        return _get_in_varlen_shard(shard_idx, n, keys, *probe_keys_info, values, num_found, &shard);
     }
 }
 
@@ -1233,16 +1300,27 @@ Status ImmutableIndex::_check_not_exist_in_shard(size_t shard_idx, size_t n, con
     if (shard_info.size == 0 || keys_info.size() == 0) {
         return Status::OK();
     }
+    KeysInfo filtered;
+    const KeysInfo* probe_keys_info = &keys_info;
+    if (_filter_by_bloom_filter(shard_idx, keys_info, &filtered)) {
+        if (filtered.size() == 0) {
+            return Status::OK();
+        }
+        probe_keys_info = &filtered;
+    }
     std::unique_ptr<ImmutableIndexShard> shard = std::make_unique<ImmutableIndexShard>(shard_info.npage);
     CHECK(shard->pages.size() * kPageSize == shard_info.bytes) << "illegal shard size";
     RETURN_IF_ERROR(_file->read_at_fully(shard_info.offset, shard->pages.data(), shard_info.bytes));
     if (shard_info.key_size != 0) {
-        return _check_not_exist_in_fixlen_shard(shard_idx, n, keys, keys_info, &shard);
+        return _check_not_exist_in_fixlen_shard(shard_idx, n, keys, *probe_keys_info, &shard);
     } else {
-        return _check_not_exist_in_varlen_shard(shard_idx, n, keys, keys_info, &shard);
+        return _check_not_exist_in_varlen_shard(shard_idx, n, keys, *probe_keys_info, &shard);
     }
 }
 
+// probing the shards of L1 in parallel only pays off if there are enough keys to read most of the shards
+static constexpr size_t kMinKeysToProbeShardsInParallel = 4096;
+
 static void split_keys_info_by_shard(const KeysInfo& keys_info, std::vector<KeysInfo>& keys_info_by_shards) {
     uint32_t shard_bits = log2(keys_info_by_shards.size());
     for (size_t i = 0; i < keys_info.key_idxes.size(); i++) {
@@ -1266,8 +1344,19 @@ Status ImmutableIndex::get(size_t n, const Slice* keys, const KeysInfo& keys_inf
     if (nshard > 1) {
         std::vector<KeysInfo> keys_info_by_shard(nshard);
         split_keys_info_by_shard(keys_info, keys_info_by_shard);
-        for (size_t i = 0; i < nshard; i++) {
-            RETURN_IF_ERROR(_get_in_shard(shard_off + i, n, keys, keys_info_by_shard[i], values, &found));
+        auto* engine = StorageEngine::instance();
+        if (keys_info.size() >= kMinKeysToProbeShardsInParallel && engine != nullptr &&
+            engine->update_manager() != nullptr) {
+            // shards are read and probed concurrently, the keys of different shards set disjoint `values`
+            std::vector<size_t> found_by_shard(nshard, 0);
+            RETURN_IF_ERROR(engine->update_manager()->parallel_apply(nshard, [&](size_t i) {
+                return _get_in_shard(shard_off + i, n, keys, keys_info_by_shard[i], values, &found_by_shard[i]);
+            }));
+            found = std::accumulate(found_by_shard.begin(), found_by_shard.end(), size_t(0));
+        } else {
+            for (size_t i = 0; i < nshard; i++) {
+                RETURN_IF_ERROR(_get_in_shard(shard_off + i, n, keys, keys_info_by_shard[i], values, &found));
+            }
         }
     } else {
         RETURN_IF_ERROR(_get_in_shard(shard_off, n, keys, keys_info, values, &found));
@@ -1351,6 +1440,21 @@ StatusOr<std::unique_ptr<ImmutableIndex>> ImmutableIndex::load(std::unique_ptr<R
         dest.value_size = src.value_size();
         dest.nbucket = src.nbucket();
     }
+    idx->_bloom_filters.resize(nshard);
+    std::string bf_buff;
+    for (size_t i = 0; i < nshard; i++) {
+        const auto& src = meta.shards(i);
+        if (!src.has_bloom_filter() || src.bloom_filter().size() == 0) {
+            continue;
+        }
+        raw::stl_string_resize_uninitialized(&bf_buff, src.bloom_filter().size());
+        RETURN_IF_ERROR(file->read_at_fully(src.bloom_filter().offset(), bf_buff.data(), bf_buff.size()));
+        std::unique_ptr<BloomFilter> bf;
+        RETURN_IF_ERROR(BloomFilter::create(BLOCK_BLOOM_FILTER, &bf));
+        RETURN_IF_ERROR(bf->init(bf_buff.data(), bf_buff.size(), HASH_MURMUR3_X64_64));
+        idx->_bloom_filter_bytes += bf->size();
+        idx->_bloom_filters[i] = std::move(bf);
+    }
     size_t nlength = meta.shard_info_size();
     for (size_t i = 0; i < nlength; i++) {
         const auto& src = meta.shard_info(i);
@@ -52,6 +52,7 @@ static constexpr size_t kIndexValueSize = 8;
 static_assert(sizeof(IndexValue) == kIndexValueSize);
 
 class ImmutableIndexShard;
+class BloomFilter;
 
 uint64_t key_index_hash(const void* data, size_t len);
 
@@ -179,6 +180,8 @@ public:
 
 class ImmutableIndex {
 public:
+    ~ImmutableIndex();
+
     // batch get
     // |n|: size of key/value array
     // |keys|: key array as slice array
@@ -201,11 +204,10 @@ public:
         }
     }
 
-    void clear() {
-        if (_file != nullptr) {
-            _file.reset();
-        }
-    }
+    void clear();
+
+    // memory usage of the bloom filters of shards
+    size_t memory_usage() const { return _bloom_filter_bytes; }
 
     static StatusOr<std::unique_ptr<ImmutableIndex>> load(std::unique_ptr<RandomAccessFile>&& rb);
 
@@ -243,6 +245,10 @@ private:
 
     Status _check_not_exist_in_shard(size_t shard_idx, size_t n, const Slice* keys, const KeysInfo& keys_info) const;
 
+    // filter out the keys in `keys_info` which must not exist in shard `shard_idx` by the bloom filter of the
+    // shard, return false if the shard has no bloom filter, in which case `filtered` is left untouched
+    bool _filter_by_bloom_filter(size_t shard_idx, const KeysInfo& keys_info, KeysInfo* filtered) const;
+
     std::unique_ptr<RandomAccessFile> _file;
     EditVersion _version;
     size_t _size = 0;
@@ -261,6 +267,10 @@ private:
 
     std::vector<ShardInfo> _shards;
     std::map<size_t, std::pair<size_t, size_t>> _shard_info_by_length;
+    // bloom filters of the hashes of the keys in each shard, loaded into memory when the index is loaded,
+    // nullptr if the shard has no bloom filter, e.g. it's written by an old version
+    std::vector<std::unique_ptr<BloomFilter>> _bloom_filters;
+    size_t _bloom_filter_bytes = 0;
 };
 
 // A persistent primary index contains an in-memory L0 and an on-SSD/NVMe L1,
@@ -293,7 +303,9 @@ public:
 
     size_t size() const { return _size; }
     size_t capacity() const { return _l0 ? _l0->capacity() : 0; }
-    size_t memory_usage() const { return _l0 ? _l0->memory_usage() : 0; }
+    size_t memory_usage() const {
+        return (_l0 ? _l0->memory_usage() : 0) + (_l1 ? _l1->memory_usage() : 0);
+    }
 
     EditVersion version() const { return _version; }
 
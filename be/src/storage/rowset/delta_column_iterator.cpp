@@ -0,0 +1,179 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#include "storage/rowset/delta_column_iterator.h"
+
+#include <algorithm>
+#include <tuple>
+
+#include "column/column.h"
+#include "column/fixed_length_column.h"
+#include "gutil/casts.h"
+#include "gutil/strings/substitute.h"
+#include "storage/chunk_helper.h"
+#include "storage/range.h"
+#include "storage/tablet_schema.h"
+#include "util/path_util.h"
+
+namespace starrocks {
+
+DeltaColumnIterator::DeltaColumnIterator(std::unique_ptr<ColumnIterator> base, ordinal_t num_rows,
+                                         std::vector<rowid_t> rowids, vectorized::ColumnPtr values)
+        : _base(std::move(base)), _num_rows(num_rows), _rowids(std::move(rowids)), _values(std::move(values)) {
+    DCHECK_EQ(_rowids.size(), _values->size());
+}
+
+DeltaColumnIterator::~DeltaColumnIterator() = default;
+
+Status DeltaColumnIterator::init(const ColumnIteratorOptions& opts) {
+    RETURN_IF_ERROR(ColumnIterator::init(opts));
+    ColumnIteratorOptions base_opts = opts;
+    // the dictionary of the segment does not cover the updated values.
+    base_opts.check_dict_encoding = false;
+    return _base->init(base_opts);
+}
+
+Status DeltaColumnIterator::next_batch(size_t* n, vectorized::Column* dst) {
+    const ordinal_t from = _base->get_current_ordinal();
+    const size_t offset = dst->size();
+    RETURN_IF_ERROR(_base->next_batch(n, dst));
+    return _apply_delta(from, *n, offset, dst);
+}
+
+Status DeltaColumnIterator::next_batch(const vectorized::SparseRange& range, vectorized::Column* dst) {
+    size_t offset = dst->size();
+    RETURN_IF_ERROR(_base->next_batch(range, dst));
+    for (size_t i = 0; i < range.size(); i++) {
+        RETURN_IF_ERROR(_apply_delta(range[i].begin(), range[i].span_size(), offset, dst));
+        offset += range[i].span_size();
+    }
+    return Status::OK();
+}
+
+Status DeltaColumnIterator::get_row_ranges_by_zone_map(
+        const std::vector<const vectorized::ColumnPredicate*>& predicates,
+        const vectorized::ColumnPredicate* del_predicate, vectorized::SparseRange* row_ranges) {
+    DCHECK(row_ranges->empty());
+    row_ranges->add({0, static_cast<rowid_t>(_num_rows)});
+    return Status::OK();
+}
+
+Status DeltaColumnIterator::fetch_values_by_rowid(const rowid_t* rowids, size_t size, vectorized::Column* values) {
+    const size_t offset = values->size();
+    RETURN_IF_ERROR(_base->fetch_values_by_rowid(rowids, size, values));
+    std::vector<uint32_t> src_indexes;
+    std::vector<uint32_t> dst_indexes;
+    auto iter = _rowids.begin();
+    for (size_t i = 0; i < size && iter != _rowids.end(); i++) {
+        iter = std::lower_bound(iter, _rowids.end(), rowids[i]);
+        if (iter != _rowids.end() && *iter == rowids[i]) {
+            src_indexes.push_back(iter - _rowids.begin());
+            dst_indexes.push_back(offset + i);
+        }
+    }
+    if (src_indexes.empty()) {
+        return Status::OK();
+    }
+    auto src = _values->clone_empty();
+    src->append_selective(*_values, src_indexes.data(), 0, src_indexes.size());
+    return values->update_rows(*src, dst_indexes.data());
+}
+
+Status DeltaColumnIterator::_apply_delta(ordinal_t from, size_t num_rows, size_t offset, vectorized::Column* dst) {
+    auto lo = std::lower_bound(_rowids.begin(), _rowids.end(), from);
+    auto hi = std::lower_bound(lo, _rowids.end(), from + num_rows);
+    if (lo == hi) {
+        return Status::OK();
+    }
+    std::vector<uint32_t> indexes;
+    indexes.reserve(hi - lo);
+    for (auto iter = lo; iter != hi; ++iter) {
+        indexes.push_back(offset + (*iter - from));
+    }
+    auto src = _values->clone_empty();
+    src->append(*_values, lo - _rowids.begin(), hi - lo);
+    return dst->update_rows(*src, indexes.data());
+}
+
+DeltaColumnReader::DeltaColumnReader(FileSystem* fs, std::string dir, const TabletSchema* tablet_schema,
+                                     DeltaColumnGroupList dcgs)
+        : _fs(fs),
+          _dir(std::move(dir)),
+          _tablet_schema(tablet_schema),
+          _dcgs(std::move(dcgs)),
+          _columns(_dcgs.size()) {}
+
+bool DeltaColumnReader::is_updated(ColumnId cid) const {
+    if (cid >= _tablet_schema->num_columns()) {
+        return false;
+    }
+    const uint32_t unique_id = _tablet_schema->column(cid).unique_id();
+    for (const auto& dcg : _dcgs) {
+        if (dcg->column_index(unique_id) >= 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+Status DeltaColumnReader::_load(size_t idx) {
+    if (!_columns[idx].empty()) {
+        return Status::OK();
+    }
+    const auto& dcg = _dcgs[idx];
+    vectorized::Columns columns;
+    columns.emplace_back(vectorized::UInt32Column::create());
+    std::vector<vectorized::Column*> values;
+    for (uint32_t unique_id : dcg->column_unique_ids()) {
+        ColumnId cid = 0;
+        while (cid < _tablet_schema->num_columns() && _tablet_schema->column(cid).unique_id() != unique_id) {
+            cid++;
+        }
+        if (cid == _tablet_schema->num_columns()) {
+            return Status::Corruption(
+                    strings::Substitute("column $0 of delta column group $1 not found", unique_id, dcg->to_string()));
+        }
+        auto field = ChunkHelper::convert_field_to_format_v2(cid, _tablet_schema->column(cid));
+        columns.emplace_back(ChunkHelper::column_from_field(field));
+        values.emplace_back(columns.back().get());
+    }
+    const std::string path = path_util::join_path_segments(_dir, dcg->file_name());
+    RETURN_IF_ERROR(DeltaColumnGroup::read_file(_fs, path, columns[0].get(), values, nullptr));
+    _columns[idx] = std::move(columns);
+    return Status::OK();
+}
+
+StatusOr<std::unique_ptr<ColumnIterator>> DeltaColumnReader::new_iterator(ColumnId cid, ordinal_t num_rows,
+                                                                          std::unique_ptr<ColumnIterator> base) {
+    const uint32_t unique_id = _tablet_schema->column(cid).unique_id();
+    // (rowid, index of the delta column group, row in the delta column file)
+    std::vector<std::tuple<rowid_t, uint32_t, uint32_t>> rows;
+    for (uint32_t i = 0; i < _dcgs.size(); i++) {
+        if (_dcgs[i]->column_index(unique_id) < 0) {
+            continue;
+        }
+        RETURN_IF_ERROR(_load(i));
+        const auto& rowids = down_cast<const vectorized::UInt32Column*>(_columns[i][0].get())->get_data();
+        for (uint32_t j = 0; j < rowids.size(); j++) {
+            rows.emplace_back(rowids[j], i, j);
+        }
+    }
+    // the delta column groups are sorted by version, so the latest value of a row is the last one after sorting.
+    std::stable_sort(rows.begin(), rows.end(),
+                     [](const auto& a, const auto& b) { return std::get<0>(a) < std::get<0>(b); });
+    std::vector<rowid_t> rowids;
+    vectorized::ColumnPtr values =
+            ChunkHelper::column_from_field(ChunkHelper::convert_field_to_format_v2(cid, _tablet_schema->column(cid)));
+    rowids.reserve(rows.size());
+    values->reserve(rows.size());
+    for (size_t i = 0; i < rows.size(); i++) {
+        const auto& [rowid, idx, row] = rows[i];
+        if (i + 1 < rows.size() && std::get<0>(rows[i + 1]) == rowid) {
+            continue;
+        }
+        rowids.push_back(rowid);
+        values->append(*_columns[idx][1 + _dcgs[idx]->column_index(unique_id)], row, 1);
+    }
+    return std::make_unique<DeltaColumnIterator>(std::move(base), num_rows, std::move(rowids), std::move(values));
+}
+
+} // namespace starrocks
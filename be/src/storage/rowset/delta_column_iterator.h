@@ -0,0 +1,89 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "common/statusor.h"
+#include "storage/delta_column_group.h"
+#include "storage/rowset/column_iterator.h"
+
+namespace starrocks {
+
+class TabletSchema;
+
+// Reads a column of a segment with the values updated by column-mode partial updates applied,
+// see DeltaColumnGroup.
+// The values of the rows in |rowids| are read from |values| instead of the segment. Since the zone map,
+// bloom filter and dictionary of the segment do not cover the updated values, none of them is used.
+class DeltaColumnIterator final : public ColumnIterator {
+public:
+    // |rowids| must be sorted in ascending order without duplicates, |values| has a value for each of them.
+    DeltaColumnIterator(std::unique_ptr<ColumnIterator> base, ordinal_t num_rows, std::vector<rowid_t> rowids,
+                        vectorized::ColumnPtr values);
+
+    ~DeltaColumnIterator() override;
+
+    Status init(const ColumnIteratorOptions& opts) override;
+
+    Status seek_to_first() override { return _base->seek_to_first(); }
+
+    Status seek_to_ordinal(ordinal_t ord) override { return _base->seek_to_ordinal(ord); }
+
+    Status next_batch(size_t* n, ColumnBlockView* dst, bool* has_null) override {
+        return Status::NotSupported("DeltaColumnIterator does not support");
+    }
+
+    Status next_batch(size_t* n, vectorized::Column* dst) override;
+
+    Status next_batch(const vectorized::SparseRange& range, vectorized::Column* dst) override;
+
+    ordinal_t get_current_ordinal() const override { return _base->get_current_ordinal(); }
+
+    Status get_row_ranges_by_zone_map(const std::vector<const vectorized::ColumnPredicate*>& predicates,
+                                      const vectorized::ColumnPredicate* del_predicate,
+                                      vectorized::SparseRange* row_ranges) override;
+
+    bool all_page_dict_encoded() const override { return false; }
+
+    Status fetch_values_by_rowid(const rowid_t* rowids, size_t size, vectorized::Column* values) override;
+
+private:
+    // Replace the values of the rows [from, from + |num_rows|) of the segment, which are in |dst| from
+    // the row |offset|.
+    Status _apply_delta(ordinal_t from, size_t num_rows, size_t offset, vectorized::Column* dst);
+
+    std::unique_ptr<ColumnIterator> _base;
+    ordinal_t _num_rows;
+    std::vector<rowid_t> _rowids;
+    vectorized::ColumnPtr _values;
+};
+
+// Reads the delta column files of a segment, each file is read at most once.
+class DeltaColumnReader {
+public:
+    // |dir| is the directory of the segment file, |dcgs| the delta column groups of the segment.
+    DeltaColumnReader(FileSystem* fs, std::string dir, const TabletSchema* tablet_schema, DeltaColumnGroupList dcgs);
+
+    // whether column |cid| is updated by any of the delta column groups.
+    bool is_updated(ColumnId cid) const;
+
+    // Wrap |base|, the column iterator of column |cid| of a segment of |num_rows| rows, with the updated
+    // values of the column.
+    StatusOr<std::unique_ptr<ColumnIterator>> new_iterator(ColumnId cid, ordinal_t num_rows,
+                                                           std::unique_ptr<ColumnIterator> base);
+
+private:
+    Status _load(size_t idx);
+
+    FileSystem* _fs;
+    std::string _dir;
+    const TabletSchema* _tablet_schema;
+    DeltaColumnGroupList _dcgs;
+    // the rowids and the updated columns read from the file of each of |_dcgs|, empty if not read yet.
+    std::vector<vectorized::Columns> _columns;
+};
+
+} // namespace starrocks
@@ -2,13 +2,60 @@
 
 #include "storage/rowset/rowid_range_option.h"
 
+#include <algorithm>
+
 #include "storage/rowset/rowset.h"
 #include "storage/rowset/segment.h"
 
 namespace starrocks::vectorized {
 
-RowidRangeOption::RowidRangeOption(const RowsetId& rowset_id, uint64_t segment_id, const SparseRange& rowid_range)
-        : rowset_id(rowset_id), segment_id(segment_id), rowid_range(rowid_range) {}
+rowid_t SplittableRowidRange::claim(rowid_t end) {
+    std::lock_guard<std::mutex> l(_mutex);
+    end = std::min(end, _end);
+    _next_rowid = std::max(_next_rowid, end);
+    return end;
+}
+
+rowid_t SplittableRowidRange::_split_point(size_t min_rows, size_t align) const {
+    if (_next_rowid >= _end) {
+        return 0;
+    }
+    align = std::max<size_t>(align, 1);
+    rowid_t mid = _next_rowid + (_end - _next_rowid) / 2;
+    mid = mid / align * align;
+    if (mid <= _next_rowid || mid - _next_rowid < min_rows || _end - mid < min_rows) {
+        return 0;
+    }
+    return mid;
+}
+
+Range SplittableRowidRange::split(size_t min_rows, size_t align) {
+    std::lock_guard<std::mutex> l(_mutex);
+    rowid_t mid = _split_point(min_rows, align);
+    if (mid == 0) {
+        return {};
+    }
+    Range taken(mid, _end);
+    _end = mid;
+    return taken;
+}
+
+bool SplittableRowidRange::can_split(size_t min_rows, size_t align) const {
+    std::lock_guard<std::mutex> l(_mutex);
+    return _split_point(min_rows, align) != 0;
+}
+
+size_t SplittableRowidRange::num_unclaimed_rows() const {
+    std::lock_guard<std::mutex> l(_mutex);
+    return _next_rowid >= _end ? 0 : _end - _next_rowid;
+}
+
+RowidRangeOption::RowidRangeOption(const RowsetId& rowset_id, uint64_t segment_id, const SparseRange& rowid_range,
+                                   SplittableRowidRangePtr splittable_range)
+        : rowset_id(rowset_id),
+          segment_id(segment_id),
+          rowid_range(rowid_range),
+          splittable_range(std::move(splittable_range)) {}
 
 bool RowidRangeOption::match_rowset(const Rowset* rowset) const {
     return rowset->rowset_id() == rowset_id;
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <string>
 
 #include "storage/olap_common.h"
@@ -14,10 +16,41 @@ class Segment;
 
 namespace vectorized {
 
+// The rows of a RowidRangeOption not read yet, the second half of which can be taken over by another reader.
+// The reader claims the rows before reading them, so the rows being read are never taken over.
+// This class is thread-safe.
+class SplittableRowidRange {
+public:
+    SplittableRowidRange(rowid_t begin, rowid_t end) : _next_rowid(begin), _end(end) {}
+
+    // Claim the rows before |end| to read. Return the end of the claimed rows, which is less than |end|
+    // if the rows after it have been taken over.
+    rowid_t claim(rowid_t end);
+
+    // Take over the second half of the unclaimed rows, which begins at a multiple of |align|.
+    // Return an empty range if either half would have less than |min_rows| rows.
+    Range split(size_t min_rows, size_t align);
+    // Whether split() with the same arguments would return a non-empty range.
+    bool can_split(size_t min_rows, size_t align) const;
+
+    size_t num_unclaimed_rows() const;
+
+private:
+    // Return 0 if the unclaimed rows cannot be split.
+    // REQUIRES: _mutex is held.
+    rowid_t _split_point(size_t min_rows, size_t align) const;
+
+    mutable std::mutex _mutex;
+    rowid_t _next_rowid;
+    rowid_t _end;
+};
+using SplittableRowidRangePtr = std::shared_ptr<SplittableRowidRange>;
+
 // It represents a specific rowid range on the segment with `segment_id` of the rowset with `rowset_id`.
 struct RowidRangeOption {
 public:
-    RowidRangeOption(const RowsetId& rowset_id, uint64_t segment_id, const SparseRange& rowid_range);
+    RowidRangeOption(const RowsetId& rowset_id, uint64_t segment_id, const SparseRange& rowid_range,
+                     SplittableRowidRangePtr splittable_range = nullptr);
 
     bool match_rowset(const Rowset* rowset) const;
     bool match_segment(const Segment* segment) const;
@@ -26,6 +59,8 @@ public:
     const RowsetId rowset_id;
     const uint64_t segment_id;
     const SparseRange rowid_range;
+    // If it's not null, the rows of rowid_range after splittable_range->claim() are read by another reader.
+    const SplittableRowidRangePtr splittable_range;
 };
 
 } // namespace vectorized
@@ -346,6 +346,7 @@ Status Rowset::get_segment_iterators(const vectorized::Schema& schema, const Row
     seg_options.ranges = options.ranges;
     seg_options.predicates = options.predicates;
     seg_options.predicates_for_zone_map = options.predicates_for_zone_map;
+    seg_options.runtime_range_pruner = options.runtime_range_pruner;
     seg_options.use_page_cache = options.use_page_cache;
     seg_options.profile = options.profile;
     seg_options.reader_type = options.reader_type;
@@ -423,12 +424,14 @@ Status Rowset::get_segment_iterators(const vectorized::Schema& schema, const Row
 
 StatusOr<std::vector<vectorized::ChunkIteratorPtr>> Rowset::get_segment_iterators2(const vectorized::Schema& schema,
                                                                                    KVStore* meta, int64_t version,
-                                                                                   OlapReaderStatistics* stats) {
+                                                                                   OlapReaderStatistics* stats,
+                                                                                   int32_t chunk_size) {
     RETURN_IF_ERROR(load());
 
     vectorized::SegmentReadOptions seg_options;
     ASSIGN_OR_RETURN(seg_options.fs, FileSystem::CreateSharedFromString(_rowset_path));
     seg_options.stats = stats;
+    seg_options.chunk_size = chunk_size;
     seg_options.is_primary_keys = meta != nullptr;
     seg_options.tablet_id = rowset_meta()->tablet_id();
     seg_options.rowset_id = rowset_meta()->get_rowset_seg_id();
@@ -455,4 +458,32 @@ StatusOr<std::vector<vectorized::ChunkIteratorPtr>> Rowset::get_segment_iterator
     return seg_iterators;
 }
 
+StatusOr<vectorized::ChunkIteratorPtr> Rowset::get_segment_iterator2(const vectorized::Schema& schema,
+                                                                     uint32_t segment_id, KVStore* meta,
+                                                                     int64_t version, OlapReaderStatistics* stats) {
+    RETURN_IF_ERROR(load());
+    if (segment_id >= num_segments()) {
+        return Status::InvalidArgument(
+                strings::Substitute("segment id $0 >= #segment $1", segment_id, num_segments()));
+    }
+    auto& seg_ptr = segments()[segment_id];
+    if (seg_ptr->num_rows() == 0) {
+        return vectorized::ChunkIteratorPtr();
+    }
+
+    vectorized::SegmentReadOptions seg_options;
+    ASSIGN_OR_RETURN(seg_options.fs, FileSystem::CreateSharedFromString(_rowset_path));
+    seg_options.stats = stats;
+    seg_options.is_primary_keys = meta != nullptr;
+    seg_options.tablet_id = rowset_meta()->tablet_id();
+    seg_options.rowset_id = rowset_meta()->get_rowset_seg_id();
+    seg_options.version = version;
+    seg_options.meta = meta;
+    auto res = seg_ptr->new_iterator(schema, seg_options);
+    if (res.status().is_end_of_file()) {
+        return vectorized::ChunkIteratorPtr();
+    }
+    return res;
+}
+
 } // namespace starrocks
@@ -26,6 +26,7 @@
 #include <mutex>
 #include <vector>
 
+#include "common/constexpr.h"
 #include "common/statusor.h"
 #include "gen_cpp/olap_file.pb.h"
 #include "gutil/macros.h"
@@ -168,12 +169,20 @@ public:
     // |meta| olap meta, used for get delvec, if null do not fetch&use delvec
     // |version| read version, use for get delvec
     // |stats| used for iterator read stats
+    // |chunk_size| max number of rows returned by each get_next of the iterators
     // return iterator list, an iterator for each segment,
     // if the segment is empty, put an empty pointer in list
     // caller is also responsible to call rowset's acquire/release
     StatusOr<std::vector<vectorized::ChunkIteratorPtr>> get_segment_iterators2(const vectorized::Schema& schema,
                                                                                KVStore* meta, int64_t version,
-                                                                               OlapReaderStatistics* stats);
+                                                                               OlapReaderStatistics* stats,
+                                                                               int32_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+    // same as get_segment_iterators2, but only return the iterator of segment |segment_id|, or an empty pointer
+    // if the segment is empty, so that the segments can be read concurrently, each with its own |stats|
+    StatusOr<vectorized::ChunkIteratorPtr> get_segment_iterator2(const vectorized::Schema& schema, uint32_t segment_id,
+                                                                 KVStore* meta, int64_t version,
+                                                                 OlapReaderStatistics* stats);
 
     int64_t mem_usage() const {
         int64_t size = sizeof(Rowset);
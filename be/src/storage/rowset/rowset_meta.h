@@ -182,6 +182,8 @@ public:
 
     void set_empty(bool empty) { _rowset_meta_pb.set_empty(empty); }
 
+    bool applied_to_delta_columns() const { return _rowset_meta_pb.applied_to_delta_columns(); }
+
     PUniqueId load_id() const { return _rowset_meta_pb.load_id(); }
 
     void set_load_id(const PUniqueId& load_id) {
@@ -23,6 +23,7 @@ namespace vectorized {
 
 class ColumnPredicate;
 class DeletePredicates;
+class RuntimeRangePruner;
 struct RowidRangeOption;
 struct ShortKeyRangeOption;
 
@@ -41,6 +42,7 @@ public:
 
     std::unordered_map<ColumnId, PredicateList> predicates;
     std::unordered_map<ColumnId, PredicateList> predicates_for_zone_map;
+    vectorized::RuntimeRangePruner* runtime_range_pruner = nullptr;
 
     // whether rowset should return rows in sorted order.
     bool sorted = true;
@@ -42,8 +42,10 @@
 #include "storage/rowset/default_value_column_iterator.h"
 #include "storage/rowset/page_io.h"
 #include "storage/rowset/segment_writer.h" // k_segment_magic_length
+#include "storage/storage_engine.h"
 #include "storage/tablet_schema.h"
 #include "storage/type_utils.h"
+#include "storage/update_manager.h"
 #include "storage/vectorized_column_predicate.h"
 #include "util/crc32c.h"
 #include "util/slice.h"
@@ -211,20 +213,47 @@ Status Segment::_open(MemTracker* mem_tracker, size_t* footer_length_hint,
 StatusOr<ChunkIteratorPtr> Segment::_new_iterator(const vectorized::Schema& schema,
                                                   const vectorized::SegmentReadOptions& read_options) {
     DCHECK(read_options.stats != nullptr);
+    DeltaColumnGroupList dcgs;
+    if (read_options.is_primary_keys && read_options.version > 0) {
+        TabletSegmentId tsid;
+        tsid.tablet_id = read_options.tablet_id;
+        tsid.segment_id = read_options.rowset_id + id();
+        RETURN_IF_ERROR(StorageEngine::instance()->update_manager()->get_delta_column_groups(
+                read_options.meta, tsid, read_options.version, &dcgs));
+    }
     // trying to prune the current segment by segment-level zone map
     for (const auto& pair : read_options.predicates_for_zone_map) {
         ColumnId column_id = pair.first;
         if (_column_readers[column_id] == nullptr || !_column_readers[column_id]->has_zone_map()) {
             continue;
         }
+        // the zone map does not cover the values in the delta column files.
+        if (!dcgs.empty() && _is_column_updated(dcgs, column_id)) {
+            continue;
+        }
         if (!_column_readers[column_id]->segment_zone_map_filter(pair.second)) {
             read_options.stats->segment_stats_filtered += _column_readers[column_id]->num_rows();
             return Status::EndOfFile(strings::Substitute("End of file $0, empty iterator", _fname));
         }
     }
+    if (!dcgs.empty()) {
+        vectorized::SegmentReadOptions options = read_options;
+        options.delta_column_groups = std::move(dcgs);
+        return vectorized::new_segment_iterator(shared_from_this(), schema, options);
+    }
     return vectorized::new_segment_iterator(shared_from_this(), schema, read_options);
 }
 
+bool Segment::_is_column_updated(const DeltaColumnGroupList& dcgs, ColumnId cid) const {
+    const uint32_t unique_id = _tablet_schema->column(cid).unique_id();
+    for (const auto& dcg : dcgs) {
+        if (dcg->column_index(unique_id) >= 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
 StatusOr<ChunkIteratorPtr> Segment::new_iterator(const vectorized::Schema& schema,
                                                  const vectorized::SegmentReadOptions& read_options) {
     if (read_options.stats == nullptr) {
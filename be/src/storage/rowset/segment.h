@@ -31,6 +31,7 @@
 #include "gen_cpp/olap_file.pb.h"
 #include "gen_cpp/segment.pb.h"
 #include "gutil/macros.h"
+#include "storage/delta_column_group.h"
 #include "storage/rowset/page_handle.h"
 #include "storage/rowset/page_pointer.h"
 #include "storage/short_key_index.h"
@@ -109,6 +110,8 @@ public:
 
     size_t num_short_keys() const { return _tablet_schema->num_short_key_columns(); }
 
+    const TabletSchema& tablet_schema() const { return *_tablet_schema; }
+
     uint32_t num_rows_per_block() const {
         DCHECK(invoked(_load_index_once));
         return _sk_index_decoder->num_rows_per_block();
@@ -195,6 +198,9 @@ private:
     StatusOr<ChunkIteratorPtr> _new_iterator(const vectorized::Schema& schema,
                                              const vectorized::SegmentReadOptions& read_options);
 
+    // whether column |cid| is updated by any of |dcgs|
+    bool _is_column_updated(const DeltaColumnGroupList& dcgs, ColumnId cid) const;
+
     void _prepare_adapter_info();
 
     friend class SegmentIterator;
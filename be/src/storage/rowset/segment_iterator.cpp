@@ -3,6 +3,7 @@
 #include "segment_iterator.h"
 
 #include <algorithm>
+#include <limits>
 #include <memory>
 #include <stack>
 #include <unordered_map>
@@ -30,11 +31,13 @@
 #include "storage/projection_iterator.h"
 #include "storage/range.h"
 #include "storage/roaring2range.h"
+#include "storage/runtime_range_pruner.h"
 #include "storage/rowset/bitmap_index_reader.h"
 #include "storage/rowset/column_decoder.h"
 #include "storage/rowset/column_reader.h"
 #include "storage/rowset/common.h"
 #include "storage/rowset/default_value_column_iterator.h"
+#include "storage/rowset/delta_column_iterator.h"
 #include "storage/rowset/dictcode_column_iterator.h"
 #include "storage/rowset/rowid_column_iterator.h"
 #include "storage/rowset/rowid_range_option.h"
@@ -44,6 +47,7 @@
 #include "storage/types.h"
 #include "storage/update_manager.h"
 #include "storage/vectorized_column_predicate.h"
+#include "util/path_util.h"
 #include "util/starrocks_metrics.h"
 
 namespace starrocks::vectorized {
@@ -193,6 +197,7 @@ private:
     Status _get_row_ranges_by_keys();
     Status _get_row_ranges_by_key_ranges();
     Status _get_row_ranges_by_short_key_ranges();
+    Status _apply_runtime_range_pruner();
     Status _get_row_ranges_by_zone_map();
     Status _get_row_ranges_by_bloom_filter();
     Status _get_row_ranges_by_rowid_range();
@@ -241,6 +246,13 @@ private:
 
     Status _init_bitmap_index_iterators();
 
+    // whether column |cid| is updated by any delta column group of the segment.
+    bool _is_delta_column(ColumnId cid) const;
+
+    // Wrap |*iter| with the values of column |cid| updated by the delta column groups, |*iter| is
+    // destroyed and set to null on failure.
+    Status _wrap_delta_column_iterator(ColumnId cid, ColumnIterator** iter);
+
     Status _apply_bitmap_index();
 
     Status _apply_del_vector();
@@ -249,6 +261,8 @@ private:
 
     Status _read_by_column(size_t n, Chunk* result, vector<rowid_t>* rowids);
 
+    void _update_block_cache_stats();
+
 private:
     using RawColumnIterators = std::vector<ColumnIterator*>;
     using ColumnDecoders = std::vector<ColumnDecoder>;
@@ -261,6 +275,9 @@ private:
     DelVectorPtr _del_vec;
     roaring_uint32_iterator_t _roaring_iter;
 
+    // not null iff the segment has delta column groups at |_opts.version|.
+    std::unique_ptr<DeltaColumnReader> _delta_column_reader;
+
     std::unique_ptr<RandomAccessFile> _rfile;
 
     SparseRange _scan_range;
@@ -306,10 +323,17 @@ SegmentIterator::SegmentIterator(std::shared_ptr<Segment> segment, vectorized::S
           _segment(std::move(segment)),
           _opts(std::move(options)),
           _predicate_columns(_opts.predicates.size()),
-          _context_switch_next_time(false) {}
+          _context_switch_next_time(false) {
+    if (!_opts.delta_column_groups.empty()) {
+        _delta_column_reader = std::make_unique<DeltaColumnReader>(
+                _opts.fs.get(), path_util::dir_name(_segment->file_name()), &_segment->tablet_schema(),
+                _opts.delta_column_groups);
+    }
+}
 
 Status SegmentIterator::_init() {
     SCOPED_RAW_TIMER(&_opts.stats->segment_init_ns);
+    RETURN_IF_ERROR(_apply_runtime_range_pruner());
     if (_opts.is_primary_keys && _opts.version > 0) {
         TabletSegmentId tsid;
         tsid.tablet_id = _opts.tablet_id;
@@ -398,6 +422,9 @@ Status SegmentIterator::_init_column_iterators(const Schema& schema) {
             }
 
             RETURN_IF_ERROR(_segment->new_column_iterator(cid, &_column_iterators[cid]));
+            if (_is_delta_column(cid)) {
+                RETURN_IF_ERROR(_wrap_delta_column_iterator(cid, &_column_iterators[cid]));
+            }
 
             _obj_pool.add(_column_iterators[cid]);
             ColumnIteratorOptions iter_opts;
@@ -564,9 +591,16 @@ Status SegmentIterator::_get_row_ranges_by_zone_map() {
     for (const auto& pair : _opts.predicates) {
         columns.insert(pair.first);
     }
+    // The predicates of late arrived runtime filters are only used to prune pages.
+    for (const auto& pair : _opts.predicates_for_zone_map) {
+        columns.insert(pair.first);
+    }
 
     std::vector<const ColumnPredicate*> query_preds;
     for (ColumnId cid : columns) {
+        if (cid >= _column_iterators.size() || _column_iterators[cid] == nullptr) {
+            continue;
+        }
         auto iter1 = _opts.predicates_for_zone_map.find(cid);
         if (iter1 != _opts.predicates_for_zone_map.end()) {
             query_preds = iter1->second;
@@ -588,6 +622,33 @@ Status SegmentIterator::_get_row_ranges_by_zone_map() {
     return Status::OK();
 }
 
+// Prune the whole segment by the segment-level zone maps and the predicates of the runtime filters
+// arrived after this iterator was created, and keep the predicates to prune pages by zone maps.
+Status SegmentIterator::_apply_runtime_range_pruner() {
+    if (_opts.runtime_range_pruner == nullptr) {
+        return Status::OK();
+    }
+    auto res = _opts.runtime_range_pruner->arrived_predicates();
+    if (res.status().is_end_of_file()) {
+        _opts.stats->segment_runtime_stats_filtered += num_rows();
+        return res.status();
+    }
+    RETURN_IF_ERROR(res.status());
+    for (const auto& [cid, preds] : *res.value()) {
+        const ColumnReader* reader = cid < _segment->num_columns() ? _segment->column(cid) : nullptr;
+        if (reader == nullptr) {
+            continue;
+        }
+        if (reader->has_zone_map() && !_is_delta_column(cid) && !reader->segment_zone_map_filter(preds)) {
+            _opts.stats->segment_runtime_stats_filtered += num_rows();
+            return Status::EndOfFile("segment pruned by runtime filters");
+        }
+        auto& zone_map_preds = _opts.predicates_for_zone_map[cid];
+        zone_map_preds.insert(zone_map_preds.end(), preds.begin(), preds.end());
+    }
+    return Status::OK();
+}
+
 // if |lower| is true, return the first row in the range [0, end) that is not less than |key|,
 // or end if no such row is found.
 // if |lower| is false, return the first row in the range [0, end) that is greater than |key|,
@@ -742,6 +803,20 @@ inline Status SegmentIterator::_read(Chunk* chunk, vector<rowid_t>* rowids, size
     }
 
     _range_iter.next_range(n, &range);
+    if (_opts.rowid_range_option != nullptr && _opts.rowid_range_option->splittable_range != nullptr) {
+        // Claim all the rest rows on the last read, none of them would be read by this reader.
+        rowid_t end = _opts.rowid_range_option->splittable_range->claim(
+                _range_iter.has_more() ? range.end() : std::numeric_limits<rowid_t>::max());
+        if (end < range.end()) {
+            // The rest rows have been taken over by another reader.
+            range = range.intersection(SparseRange(0, end));
+            _scan_range.clear();
+            _range_iter = _scan_range.new_iterator();
+            if (range.empty()) {
+                return Status::OK();
+            }
+        }
+    }
     read_num += range.span_size();
 
     {
@@ -1437,12 +1512,25 @@ Status SegmentIterator::_encode_to_global_id(ScanContext* ctx) {
     return Status::OK();
 }
 
+bool SegmentIterator::_is_delta_column(ColumnId cid) const {
+    return _delta_column_reader != nullptr && _delta_column_reader->is_updated(cid);
+}
+
+Status SegmentIterator::_wrap_delta_column_iterator(ColumnId cid, ColumnIterator** iter) {
+    std::unique_ptr<ColumnIterator> base(*iter);
+    *iter = nullptr;
+    ASSIGN_OR_RETURN(auto delta_iter, _delta_column_reader->new_iterator(cid, num_rows(), std::move(base)));
+    *iter = delta_iter.release();
+    return Status::OK();
+}
+
 Status SegmentIterator::_init_bitmap_index_iterators() {
     DCHECK_EQ(_predicate_columns, _opts.predicates.size());
     _bitmap_index_iterators.resize(ChunkHelper::max_column_id(_schema) + 1, nullptr);
     for (const auto& pair : _opts.predicates) {
         ColumnId cid = pair.first;
-        if (_bitmap_index_iterators[cid] == nullptr) {
+        // the bitmap index does not cover the values in the delta column files.
+        if (_bitmap_index_iterators[cid] == nullptr && !_is_delta_column(cid)) {
             RETURN_IF_ERROR(_segment->new_bitmap_index_iterator(cid, &_bitmap_index_iterators[cid]));
             _has_bitmap_index |= (_bitmap_index_iterators[cid] != nullptr);
         }
@@ -1577,10 +1665,29 @@ Status SegmentIterator::_get_row_ranges_by_rowid_range() {
     return Status::OK();
 }
 
+// Files of lake segments are read through the block cache, see fs/block_cache.h.
+void SegmentIterator::_update_block_cache_stats() {
+    auto stats_or = _rfile->get_numeric_statistics();
+    if (!stats_or.ok() || stats_or.value() == nullptr) {
+        return;
+    }
+    const auto& stats = stats_or.value();
+    for (int64_t i = 0; i < stats->size(); i++) {
+        if (stats->name(i) == "BlockCacheHitBytes") {
+            _opts.stats->block_cache_hit_bytes += stats->value(i);
+        } else if (stats->name(i) == "BlockCacheMissBytes") {
+            _opts.stats->block_cache_miss_bytes += stats->value(i);
+        }
+    }
+}
+
 void SegmentIterator::close() {
     _context_list[0].close();
     _context_list[1].close();
     _obj_pool.clear();
+    if (_rfile != nullptr) {
+        _update_block_cache_stats();
+    }
     _rfile.reset();
     _segment.reset();
     _column_decoders.clear();
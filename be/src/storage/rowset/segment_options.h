@@ -8,6 +8,7 @@
 #include "column/datum.h"
 #include "fs/fs.h"
 #include "runtime/global_dict/types.h"
+#include "storage/delta_column_group.h"
 #include "storage/disjunctive_predicates.h"
 #include "storage/seek_range.h"
 
@@ -22,6 +23,7 @@ class KVStore;
 namespace starrocks::vectorized {
 
 class ColumnPredicate;
+class RuntimeRangePruner;
 struct RowidRangeOption;
 using RowidRangeOptionPtr = std::shared_ptr<RowidRangeOption>;
 struct ShortKeyRangeOption;
@@ -37,6 +39,9 @@ public:
 
     std::unordered_map<ColumnId, PredicateList> predicates;
     std::unordered_map<ColumnId, PredicateList> predicates_for_zone_map;
+    // The predicates of late arrived runtime filters, which are applied when the iterator is initialized.
+    // Not converted by |convert_to|, since they are of the types of tablet schema.
+    RuntimeRangePruner* runtime_range_pruner = nullptr;
 
     DisjunctivePredicates delete_predicates;
 
@@ -46,6 +51,8 @@ public:
     uint32_t rowset_id = 0;
     int64_t version = 0;
     KVStore* meta = nullptr;
+    // The delta column files of column-mode partial updates of the segment at |version|, filled by the segment.
+    DeltaColumnGroupList delta_column_groups;
 
     // REQUIRED (null is not allowed)
     OlapReaderStatistics* stats = nullptr;
@@ -3,6 +3,7 @@
 #include "storage/rowset_merger.h"
 
 #include <memory>
+#include <numeric>
 #include <queue>
 
 #include "gutil/stl_util.h"
@@ -10,6 +11,7 @@
 #include "storage/empty_iterator.h"
 #include "storage/merge_iterator.h"
 #include "storage/primary_key_encoder.h"
+#include "storage/rowset/column_reader.h"
 #include "storage/rowset/rowset_options.h"
 #include "storage/rowset/rowset_writer.h"
 #include "storage/tablet.h"
@@ -233,8 +235,6 @@ public:
 
     Status do_merge(Tablet& tablet, int64_t version, const Schema& schema, const vector<RowsetSharedPtr>& rowsets,
                     RowsetWriter* writer, const MergeConfig& cfg) override {
-        _chunk_size = cfg.chunk_size;
-
         size_t total_input_size = 0;
         size_t total_rows = 0;
         size_t total_chunk = 0;
@@ -249,6 +249,9 @@ public:
             RETURN_IF_ERROR(_do_merge_vertically(tablet, version, rowsets, writer, cfg, column_groups,
                                                  &total_input_size, &total_rows, &total_chunk, &stats));
         } else {
+            vector<uint32_t> all_columns(tablet.num_columns());
+            std::iota(all_columns.begin(), all_columns.end(), 0);
+            RETURN_IF_ERROR(_init_chunk_size(rowsets, all_columns, cfg));
             RETURN_IF_ERROR(_do_merge_horizontally(tablet, version, schema, rowsets, writer, cfg, &total_input_size,
                                                    &total_rows, &total_chunk, &stats));
         }
@@ -271,6 +274,31 @@ public:
     }
 
 private:
+    // Set |_chunk_size| so that the chunks of all the rowsets holding the columns of |column_group| fit in
+    // config::compaction_memory_limit_per_worker, as each rowset keeps one chunk in memory during the merge.
+    // The merge of each column group is thus bounded by the memory limit, whatever the width of the tablet.
+    Status _init_chunk_size(const vector<RowsetSharedPtr>& rowsets, const vector<uint32_t>& column_group,
+                            const MergeConfig& cfg) {
+        int64_t total_num_rows = 0;
+        int64_t total_mem_footprint = 0;
+        for (const auto& rowset : rowsets) {
+            RETURN_IF_ERROR(rowset->load());
+            total_num_rows += rowset->num_rows();
+            for (const auto& segment : rowset->segments()) {
+                for (uint32_t column_index : column_group) {
+                    const auto* column_reader = segment->column(column_index);
+                    if (column_reader != nullptr) {
+                        total_mem_footprint += column_reader->total_mem_footprint();
+                    }
+                }
+            }
+        }
+        _chunk_size = CompactionUtils::get_read_chunk_size(config::compaction_memory_limit_per_worker, cfg.chunk_size,
+                                                           total_num_rows, total_mem_footprint,
+                                                           std::max<size_t>(1, rowsets.size()));
+        return Status::OK();
+    }
+
     Status _do_merge_horizontally(Tablet& tablet, int64_t version, const Schema& schema,
                                   const vector<RowsetSharedPtr>& rowsets, RowsetWriter* writer, const MergeConfig& cfg,
                                   size_t* total_input_size, size_t* total_rows, size_t* total_chunk,
@@ -288,7 +316,8 @@ private:
             _entries.emplace_back(new MergeEntry<T>());
             MergeEntry<T>& entry = *_entries.back();
             entry.rowset_release_guard = std::make_unique<RowsetReleaseGuard>(rowset);
-            auto res = rowset->get_segment_iterators2(schema, tablet.data_dir()->get_meta(), version, stats);
+            auto res = rowset->get_segment_iterators2(schema, tablet.data_dir()->get_meta(), version, stats,
+                                                      _chunk_size);
             if (!res.ok()) {
                 return res.status();
             }
@@ -396,6 +425,7 @@ private:
         // merge key columns
         auto mask_buffer = std::make_unique<RowSourceMaskBuffer>(tablet.tablet_id(), tablet.data_dir()->path());
         {
+            RETURN_IF_ERROR(_init_chunk_size(rowsets, column_groups[0], cfg));
             Schema schema = ChunkHelper::convert_schema_to_format_v2(tablet.tablet_schema(), column_groups[0]);
             RETURN_IF_ERROR(_do_merge_horizontally(tablet, version, schema, rowsets, writer, cfg, total_input_size,
                                                    total_rows, total_chunk, stats, mask_buffer.get()));
@@ -406,6 +436,7 @@ private:
         for (size_t i = 1; i < column_groups.size(); ++i) {
             // read mask buffer from the beginning
             mask_buffer->flip_to_read();
+            RETURN_IF_ERROR(_init_chunk_size(rowsets, column_groups[i], cfg));
 
             _entries.clear();
             _entries.reserve(rowsets.size());
@@ -417,8 +448,8 @@ private:
                 _entries.emplace_back(new MergeEntry<T>());
                 MergeEntry<T>& entry = *_entries.back();
                 entry.rowset_release_guard = std::make_unique<RowsetReleaseGuard>(rowset);
-                auto res =
-                        rowset->get_segment_iterators2(schema, tablet.data_dir()->get_meta(), version, &non_key_stats);
+                auto res = rowset->get_segment_iterators2(schema, tablet.data_dir()->get_meta(), version,
+                                                          &non_key_stats, _chunk_size);
                 if (!res.ok()) {
                     return res.status();
                 }
@@ -2,6 +2,7 @@
 
 #include "rowset_update_state.h"
 
+#include "column/fixed_length_column.h"
 #include "common/tracer.h"
 #include "gutil/strings/substitute.h"
 #include "serde/column_array_serde.h"
@@ -10,9 +11,12 @@
 #include "storage/rowset/rowset.h"
 #include "storage/rowset/rowset_options.h"
 #include "storage/rowset/segment_rewriter.h"
+#include "storage/storage_engine.h"
 #include "storage/tablet.h"
 #include "storage/tablet_meta_manager.h"
+#include "storage/update_manager.h"
 #include "util/defer_op.h"
+#include "util/path_util.h"
 #include "util/phmap/phmap.h"
 #include "util/stack_util.h"
 #include "util/time.h"
@@ -76,41 +80,12 @@ Status RowsetUpdateState::_do_load(Tablet* tablet, Rowset* rowset) {
     }
 
     RowsetReleaseGuard guard(rowset->shared_from_this());
-    OlapReaderStatistics stats;
-    auto res = rowset->get_segment_iterators2(pkey_schema, nullptr, 0, &stats);
-    if (!res.ok()) {
-        return res.status();
-    }
-    // TODO(cbl): auto close iterators on failure
-    auto& itrs = res.value();
-    CHECK(itrs.size() == rowset->num_segments()) << "itrs.size != num_segments";
     _upserts.resize(rowset->num_segments());
-    // only hold pkey, so can use larger chunk size
-    auto chunk_shared_ptr = ChunkHelper::new_chunk(pkey_schema, 4096);
-    auto chunk = chunk_shared_ptr.get();
-    for (size_t i = 0; i < itrs.size(); i++) {
-        auto& dest = _upserts[i];
-        auto col = pk_column->clone();
-        auto itr = itrs[i].get();
-        if (itr != nullptr) {
-            auto num_rows = rowset->segments()[i]->num_rows();
-            col->reserve(num_rows);
-            while (true) {
-                chunk->reset();
-                auto st = itr->get_next(chunk);
-                if (st.is_end_of_file()) {
-                    break;
-                } else if (!st.ok()) {
-                    return st;
-                } else {
-                    PrimaryKeyEncoder::encode(pkey_schema, *chunk, 0, chunk->num_rows(), col.get());
-                }
-            }
-            itr->close();
-            CHECK(col->size() == num_rows) << "read segment: iter rows != num rows";
-        }
-        dest = std::move(col);
-    }
+    // segments are read concurrently, each task only writes its own slot of _upserts
+    auto manager = StorageEngine::instance()->update_manager();
+    RETURN_IF_ERROR(manager->parallel_apply(rowset->num_segments(), [&](size_t i) {
+        return _load_upserts(rowset, pkey_schema, *pk_column, i);
+    }));
     for (const auto& upsert : _upserts) {
         _memory_usage += upsert != nullptr ? upsert->memory_usage() : 0;
     }
@@ -123,6 +98,36 @@ Status RowsetUpdateState::_do_load(Tablet* tablet, Rowset* rowset) {
     return _prepare_partial_update_states(tablet, rowset);
 }
 
+Status RowsetUpdateState::_load_upserts(Rowset* rowset, const vectorized::Schema& pkey_schema,
+                                        const vectorized::Column& pk_column, uint32_t idx) {
+    OlapReaderStatistics stats;
+    ASSIGN_OR_RETURN(auto itr, rowset->get_segment_iterator2(pkey_schema, idx, nullptr, 0, &stats));
+    auto col = pk_column.clone();
+    if (itr != nullptr) {
+        auto num_rows = rowset->segments()[idx]->num_rows();
+        col->reserve(num_rows);
+        // only hold pkey, so can use larger chunk size
+        auto chunk_shared_ptr = ChunkHelper::new_chunk(pkey_schema, 4096);
+        auto chunk = chunk_shared_ptr.get();
+        while (true) {
+            chunk->reset();
+            auto st = itr->get_next(chunk);
+            if (st.is_end_of_file()) {
+                break;
+            } else if (!st.ok()) {
+                itr->close();
+                return st;
+            } else {
+                PrimaryKeyEncoder::encode(pkey_schema, *chunk, 0, chunk->num_rows(), col.get());
+            }
+        }
+        itr->close();
+        CHECK(col->size() == num_rows) << "read segment: iter rows != num rows";
+    }
+    _upserts[idx] = std::move(col);
+    return Status::OK();
+}
+
 struct RowidSortEntry {
     uint32_t rowid;
     uint32_t idx;
@@ -213,19 +218,10 @@ Status RowsetUpdateState::_prepare_partial_update_states(Tablet* tablet, Rowset*
         }
     }
 
-    std::vector<std::unique_ptr<vectorized::Column>> read_columns(read_column_ids.size());
     size_t num_segments = rowset->num_segments();
     _partial_update_states.resize(num_segments);
     for (size_t i = 0; i < num_segments; i++) {
-        _partial_update_states[i].write_columns.resize(read_columns.size());
         _partial_update_states[i].src_rss_rowids.resize(_upserts[i]->size());
-        for (uint32_t j = 0; j < read_columns.size(); ++j) {
-            const auto read_column_id = read_column_ids[j];
-            auto tablet_column = tablet_schema.column(read_column_id);
-            auto column = ChunkHelper::column_from_field_type(tablet_column.type(), tablet_column.is_nullable());
-            read_columns[j] = column->clone_empty();
-            _partial_update_states[i].write_columns[j] = column->clone_empty();
-        }
     }
 
     int64_t t_read_index = MonotonicMillis();
@@ -240,33 +236,86 @@ Status RowsetUpdateState::_prepare_partial_update_states(Tablet* tablet, Rowset*
 
     int64_t t_read_values = MonotonicMillis();
     size_t total_rows = 0;
+    for (size_t i = 0; i < num_segments; i++) {
+        total_rows += _partial_update_states[i].src_rss_rowids.size();
+    }
     // rows actually needed to be read, excluding rows with default values
     size_t total_nondefault_rows = 0;
+    _column_mode = _can_apply_in_column_mode(tablet_schema, txn_meta);
+    if (!_column_mode) {
+        RETURN_IF_ERROR(_read_partial_update_values(tablet, read_column_ids, &total_nondefault_rows));
+    }
+    int64_t t_end = MonotonicMillis();
+
+    LOG(INFO) << Substitute(
+            "prepare PartialUpdateState tablet:$0 read_version:$1 #segment:$2 #row:$3(#non-default:$4) #column:$5 "
+            "mode:$6 time:$7ms(index:$8/value:$9)",
+            _tablet_id, _read_version.to_string(), num_segments, total_rows, total_nondefault_rows,
+            read_column_ids.size(), _column_mode ? "column" : "row", t_end - t_start, t_read_values - t_read_index,
+            t_end - t_read_values);
+    return Status::OK();
+}
+
+Status RowsetUpdateState::_read_partial_update_values(Tablet* tablet, const std::vector<uint32_t>& read_column_ids,
+                                                      size_t* num_nondefault_rows) {
+    const auto& tablet_schema = tablet->tablet_schema();
+    std::vector<std::unique_ptr<vectorized::Column>> read_columns(read_column_ids.size());
+    size_t num_segments = _partial_update_states.size();
+    for (size_t i = 0; i < num_segments; i++) {
+        _partial_update_states[i].write_columns.resize(read_columns.size());
+        for (uint32_t j = 0; j < read_columns.size(); ++j) {
+            const auto read_column_id = read_column_ids[j];
+            auto tablet_column = tablet_schema.column(read_column_id);
+            auto column = ChunkHelper::column_from_field_type(tablet_column.type(), tablet_column.is_nullable());
+            read_columns[j] = column->clone_empty();
+            _partial_update_states[i].write_columns[j] = column->clone_empty();
+        }
+    }
+
+    *num_nondefault_rows = 0;
     for (size_t i = 0; i < num_segments; i++) {
         size_t num_default = 0;
         std::map<uint32_t, std::vector<uint32_t>> rowids_by_rssid;
         vector<uint32_t> idxes;
         plan_read_by_rssid(_partial_update_states[i].src_rss_rowids, &num_default, &rowids_by_rssid, &idxes);
-        total_rows += _partial_update_states[i].src_rss_rowids.size();
-        total_nondefault_rows += _partial_update_states[i].src_rss_rowids.size() - num_default;
+        *num_nondefault_rows += _partial_update_states[i].src_rss_rowids.size() - num_default;
         // get column values by rowid, also get default values if needed
         RETURN_IF_ERROR(
                 tablet->updates()->get_column_values(read_column_ids, num_default > 0, rowids_by_rssid, &read_columns));
         for (size_t col_idx = 0; col_idx < read_column_ids.size(); col_idx++) {
             _partial_update_states[i].write_columns[col_idx]->append_selective(*read_columns[col_idx], idxes.data(), 0,
                                                                                idxes.size());
+            read_columns[col_idx]->reset_column();
         }
     }
-    int64_t t_end = MonotonicMillis();
-
-    LOG(INFO) << Substitute(
-            "prepare PartialUpdateState tablet:$0 read_version:$1 #segment:$2 #row:$3(#non-default:$4) #column:$5 "
-            "time:$6ms(index:$7/value:$8)",
-            _tablet_id, _read_version.to_string(), num_segments, total_rows, total_nondefault_rows, read_columns.size(),
-            t_end - t_start, t_read_values - t_read_index, t_end - t_read_values);
     return Status::OK();
 }
 
+bool RowsetUpdateState::_can_apply_in_column_mode(const TabletSchema& tablet_schema,
+                                                  const RowsetTxnMetaPB& txn_meta) const {
+    if (!config::enable_column_mode_partial_update) {
+        return false;
+    }
+    size_t num_value_columns = tablet_schema.num_columns() - tablet_schema.num_key_columns();
+    size_t num_update_value_columns = 0;
+    for (uint32_t cid : txn_meta.partial_update_column_ids()) {
+        num_update_value_columns += cid >= tablet_schema.num_key_columns();
+    }
+    if (num_update_value_columns == 0 ||
+        num_update_value_columns * 100 > num_value_columns * config::column_mode_partial_update_max_column_percent) {
+        return false;
+    }
+    // rows of new keys are inserted as full rows, which is not supported by column mode
+    for (const auto& state : _partial_update_states) {
+        for (uint64_t rss_rowid : state.src_rss_rowids) {
+            if ((uint32_t)(rss_rowid >> 32) == (uint32_t)-1) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 Status RowsetUpdateState::_check_and_resolve_conflict(Tablet* tablet, Rowset* rowset, uint32_t rowset_id,
                                                       EditVersion latest_applied_version,
                                                       std::vector<uint32_t>& read_column_ids,
@@ -294,6 +343,28 @@ Status RowsetUpdateState::_check_and_resolve_conflict(Tablet* tablet, Rowset* ro
     }
     int64_t t_read_index = MonotonicMillis();
 
+    // A column-mode partial update applied after _read_version updates the rows in place, by a delta column group
+    // of a version larger than _read_version, so the values read of the rows in such segments are stale even if
+    // the rows are not moved.
+    auto* update_manager = StorageEngine::instance()->update_manager();
+    std::map<uint32_t, bool> updated_after_read;
+    auto is_updated_after_read = [&](uint32_t rssid) -> StatusOr<bool> {
+        auto iter = updated_after_read.find(rssid);
+        if (iter != updated_after_read.end()) {
+            return iter->second;
+        }
+        TabletSegmentId tsid;
+        tsid.tablet_id = tablet->tablet_id();
+        tsid.segment_id = rssid;
+        DeltaColumnGroupList dcgs;
+        RETURN_IF_ERROR(
+                update_manager->get_delta_column_groups(tablet->data_dir()->get_meta(), tsid, INT64_MAX, &dcgs));
+        // dcgs are sorted by version in ascending order
+        bool updated = !dcgs.empty() && dcgs.back()->version() > _read_version.major();
+        updated_after_read.emplace(rssid, updated);
+        return updated;
+    };
+
     size_t total_conflicts = 0;
     for (uint32_t i = 0; i < num_segments; ++i) {
         uint32_t num_rows = new_rss_rowids[i].size();
@@ -306,7 +377,11 @@ Status RowsetUpdateState::_check_and_resolve_conflict(Tablet* tablet, Rowset* ro
             uint64_t rss_rowid = _partial_update_states[i].src_rss_rowids[j];
             uint32_t rssid = rss_rowid >> 32;
 
-            if (rssid != new_rssid) {
+            bool conflict = rssid != new_rssid;
+            if (!conflict && new_rssid != (uint32_t)-1) {
+                ASSIGN_OR_RETURN(conflict, is_updated_after_read(new_rssid));
+            }
+            if (conflict) {
                 conflict_idxes.emplace_back(j);
                 conflict_rowids.emplace_back(new_rss_rowid);
             }
@@ -346,11 +421,47 @@ Status RowsetUpdateState::_check_and_resolve_conflict(Tablet* tablet, Rowset* ro
 }
 
 Status RowsetUpdateState::apply(Tablet* tablet, Rowset* rowset, uint32_t rowset_id, EditVersion latest_applied_version,
-                                const PrimaryIndex& index) {
+                                const PrimaryIndex& index, int64_t version) {
     const auto& rowset_meta_pb = rowset->rowset_meta()->get_meta_pb();
     if (!rowset_meta_pb.has_txn_meta() || rowset->num_segments() == 0) {
         return Status::OK();
     }
+    if (_column_mode) {
+        // the rows may have been moved by compaction or deleted since read, so look up the index again
+        uint32_t num_segments = _upserts.size();
+        std::vector<std::vector<uint64_t>> rss_rowids(num_segments);
+        bool all_keys_exist = true;
+        for (uint32_t i = 0; i < num_segments; ++i) {
+            rss_rowids[i].resize(_upserts[i]->size());
+            index.get(*_upserts[i], &rss_rowids[i]);
+            for (uint64_t rss_rowid : rss_rowids[i]) {
+                all_keys_exist &= (uint32_t)(rss_rowid >> 32) != (uint32_t)-1;
+            }
+        }
+        if (all_keys_exist) {
+            return _apply_column_mode(tablet, rowset, rowset_id, version, rss_rowids);
+        }
+        // some keys are deleted by the rowsets applied after read, fall back to row mode and read the values
+        // of the latest version
+        _column_mode = false;
+        for (uint32_t i = 0; i < num_segments; ++i) {
+            _partial_update_states[i].src_rss_rowids = std::move(rss_rowids[i]);
+        }
+        const auto& tschema = tablet->tablet_schema();
+        std::set<uint32_t> update_columns_set(rowset_meta_pb.txn_meta().partial_update_column_ids().begin(),
+                                              rowset_meta_pb.txn_meta().partial_update_column_ids().end());
+        std::vector<uint32_t> read_column_ids;
+        for (uint32_t i = 0; i < tschema.num_columns(); i++) {
+            if (update_columns_set.find(i) == update_columns_set.end()) {
+                read_column_ids.push_back(i);
+            }
+        }
+        size_t num_nondefault_rows = 0;
+        RETURN_IF_ERROR(_read_partial_update_values(tablet, read_column_ids, &num_nondefault_rows));
+        _read_version = latest_applied_version;
+        LOG(INFO) << Substitute("partial update falls back to row mode tablet:$0 rowset:$1 #non-default:$2",
+                                tablet->tablet_id(), rowset_id, num_nondefault_rows);
+    }
     // currently assume it's a partial update
     const auto& txn_meta = rowset_meta_pb.txn_meta();
     const auto& tschema = tablet->tablet_schema();
@@ -419,6 +530,111 @@ Status RowsetUpdateState::apply(Tablet* tablet, Rowset* rowset, uint32_t rowset_
     return Status::OK();
 }
 
+// read all the rows of |schema| of segment |idx| into |chunk|
+static Status read_segment(Rowset* rowset, const vectorized::Schema& schema, uint32_t idx,
+                           vectorized::ChunkPtr* chunk) {
+    OlapReaderStatistics stats;
+    ASSIGN_OR_RETURN(auto itr, rowset->get_segment_iterator2(schema, idx, nullptr, 0, &stats));
+    *chunk = ChunkHelper::new_chunk(schema, rowset->segments()[idx]->num_rows());
+    if (itr == nullptr) {
+        return Status::OK();
+    }
+    auto read_chunk = ChunkHelper::new_chunk(schema, config::vector_chunk_size);
+    while (true) {
+        read_chunk->reset();
+        auto st = itr->get_next(read_chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        } else if (!st.ok()) {
+            itr->close();
+            return st;
+        }
+        (*chunk)->append(*read_chunk);
+    }
+    itr->close();
+    if ((*chunk)->num_rows() != rowset->segments()[idx]->num_rows()) {
+        return Status::InternalError(Substitute("read partial segment: #row $0 != $1", (*chunk)->num_rows(),
+                                                rowset->segments()[idx]->num_rows()));
+    }
+    return Status::OK();
+}
+
+Status RowsetUpdateState::_apply_column_mode(Tablet* tablet, Rowset* rowset, uint32_t rowset_id, int64_t version,
+                                             const std::vector<std::vector<uint64_t>>& rss_rowids) {
+    int64_t t_start = MonotonicMillis();
+    const auto& txn_meta = rowset->rowset_meta()->get_meta_pb().txn_meta();
+    const auto& tschema = tablet->tablet_schema();
+    // the updated non-key columns
+    std::vector<uint32_t> value_column_ids;
+    std::vector<uint32_t> value_column_unique_ids;
+    for (uint32_t cid : txn_meta.partial_update_column_ids()) {
+        if (cid >= tschema.num_key_columns()) {
+            value_column_ids.push_back(cid);
+            value_column_unique_ids.push_back(tschema.column(cid).unique_id());
+        }
+    }
+    vectorized::Schema value_schema = ChunkHelper::convert_schema_to_format_v2(tschema, value_column_ids);
+    RowsetReleaseGuard guard(rowset->shared_from_this());
+    size_t num_segments = rowset->num_segments();
+    std::vector<vectorized::ChunkPtr> values(num_segments);
+    RETURN_IF_ERROR(StorageEngine::instance()->update_manager()->parallel_apply(
+            num_segments, [&](size_t i) { return read_segment(rowset, value_schema, i, &values[i]); }));
+    int64_t t_read = MonotonicMillis();
+
+    // (rowid, segment, row in segment) of the rows, grouped by the rssids of the segments to update
+    std::map<uint32_t, std::vector<std::tuple<uint32_t, uint32_t, uint32_t>>> rows_by_rssid;
+    for (uint32_t i = 0; i < num_segments; i++) {
+        for (uint32_t j = 0; j < rss_rowids[i].size(); j++) {
+            uint64_t v = rss_rowids[i][j];
+            rows_by_rssid[v >> 32].emplace_back(v & ROWID_MASK, i, j);
+        }
+    }
+    ASSIGN_OR_RETURN(auto fs, FileSystem::CreateSharedFromString(tablet->schema_hash_path()));
+    _delta_column_groups.clear();
+    size_t total_rows = 0;
+    for (auto& [rssid, rows] : rows_by_rssid) {
+        // a key may occur more than once in the rowset, the last one wins
+        std::stable_sort(rows.begin(), rows.end(),
+                         [](const auto& a, const auto& b) { return std::get<0>(a) < std::get<0>(b); });
+        auto rowids = vectorized::UInt32Column::create();
+        std::vector<vectorized::ColumnPtr> columns;
+        std::vector<const vectorized::Column*> column_ptrs;
+        for (size_t c = 0; c < value_column_ids.size(); c++) {
+            columns.emplace_back(values[0]->get_column_by_index(c)->clone_empty());
+            column_ptrs.emplace_back(columns.back().get());
+        }
+        auto pks = _upserts[0]->clone_empty();
+        for (size_t k = 0; k < rows.size(); k++) {
+            const auto& [rowid, seg, row] = rows[k];
+            if (k + 1 < rows.size() && std::get<0>(rows[k + 1]) == rowid) {
+                continue;
+            }
+            rowids->append(rowid);
+            for (size_t c = 0; c < columns.size(); c++) {
+                columns[c]->append(*values[seg]->get_column_by_index(c), row, 1);
+            }
+            pks->append(*_upserts[seg], row, 1);
+        }
+        RowsetSharedPtr target_rowset;
+        uint32_t segment_idx = 0;
+        RETURN_IF_ERROR(
+                tablet->updates()->get_rowset_and_segment_idx_by_rssid(rssid, &target_rowset, &segment_idx));
+        auto file_name = DeltaColumnGroup::gen_file_name(target_rowset->rowset_id(), segment_idx, version);
+        auto path = path_util::join_path_segments(tablet->schema_hash_path(), file_name);
+        RETURN_IF_ERROR(DeltaColumnGroup::write_file(fs.get(), path, *rowids, column_ptrs, *pks));
+        _delta_column_groups.emplace_back(rssid, std::make_shared<DeltaColumnGroup>(version, value_column_unique_ids,
+                                                                                    file_name, rowids->size()));
+        total_rows += rowids->size();
+    }
+    int64_t t_end = MonotonicMillis();
+    LOG(INFO) << Substitute(
+            "apply partial rowset in column mode tablet:$0 rowset:$1 version:$2 #column:$3 #segment-updated:$4 "
+            "#row:$5 time:$6ms(read:$7/write:$8)",
+            tablet->tablet_id(), rowset_id, version, value_column_ids.size(), _delta_column_groups.size(), total_rows,
+            t_end - t_start, t_read - t_start, t_end - t_read);
+    return Status::OK();
+}
+
 Status RowsetUpdateState::_update_rowset_meta(Tablet* tablet, Rowset* rowset) {
     rowset->rowset_meta()->clear_txn_meta();
     auto& rowset_meta_pb = rowset->rowset_meta()->get_meta_pb();
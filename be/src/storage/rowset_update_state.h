@@ -5,6 +5,7 @@
 #include <string>
 #include <unordered_map>
 
+#include "storage/delta_column_group.h"
 #include "storage/olap_common.h"
 #include "storage/primary_index.h"
 #include "storage/tablet_updates.h"
@@ -12,6 +13,7 @@
 namespace starrocks {
 
 class Tablet;
+class TabletSchema;
 
 struct PartialUpdateState {
     std::vector<uint64_t> src_rss_rowids;
@@ -27,8 +29,9 @@ public:
 
     Status load(Tablet* tablet, Rowset* rowset);
 
+    // |version| is the major version the rowset is applied at.
     Status apply(Tablet* tablet, Rowset* rowset, uint32_t rowset_id, EditVersion latest_applied_version,
-                 const PrimaryIndex& index);
+                 const PrimaryIndex& index, int64_t version);
 
     const std::vector<ColumnUniquePtr>& upserts() const { return _upserts; }
     const std::vector<ColumnUniquePtr>& deletes() const { return _deletes; }
@@ -39,6 +42,16 @@ public:
 
     const std::vector<PartialUpdateState>& parital_update_states() { return _partial_update_states; }
 
+    // Whether the partial update is applied in column mode, i.e. only the updated columns are written into
+    // A rowset applied in column mode does not add any row to the tablet, it is rewritten into an empty rowset.
+    // A rowset applied in column mode does not add any row to the tablet, all its rows should be marked deleted.
+    bool is_column_mode() const { return _column_mode; }
+
+    // the delta column groups written by apply in column mode, with the rssids of the segments they belong to
+    const std::vector<std::pair<uint32_t, DeltaColumnGroupPtr>>& delta_column_groups() const {
+        return _delta_column_groups;
+    }
+
     // call check conflict directly
     // only use for ut of partial update
     Status test_check_conflict(Tablet* tablet, Rowset* rowset, uint32_t rowset_id, EditVersion latest_applied_version,
@@ -49,8 +62,23 @@ public:
 private:
     Status _do_load(Tablet* tablet, Rowset* rowset);
 
+    // read the encoded primary keys of segment |idx| into _upserts[idx]
+    Status _load_upserts(Rowset* rowset, const vectorized::Schema& pkey_schema, const vectorized::Column& pk_column,
+                         uint32_t idx);
+
     Status _prepare_partial_update_states(Tablet* tablet, Rowset* rowset);
 
+    // read the values of |read_column_ids| of the rows in _partial_update_states[*].src_rss_rowids
+    Status _read_partial_update_values(Tablet* tablet, const std::vector<uint32_t>& read_column_ids,
+                                       size_t* num_nondefault_rows);
+
+    bool _can_apply_in_column_mode(const TabletSchema& tablet_schema, const RowsetTxnMetaPB& txn_meta) const;
+
+    // write the updated columns of the rows into a delta column file for each segment updated, |rss_rowids| are
+    // the rowids of the rows to update
+    Status _apply_column_mode(Tablet* tablet, Rowset* rowset, uint32_t rowset_id, int64_t version,
+                              const std::vector<std::vector<uint64_t>>& rss_rowids);
+
     Status _check_and_resolve_conflict(Tablet* tablet, Rowset* rowset, uint32_t rowset_id,
                                        EditVersion latest_applied_version, std::vector<uint32_t>& read_column_ids,
                                        const PrimaryIndex& index);
@@ -73,6 +101,9 @@ private:
     // TODO: dump to disk if memory usage is too large
     std::vector<PartialUpdateState> _partial_update_states;
 
+    bool _column_mode = false;
+    std::vector<std::pair<uint32_t, DeltaColumnGroupPtr>> _delta_column_groups;
+
     RowsetUpdateState(const RowsetUpdateState&) = delete;
     const RowsetUpdateState& operator=(const RowsetUpdateState&) = delete;
 };
@@ -0,0 +1,32 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "common/statusor.h"
+#include "storage/olap_common.h"
+
+namespace starrocks::vectorized {
+
+class ColumnPredicate;
+
+// RuntimeRangePruner provides the predicates translated from the join runtime filters that arrive
+// after the scan is prepared, so that the segments not opened yet can be pruned by them at segment
+// and page level with zone maps, instead of decompressing the pages and evaluating the runtime
+// filters row by row.
+//
+// It's only accessed by the thread driving the scan, so it's not thread-safe.
+class RuntimeRangePruner {
+public:
+    using PredicatesMap = std::unordered_map<ColumnId, std::vector<const ColumnPredicate*>>;
+
+    virtual ~RuntimeRangePruner() = default;
+
+    // Returns the predicates of all the runtime filters arrived so far, grouped by column id, which
+    // are valid until the pruner is destroyed. Returns EndOfFile if no row can pass the filters.
+    virtual StatusOr<const PredicatesMap*> arrived_predicates() = 0;
+};
+
+} // namespace starrocks::vectorized
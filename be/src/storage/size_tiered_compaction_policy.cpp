@@ -0,0 +1,165 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+#include "storage/size_tiered_compaction_policy.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "common/config.h"
+#include "storage/compaction_task.h"
+#include "storage/compaction_task_factory.h"
+#include "storage/rowset/rowset.h"
+#include "util/time.h"
+
+namespace starrocks {
+
+int SizeTieredCompactionPolicy::level_of(int64_t size) {
+    const int64_t min_level_size = std::max<int64_t>(1, config::size_tiered_min_level_size);
+    const int64_t multiple = std::max<int64_t>(2, config::size_tiered_level_multiple);
+    int level = 0;
+    for (int64_t level_size = min_level_size; size >= level_size; level_size *= multiple) {
+        level++;
+    }
+    return level;
+}
+
+void SizeTieredCompactionPolicy::_init_rowsets() {
+    _rowsets.clear();
+    for (const auto& level : _compaction_context->rowset_levels) {
+        _rowsets.insert(_rowsets.end(), level.begin(), level.end());
+    }
+    std::sort(_rowsets.begin(), _rowsets.end(), RowsetComparator());
+    _levels.resize(_rowsets.size());
+    _is_delete.resize(_rowsets.size());
+    for (size_t i = 0; i < _rowsets.size(); i++) {
+        _levels[i] = level_of(_rowsets[i]->data_disk_size());
+        _is_delete[i] = _compaction_context->tablet->version_for_delete_predicate(_rowsets[i]->version());
+    }
+}
+
+bool SizeTieredCompactionPolicy::_can_pick(size_t run_begin, size_t idx) const {
+    Rowset* rowset = _rowsets[idx];
+    if (_compaction_context->compacting_rowsets.count(rowset) > 0) {
+        return false;
+    }
+    // delete predicates are removed with the rowsets carrying them, so they can only be compacted together
+    // with all the rowsets before them.
+    if (_is_delete[idx] && (run_begin != 0 || _rowsets[0]->start_version() != 0)) {
+        return false;
+    }
+    // skip the newly loaded rowsets, more rowsets of the same level may come soon.
+    if (rowset->start_version() == rowset->end_version() &&
+        rowset->creation_time() + config::cumulative_compaction_skip_window_seconds > UnixSeconds()) {
+        return false;
+    }
+    return true;
+}
+
+SizeTieredCompactionPolicy::Run SizeTieredCompactionPolicy::_pick_run(size_t from, bool base) const {
+    Run best;
+    if (from >= _rowsets.size()) {
+        return best;
+    }
+    std::vector<int> levels(_levels.begin() + from, _levels.end());
+    std::sort(levels.begin(), levels.end());
+    levels.erase(std::unique(levels.begin(), levels.end()), levels.end());
+    for (int level : levels) {
+        size_t begin = from;
+        while (begin < _rowsets.size()) {
+            if (!_can_pick(begin, begin) || _levels[begin] > level) {
+                if (base) {
+                    break;
+                }
+                begin++;
+                continue;
+            }
+            size_t end = begin;
+            int64_t num_segments = 0;
+            int64_t num_level_segments = 0;
+            int64_t bytes = 0;
+            while (end < _rowsets.size() && _can_pick(begin, end) && (_is_delete[end] || _levels[end] <= level)) {
+                int64_t score = _rowsets[end]->rowset_meta()->get_compaction_score();
+                num_segments += score;
+                num_level_segments += (!_is_delete[end] && _levels[end] == level) ? score : 0;
+                bytes += _rowsets[end]->data_disk_size();
+                end++;
+                if (num_segments >= config::max_cumulative_compaction_num_singleton_deltas) {
+                    break;
+                }
+            }
+            if (num_level_segments >= config::size_tiered_min_level_rowsets && num_segments > 1) {
+                double mbs = std::max(1.0, static_cast<double>(bytes) / (1024 * 1024));
+                double efficiency = (num_segments - 1) / mbs;
+                if (efficiency > best.efficiency) {
+                    double score = static_cast<double>(num_segments) /
+                                   std::max<int64_t>(1, config::size_tiered_min_level_rowsets);
+                    best = {begin, end, efficiency, score};
+                }
+            }
+            if (base) {
+                break;
+            }
+            begin = end;
+        }
+    }
+    return best;
+}
+
+void SizeTieredCompactionPolicy::_pick_runs(Run* base_run, Run* cumulative_run) {
+    _init_rowsets();
+    *base_run = Run();
+    *cumulative_run = Run();
+    if (_rowsets.empty()) {
+        return;
+    }
+    if (_rowsets[0]->start_version() == 0) {
+        *base_run = _pick_run(0, true);
+    }
+    // the runs of base and cumulative compaction must not overlap, they may run at the same time.
+    *cumulative_run = _pick_run(std::max<size_t>(1, base_run->end), false);
+}
+
+bool SizeTieredCompactionPolicy::need_compaction() {
+    Run base_run;
+    Run cumulative_run;
+    _pick_runs(&base_run, &cumulative_run);
+    _compaction_context->base_score = base_run.score;
+    _compaction_context->cumulative_score = cumulative_run.score;
+    VLOG(2) << "need_compaction compaction context:" << _compaction_context->to_string();
+    return _compaction_context->cumulative_score > COMPACTION_SCORE_THRESHOLD ||
+           _compaction_context->base_score > COMPACTION_SCORE_THRESHOLD;
+}
+
+std::shared_ptr<CompactionTask> SizeTieredCompactionPolicy::create_compaction() {
+    CompactionType type = _compaction_context->chosen_compaction_type;
+    if (type != BASE_COMPACTION && type != CUMULATIVE_COMPACTION) {
+        LOG(WARNING) << "invalid compaction type:" << type << ", tablet:" << _compaction_context->tablet->tablet_id();
+        return nullptr;
+    }
+    Run base_run;
+    Run cumulative_run;
+    _pick_runs(&base_run, &cumulative_run);
+    const Run& run = type == BASE_COMPACTION ? base_run : cumulative_run;
+    if (run.score <= COMPACTION_SCORE_THRESHOLD || run.end <= run.begin) {
+        LOG(INFO) << "no suitable rowsets for size tiered compaction. tablet:"
+                  << _compaction_context->tablet->tablet_id() << ", type:" << type;
+        return nullptr;
+    }
+    std::vector<RowsetSharedPtr> input_rowsets;
+    input_rowsets.reserve(run.end - run.begin);
+    for (size_t i = run.begin; i < run.end; i++) {
+        if (!input_rowsets.empty() && _rowsets[i]->start_version() != input_rowsets.back()->end_version() + 1) {
+            LOG(WARNING) << "There are missed versions among rowsets. tablet:"
+                         << _compaction_context->tablet->tablet_id() << ", rowset version:" << _rowsets[i]->version()
+                         << ", previous rowset version:" << input_rowsets.back()->version();
+            return nullptr;
+        }
+        input_rowsets.emplace_back(_rowsets[i]->shared_from_this());
+    }
+
+    Version output_version(input_rowsets.front()->start_version(), input_rowsets.back()->end_version());
+    CompactionTaskFactory factory(output_version, _compaction_context->tablet, std::move(input_rowsets), run.score,
+                                  type);
+    return factory.create_compaction_task();
+}
+
+} // namespace starrocks
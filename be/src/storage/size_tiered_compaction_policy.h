@@ -0,0 +1,69 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#pragma once
+
+#include <vector>
+
+#include "storage/compaction_context.h"
+#include "storage/compaction_policy.h"
+
+namespace starrocks {
+
+class CompactionTask;
+
+// Compaction policy merging the adjacent rowsets of similar size, to reduce the write amplification of
+// tablets with frequent small loads compared with BaseAndCumulativeCompactionPolicy.
+//
+// Rowsets are grouped into levels by data size, see config::size_tiered_min_level_size and
+// config::size_tiered_level_multiple. A run of adjacent rowsets not larger than level L is compacted if it has
+// at least config::size_tiered_min_level_rowsets segments of level L, so that each row is rewritten about once
+// per level. The run starting from the first rowset of the tablet is compacted by base compaction, and the
+// others by cumulative compaction.
+//
+// Among the candidate runs of a tablet, the one reducing the most segments per MB to read is picked, i.e. the
+// largest reduction of read amplification per byte of IO. Its compaction score is the number of its segments
+// divided by config::size_tiered_min_level_rowsets, which is the multiple of the trigger threshold like the
+// scores of BaseAndCumulativeCompactionPolicy, so that compaction manager ranks the tablets of both policies
+// on the same scale.
+class SizeTieredCompactionPolicy : public CompactionPolicy {
+public:
+    explicit SizeTieredCompactionPolicy(CompactionContext* compaction_context)
+            : _compaction_context(compaction_context) {}
+    ~SizeTieredCompactionPolicy() override = default;
+
+    bool need_compaction() override;
+
+    std::shared_ptr<CompactionTask> create_compaction() override;
+
+    // level of a rowset of |size| bytes
+    static int level_of(int64_t size);
+
+private:
+    struct Run {
+        // [begin, end) of _rowsets
+        size_t begin = 0;
+        size_t end = 0;
+        // segments reduced per MB to read
+        double efficiency = 0;
+        double score = 0;
+    };
+
+    void _init_rowsets();
+
+    // whether the rowset can be picked by a run which starts from _rowsets[|run_begin|]
+    bool _can_pick(size_t run_begin, size_t idx) const;
+
+    // pick the run of the highest score in [from, _rowsets.size()), with the first rowset of the run at |from|
+    // if |base| is true.
+    Run _pick_run(size_t from, bool base) const;
+
+    void _pick_runs(Run* base_run, Run* cumulative_run);
+
+    CompactionContext* _compaction_context;
+    // all the rowsets of the tablet sorted by version
+    std::vector<Rowset*> _rowsets;
+    std::vector<int> _levels;
+    std::vector<bool> _is_delete;
+};
+
+} // namespace starrocks
@@ -33,6 +33,7 @@
 #include "runtime/current_thread.h"
 #include "runtime/exec_env.h"
 #include "storage/del_vector.h"
+#include "storage/delta_column_group.h"
 #include "storage/rowset/rowset.h"
 #include "storage/rowset/rowset_factory.h"
 #include "storage/rowset/rowset_id_generator.h"
@@ -41,6 +42,7 @@
 #include "storage/tablet_manager.h"
 #include "storage/tablet_updates.h"
 #include "util/defer_op.h"
+#include "util/path_util.h"
 #include "util/raw_container.h"
 
 using std::map;
@@ -552,6 +554,10 @@ Status SnapshotManager::make_snapshot_on_tablet_meta(SnapshotTypePB snapshot_typ
     for (const auto& rowset_meta : rowset_metas) {
         RowsetMetaPB& meta_pb = snapshot_meta.rowset_metas().emplace_back();
         rowset_meta->to_rowset_pb(&meta_pb);
+        if (snapshot_type == SNAPSHOT_TYPE_INCREMENTAL && meta_pb.applied_to_delta_columns()) {
+            // applied after the rowsets were chosen, its values are no longer in the rowset files
+            return Status::Aborted("rowset applied to delta columns during incremental snapshot, retry");
+        }
     }
     if (snapshot_type == SNAPSHOT_TYPE_FULL) {
         auto meta_store = tablet->data_dir()->get_meta();
@@ -566,6 +572,12 @@ Status SnapshotManager::make_snapshot_on_tablet_meta(SnapshotTypePB snapshot_typ
                 DelVector* delvec = &snapshot_meta.delete_vectors()[new_segment_id];
                 RETURN_IF_ERROR(TabletMetaManager::get_del_vector(meta_store, tablet->tablet_id(), old_segment_id,
                                                                   snapshot_version, delvec, &dummy /*latest_version*/));
+                DeltaColumnGroupList dcgs;
+                RETURN_IF_ERROR(TabletMetaManager::get_delta_column_groups(meta_store, tablet->tablet_id(),
+                                                                           old_segment_id, snapshot_version, &dcgs));
+                if (!dcgs.empty()) {
+                    snapshot_meta.delta_column_groups()[new_segment_id] = std::move(dcgs);
+                }
             }
             rowset_meta_pb.set_rowset_seg_id(new_rsid);
             new_rsid += std::max<uint32_t>(rowset_meta_pb.num_segments(), 1);
@@ -594,6 +606,18 @@ Status SnapshotManager::make_snapshot_on_tablet_meta(SnapshotTypePB snapshot_typ
         meta_pb.mutable_updates()->mutable_apply_version()->set_minor(0);
     }
 
+    // The delta column files are immutable, link them along with the meta. There is nothing to link if the
+    // snapshot is made in the tablet directory itself.
+    if (snapshot_dir != tablet->schema_hash_path()) {
+        for (const auto& [segment_id, dcgs] : snapshot_meta.delta_column_groups()) {
+            for (const auto& dcg : dcgs) {
+                auto src_path = path_util::join_path_segments(tablet->schema_hash_path(), dcg->file_name());
+                auto dst_path = path_util::join_path_segments(snapshot_dir, dcg->file_name());
+                RETURN_IF_ERROR(FileSystem::Default()->link_file(src_path, dst_path));
+            }
+        }
+    }
+
     WritableFileOptions opts{.sync_on_close = true, .mode = FileSystem::CREATE_OR_OPEN_WITH_TRUNCATE};
     ASSIGN_OR_RETURN(auto f, FileSystem::Default()->new_writable_file(opts, snapshot_dir + "/meta"));
     RETURN_IF_ERROR(snapshot_meta.serialize_to_file(f.get()));
@@ -627,6 +651,21 @@ Status SnapshotManager::assign_new_rowset_id(SnapshotMeta* snapshot_meta, const
             auto new_path = Rowset::segment_del_file_path(clone_dir, new_rowset_id, del_id);
             RETURN_IF_ERROR(FileSystem::Default()->link_file(old_path, new_path));
         }
+        // The delta column files are named after the rowset id of the segment they update.
+        for (int seg_id = 0; seg_id < rowset_meta_pb.num_segments(); seg_id++) {
+            auto iter = snapshot_meta->delta_column_groups().find(rowset_meta_pb.rowset_seg_id() + seg_id);
+            if (iter == snapshot_meta->delta_column_groups().end()) {
+                continue;
+            }
+            for (auto& dcg : iter->second) {
+                auto file_name = DeltaColumnGroup::gen_file_name(new_rowset_id, seg_id, dcg->version());
+                auto old_path = path_util::join_path_segments(clone_dir, dcg->file_name());
+                auto new_path = path_util::join_path_segments(clone_dir, file_name);
+                RETURN_IF_ERROR(FileSystem::Default()->link_file(old_path, new_path));
+                dcg = std::make_shared<DeltaColumnGroup>(dcg->version(), dcg->column_unique_ids(),
+                                                         std::move(file_name), dcg->num_rows());
+            }
+        }
         rowset_meta_pb.set_rowset_id(new_rowset_id.to_string());
     }
     return Status::OK();
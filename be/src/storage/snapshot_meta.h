@@ -10,6 +10,7 @@
 #include "gen_cpp/olap_file.pb.h"
 #include "gen_cpp/snapshot.pb.h"
 #include "storage/del_vector.h"
+#include "storage/delta_column_group.h"
 
 namespace starrocks {
 
@@ -47,6 +48,12 @@ public:
 
     const std::unordered_map<uint32_t, DelVector>& delete_vectors() const { return _delete_vectors; }
 
+    std::unordered_map<uint32_t, DeltaColumnGroupList>& delta_column_groups() { return _delta_column_groups; }
+
+    const std::unordered_map<uint32_t, DeltaColumnGroupList>& delta_column_groups() const {
+        return _delta_column_groups;
+    }
+
 private:
     SnapshotTypePB _snapshot_type = SNAPSHOT_TYPE_UNKNOWN;
     int32_t _format_version = -1 /* default invalid value*/;
@@ -54,6 +61,8 @@ private:
     TabletMetaPB _tablet_meta; // only valid in full snapshot mode, will empty in incremental snapshot mode
     std::vector<RowsetMetaPB> _rowset_metas;
     std::unordered_map<uint32_t, DelVector> _delete_vectors;
+    // only non-empty in full snapshot mode, sorted by version in ascending order for each segment
+    std::unordered_map<uint32_t, DeltaColumnGroupList> _delta_column_groups;
 };
 
 } // namespace starrocks
@@ -360,6 +360,7 @@ Status Tablet::add_inc_rowset(const RowsetSharedPtr& rowset, int64_t version) {
     LOG_IF(WARNING, !st.ok()) << "ignore load rowset error tablet:" << tablet_id() << " rowset:" << rowset->rowset_id()
                               << " " << st;
     ++_newly_created_rowset_num;
+    _ingested_bytes += rowset->data_disk_size();
     return Status::OK();
 }
 
@@ -922,6 +923,13 @@ void Tablet::get_compaction_status(std::string* json_result) {
     format_str = ToStringFromUnixMillis(_last_base_compaction_success_millis.load());
     base_success_value.SetString(format_str.c_str(), format_str.length(), root.GetAllocator());
     root.AddMember("last base success time", base_success_value, root.GetAllocator());
+    rapidjson::Value policy_value;
+    format_str = CompactionPolicyPB_Name(_tablet_meta->compaction_policy());
+    policy_value.SetString(format_str.c_str(), format_str.length(), root.GetAllocator());
+    root.AddMember("compaction policy", policy_value, root.GetAllocator());
+    root.AddMember("ingested bytes", _ingested_bytes.load(), root.GetAllocator());
+    root.AddMember("compaction written bytes", _compaction_written_bytes.load(), root.GetAllocator());
+    root.AddMember("write amplification", write_amplification(), root.GetAllocator());
 
     // print all rowsets' version as an array
     rapidjson::Document versions_arr;
@@ -948,6 +956,14 @@ void Tablet::get_compaction_status(std::string* json_result) {
     *json_result = std::string(strbuf.GetString());
 }
 
+double Tablet::write_amplification() const {
+    int64_t ingested_bytes = _ingested_bytes;
+    if (ingested_bytes <= 0) {
+        return 0;
+    }
+    return static_cast<double>(ingested_bytes + _compaction_written_bytes) / ingested_bytes;
+}
+
 void Tablet::do_tablet_meta_checkpoint() {
     std::unique_lock store_lock(_meta_store_lock);
     if (_newly_created_rowset_num == 0) {
@@ -1199,6 +1215,13 @@ std::unique_ptr<CompactionContext> Tablet::_get_compaction_context() {
         }
     }
     compaction_context->tablet = std::static_pointer_cast<Tablet>(shared_from_this());
+    for (const auto& task : {_base_compaction_task, _cumulative_compaction_task}) {
+        if (task) {
+            for (const auto& rowset : task->input_rowsets()) {
+                compaction_context->compacting_rowsets.insert(rowset.get());
+            }
+        }
+    }
 
     // For leading 'delete' or 'compacted' rowset in level 0, move it to level 1
     // because they should be compacted by base compaction
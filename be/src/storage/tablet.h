@@ -201,6 +201,14 @@ public:
     int64_t last_base_compaction_success_time() { return _last_base_compaction_success_millis; }
     void set_last_base_compaction_success_time(int64_t millis) { _last_base_compaction_success_millis = millis; }
 
+    // bytes of the rowsets loaded into / written by compaction of this tablet since BE started,
+    // used to calculate the write amplification of the tablet.
+    int64_t ingested_bytes() const { return _ingested_bytes; }
+    int64_t compaction_written_bytes() const { return _compaction_written_bytes; }
+    void add_compaction_written_bytes(int64_t bytes) { _compaction_written_bytes += bytes; }
+    // bytes written per byte ingested, 0 if nothing ingested.
+    double write_amplification() const;
+
     void delete_all_files();
 
     bool check_rowset_id(const RowsetId& rowset_id);
@@ -349,6 +357,9 @@ private:
     // timestamp of last base compaction success
     std::atomic<int64_t> _last_base_compaction_success_millis{0};
 
+    std::atomic<int64_t> _ingested_bytes{0};
+    std::atomic<int64_t> _compaction_written_bytes{0};
+
     std::atomic<int64_t> _cumulative_point{0};
     std::atomic<int32_t> _newly_created_rowset_num{0};
     std::atomic<int64_t> _last_checkpoint_time{0};
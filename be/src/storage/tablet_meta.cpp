@@ -47,6 +47,9 @@ Status TabletMeta::create(MemTracker* mem_tracker, const TCreateTabletReq& reque
                            col_ordinal_to_unique_id, tablet_uid,
                            request.__isset.tablet_type ? request.tablet_type : TTabletType::TABLET_TYPE_DISK),
             DeleterWithMemTracker<TabletMeta>(mem_tracker));
+    if (request.__isset.compaction_policy && request.compaction_policy == TCompactionPolicy::SIZE_TIERED) {
+        (*tablet_meta)->set_compaction_policy(CompactionPolicyPB::SIZE_TIERED);
+    }
     mem_tracker->consume((*tablet_meta)->mem_usage());
     return Status::OK();
 }
@@ -194,6 +197,8 @@ void TabletMeta::init_from_pb(TabletMetaPB* ptablet_meta_pb) {
         _enable_persistent_index = false;
     }
 
+    _compaction_policy = tablet_meta_pb.compaction_policy();
+
     // init _tablet_state
     switch (tablet_meta_pb.tablet_state()) {
     case PB_NOTREADY:
@@ -258,6 +263,7 @@ void TabletMeta::to_meta_pb(TabletMetaPB* tablet_meta_pb) {
     tablet_meta_pb->set_enable_persistent_index(get_enable_persistent_index());
     *tablet_meta_pb->mutable_tablet_uid() = tablet_uid().to_proto();
     tablet_meta_pb->set_tablet_type(_tablet_type);
+    tablet_meta_pb->set_compaction_policy(_compaction_policy);
     switch (tablet_state()) {
     case TABLET_NOTREADY:
         tablet_meta_pb->set_tablet_state(PB_NOTREADY);
@@ -498,6 +504,7 @@ bool operator==(const TabletMeta& a, const TabletMeta& b) {
     if (a._cumulative_layer_point != b._cumulative_layer_point) return false;
     if (a._tablet_uid != b._tablet_uid) return false;
     if (a._tablet_type != b._tablet_type) return false;
+    if (a._compaction_policy != b._compaction_policy) return false;
     if (a._tablet_state != b._tablet_state) return false;
     if (!((a._schema == nullptr && b._schema == nullptr) ||
           (a._schema != nullptr && b._schema != nullptr && *a._schema == *b._schema))) {
@@ -182,6 +182,11 @@ public:
         _enable_persistent_index = enable_persistent_index;
     }
 
+    // the policy to pick the rowsets to compact, assigned when the tablet is created. Ignored by primary key tablets.
+    CompactionPolicyPB compaction_policy() const { return _compaction_policy; }
+
+    void set_compaction_policy(CompactionPolicyPB compaction_policy) { _compaction_policy = compaction_policy; }
+
 private:
     Status _save_meta(DataDir* data_dir);
 
@@ -207,6 +212,7 @@ private:
     bool _enable_persistent_index = false;
     TabletUid _tablet_uid;
     TabletTypePB _tablet_type = TabletTypePB::TABLET_TYPE_DISK;
+    CompactionPolicyPB _compaction_policy = CompactionPolicyPB::BASE_AND_CUMULATIVE;
 
     TabletState _tablet_state = TABLET_NOTREADY;
     // Note: Segment store the pointer of TabletSchema,
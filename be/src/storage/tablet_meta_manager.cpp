@@ -61,6 +61,7 @@ static const std::string TABLET_META_ROWSET_PREFIX = "trs_";
 static const std::string TABLET_META_PENDING_ROWSET_PREFIX = "tpr_";
 static const std::string TABLET_DELVEC_PREFIX = "dlv_";
 static const std::string TABLET_PERSISTENT_INDEX_META_PREFIX = "tpi_";
+static const std::string TABLET_DELTA_COLUMN_GROUP_PREFIX = "dcg_";
 
 static string encode_meta_log_key(TTabletId id, uint64_t logid);
 static bool decode_meta_log_key(std::string_view key, TTabletId* id, uint64_t* logid);
@@ -72,6 +73,7 @@ std::string encode_del_vector_key(TTabletId tablet_id, uint32_t segment_id, int6
 void decode_del_vector_key(std::string_view enc_key, TTabletId* tablet_id, uint32_t* segment_id, int64_t* version);
 std::string encode_persistent_index_key(TTabletId tablet_id);
 void decode_persistent_index_key(std::string_view enc_key, TTabletId* tablet_id);
+std::string encode_delta_column_group_key(TTabletId tablet_id, uint32_t segment_id, int64_t version);
 
 static std::string encode_tablet_meta_key(TTabletId tablet_id, TSchemaHash schema_hash) {
     return strings::Substitute("$0$1_$2", HEADER_PREFIX, tablet_id, schema_hash);
@@ -477,6 +479,9 @@ Status TabletMetaManager::build_primary_meta(DataDir* store, rapidjson::Document
     if (!clear_del_vector(store, &batch, tablet_id).ok()) {
         return Status::IOError("clear delvec add to batch failed");
     }
+    if (!clear_delta_column_group(store, &batch, tablet_id).ok()) {
+        return Status::IOError("clear delta column group add to batch failed");
+    }
     if (!clear_rowset(store, &batch, tablet_id).ok()) {
         return Status::IOError("clear rowset add to batch failed");
     }
@@ -678,6 +683,23 @@ void decode_del_vector_key(std::string_view enc_key, TTabletId* tablet_id, uint3
     *version = INT64_MAX - BigEndian::ToHost64(UNALIGNED_LOAD64(enc_key.data() + 16));
 }
 
+std::string encode_delta_column_group_key(TTabletId tablet_id, uint32_t segment_id, int64_t version) {
+    std::string key;
+    key.reserve(24);
+    key.append(TABLET_DELTA_COLUMN_GROUP_PREFIX);
+    put_fixed64_le(&key, BigEndian::FromHost64(tablet_id));
+    put_fixed32_le(&key, BigEndian::FromHost32(segment_id));
+    // Unlike delete vectors, all the delta column groups of a segment take effect together,
+    // make them sorted by version in RocksDB.
+    put_fixed64_le(&key, BigEndian::FromHost64(version));
+    return key;
+}
+
+static int64_t decode_delta_column_group_key_version(std::string_view key) {
+    DCHECK_GT(key.size(), sizeof(int64_t));
+    return BigEndian::ToHost64(UNALIGNED_LOAD64(key.data() + key.size() - sizeof(int64_t)));
+}
+
 std::string encode_persistent_index_key(TTabletId tablet_id) {
     std::string key;
     key.reserve(TABLET_PERSISTENT_INDEX_META_PREFIX.length() + sizeof(uint64_t));
@@ -786,6 +808,12 @@ Status TabletMetaManager::rowset_delete(DataDir* store, TTabletId tablet_id, uin
         if (UNLIKELY(!st.ok())) {
             return Status::InternalError("remove delete vector failed");
         }
+        lower = encode_delta_column_group_key(tablet_id, rowset_id + 0, 0);
+        upper = encode_delta_column_group_key(tablet_id, rowset_id + segments, 0);
+        st = batch.DeleteRange(cf_meta, lower, upper);
+        if (UNLIKELY(!st.ok())) {
+            return Status::InternalError("remove delta column group failed");
+        }
     }
     return meta->write_batch(&batch);
 }
@@ -807,7 +835,9 @@ Status TabletMetaManager::rowset_iterate(DataDir* store, TTabletId tablet_id, co
 Status TabletMetaManager::apply_rowset_commit(DataDir* store, TTabletId tablet_id, int64_t logid,
                                               const EditVersion& version,
                                               vector<std::pair<uint32_t, DelVectorPtr>>& delvecs,
-                                              const PersistentIndexMetaPB& index_meta, bool enable_persistent_index) {
+                                              const PersistentIndexMetaPB& index_meta, bool enable_persistent_index,
+                                              const vector<std::pair<uint32_t, DeltaColumnGroupPtr>>& dcgs,
+                                              const RowsetMetaPB* rowset_meta) {
     auto span = Tracer::Instance().start_trace_tablet("apply_save_meta", tablet_id);
     span->SetAttribute("version", version.to_string());
     WriteBatch batch;
@@ -843,6 +873,24 @@ Status TabletMetaManager::apply_rowset_commit(DataDir* store, TTabletId tablet_i
     span->SetAttribute("delvec_bytes", total_bytes);
     span->AddEvent("delvec_end");
 
+    for (auto& rssid_dcg : dcgs) {
+        auto dcg_key = encode_delta_column_group_key(tablet_id, rssid_dcg.first, rssid_dcg.second->version());
+        st = batch.Put(handle, dcg_key, rssid_dcg.second->save());
+        if (!st.ok()) {
+            LOG(WARNING) << "rowset_commit failed, rocksdb.batch.put failed";
+            return to_status(st);
+        }
+    }
+
+    if (rowset_meta != nullptr) {
+        auto rowset_key = encode_meta_rowset_key(tablet_id, rowset_meta->rowset_seg_id());
+        st = batch.Put(handle, rowset_key, rowset_meta->SerializeAsString());
+        if (!st.ok()) {
+            LOG(WARNING) << "rowset_commit failed, rocksdb.batch.put failed";
+            return to_status(st);
+        }
+    }
+
     if (enable_persistent_index) {
         auto meta_key = encode_persistent_index_key(tsid.tablet_id);
         auto meta_value = index_meta.SerializeAsString();
@@ -975,6 +1023,34 @@ Status TabletMetaManager::delete_del_vector_range(KVStore* meta, TTabletId table
     return meta->write_batch(&batch);
 }
 
+Status TabletMetaManager::get_delta_column_groups(KVStore* meta, TTabletId tablet_id, uint32_t segment_id,
+                                                  int64_t version, DeltaColumnGroupList* dcgs) {
+    std::string lower = encode_delta_column_group_key(tablet_id, segment_id, 0);
+    std::string upper = encode_delta_column_group_key(tablet_id, segment_id + 1, 0);
+
+    Status st;
+    auto traverse_versions = [&](std::string_view key, std::string_view value) -> bool {
+        int64_t cv = decode_delta_column_group_key_version(key);
+        if (cv > version) {
+            return false;
+        }
+        auto dcg = std::make_shared<DeltaColumnGroup>();
+        st = dcg->load(cv, value.data(), value.size());
+        if (!st.ok()) {
+            return false;
+        }
+        dcgs->emplace_back(std::move(dcg));
+        return true;
+    };
+    auto ret = meta->iterate_range(META_COLUMN_FAMILY_INDEX, lower, upper, traverse_versions);
+    if (!ret.ok()) {
+        LOG(WARNING) << "fail to iterate rocksdb delta column groups. tablet_id=" << tablet_id
+                     << " segment_id=" << segment_id << " error_code=" << ret.to_string();
+        return ret;
+    }
+    return st;
+}
+
 Status TabletMetaManager::put_rowset_meta(DataDir* store, WriteBatch* batch, TTabletId tablet_id,
                                           const RowsetMetaPB& rowset_meta) {
     auto h = store->get_meta()->handle(META_COLUMN_FAMILY_INDEX);
@@ -991,6 +1067,14 @@ Status TabletMetaManager::put_del_vector(DataDir* store, WriteBatch* batch, TTab
     return to_status(batch->Put(h, k, v));
 }
 
+Status TabletMetaManager::put_delta_column_group(DataDir* store, WriteBatch* batch, TTabletId tablet_id,
+                                                 uint32_t segment_id, const DeltaColumnGroup& dcg) {
+    auto k = encode_delta_column_group_key(tablet_id, segment_id, dcg.version());
+    auto v = dcg.save();
+    auto h = store->get_meta()->handle(META_COLUMN_FAMILY_INDEX);
+    return to_status(batch->Put(h, k, v));
+}
+
 Status TabletMetaManager::put_tablet_meta(DataDir* store, WriteBatch* batch, const TabletMetaPB& meta) {
     auto k = encode_tablet_meta_key(meta.tablet_id(), meta.schema_hash());
     auto v = meta.SerializeAsString();
@@ -1019,6 +1103,13 @@ Status TabletMetaManager::clear_del_vector(DataDir* store, WriteBatch* batch, TT
     return to_status(batch->DeleteRange(h, lower, upper));
 }
 
+Status TabletMetaManager::clear_delta_column_group(DataDir* store, WriteBatch* batch, TTabletId tablet_id) {
+    auto lower = encode_delta_column_group_key(tablet_id, 0, 0);
+    auto upper = encode_delta_column_group_key(tablet_id, UINT32_MAX, INT64_MAX);
+    auto h = store->get_meta()->handle(META_COLUMN_FAMILY_INDEX);
+    return to_status(batch->DeleteRange(h, lower, upper));
+}
+
 Status TabletMetaManager::clear_persistent_index(DataDir* store, WriteBatch* batch, TTabletId tablet_id) {
     auto k = encode_persistent_index_key(tablet_id);
     auto h = store->get_meta()->handle(META_COLUMN_FAMILY_INDEX);
@@ -1224,6 +1315,9 @@ Status TabletMetaManager::remove(DataDir* store, TTabletId tablet_id) {
         if (!clear_del_vector(store, &batch, tablet_id).ok()) {
             LOG(WARNING) << "clear delvec add to batch failed";
         }
+        if (!clear_delta_column_group(store, &batch, tablet_id).ok()) {
+            LOG(WARNING) << "clear delta column group add to batch failed";
+        }
         if (!clear_rowset(store, &batch, tablet_id).ok()) {
             LOG(WARNING) << "clear rowset add to batch failed";
         }
@@ -31,6 +31,7 @@ DIAGNOSTIC_POP
 
 #include "gen_cpp/persistent_index.pb.h"
 #include "storage/data_dir.h"
+#include "storage/delta_column_group.h"
 #include "storage/kv_store.h"
 #include "storage/olap_define.h"
 #include "storage/tablet_meta.h"
@@ -144,13 +145,16 @@ public:
     // Remove rowset meta from |store|, leave tablet meta unchanged.
     // |rowset_id| is the value returned from `RowsetMeta::get_rowset_seg_id`.
     // |segments| is the number of segments in the rowset, i.e, `Rowset::num_segments`.
-    // All delete vectors that associated with this rowset will be deleted too.
+    // All delete vectors and delta column groups that associated with this rowset will be deleted too.
     static Status rowset_delete(DataDir* store, TTabletId tablet_id, uint32_t rowset_id, uint32_t segments);
 
     // update meta after state of a rowset commit is applied
+    // |rowset_meta| if not null, the rewritten meta of the applied rowset
     static Status apply_rowset_commit(DataDir* store, TTabletId tablet_id, int64_t logid, const EditVersion& version,
                                       std::vector<std::pair<uint32_t, DelVectorPtr>>& delvecs,
-                                      const PersistentIndexMetaPB& index_meta, bool enable_persistent_index);
+                                      const PersistentIndexMetaPB& index_meta, bool enable_persistent_index,
+                                      const std::vector<std::pair<uint32_t, DeltaColumnGroupPtr>>& dcgs = {},
+                                      const RowsetMetaPB* rowset_meta = nullptr);
 
     // traverse all the op logs for a tablet
     static Status traverse_meta_logs(DataDir* store, TTabletId tablet_id,
@@ -171,12 +175,20 @@ public:
     static Status delete_del_vector_range(KVStore* meta, TTabletId tablet_id, uint32_t segment_id,
                                           int64_t start_version, int64_t end_version);
 
+    // Get the delta column groups of segment |segment_id| whose version is not greater than |version|,
+    // sorted by version in ascending order.
+    static Status get_delta_column_groups(KVStore* meta, TTabletId tablet_id, uint32_t segment_id, int64_t version,
+                                          DeltaColumnGroupList* dcgs);
+
     static Status put_rowset_meta(DataDir* store, WriteBatch* batch, TTabletId tablet_id,
                                   const RowsetMetaPB& rowset_meta);
 
     static Status put_del_vector(DataDir* store, WriteBatch* batch, TTabletId tablet_id, uint32_t segment_id,
                                  const DelVector& delvec);
 
+    static Status put_delta_column_group(DataDir* store, WriteBatch* batch, TTabletId tablet_id, uint32_t segment_id,
+                                         const DeltaColumnGroup& dcg);
+
     static Status put_tablet_meta(DataDir* store, WriteBatch* batch, const TabletMetaPB& tablet_meta);
 
     static Status delete_pending_rowset(DataDir* store, WriteBatch* batch, TTabletId tablet_id, int64_t version);
@@ -192,6 +204,8 @@ public:
 
     static Status clear_del_vector(DataDir* store, WriteBatch* batch, TTabletId tablet_id);
 
+    static Status clear_delta_column_group(DataDir* store, WriteBatch* batch, TTabletId tablet_id);
+
     static Status clear_persistent_index(DataDir* store, WriteBatch* batch, TTabletId tablet_id);
 
     static Status remove_tablet_meta(DataDir* store, WriteBatch* batch, TTabletId tablet_id, TSchemaHash schema_hash);
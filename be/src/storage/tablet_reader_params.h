@@ -19,6 +19,7 @@ class RuntimeState;
 namespace vectorized {
 
 class ColumnPredicate;
+class RuntimeRangePruner;
 struct RowidRangeOption;
 using RowidRangeOptionPtr = std::shared_ptr<RowidRangeOption>;
 struct ShortKeyRangeOption;
@@ -50,6 +51,8 @@ struct TabletReaderParams {
     std::vector<OlapTuple> start_key;
     std::vector<OlapTuple> end_key;
     std::vector<const ColumnPredicate*> predicates;
+    // Prunes the segments opened later by the join runtime filters arrived after the reader is opened.
+    RuntimeRangePruner* runtime_range_pruner = nullptr;
 
     RuntimeState* runtime_state = nullptr;
 
@@ -2,9 +2,13 @@
 
 #include "storage/tablet_updates.h"
 
+#include <unistd.h>
+
 #include <ctime>
 #include <memory>
+#include <numeric>
 
+#include "column/fixed_length_column.h"
 #include "common/status.h"
 #include "common/tracer.h"
 #include "gen_cpp/MasterService_types.h"
@@ -20,7 +24,10 @@
 #include "storage/chunk_iterator.h"
 #include "storage/compaction_utils.h"
 #include "storage/del_vector.h"
+#include "storage/delta_column_group.h"
+#include "storage/primary_key_encoder.h"
 #include "storage/rowset/default_value_column_iterator.h"
+#include "storage/rowset/delta_column_iterator.h"
 #include "storage/rowset/rowset_factory.h"
 #include "storage/rowset/rowset_meta_manager.h"
 #include "storage/rowset/rowset_options.h"
@@ -38,6 +45,7 @@
 #include "storage/update_manager.h"
 #include "storage/wrapper_field.h"
 #include "util/defer_op.h"
+#include "util/path_util.h"
 #include "util/pretty_printer.h"
 #include "util/scoped_cleanup.h"
 #include "util/starrocks_metrics.h"
@@ -834,7 +842,7 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
     EditVersion latest_applied_version;
     st = get_latest_applied_version(&latest_applied_version);
     if (st.ok()) {
-        st = state.apply(&_tablet, rowset.get(), rowset_id, latest_applied_version, index);
+        st = state.apply(&_tablet, rowset.get(), rowset_id, latest_applied_version, index, version.major());
     }
     if (!st.ok()) {
         manager->update_state_cache().remove(state_entry);
@@ -851,16 +859,34 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
     // add initial empty delvec for new segments
     PrimaryIndex::DeletesMap new_deletes;
     size_t delete_op = 0;
-    for (uint32_t i = 0; i < rowset->num_segments(); i++) {
-        new_deletes[rowset_id + i] = {};
-    }
     auto& upserts = state.upserts();
-    for (uint32_t i = 0; i < upserts.size(); i++) {
-        if (upserts[i] != nullptr) {
-            index.upsert(rowset_id + i, 0, *upserts[i], &new_deletes);
-            manager->index_cache().update_object_size(index_entry, index.memory_usage());
+    // the updated values of a rowset applied in column mode have been written into the delta column files of the
+    // segments updated, so the rows of the rowset are not added to the index, and the rowset is rewritten into an
+    // empty one when the apply is committed.
+    const uint32_t num_segments = rowset->num_segments();
+    std::unique_ptr<RowsetMetaPB> empty_rowset_meta;
+    if (state.is_column_mode()) {
+        empty_rowset_meta = std::make_unique<RowsetMetaPB>(rowset->rowset_meta()->get_meta_pb());
+        empty_rowset_meta->clear_txn_meta();
+        empty_rowset_meta->set_num_segments(0);
+        empty_rowset_meta->set_num_rows(0);
+        empty_rowset_meta->set_total_disk_size(0);
+        empty_rowset_meta->set_data_disk_size(0);
+        empty_rowset_meta->set_index_disk_size(0);
+        empty_rowset_meta->set_empty(true);
+        empty_rowset_meta->set_applied_to_delta_columns(true);
+    } else {
+        for (uint32_t i = 0; i < rowset->num_segments(); i++) {
+            new_deletes[rowset_id + i] = {};
+        }
+        for (uint32_t i = 0; i < upserts.size(); i++) {
+            if (upserts[i] != nullptr) {
+                index.upsert(rowset_id + i, 0, *upserts[i], &new_deletes);
+                manager->index_cache().update_object_size(index_entry, index.memory_usage());
+            }
         }
     }
+    const auto dcgs = state.delta_column_groups();
 
     for (const auto& one_delete : state.deletes()) {
         delete_op += one_delete->size();
@@ -895,6 +921,38 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
     span->AddEvent("gen_delvec");
     size_t ndelvec = new_deletes.size();
     vector<std::pair<uint32_t, DelVectorPtr>> new_del_vecs(ndelvec);
+    // the delvecs are generated concurrently, then the stats are updated serially
+    vector<PrimaryIndex::DeletesMap::value_type*> delete_entries;
+    delete_entries.reserve(ndelvec);
+    for (auto& new_delete : new_deletes) {
+        delete_entries.emplace_back(&new_delete);
+    }
+    vector<DelVectorPtr> old_del_vecs(ndelvec);
+    st = manager->parallel_apply(ndelvec, [&](size_t i) {
+        uint32_t rssid = delete_entries[i]->first;
+        auto& del_ids = delete_entries[i]->second;
+        new_del_vecs[i].first = rssid;
+        if (rssid >= rowset_id && rssid < rowset_id + rowset->num_segments()) {
+            // it's newly added rowset's segment, do not have latest delvec yet
+            new_del_vecs[i].second = std::make_shared<DelVector>();
+            new_del_vecs[i].second->init(version.major(), del_ids.data(), del_ids.size());
+            return Status::OK();
+        }
+        TabletSegmentId tsid;
+        tsid.tablet_id = tablet_id;
+        tsid.segment_id = rssid;
+        // TODO(cbl): should get the version before this apply version, to be safe
+        RETURN_IF_ERROR(manager->get_latest_del_vec(_tablet.data_dir()->get_meta(), tsid, &old_del_vecs[i]));
+        old_del_vecs[i]->add_dels_as_new_version(del_ids, version.major(), &(new_del_vecs[i].second));
+        return Status::OK();
+    });
+    if (!st.ok()) {
+        std::string msg = Substitute("_apply_rowset_commit error: get_latest_del_vec failed: $0 $1", st.to_string(),
+                                     debug_string());
+        LOG(ERROR) << msg;
+        _set_error(msg);
+        return;
+    }
     size_t idx = 0;
     size_t old_total_del = 0;
     size_t new_del = 0;
@@ -902,33 +960,16 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
     string delvec_change_info;
     for (auto& new_delete : new_deletes) {
         uint32_t rssid = new_delete.first;
-        if (rssid >= rowset_id && rssid < rowset_id + rowset->num_segments()) {
-            // it's newly added rowset's segment, do not have latest delvec yet
-            new_del_vecs[idx].first = rssid;
-            new_del_vecs[idx].second = std::make_shared<DelVector>();
+        DCHECK_EQ(rssid, new_del_vecs[idx].first);
+        auto& old_del_vec = old_del_vecs[idx];
+        if (old_del_vec == nullptr) {
             auto& del_ids = new_delete.second;
-            new_del_vecs[idx].second->init(version.major(), del_ids.data(), del_ids.size());
             if (VLOG_IS_ON(1)) {
                 StringAppendF(&delvec_change_info, " %u:+%zu", rssid, del_ids.size());
             }
             new_del += del_ids.size();
             total_del += del_ids.size();
         } else {
-            TabletSegmentId tsid;
-            tsid.tablet_id = tablet_id;
-            tsid.segment_id = rssid;
-            DelVectorPtr old_del_vec;
-            // TODO(cbl): should get the version before this apply version, to be safe
-            st = manager->get_latest_del_vec(_tablet.data_dir()->get_meta(), tsid, &old_del_vec);
-            if (!st.ok()) {
-                std::string msg = Substitute("_apply_rowset_commit error: get_latest_del_vec failed: $0 $1",
-                                             st.to_string(), debug_string());
-                LOG(ERROR) << msg;
-                _set_error(msg);
-                return;
-            }
-            new_del_vecs[idx].first = rssid;
-            old_del_vec->add_dels_as_new_version(new_delete.second, version.major(), &(new_del_vecs[idx].second));
             size_t cur_old = old_del_vec->cardinality();
             size_t cur_add = new_delete.second.size();
             size_t cur_new = new_del_vecs[idx].second->cardinality();
@@ -983,7 +1024,8 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
         }
         // 4. write meta
         st = TabletMetaManager::apply_rowset_commit(_tablet.data_dir(), tablet_id, _next_log_id, version, new_del_vecs,
-                                                    index_meta, enable_persistent_index);
+                                                    index_meta, enable_persistent_index, dcgs,
+                                                    empty_rowset_meta.get());
         if (!st.ok()) {
             std::string msg = Substitute("_apply_rowset_commit error: write meta failed: $0 $1", st.to_string(),
                                          _debug_string(false));
@@ -998,6 +1040,25 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
             tsid.segment_id = delvec_pair.first;
             manager->set_cached_del_vec(tsid, delvec_pair.second);
         }
+        for (const auto& [rssid, dcg] : dcgs) {
+            tsid.segment_id = rssid;
+            manager->set_cached_delta_column_group(tsid, dcg);
+        }
+        if (empty_rowset_meta != nullptr) {
+            rowset->rowset_meta()->init_from_pb(*empty_rowset_meta);
+            st = rowset->reload();
+            if (!st.ok()) {
+                std::string msg = Substitute("_apply_rowset_commit error: reload rowset failed: $0 $1",
+                                             st.to_string(), _debug_string(false));
+                LOG(ERROR) << msg;
+                _set_error(msg);
+                return;
+            }
+            auto stats = std::make_unique<RowsetStats>();
+            _calc_compaction_score(stats.get());
+            std::lock_guard lg(_rowset_stats_lock);
+            _rowset_stats[rowset_id] = std::move(stats);
+        }
         // 5. apply memory
         _next_log_id++;
         _apply_version_idx++;
@@ -1021,6 +1082,13 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
         manager->index_cache().release(index_entry);
     }
     _update_total_stats(version_info.rowsets, nullptr, nullptr);
+    if (empty_rowset_meta != nullptr) {
+        // the segment files are not referenced by the rowset any more
+        for (uint32_t i = 0; i < num_segments; i++) {
+            auto path = Rowset::segment_file_path(_tablet.schema_hash_path(), rowset->rowset_id(), i);
+            WARN_IF_ERROR(FileSystem::Default()->delete_file(path), "fail to delete partial segment file " + path);
+        }
+    }
     int64_t t_write = MonotonicMillis();
 
     size_t del_percent = _cur_total_rows == 0 ? 0 : (_cur_total_dels * 100) / _cur_total_rows;
@@ -1353,6 +1421,16 @@ void TabletUpdates::_apply_compaction_commit(const EditVersionInfo& version_info
     }
     // release memory
     _compaction_state.reset();
+    vector<std::pair<uint32_t, DeltaColumnGroupPtr>> dcgs;
+    st = _carry_over_delta_column_groups(*info, rowset_id, index, &dcgs);
+    if (!st.ok()) {
+        manager->index_cache().release(index_entry);
+        std::string msg = Substitute("_apply_compaction_commit error: carry over delta column groups failed: $0 $1",
+                                     st.to_string(), debug_string());
+        LOG(ERROR) << msg;
+        _set_error(msg);
+        return;
+    }
     int64_t t_index_delvec = MonotonicMillis();
 
     PersistentIndexMetaPB index_meta;
@@ -1381,7 +1459,7 @@ void TabletUpdates::_apply_compaction_commit(const EditVersionInfo& version_info
         }
         // 3. write meta
         st = TabletMetaManager::apply_rowset_commit(_tablet.data_dir(), tablet_id, _next_log_id, version_info.version,
-                                                    delvecs, index_meta, enable_persistent_index);
+                                                    delvecs, index_meta, enable_persistent_index, dcgs);
         if (!st.ok()) {
             manager->index_cache().release(index_entry);
             std::string msg = Substitute("_apply_compaction_commit error: write meta failed: $0 $1", st.to_string(),
@@ -1397,6 +1475,10 @@ void TabletUpdates::_apply_compaction_commit(const EditVersionInfo& version_info
             tsid.segment_id = delvec_pair.first;
             manager->set_cached_del_vec(tsid, delvec_pair.second);
         }
+        for (const auto& [rssid, dcg] : dcgs) {
+            tsid.segment_id = rssid;
+            manager->set_cached_delta_column_group(tsid, dcg);
+        }
         // 5. apply memory
         _next_log_id++;
         _apply_version_idx++;
@@ -1457,6 +1539,121 @@ void TabletUpdates::_apply_compaction_commit(const EditVersionInfo& version_info
     }
 }
 
+Status TabletUpdates::_carry_over_delta_column_groups(const CompactionInfo& info, uint32_t rowset_id,
+                                                     const PrimaryIndex& index,
+                                                     vector<std::pair<uint32_t, DeltaColumnGroupPtr>>* dcgs) {
+    struct OutputGroup {
+        DeltaColumnGroupPtr input_dcg;
+        vector<uint32_t> rowids;
+        vectorized::Columns values;
+        std::unique_ptr<vectorized::Column> pks;
+    };
+    auto manager = StorageEngine::instance()->update_manager();
+    auto meta = _tablet.data_dir()->get_meta();
+    const auto& tablet_schema = _tablet.tablet_schema();
+    auto output_rowset = _get_rowset(rowset_id);
+    const uint32_t num_output_segments = output_rowset->num_segments();
+    vector<uint32_t> pk_columns;
+    for (uint32_t i = 0; i < tablet_schema.num_key_columns(); i++) {
+        pk_columns.push_back(i);
+    }
+    vectorized::Schema pkey_schema = ChunkHelper::convert_schema_to_format_v2(tablet_schema, pk_columns);
+    std::unique_ptr<vectorized::Column> pk_column;
+    RETURN_IF_ERROR(PrimaryKeyEncoder::create_column(pkey_schema, &pk_column));
+    ASSIGN_OR_RETURN(auto fs, FileSystem::CreateSharedFromString(_tablet.schema_hash_path()));
+    // the rows of the output segments updated by the delta column groups, grouped by (version, rssid)
+    std::map<std::pair<int64_t, uint32_t>, OutputGroup> groups;
+    TabletSegmentId tsid;
+    tsid.tablet_id = _tablet.tablet_id();
+    for (uint32_t input : info.inputs) {
+        auto input_rowset = _get_rowset(input);
+        for (uint32_t i = 0; input_rowset != nullptr && i < input_rowset->num_segments(); i++) {
+            tsid.segment_id = input + i;
+            DeltaColumnGroupList input_dcgs;
+            RETURN_IF_ERROR(manager->get_delta_column_groups(meta, tsid, INT64_MAX, &input_dcgs));
+            for (const auto& input_dcg : input_dcgs) {
+                if (input_dcg->version() <= info.start_version.major()) {
+                    // already merged into the output rowset
+                    continue;
+                }
+                auto rowids = vectorized::UInt32Column::create();
+                vectorized::Columns values;
+                std::vector<vectorized::Column*> value_ptrs;
+                for (uint32_t unique_id : input_dcg->column_unique_ids()) {
+                    ColumnId cid = 0;
+                    while (cid < tablet_schema.num_columns() && tablet_schema.column(cid).unique_id() != unique_id) {
+                        cid++;
+                    }
+                    if (cid == tablet_schema.num_columns()) {
+                        return Status::InternalError(Substitute("column $0 of delta column group $1 not found",
+                                                                unique_id, input_dcg->to_string()));
+                    }
+                    auto field = ChunkHelper::convert_field_to_format_v2(cid, tablet_schema.column(cid));
+                    values.emplace_back(ChunkHelper::column_from_field(field));
+                    value_ptrs.emplace_back(values.back().get());
+                }
+                auto pks = pk_column->clone_empty();
+                auto path = path_util::join_path_segments(_tablet.schema_hash_path(), input_dcg->file_name());
+                RETURN_IF_ERROR(DeltaColumnGroup::read_file(fs.get(), path, rowids.get(), value_ptrs, pks.get()));
+                vector<uint64_t> rss_rowids(pks->size());
+                index.get(*pks, &rss_rowids);
+                for (uint32_t j = 0; j < rss_rowids.size(); j++) {
+                    uint32_t rssid = rss_rowids[j] >> 32;
+                    if (rssid < rowset_id || rssid >= rowset_id + num_output_segments) {
+                        // updated or deleted after the delta column group is applied
+                        continue;
+                    }
+                    auto& group = groups[{input_dcg->version(), rssid}];
+                    if (group.input_dcg == nullptr) {
+                        group.input_dcg = input_dcg;
+                        for (const auto& value : values) {
+                            group.values.emplace_back(value->clone_empty());
+                        }
+                        group.pks = pks->clone_empty();
+                    }
+                    group.rowids.push_back(rss_rowids[j] & ROWID_MASK);
+                    for (size_t c = 0; c < values.size(); c++) {
+                        group.values[c]->append(*values[c], j, 1);
+                    }
+                    group.pks->append(*pks, j, 1);
+                }
+            }
+        }
+    }
+    for (auto& [version_rssid, group] : groups) {
+        const auto& [version, rssid] = version_rssid;
+        // the rowids of the delta column file must be in ascending order
+        vector<uint32_t> idxes(group.rowids.size());
+        std::iota(idxes.begin(), idxes.end(), 0);
+        std::sort(idxes.begin(), idxes.end(),
+                  [&](uint32_t a, uint32_t b) { return group.rowids[a] < group.rowids[b]; });
+        auto rowids = vectorized::UInt32Column::create();
+        for (uint32_t idx : idxes) {
+            rowids->append(group.rowids[idx]);
+        }
+        vectorized::Columns values;
+        std::vector<const vectorized::Column*> value_ptrs;
+        for (const auto& value : group.values) {
+            values.emplace_back(value->clone_empty());
+            values.back()->append_selective(*value, idxes.data(), 0, idxes.size());
+            value_ptrs.emplace_back(values.back().get());
+        }
+        auto pks = group.pks->clone_empty();
+        pks->append_selective(*group.pks, idxes.data(), 0, idxes.size());
+        auto file_name = DeltaColumnGroup::gen_file_name(output_rowset->rowset_id(), rssid - rowset_id, version);
+        RETURN_IF_ERROR(DeltaColumnGroup::write_file(
+                fs.get(), path_util::join_path_segments(_tablet.schema_hash_path(), file_name), *rowids, value_ptrs,
+                *pks));
+        dcgs->emplace_back(rssid, std::make_shared<DeltaColumnGroup>(version, group.input_dcg->column_unique_ids(),
+                                                                     file_name, rowids->size()));
+    }
+    if (!dcgs->empty()) {
+        LOG(INFO) << Substitute("carry over delta column groups tablet:$0 rowset:$1 #delta-column-group:$2",
+                                _tablet.tablet_id(), rowset_id, dcgs->size());
+    }
+    return Status::OK();
+}
+
 void TabletUpdates::to_updates_pb(TabletUpdatesPB* updates_pb) const {
     std::lock_guard rl(_lock);
     _to_updates_pb_unlocked(updates_pb);
@@ -2219,8 +2416,36 @@ struct RowsetLoadInfo {
     uint32_t num_segments = 0;
     RowsetMetaPB rowset_meta_pb;
     vector<DelVectorPtr> delvecs;
+    // the delta column groups of each segment
+    vector<DeltaColumnGroupList> dcgs;
 };
 
+Status TabletUpdates::_link_delta_column_groups(const Rowset& src_rowset, const RowsetId& new_rowset_id,
+                                                int64_t version, vector<DeltaColumnGroupList>* dcgs) {
+    auto update_manager = StorageEngine::instance()->update_manager();
+    dcgs->resize(src_rowset.num_segments());
+    for (uint32_t i = 0; i < src_rowset.num_segments(); i++) {
+        TabletSegmentId tsid;
+        tsid.tablet_id = src_rowset.rowset_meta()->tablet_id();
+        tsid.segment_id = src_rowset.rowset_meta()->get_rowset_seg_id() + i;
+        DeltaColumnGroupList src_dcgs;
+        RETURN_IF_ERROR(update_manager->get_delta_column_groups(_tablet.data_dir()->get_meta(), tsid, version,
+                                                                &src_dcgs));
+        for (const auto& src_dcg : src_dcgs) {
+            auto file_name = DeltaColumnGroup::gen_file_name(new_rowset_id, i, src_dcg->version());
+            auto src_path = path_util::join_path_segments(src_rowset.rowset_path(), src_dcg->file_name());
+            auto dst_path = path_util::join_path_segments(_tablet.schema_hash_path(), file_name);
+            if (link(src_path.c_str(), dst_path.c_str()) != 0) {
+                PLOG(WARNING) << "Fail to link " << src_path << " to " << dst_path;
+                return Status::RuntimeError("Fail to link delta column file");
+            }
+            (*dcgs)[i].emplace_back(std::make_shared<DeltaColumnGroup>(
+                    src_dcg->version(), src_dcg->column_unique_ids(), std::move(file_name), src_dcg->num_rows()));
+        }
+    }
+    return Status::OK();
+}
+
 Status TabletUpdates::link_from(Tablet* base_tablet, int64_t request_version) {
     OlapStopWatch watch;
     DCHECK(_tablet.tablet_state() == TABLET_NOTREADY)
@@ -2284,6 +2509,7 @@ Status TabletUpdates::link_from(Tablet* base_tablet, int64_t request_version) {
                 return st;
             }
         }
+        RETURN_IF_ERROR(_link_delta_column_groups(src_rowset, rid, version.major(), &new_rowset_info.dcgs));
         next_rowset_id += std::max(1U, (uint32_t)new_rowset_info.num_segments);
         total_bytes += rowset_meta_pb.total_disk_size();
         total_rows += rowset_meta_pb.num_rows();
@@ -2316,6 +2542,7 @@ Status TabletUpdates::link_from(Tablet* base_tablet, int64_t request_version) {
     RETURN_IF_ERROR(TabletMetaManager::clear_log(data_dir, &wb, tablet_id));
     RETURN_IF_ERROR(TabletMetaManager::clear_rowset(data_dir, &wb, tablet_id));
     RETURN_IF_ERROR(TabletMetaManager::clear_del_vector(data_dir, &wb, tablet_id));
+    RETURN_IF_ERROR(TabletMetaManager::clear_delta_column_group(data_dir, &wb, tablet_id));
     RETURN_IF_ERROR(TabletMetaManager::clear_persistent_index(data_dir, &wb, tablet_id));
     // do not clear pending rowsets, because these pending rowsets should be committed after schemachange is done
     RETURN_IF_ERROR(TabletMetaManager::put_tablet_meta(data_dir, &wb, meta_pb));
@@ -2324,6 +2551,10 @@ Status TabletUpdates::link_from(Tablet* base_tablet, int64_t request_version) {
         for (int j = 0; j < info.num_segments; j++) {
             RETURN_IF_ERROR(
                     TabletMetaManager::put_del_vector(data_dir, &wb, tablet_id, info.rowset_id + j, *info.delvecs[j]));
+            for (const auto& dcg : info.dcgs[j]) {
+                RETURN_IF_ERROR(
+                        TabletMetaManager::put_delta_column_group(data_dir, &wb, tablet_id, info.rowset_id + j, *dcg));
+            }
         }
     }
 
@@ -2476,6 +2707,7 @@ Status TabletUpdates::convert_from(const std::shared_ptr<Tablet>& base_tablet, i
     RETURN_IF_ERROR(TabletMetaManager::clear_log(data_dir, &wb, tablet_id));
     RETURN_IF_ERROR(TabletMetaManager::clear_rowset(data_dir, &wb, tablet_id));
     RETURN_IF_ERROR(TabletMetaManager::clear_del_vector(data_dir, &wb, tablet_id));
+    RETURN_IF_ERROR(TabletMetaManager::clear_delta_column_group(data_dir, &wb, tablet_id));
     RETURN_IF_ERROR(TabletMetaManager::clear_persistent_index(data_dir, &wb, tablet_id));
     // do not clear pending rowsets, because these pending rowsets should be committed after schemachange is done
     RETURN_IF_ERROR(TabletMetaManager::put_tablet_meta(data_dir, &wb, meta_pb));
@@ -2574,7 +2806,22 @@ void TabletUpdates::_remove_unused_rowsets() {
             continue;
         }
 
-        _clear_rowset_del_vec_cache(*rowset);
+        _clear_rowset_segment_cache(*rowset);
+
+        // the delta column files are named after the rowset, the ones missed here are removed by path gc
+        std::vector<std::string> delta_column_files;
+        for (uint32_t i = 0; i < rowset->num_segments(); i++) {
+            DeltaColumnGroupList dcgs;
+            auto st = TabletMetaManager::get_delta_column_groups(_tablet.data_dir()->get_meta(), _tablet.tablet_id(),
+                                                                 rowset->rowset_meta()->get_rowset_seg_id() + i,
+                                                                 INT64_MAX, &dcgs);
+            LOG_IF(WARNING, !st.ok()) << "Fail to get delta column groups of rowset " << rowset->rowset_id() << ": "
+                                      << st << " tablet:" << _tablet.tablet_id();
+            for (const auto& dcg : dcgs) {
+                delta_column_files.emplace_back(
+                        path_util::join_path_segments(_tablet.schema_hash_path(), dcg->file_name()));
+            }
+        }
 
         Status st =
                 TabletMetaManager::rowset_delete(_tablet.data_dir(), _tablet.tablet_id(),
@@ -2588,6 +2835,9 @@ void TabletUpdates::_remove_unused_rowsets() {
         rowset->close();
         rowset->set_need_delete_file();
         auto ost = rowset->remove();
+        for (const auto& path : delta_column_files) {
+            WARN_IF_ERROR(FileSystem::Default()->delete_file(path), "Fail to delete delta column file " + path);
+        }
         VLOG(1) << "remove rowset " << _tablet.tablet_id() << "@" << rowset->rowset_meta()->get_rowset_seg_id() << "@"
                 << rowset->rowset_id() << ": " << ost << " tablet:" << _tablet.tablet_id();
         removed++;
@@ -2716,6 +2966,15 @@ Status TabletUpdates::load_snapshot(const SnapshotMeta& snapshot_meta) {
         for (const auto& rowset_meta_pb : snapshot_meta.rowset_metas()) {
             RETURN_IF_ERROR(check_rowset_files(rowset_meta_pb));
         }
+        for (const auto& [rssid, dcgs] : snapshot_meta.delta_column_groups()) {
+            for (const auto& dcg : dcgs) {
+                auto path = path_util::join_path_segments(_tablet.schema_hash_path(), dcg->file_name());
+                auto st = FileSystem::Default()->path_exists(path);
+                if (!st.ok()) {
+                    return Status::InternalError("delta column file does not exist: " + st.to_string());
+                }
+            }
+        }
         // Stop apply thread.
         _stop_and_wait_apply_done();
 
@@ -2794,6 +3053,12 @@ Status TabletUpdates::load_snapshot(const SnapshotMeta& snapshot_meta) {
             auto id = rssid + _next_rowset_id;
             CHECK_FAIL(TabletMetaManager::put_del_vector(data_store, &wb, tablet_id, id, delvec));
         }
+        for (const auto& [rssid, dcgs] : snapshot_meta.delta_column_groups()) {
+            auto id = rssid + _next_rowset_id;
+            for (const auto& dcg : dcgs) {
+                CHECK_FAIL(TabletMetaManager::put_delta_column_group(data_store, &wb, tablet_id, id, *dcg));
+            }
+        }
         for (const auto& [rid, rowset] : _rowsets) {
             RowsetMetaPB meta_pb = rowset->rowset_meta()->to_rowset_pb();
             CHECK_FAIL(TabletMetaManager::put_rowset_meta(data_store, &wb, tablet_id, meta_pb));
@@ -2845,15 +3110,15 @@ Status TabletUpdates::load_snapshot(const SnapshotMeta& snapshot_meta) {
 #undef CHECK_FAIL
 }
 
-void TabletUpdates::_clear_rowset_del_vec_cache(const Rowset& rowset) {
-    StorageEngine::instance()->update_manager()->clear_cached_del_vec([&]() {
-        std::vector<TabletSegmentId> tsids;
-        tsids.reserve(rowset.num_segments());
-        for (auto i = 0; i < rowset.num_segments(); i++) {
-            tsids.emplace_back(TabletSegmentId{_tablet.tablet_id(), rowset.rowset_meta()->get_rowset_seg_id() + i});
-        }
-        return tsids;
-    }());
+void TabletUpdates::_clear_rowset_segment_cache(const Rowset& rowset) {
+    std::vector<TabletSegmentId> tsids;
+    tsids.reserve(rowset.num_segments());
+    for (auto i = 0; i < rowset.num_segments(); i++) {
+        tsids.emplace_back(TabletSegmentId{_tablet.tablet_id(), rowset.rowset_meta()->get_rowset_seg_id() + i});
+    }
+    auto manager = StorageEngine::instance()->update_manager();
+    manager->clear_cached_del_vec(tsids);
+    manager->clear_cached_delta_column_groups(tsids);
 }
 
 Status TabletUpdates::clear_meta() {
@@ -2876,6 +3141,7 @@ Status TabletUpdates::clear_meta() {
     TabletMetaManager::clear_pending_rowset(data_store, &wb, _tablet.tablet_id());
     TabletMetaManager::clear_rowset(data_store, &wb, _tablet.tablet_id());
     TabletMetaManager::clear_del_vector(data_store, &wb, _tablet.tablet_id());
+    TabletMetaManager::clear_delta_column_group(data_store, &wb, _tablet.tablet_id());
     TabletMetaManager::clear_log(data_store, &wb, _tablet.tablet_id());
     TabletMetaManager::clear_persistent_index(data_store, &wb, _tablet.tablet_id());
     TabletMetaManager::remove_tablet_meta(data_store, &wb, _tablet.tablet_id(), _tablet.schema_hash());
@@ -2883,7 +3149,7 @@ Status TabletUpdates::clear_meta() {
 
     // Clear cached delete vectors.
     for (auto& [id, rowset] : _rowsets) {
-        _clear_rowset_del_vec_cache(*rowset);
+        _clear_rowset_segment_cache(*rowset);
     }
     // Clear cached primary index.
     StorageEngine::instance()->update_manager()->index_cache().remove_by_key(_tablet.tablet_id());
@@ -2972,6 +3238,18 @@ Status TabletUpdates::get_column_values(std::vector<uint32_t>& column_ids, bool
         if ((*segment)->num_rows() == 0) {
             continue;
         }
+        // read the latest values, including the ones updated by column-mode partial updates
+        TabletSegmentId tsid;
+        tsid.tablet_id = _tablet.tablet_id();
+        tsid.segment_id = rssid;
+        DeltaColumnGroupList dcgs;
+        RETURN_IF_ERROR(StorageEngine::instance()->update_manager()->get_delta_column_groups(
+                _tablet.data_dir()->get_meta(), tsid, INT64_MAX, &dcgs));
+        std::unique_ptr<DeltaColumnReader> delta_column_reader;
+        if (!dcgs.empty()) {
+            delta_column_reader = std::make_unique<DeltaColumnReader>(fs.get(), rowset->rowset_path(),
+                                                                      &rowset->schema(), std::move(dcgs));
+        }
         ColumnIteratorOptions iter_opts;
         OlapReaderStatistics stats;
         iter_opts.stats = &stats;
@@ -2981,6 +3259,10 @@ Status TabletUpdates::get_column_values(std::vector<uint32_t>& column_ids, bool
             ColumnIterator* col_iter_raw_ptr = nullptr;
             RETURN_IF_ERROR((*segment)->new_column_iterator(column_ids[i], &col_iter_raw_ptr));
             std::unique_ptr<ColumnIterator> col_iter(col_iter_raw_ptr);
+            if (delta_column_reader != nullptr && delta_column_reader->is_updated(column_ids[i])) {
+                ASSIGN_OR_RETURN(col_iter, delta_column_reader->new_iterator(column_ids[i], (*segment)->num_rows(),
+                                                                             std::move(col_iter)));
+            }
             RETURN_IF_ERROR(col_iter->init(iter_opts));
             RETURN_IF_ERROR(col_iter->fetch_values_by_rowid(rowids.data(), rowids.size(), (*columns)[i].get()));
         }
@@ -2988,6 +3270,19 @@ Status TabletUpdates::get_column_values(std::vector<uint32_t>& column_ids, bool
     return Status::OK();
 }
 
+Status TabletUpdates::get_rowset_and_segment_idx_by_rssid(uint32_t rssid, RowsetSharedPtr* rowset,
+                                                          uint32_t* segment_idx) {
+    std::lock_guard<std::mutex> l(_rowsets_lock);
+    for (const auto& [rowset_id, rs] : _rowsets) {
+        if (rowset_id <= rssid && rssid < rowset_id + rs->num_segments()) {
+            *rowset = rs;
+            *segment_idx = rssid - rowset_id;
+            return Status::OK();
+        }
+    }
+    return Status::NotFound(Substitute("rowset of rssid $0 not found tablet:$1", rssid, _tablet.tablet_id()));
+}
+
 Status TabletUpdates::prepare_partial_update_states(Tablet* tablet, const std::vector<ColumnUniquePtr>& upserts,
                                                     EditVersion* read_version, uint32_t* next_rowset_id,
                                                     std::vector<std::vector<uint64_t>*>* rss_rowids) {
@@ -3122,7 +3417,16 @@ Status TabletUpdates::get_rowsets_for_incremental_snapshot(const std::vector<int
         std::lock_guard lg2(_rowsets_lock);
         for (auto rid : rowsetids) {
             auto itr = _rowsets.find(rid);
-            if (itr != _rowsets.end()) {
+            if (itr != _rowsets.end() && itr->second->rowset_meta()->applied_to_delta_columns()) {
+                // the values of the rowset live in the delta column files of other rowsets, which are
+                // only shipped by full snapshot
+                LOG(INFO) << strings::Substitute(
+                        "get_rowsets_for_incremental_snapshot: rowset applied to delta columns tablet:$0 "
+                        "rowsetid:$1, switch to full snapshot",
+                        _tablet.tablet_id(), rid);
+                rowsets.clear();
+                return Status::OK();
+            } else if (itr != _rowsets.end()) {
                 rowsets.push_back(itr->second);
             } else {
                 LOG(ERROR) << strings::Substitute(
@@ -10,6 +10,7 @@
 
 #include "common/statusor.h"
 #include "gen_cpp/olap_file.pb.h"
+#include "storage/delta_column_group.h"
 #include "storage/edit_version.h"
 #include "storage/olap_common.h"
 #include "storage/rowset/rowset_writer.h"
@@ -224,6 +225,9 @@ public:
                                          EditVersion* read_version, uint32_t* next_rowset_id,
                                          std::vector<std::vector<uint64_t>*>* rss_rowids);
 
+    // get the rowset of the segment |rssid| and the index of the segment in the rowset
+    Status get_rowset_and_segment_idx_by_rssid(uint32_t rssid, RowsetSharedPtr* rowset, uint32_t* segment_idx);
+
     Status get_missing_version_ranges(std::vector<int64_t>& missing_version_ranges);
 
     Status get_rowsets_for_incremental_snapshot(const std::vector<int64_t>& missing_version_ranges,
@@ -281,6 +285,15 @@ private:
 
     void _apply_compaction_commit(const EditVersionInfo& version_info);
 
+    // Link the delta column files of |src_rowset| at |version| to the rowset |new_rowset_id| of this tablet.
+    Status _link_delta_column_groups(const Rowset& src_rowset, const RowsetId& new_rowset_id, int64_t version,
+                                     std::vector<DeltaColumnGroupList>* dcgs);
+
+    // Carry the delta column groups of the input segments of a compaction which are applied after the compaction
+    // started, so not merged into the output rowset |rowset_id|, over to the output segments.
+    Status _carry_over_delta_column_groups(const CompactionInfo& info, uint32_t rowset_id, const PrimaryIndex& index,
+                                           std::vector<std::pair<uint32_t, DeltaColumnGroupPtr>>* dcgs);
+
     RowsetSharedPtr _get_rowset(uint32_t rowset_id);
 
     // wait a version to be applied, so reader can read this version
@@ -325,7 +338,7 @@ private:
     // REQUIRE: |_lock| is held.
     void _to_updates_pb_unlocked(TabletUpdatesPB* updates_pb) const;
 
-    void _clear_rowset_del_vec_cache(const Rowset& rowset);
+    void _clear_rowset_segment_cache(const Rowset& rowset);
 
     void _update_total_stats(const std::vector<uint32_t>& rowsets, size_t* row_count_before, size_t* row_count_after);
 
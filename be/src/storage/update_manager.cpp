@@ -6,13 +6,16 @@
 #include <memory>
 #include <numeric>
 
+#include "common/config.h"
 #include "gutil/endian.h"
+#include "runtime/current_thread.h"
 #include "storage/chunk_helper.h"
 #include "storage/del_vector.h"
 #include "storage/kv_store.h"
 #include "storage/rowset_update_state.h"
 #include "storage/tablet.h"
 #include "storage/tablet_meta_manager.h"
+#include "util/cpu_info.h"
 #include "util/pretty_printer.h"
 #include "util/starrocks_metrics.h"
 #include "util/time.h"
@@ -38,6 +41,9 @@ UpdateManager::~UpdateManager() {
         // should be shutdown.
         _apply_thread_pool->shutdown();
     }
+    if (_apply_worker_thread_pool != nullptr) {
+        _apply_worker_thread_pool->shutdown();
+    }
     clear_cache();
     if (_compaction_state_mem_tracker) {
         _compaction_state_mem_tracker.reset();
@@ -54,8 +60,45 @@ UpdateManager::~UpdateManager() {
 }
 
 Status UpdateManager::init() {
-    auto st = ThreadPoolBuilder("update_apply").build(&_apply_thread_pool);
-    return st;
+    RETURN_IF_ERROR(ThreadPoolBuilder("update_apply").build(&_apply_thread_pool));
+    int32_t worker_thread_num = config::update_apply_worker_thread_num;
+    if (worker_thread_num <= 0) {
+        worker_thread_num = CpuInfo::num_cores();
+    }
+    return ThreadPoolBuilder("update_apply_worker")
+            .set_min_threads(1)
+            .set_max_threads(std::max(1, worker_thread_num))
+            .build(&_apply_worker_thread_pool);
+}
+
+Status UpdateManager::parallel_apply(size_t num_tasks, const std::function<Status(size_t)>& task) {
+    if (num_tasks <= 1 || _apply_worker_thread_pool == nullptr || !config::enable_parallel_update_apply) {
+        for (size_t i = 0; i < num_tasks; i++) {
+            RETURN_IF_ERROR(task(i));
+        }
+        return Status::OK();
+    }
+    std::vector<Status> statuses(num_tasks);
+    auto* mem_tracker = CurrentThread::mem_tracker();
+    auto token = _apply_worker_thread_pool->new_token(ThreadPool::ExecutionMode::CONCURRENT);
+    // the first task is run by the calling thread, which is going to wait anyway
+    for (size_t i = 1; i < num_tasks; i++) {
+        auto st = token->submit_func([&, i]() {
+            SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(mem_tracker);
+            SCOPED_THREAD_LOCAL_CHECK_MEM_LIMIT_SETTER(false);
+            statuses[i] = task(i);
+        });
+        if (!st.ok()) {
+            // the pool is shutting down, run it in place
+            statuses[i] = task(i);
+        }
+    }
+    statuses[0] = task(0);
+    token->wait();
+    for (auto& st : statuses) {
+        RETURN_IF_ERROR(st);
+    }
+    return Status::OK();
 }
 
 Status UpdateManager::get_del_vec_in_meta(KVStore* meta, const TabletSegmentId& tsid, int64_t version,
@@ -122,6 +165,10 @@ void UpdateManager::clear_cache() {
         StarRocksMetrics::instance()->update_del_vector_num.set_value(0);
         StarRocksMetrics::instance()->update_del_vector_bytes_total.set_value(0);
     }
+    {
+        std::lock_guard<std::mutex> lg(_delta_column_group_cache_lock);
+        _delta_column_group_cache.clear();
+    }
 }
 
 void UpdateManager::clear_cached_del_vec(const std::vector<TabletSegmentId>& tsids) {
@@ -135,6 +182,13 @@ void UpdateManager::clear_cached_del_vec(const std::vector<TabletSegmentId>& tsi
     }
 }
 
+void UpdateManager::clear_cached_delta_column_groups(const std::vector<TabletSegmentId>& tsids) {
+    std::lock_guard<std::mutex> lg(_delta_column_group_cache_lock);
+    for (const auto& tsid : tsids) {
+        _delta_column_group_cache.erase(tsid);
+    }
+}
+
 void UpdateManager::expire_cache() {
     StarRocksMetrics::instance()->update_primary_index_num.set_value(_index_cache.object_size());
     StarRocksMetrics::instance()->update_primary_index_bytes_total.set_value(_index_cache.size());
@@ -245,6 +299,40 @@ Status UpdateManager::set_cached_del_vec(const TabletSegmentId& tsid, const DelV
     return Status::OK();
 }
 
+Status UpdateManager::get_delta_column_groups(KVStore* meta, const TabletSegmentId& tsid, int64_t version,
+                                              DeltaColumnGroupList* dcgs) {
+    // the meta is read with the lock held, so that a concurrent set_cached_delta_column_group
+    // either sees the loaded entry or its dcg is already in the meta.
+    std::lock_guard<std::mutex> lg(_delta_column_group_cache_lock);
+    auto itr = _delta_column_group_cache.find(tsid);
+    if (itr == _delta_column_group_cache.end()) {
+        DeltaColumnGroupList all;
+        RETURN_IF_ERROR(
+                TabletMetaManager::get_delta_column_groups(meta, tsid.tablet_id, tsid.segment_id, INT64_MAX, &all));
+        itr = _delta_column_group_cache.emplace(tsid, std::move(all)).first;
+    }
+    for (const auto& dcg : itr->second) {
+        if (dcg->version() > version) {
+            break;
+        }
+        dcgs->emplace_back(dcg);
+    }
+    return Status::OK();
+}
+
+void UpdateManager::set_cached_delta_column_group(const TabletSegmentId& tsid, const DeltaColumnGroupPtr& dcg) {
+    std::lock_guard<std::mutex> lg(_delta_column_group_cache_lock);
+    auto itr = _delta_column_group_cache.find(tsid);
+    if (itr == _delta_column_group_cache.end()) {
+        // will be loaded from the meta on the next read
+        return;
+    }
+    auto& dcgs = itr->second;
+    if (dcgs.empty() || dcgs.back()->version() < dcg->version()) {
+        dcgs.emplace_back(dcg);
+    }
+}
+
 Status UpdateManager::on_rowset_finished(Tablet* tablet, Rowset* rowset) {
     if (!rowset->has_data_files() || tablet->tablet_state() == TABLET_NOTREADY) {
         // if rowset is empty or tablet is in schemachange, we can skip preparing updatestates and pre-loading primary index
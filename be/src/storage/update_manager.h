@@ -2,9 +2,11 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
 #include <unordered_map>
 
+#include "storage/delta_column_group.h"
 #include "storage/olap_common.h"
 #include "storage/primary_index.h"
 #include "util/dynamic_cache.h"
@@ -22,8 +24,8 @@ class RowsetUpdateState;
 class Tablet;
 
 // UpdateManager maintain update feature related data structures, including
-// PrimaryIndexe cache, RowsetUpdateState cache, DelVector cache and
-// async apply thread pool.
+// PrimaryIndexe cache, RowsetUpdateState cache, DelVector cache, DeltaColumnGroup cache
+// and async apply thread pool.
 class UpdateManager {
 public:
     UpdateManager(MemTracker* mem_tracker);
@@ -46,12 +48,27 @@ public:
 
     Status set_cached_del_vec(const TabletSegmentId& tsid, const DelVectorPtr& delvec);
 
+    // Get the delta column groups of segment |tsid| whose version is not greater than |version|,
+    // sorted by version in ascending order.
+    Status get_delta_column_groups(KVStore* meta, const TabletSegmentId& tsid, int64_t version,
+                                   DeltaColumnGroupList* dcgs);
+
+    // Add the newly applied |dcg| to the cache, should be called after it's written to the meta.
+    void set_cached_delta_column_group(const TabletSegmentId& tsid, const DeltaColumnGroupPtr& dcg);
+
     Status on_rowset_finished(Tablet* tablet, Rowset* rowset);
 
     void on_rowset_cancel(Tablet* tablet, Rowset* rowset);
 
     ThreadPool* apply_thread_pool() { return _apply_thread_pool.get(); }
 
+    ThreadPool* apply_worker_thread_pool() { return _apply_worker_thread_pool.get(); }
+
+    // Run |task| with each index in [0, num_tasks) concurrently in the apply worker thread pool and the calling
+    // thread, and wait for all of them to finish. The tasks are run serially in the calling thread if the
+    // parallel apply is disabled. Returns the first error of the tasks.
+    Status parallel_apply(size_t num_tasks, const std::function<Status(size_t)>& task);
+
     DynamicCache<uint64_t, PrimaryIndex>& index_cache() { return _index_cache; }
 
     DynamicCache<string, RowsetUpdateState>& update_state_cache() { return _update_state_cache; }
@@ -62,6 +79,8 @@ public:
 
     void clear_cached_del_vec(const std::vector<TabletSegmentId>& tsids);
 
+    void clear_cached_delta_column_groups(const std::vector<TabletSegmentId>& tsids);
+
     void expire_cache();
 
     MemTracker* mem_tracker() const { return _update_mem_tracker; }
@@ -93,7 +112,15 @@ private:
     std::unordered_map<TabletSegmentId, DelVectorPtr> _del_vec_cache;
     std::unique_ptr<MemTracker> _del_vec_cache_mem_tracker;
 
+    // DeltaColumnGroup related states, all the delta column groups of a segment are cached,
+    // an empty list is cached for the segments without delta column groups.
+    std::mutex _delta_column_group_cache_lock;
+    std::unordered_map<TabletSegmentId, DeltaColumnGroupList> _delta_column_group_cache;
+
     std::unique_ptr<ThreadPool> _apply_thread_pool;
+    // used to apply a single rowset with multiple threads, which is separated from _apply_thread_pool so that
+    // the apply tasks waiting for their sub tasks never occupy the threads the sub tasks need
+    std::unique_ptr<ThreadPool> _apply_worker_thread_pool;
 
     UpdateManager(const UpdateManager&) = delete;
     const UpdateManager& operator=(const UpdateManager&) = delete;
@@ -2,9 +2,13 @@
 
 #include "util/buffered_stream.h"
 
+#include <limits>
+
 #include "common/config.h"
+#include "common/logging.h"
 #include "fs/fs.h"
 #include "util/bit_util.h"
+#include "util/threadpool.h"
 
 namespace starrocks {
 
@@ -75,6 +79,19 @@ Status DefaultBufferedInputStream::get_bytes(const uint8_t** buffer, size_t offs
 
 SharedBufferedInputStream::SharedBufferedInputStream(RandomAccessFile* file) : _file(file) {}
 
+SharedBufferedInputStream::~SharedBufferedInputStream() {
+    // Prefetching tasks read |_file|, which may be destroyed after this stream.
+    release();
+}
+
+void SharedBufferedInputStream::_add_shared_buffer(int64_t offset, int64_t size, int64_t ref_count) {
+    auto sb = std::make_shared<SharedBuffer>();
+    sb->offset = offset;
+    sb->size = size;
+    sb->ref_count = ref_count;
+    _map.insert(std::make_pair(offset + size, std::move(sb)));
+}
+
 Status SharedBufferedInputStream::set_io_ranges(const std::vector<IORange>& ranges) {
     if (ranges.size() == 0) {
         return Status::OK();
@@ -100,8 +117,7 @@ Status SharedBufferedInputStream::set_io_ranges(const std::vector<IORange>& rang
     std::vector<IORange> small_ranges;
     for (const IORange& r : check) {
         if (r.size > _options.max_buffer_size) {
-            SharedBuffer sb = SharedBuffer{.offset = r.offset, .size = r.size, .ref_count = 1};
-            _map.insert(std::make_pair(r.offset + r.size, sb));
+            _add_shared_buffer(r.offset, r.size, 1);
         } else {
             small_ranges.emplace_back(r);
         }
@@ -112,10 +128,7 @@ Status SharedBufferedInputStream::set_io_ranges(const std::vector<IORange>& rang
             // merge from [unmerge, i-1]
             int64_t ref_count = (to - from + 1);
             int64_t end = (small_ranges[to].offset + small_ranges[to].size);
-            SharedBuffer sb = SharedBuffer{.offset = small_ranges[from].offset,
-                                           .size = end - small_ranges[from].offset,
-                                           .ref_count = ref_count};
-            _map.insert(std::make_pair(sb.offset + sb.size, sb));
+            _add_shared_buffer(small_ranges[from].offset, end - small_ranges[from].offset, ref_count);
         };
 
         size_t unmerge = 0;
@@ -134,33 +147,94 @@ Status SharedBufferedInputStream::set_io_ranges(const std::vector<IORange>& rang
         }
         update_map(unmerge, small_ranges.size() - 1);
     }
+    _prefetch();
     return Status::OK();
 }
 
+void SharedBufferedInputStream::_prefetch() {
+    if (_prefetch_pool == nullptr) {
+        return;
+    }
+    for (auto it = _map.upper_bound(_prefetch_end_offset); it != _map.end(); ++it) {
+        SharedBufferPtr sb = it->second;
+        if (!sb->loaded && !sb->prefetch.valid()) {
+            // Always allow one buffer in flight, even if it's larger than the limit.
+            if (_prefetch_bytes > 0 && _prefetch_bytes + sb->size > _max_prefetch_bytes) {
+                break;
+            }
+            auto task = std::make_shared<std::packaged_task<Status()>>([file = _file, sb]() {
+                sb->buffer.reserve(sb->size);
+                return file->pread_fully(sb->offset, sb->buffer.data(), sb->size);
+            });
+            auto future = task->get_future();
+            if (!_prefetch_pool->submit_func([task]() { (*task)(); }).ok()) {
+                // The pool is busy or shutting down, the buffer will be read synchronously.
+                break;
+            }
+            sb->prefetch = std::move(future);
+            _prefetch_bytes += sb->size;
+            _prefetch_count++;
+        }
+        _prefetch_end_offset = it->first;
+    }
+}
+
+Status SharedBufferedInputStream::_wait_prefetch(SharedBuffer* sb) {
+    Status st;
+    try {
+        st = sb->prefetch.get();
+    } catch (const std::future_error& e) {
+        // The task was dropped by the pool without being run, e.g. the pool is shut down.
+        st = Status::Cancelled(std::string("prefetch task is dropped: ") + e.what());
+    }
+    _prefetch_bytes -= sb->size;
+    sb->loaded = st.ok();
+    if (st.is_not_supported()) {
+        // The file cannot be read concurrently.
+        _prefetch_pool = nullptr;
+        return Status::OK();
+    }
+    return st;
+}
+
 Status SharedBufferedInputStream::get_bytes(const uint8_t** buffer, size_t offset, size_t* nbytes, bool peek) {
     auto iter = _map.upper_bound(offset);
     if (iter == _map.end()) {
         return Status::RuntimeError("failed to find shared buffer based on offset");
     }
-    SharedBuffer& sb = iter->second;
+    SharedBuffer& sb = *iter->second;
     if ((sb.offset > offset) || (sb.offset + sb.size) < (offset + *nbytes)) {
         return Status::RuntimeError("bad construction of shared buffer");
     }
-    if (sb.buffer.capacity() == 0) {
+    if (sb.prefetch.valid()) {
+        // Fall back to read synchronously if prefetching failed.
+        WARN_IF_ERROR(_wait_prefetch(&sb), "fail to prefetch shared buffer");
+        // One buffer is consumed, fetch more in the background.
+        _prefetch();
+    }
+    if (!sb.loaded) {
         sb.buffer.reserve(sb.size);
         RETURN_IF_ERROR(_file->read_at_fully(sb.offset, sb.buffer.data(), sb.size));
+        sb.loaded = true;
     }
     *buffer = sb.buffer.data() + offset - sb.offset;
     return Status::OK();
 }
 
 void SharedBufferedInputStream::release() {
-    _map.clear();
+    release_to_offset(std::numeric_limits<int64_t>::max());
+    _prefetch_end_offset = 0;
 }
 
 void SharedBufferedInputStream::release_to_offset(int64_t offset) {
     auto it = _map.upper_bound(offset);
+    for (auto iter = _map.begin(); iter != it; ++iter) {
+        if (iter->second->prefetch.valid()) {
+            WARN_IF_ERROR(_wait_prefetch(iter->second.get()), "fail to prefetch shared buffer");
+        }
+    }
     _map.erase(_map.begin(), it);
+    _prefetch();
 }
 
 } // namespace starrocks
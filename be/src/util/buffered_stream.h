@@ -4,13 +4,17 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <future>
+#include <map>
 #include <memory>
+#include <vector>
 
 #include "common/status.h"
 
 namespace starrocks {
 
 class RandomAccessFile;
+class ThreadPool;
 
 class IBufferedInputStream {
 public:
@@ -74,6 +78,15 @@ private:
     uint64_t _file_offset = 0;
 };
 
+// SharedBufferedInputStream reads a set of io ranges which are known in advance, e.g. all the selected
+// column chunks of a parquet row group. Nearby ranges are coalesced into one shared buffer, so that
+// small ranges are read by one larger io.
+//
+// If a prefetch pool is set, the shared buffers are fetched in the background in the order of their
+// offsets, and at most `max_prefetch_bytes` are fetched ahead of the reader. A buffer which has not
+// been prefetched yet when it's read is fetched synchronously.
+// Prefetching reads |file| by `pread_fully()` concurrently with the reader, it's disabled if |file|
+// does not support that.
 class SharedBufferedInputStream : public IBufferedInputStream {
 public:
     struct IORange {
@@ -89,7 +102,7 @@ public:
 
     SharedBufferedInputStream(RandomAccessFile* file);
 
-    ~SharedBufferedInputStream() override = default;
+    ~SharedBufferedInputStream() override;
 
     Status set_io_ranges(const std::vector<IORange>& ranges);
     void release_to_offset(int64_t offset);
@@ -99,6 +112,14 @@ public:
     Status get_bytes(const uint8_t** buffer, size_t offset, size_t* nbytes, bool peek) override;
     void release();
     void set_coalesce_options(const CoalesceOptions& options) { _options = options; }
+    // Must be called before `set_io_ranges()`, a null |pool| disables prefetching.
+    void set_prefetch_options(ThreadPool* pool, int64_t max_prefetch_bytes) {
+        _prefetch_pool = pool;
+        _max_prefetch_bytes = max_prefetch_bytes;
+    }
+
+    // Number of shared buffers which are fetched in the background.
+    int64_t prefetch_count() const { return _prefetch_count; }
 
 private:
     struct SharedBuffer {
@@ -107,10 +128,29 @@ private:
         int64_t size;
         int64_t ref_count;
         std::vector<uint8_t> buffer;
+        bool loaded = false;
+        // Valid while the buffer is being prefetched and not waited by the reader.
+        std::future<Status> prefetch;
     };
+    using SharedBufferPtr = std::shared_ptr<SharedBuffer>;
+
+    void _add_shared_buffer(int64_t offset, int64_t size, int64_t ref_count);
+    // Submit the following shared buffers to the prefetch pool until the prefetch limit is reached.
+    void _prefetch();
+    Status _wait_prefetch(SharedBuffer* sb);
+
     RandomAccessFile* _file;
-    std::map<int64_t, SharedBuffer> _map;
+    // shared buffers keyed by their end offsets.
+    std::map<int64_t, SharedBufferPtr> _map;
     CoalesceOptions _options;
+
+    ThreadPool* _prefetch_pool = nullptr;
+    int64_t _max_prefetch_bytes = 0;
+    // Bytes of the buffers which are being prefetched or prefetched but not read yet.
+    int64_t _prefetch_bytes = 0;
+    // End offset of the last shared buffer checked by `_prefetch()`.
+    int64_t _prefetch_end_offset = 0;
+    int64_t _prefetch_count = 0;
 };
 
 } // namespace starrocks
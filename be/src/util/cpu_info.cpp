@@ -40,6 +40,7 @@
 
 #include <algorithm>
 #include <boost/algorithm/string.hpp>
+#include <cerrno>
 #include <cstdlib>
 #include <cstring>
 #include <filesystem>
@@ -307,6 +308,30 @@ int CpuInfo::get_current_core() {
 #endif
 }
 
+int CpuInfo::num_execution_numa_nodes() {
+    return config::enable_numa_aware_execution ? std::max(1, max_num_numa_nodes_) : 1;
+}
+
+bool CpuInfo::bind_current_thread_to_numa_node(int node) {
+#ifdef __linux__
+    if (node < 0 || node >= max_num_numa_nodes_ || numa_node_to_cores_[node].empty()) {
+        return false;
+    }
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (int core : numa_node_to_cores_[node]) {
+        CPU_SET(core, &cpu_set);
+    }
+    if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+        LOG_FIRST_N(WARNING, 5) << "Failed to bind thread to NUMA node " << node << ": " << std::strerror(errno);
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
 void CpuInfo::_get_cache_info(long cache_sizes[NUM_CACHE_LEVELS], long cache_line_sizes[NUM_CACHE_LEVELS]) {
 #ifdef __APPLE__
     // On Mac OS X use sysctl() to get the cache sizes
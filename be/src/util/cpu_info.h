@@ -137,6 +137,15 @@ public:
         return numa_node_core_idx_[core];
     }
 
+    /// Returns the number of NUMA nodes that the execution threads and the free lists of
+    /// ChunkAllocator are partitioned by. It is 1 unless enable_numa_aware_execution is
+    /// set on a machine with multiple NUMA nodes.
+    static int num_execution_numa_nodes();
+
+    /// Binds the current thread to the cores of NUMA node 'node'. Returns false if the
+    /// node has no cores or the affinity cannot be set.
+    static bool bind_current_thread_to_numa_node(int node);
+
     /// Returns the model name of the cpu (e.g. Intel i7-2600)
     static std::string model_name() {
         DCHECK(initialized_);
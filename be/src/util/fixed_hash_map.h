@@ -116,6 +116,9 @@ public:
 
     size_t capacity() { return bucket_count(); }
 
+    // All keys fit in the hash table, it's never rehashed.
+    void reserve(size_t) {}
+
     size_t dump_bound() { return hash_table_size; }
 
 private:
@@ -184,6 +187,9 @@ public:
 
     size_t capacity() { return hash_table_size; }
 
+    // All keys fit in the hash table, it's never rehashed.
+    void reserve(size_t) {}
+
 private:
     size_t _size = 0;
     uint8_t _hash_table[hash_table_size + 1];
@@ -6,6 +6,8 @@
 
 #include <rapidjson/document.h>
 
+#include <strings.h>
+
 #include <cstdio>
 #include <cstdlib>
 #include <sstream>
@@ -59,6 +61,18 @@ uint32_t CacheKey::hash(const char* data, size_t n, uint32_t seed) const {
 
 Cache::~Cache() = default;
 
+bool parse_cache_eviction_policy(std::string_view name, CacheEvictionPolicy* policy) {
+    if (strcasecmp(std::string(name).c_str(), "lru") == 0) {
+        *policy = CacheEvictionPolicy::LRU;
+        return true;
+    }
+    if (strcasecmp(std::string(name).c_str(), "2q") == 0) {
+        *policy = CacheEvictionPolicy::TWO_Q;
+        return true;
+    }
+    return false;
+}
+
 // LRU cache implementation
 LRUHandle* HandleTable::lookup(const CacheKey& key, uint32_t hash) {
     return *_find_pointer(key, hash);
@@ -151,10 +165,15 @@ bool HandleTable::_resize() {
     return true;
 }
 
+// Fraction of the capacity can be used by the protected segment of TWO_Q policy.
+static constexpr double kProtectedRatio = 0.8;
+
 LRUCache::LRUCache() {
     // Make empty circular linked list
     _lru.next = &_lru;
     _lru.prev = &_lru;
+    _protected_lru.next = &_protected_lru;
+    _protected_lru.prev = &_protected_lru;
 }
 
 LRUCache::~LRUCache() {
@@ -194,6 +213,12 @@ Cache::Handle* LRUCache::lookup(const CacheKey& key, uint32_t hash) {
         }
         e->refs++;
         ++_hit_count;
+        if (_policy == CacheEvictionPolicy::TWO_Q && !e->in_protected) {
+            // promote it, it will be put into the protected segment when it's released
+            e->in_protected = true;
+            _protected_usage += e->charge;
+            _demote_if_needed();
+        }
     }
     return reinterpret_cast<Cache::Handle*>(e);
 }
@@ -204,6 +229,7 @@ void LRUCache::release(Cache::Handle* handle) {
     }
     LRUHandle* e = reinterpret_cast<LRUHandle*>(handle);
     bool last_ref = false;
+    bool evicted = false;
     {
         std::lock_guard l(_mutex);
         last_ref = _unref(e);
@@ -215,40 +241,76 @@ void LRUCache::release(Cache::Handle* handle) {
                 // take this opportunity and remove the item
                 _table.remove(e->key(), e->hash);
                 e->in_cache = false;
+                _unprotect(e);
                 _unref(e);
                 _usage -= e->charge;
                 last_ref = true;
+                evicted = true;
             } else {
                 // put it to LRU free list
-                _lru_append(&_lru, e);
+                _lru_append(e->in_protected ? &_protected_lru : &_lru, e);
+                _demote_if_needed();
             }
         }
     }
 
     // free handle out of mutex
+    if (evicted) {
+        _notify_evicted(e);
+    }
     if (last_ref) {
         e->free();
     }
 }
 
+void LRUCache::_notify_evicted(LRUHandle* e) {
+    if (_evict_listener != nullptr) {
+        (*_evict_listener)(e->key(), Slice((char*)e->value, e->charge));
+    }
+}
+
+void LRUCache::_unprotect(LRUHandle* e) {
+    if (e->in_protected) {
+        e->in_protected = false;
+        _protected_usage -= e->charge;
+    }
+}
+
+void LRUCache::_demote_if_needed() {
+    const auto protected_capacity = static_cast<size_t>(_capacity * kProtectedRatio);
+    while (_protected_usage > protected_capacity && _protected_lru.next != &_protected_lru) {
+        LRUHandle* old = _protected_lru.next;
+        _lru_remove(old);
+        _unprotect(old);
+        // give it another chance as the newest probationary entry
+        _lru_append(&_lru, old);
+    }
+}
+
 void LRUCache::_evict_from_lru(size_t charge, std::vector<LRUHandle*>* deleted) {
-    LRUHandle* cur = &_lru;
+    // The probationary segment is evicted before the protected segment.
+    LRUHandle* lists[] = {&_lru, &_protected_lru};
     // 1. evict normal cache entries
-    while (_usage + charge > _capacity && cur->next != &_lru) {
-        LRUHandle* old = cur->next;
-        if (old->priority == CachePriority::DURABLE) {
-            cur = cur->next;
-            continue;
+    for (LRUHandle* list : lists) {
+        LRUHandle* cur = list;
+        while (_usage + charge > _capacity && cur->next != list) {
+            LRUHandle* old = cur->next;
+            if (old->priority == CachePriority::DURABLE) {
+                cur = cur->next;
+                continue;
+            }
+            _evict_one_entry(old);
+            deleted->push_back(old);
         }
-        _evict_one_entry(old);
-        deleted->push_back(old);
     }
     // 2. evict durable cache entries if need
-    while (_usage + charge > _capacity && _lru.next != &_lru) {
-        LRUHandle* old = _lru.next;
-        DCHECK(old->priority == CachePriority::DURABLE);
-        _evict_one_entry(old);
-        deleted->push_back(old);
+    for (LRUHandle* list : lists) {
+        while (_usage + charge > _capacity && list->next != list) {
+            LRUHandle* old = list->next;
+            DCHECK(old->priority == CachePriority::DURABLE);
+            _evict_one_entry(old);
+            deleted->push_back(old);
+        }
     }
 }
 
@@ -258,6 +320,7 @@ void LRUCache::_evict_one_entry(LRUHandle* e) {
     _lru_remove(e);
     _table.remove(e->key(), e->hash);
     e->in_cache = false;
+    _unprotect(e);
     _unref(e);
     _usage -= e->charge;
 }
@@ -273,15 +336,18 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
     e->refs = 2; // one for the returned handle, one for LRUCache.
     e->next = e->prev = nullptr;
     e->in_cache = true;
+    e->in_protected = false;
     e->priority = priority;
     memcpy(e->key_data, key.data(), key.size());
     std::vector<LRUHandle*> last_ref_list;
+    size_t num_evicted = 0;
     {
         std::lock_guard l(_mutex);
 
         // Free the space following strict LRU policy until enough space
         // is freed or the lru list is empty
         _evict_from_lru(charge, &last_ref_list);
+        num_evicted = last_ref_list.size();
 
         // insert into the cache
         // note that the cache might get larger than its capacity if not enough
@@ -290,6 +356,7 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
         _usage += charge;
         if (old != nullptr) {
             old->in_cache = false;
+            _unprotect(old);
             if (_unref(old)) {
                 _usage -= old->charge;
                 // old is on LRU because it's in cache and its reference count
@@ -302,6 +369,9 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
 
     // we free the entries here outside of mutex for
     // performance reasons
+    for (size_t i = 0; i < num_evicted; i++) {
+        _notify_evicted(last_ref_list[i]);
+    }
     for (auto entry : last_ref_list) {
         entry->free();
     }
@@ -325,6 +395,7 @@ void LRUCache::erase(const CacheKey& key, uint32_t hash) {
                 }
             }
             e->in_cache = false;
+            _unprotect(e);
         }
     }
     // free handle out of mutex, when last_ref is true, e must not be nullptr
@@ -337,16 +408,19 @@ int LRUCache::prune() {
     std::vector<LRUHandle*> last_ref_list;
     {
         std::lock_guard l(_mutex);
-        while (_lru.next != &_lru) {
-            LRUHandle* old = _lru.next;
-            DCHECK(old->in_cache);
-            DCHECK(old->refs == 1); // LRU list contains elements which may be evicted
-            _lru_remove(old);
-            _table.remove(old->key(), old->hash);
-            old->in_cache = false;
-            _unref(old);
-            _usage -= old->charge;
-            last_ref_list.push_back(old);
+        for (LRUHandle* list : {&_lru, &_protected_lru}) {
+            while (list->next != list) {
+                LRUHandle* old = list->next;
+                DCHECK(old->in_cache);
+                DCHECK(old->refs == 1); // LRU list contains elements which may be evicted
+                _lru_remove(old);
+                _table.remove(old->key(), old->hash);
+                old->in_cache = false;
+                _unprotect(old);
+                _unref(old);
+                _usage -= old->charge;
+                last_ref_list.push_back(old);
+            }
         }
     }
     for (auto entry : last_ref_list) {
@@ -363,11 +437,12 @@ uint32_t ShardedLRUCache::_shard(uint32_t hash) {
     return hash >> (32 - kNumShardBits);
 }
 
-ShardedLRUCache::ShardedLRUCache(size_t capacity) : _last_id(0) {
+ShardedLRUCache::ShardedLRUCache(size_t capacity, CacheEvictionPolicy policy) : _last_id(0) {
     const size_t per_shard = (capacity + (kNumShards - 1)) / kNumShards;
 
     for (auto& _shard : _shards) {
         _shard.set_capacity(per_shard);
+        _shard.set_eviction_policy(policy);
     }
 }
 
@@ -414,6 +489,13 @@ void ShardedLRUCache::prune() {
     VLOG(7) << "Successfully prune cache, clean " << num_prune << " entries.";
 }
 
+void ShardedLRUCache::set_evict_listener(EvictListener listener) {
+    _evict_listener = std::move(listener);
+    for (auto& shard : _shards) {
+        shard.set_evict_listener(_evict_listener ? &_evict_listener : nullptr);
+    }
+}
+
 size_t ShardedLRUCache::get_memory_usage() {
     size_t total_usage = 0;
     for (const auto& _shard : _shards) {
@@ -422,6 +504,22 @@ size_t ShardedLRUCache::get_memory_usage() {
     return total_usage;
 }
 
+uint64_t ShardedLRUCache::get_lookup_count() {
+    uint64_t total_count = 0;
+    for (const auto& shard : _shards) {
+        total_count += shard.get_lookup_count();
+    }
+    return total_count;
+}
+
+uint64_t ShardedLRUCache::get_hit_count() {
+    uint64_t total_count = 0;
+    for (const auto& shard : _shards) {
+        total_count += shard.get_hit_count();
+    }
+    return total_count;
+}
+
 void ShardedLRUCache::get_cache_status(rapidjson::Document* document) {
     size_t shard_count = sizeof(_shards) / sizeof(LRUCache);
 
@@ -456,8 +554,8 @@ void ShardedLRUCache::get_cache_status(rapidjson::Document* document) {
     }
 }
 
-Cache* new_lru_cache(size_t capacity) {
-    return new ShardedLRUCache(capacity);
+Cache* new_lru_cache(size_t capacity, CacheEvictionPolicy policy) {
+    return new ShardedLRUCache(capacity, policy);
 }
 
 } // namespace starrocks
@@ -8,6 +8,7 @@
 
 #include <cstdint>
 #include <cstring>
+#include <functional>
 #include <mutex>
 #include <string>
 #include <string_view>
@@ -20,9 +21,22 @@ namespace starrocks {
 class Cache;
 class CacheKey;
 
+// The eviction policy of the cache created by new_lru_cache().
+//  LRU:   Evict the least recently used entry.
+//  TWO_Q: A scan resistant variant of 2Q. A new entry is put into the probationary
+//         segment, and is promoted into the protected segment once it's hit. The
+//         protected segment is limited to a fraction of the capacity, the least
+//         recently used protected entries are demoted back to the probationary
+//         segment. Entries are evicted from the probationary segment first, so
+//         entries accessed only once, e.g. by a large scan, can't flush the hot ones.
+enum class CacheEvictionPolicy { LRU = 0, TWO_Q = 1 };
+
+// Parse "lru" or "2q" (case insensitive), return false if |name| is invalid.
+bool parse_cache_eviction_policy(std::string_view name, CacheEvictionPolicy* policy);
+
 // Create a new cache with a fixed size capacity.  This implementation
-// of Cache uses a least-recently-used eviction policy.
-extern Cache* new_lru_cache(size_t capacity);
+// of Cache uses a least-recently-used eviction policy by default.
+extern Cache* new_lru_cache(size_t capacity, CacheEvictionPolicy policy = CacheEvictionPolicy::LRU);
 
 class CacheKey {
 public:
@@ -176,9 +190,20 @@ public:
     // leveldb may change prune() to a pure abstract method.
     virtual void prune() {}
 
+    // Called with the key and value of every entry which is evicted to make room for other
+    // entries, right before the deleter of the entry is called. Entries removed by erase(),
+    // prune() or replaced by insert() are not reported.
+    // REQUIRES: the listener must be set before the cache is used.
+    using EvictListener = std::function<void(const CacheKey& key, const Slice& value)>;
+    virtual void set_evict_listener(EvictListener listener) {}
+
     virtual size_t get_memory_usage() = 0;
     virtual void get_cache_status(rapidjson::Document* document) = 0;
 
+    // Number of lookups and hits since the cache is created.
+    virtual uint64_t get_lookup_count() = 0;
+    virtual uint64_t get_hit_count() = 0;
+
 private:
     Cache(const Cache&) = delete;
     const Cache& operator=(const Cache&) = delete;
@@ -194,7 +219,8 @@ typedef struct LRUHandle {
     LRUHandle* prev;
     size_t charge;
     size_t key_length;
-    bool in_cache; // Whether entry is in the cache.
+    bool in_cache;     // Whether entry is in the cache.
+    bool in_protected; // Whether entry is in the protected segment of TWO_Q policy.
     uint32_t refs;
     uint32_t hash; // Hash of key(); used for fast sharding and comparisons
     CachePriority priority = CachePriority::NORMAL;
@@ -257,6 +283,8 @@ public:
 
     // Separate from constructor so caller can easily make an array of LRUCache
     void set_capacity(size_t capacity) { _capacity = capacity; }
+    void set_eviction_policy(CacheEvictionPolicy policy) { _policy = policy; }
+    void set_evict_listener(const Cache::EvictListener* listener) { _evict_listener = listener; }
 
     // Like Cache methods, but with an extra "hash" parameter.
     Cache::Handle* insert(const CacheKey& key, uint32_t hash, void* value, size_t charge,
@@ -270,6 +298,7 @@ public:
     uint64_t get_lookup_count() const { return _lookup_count; }
     uint64_t get_hit_count() const { return _hit_count; }
     size_t get_usage() const { return _usage; }
+    size_t get_protected_usage() const { return _protected_usage; }
     size_t get_capacity() const { return _capacity; }
 
 private:
@@ -278,19 +307,28 @@ private:
     bool _unref(LRUHandle* e);
     void _evict_from_lru(size_t charge, std::vector<LRUHandle*>* deleted);
     void _evict_one_entry(LRUHandle* e);
+    void _notify_evicted(LRUHandle* e);
+    void _unprotect(LRUHandle* e);
+    void _demote_if_needed();
 
     // Initialized before use.
     size_t _capacity;
+    const Cache::EvictListener* _evict_listener = nullptr;
+    CacheEvictionPolicy _policy = CacheEvictionPolicy::LRU;
 
     // _mutex protects the following state.
     std::mutex _mutex;
     size_t _usage{0};
     uint64_t _last_id{0};
 
-    // Dummy head of LRU list.
+    // Dummy head of LRU list, which is the probationary segment of TWO_Q policy.
     // lru.prev is newest entry, lru.next is oldest entry.
     // Entries have refs==1 and in_cache==true.
     LRUHandle _lru;
+    // Dummy head of the protected segment of TWO_Q policy, always empty for LRU policy.
+    LRUHandle _protected_lru;
+    // Charge of the entries with in_protected==true, including the ones in use.
+    size_t _protected_usage{0};
 
     HandleTable _table;
 
@@ -303,7 +341,7 @@ static const int kNumShards = 1 << kNumShardBits;
 
 class ShardedLRUCache : public Cache {
 public:
-    explicit ShardedLRUCache(size_t capacity);
+    explicit ShardedLRUCache(size_t capacity, CacheEvictionPolicy policy = CacheEvictionPolicy::LRU);
     ~ShardedLRUCache() override = default;
     Handle* insert(const CacheKey& key, void* value, size_t charge, void (*deleter)(const CacheKey& key, void* value),
                    CachePriority priority = CachePriority::NORMAL) override;
@@ -314,13 +352,17 @@ public:
     Slice value_slice(Handle* handle) override;
     uint64_t new_id() override;
     void prune() override;
+    void set_evict_listener(EvictListener listener) override;
     size_t get_memory_usage() override;
     void get_cache_status(rapidjson::Document* document) override;
+    uint64_t get_lookup_count() override;
+    uint64_t get_hit_count() override;
 
 private:
     static uint32_t _hash_slice(const CacheKey& s);
     static uint32_t _shard(uint32_t hash);
 
+    EvictListener _evict_listener;
     LRUCache _shards[kNumShards];
     std::mutex _id_mutex;
     uint64_t _last_id;
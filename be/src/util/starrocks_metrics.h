@@ -218,6 +218,12 @@ public:
     METRIC_DEFINE_UINT_GAUGE(small_file_cache_count, MetricUnit::NOUNIT);
     METRIC_DEFINE_UINT_GAUGE(stream_load_pipe_count, MetricUnit::NOUNIT);
     METRIC_DEFINE_UINT_GAUGE(brpc_endpoint_stub_count, MetricUnit::NOUNIT);
+
+    // Lookups and hits of the caches, used to compare the cache eviction policies
+    METRIC_DEFINE_UINT_GAUGE(storage_page_cache_lookup_count, MetricUnit::OPERATIONS);
+    METRIC_DEFINE_UINT_GAUGE(storage_page_cache_hit_count, MetricUnit::OPERATIONS);
+    METRIC_DEFINE_UINT_GAUGE(lake_metacache_lookup_count, MetricUnit::OPERATIONS);
+    METRIC_DEFINE_UINT_GAUGE(lake_metacache_hit_count, MetricUnit::OPERATIONS);
     METRIC_DEFINE_UINT_GAUGE(tablet_writer_count, MetricUnit::NOUNIT);
 
     static StarRocksMetrics* instance() {
@@ -207,6 +207,8 @@ public:
         return _num_threads + _num_threads_pending_start;
     }
 
+    int max_threads() const { return _max_threads; }
+
     int num_queued_tasks() const {
         std::lock_guard l(_lock);
         return _total_queued_tasks;
@@ -0,0 +1,238 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#include <gtest/gtest.h>
+
+#include <optional>
+
+#include "column/column_helper.h"
+#include "common/config.h"
+#include "exec/pipeline/aggregate/aggregate_blocking_sink_operator.h"
+#include "exec/pipeline/aggregate/aggregate_blocking_source_operator.h"
+#include "fs/fs.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/runtime_state.h"
+#include "testutil/assert.h"
+
+namespace starrocks::pipeline {
+
+// Runs `select k, sum(v), count(*) from t group by k` through AggregateBlockingSinkOperator and
+// AggregateBlockingSourceOperator, with and without spilling the hash map, and compares the results.
+class AggregateBlockingOperatorTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        _old_scratch_dirs = config::query_scratch_dirs;
+        _old_spill_mem_limit_threshold = config::spill_mem_limit_threshold;
+        _old_spill_operator_min_bytes = config::spill_operator_min_bytes;
+        config::query_scratch_dirs = "./ut_dir/aggregate_blocking_operator_test";
+        ASSERT_OK(FileSystem::Default()->create_dir_recursive(config::query_scratch_dirs));
+        // The aggregator spills its hash map after every input chunk.
+        config::spill_mem_limit_threshold = 0;
+        config::spill_operator_min_bytes = 0;
+
+        // Tuple 0 is the input with slots 0 (k) and 1 (v), tuple 1 is both the intermediate and the output tuple with
+        // slots 2 (k), 3 (sum) and 4 (count).
+        TDescriptorTableBuilder desc_builder;
+        TTupleDescriptorBuilder input_builder;
+        input_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).column_name("k").nullable(true).build());
+        input_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).column_name("v").nullable(true).build());
+        input_builder.build(&desc_builder);
+        TTupleDescriptorBuilder output_builder;
+        output_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).column_name("k").nullable(true).build());
+        output_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_BIGINT).column_name("sum").nullable(true).build());
+        output_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_BIGINT).column_name("cnt").nullable(false).build());
+        output_builder.build(&desc_builder);
+        ASSERT_OK(DescriptorTbl::create(&_pool, desc_builder.desc_tbl(), &_desc_tbl, config::vector_chunk_size));
+
+        // Null keys, null values, and more groups than fit in a single output chunk.
+        for (int32_t i = 0; i < 3000; i++) {
+            std::optional<int32_t> key = i % 13 == 0 ? std::nullopt : std::optional<int32_t>(i % 700);
+            std::optional<int32_t> value = i % 5 == 0 ? std::nullopt : std::optional<int32_t>(i);
+            _rows.emplace_back(key, value);
+        }
+    }
+
+    void TearDown() override {
+        config::query_scratch_dirs = _old_scratch_dirs;
+        config::spill_mem_limit_threshold = _old_spill_mem_limit_threshold;
+        config::spill_operator_min_bytes = _old_spill_operator_min_bytes;
+    }
+
+protected:
+    using Rows = std::vector<std::pair<std::optional<int32_t>, std::optional<int32_t>>>;
+
+    struct AggResult {
+        std::vector<std::string> rows;
+        // Counters of the aggregator, which are only added if the aggregator can spill.
+        std::optional<int64_t> spill_count;
+        int64_t spilled_rows = 0;
+        int64_t spilled_bytes = 0;
+    };
+
+    std::shared_ptr<RuntimeState> _create_runtime_state(bool enable_spilling) {
+        TUniqueId fragment_id;
+        TQueryOptions query_options;
+        query_options.batch_size = kChunkSize;
+        query_options.__set_enable_spilling(enable_spilling);
+        TQueryGlobals query_globals;
+        auto state = std::make_shared<RuntimeState>(fragment_id, query_options, query_globals, nullptr);
+        state->init_mem_trackers(std::make_shared<MemTracker>(MemTracker::QUERY, 1L << 40, "query"));
+        state->set_desc_tbl(_desc_tbl);
+        return state;
+    }
+
+    static TExprNode _create_slot_ref(PrimitiveType type, SlotId slot_id) {
+        TExprNode node;
+        node.node_type = TExprNodeType::SLOT_REF;
+        node.type = TypeDescriptor(type).to_thrift();
+        node.num_children = 0;
+        node.__set_slot_ref(TSlotRef());
+        node.slot_ref.slot_id = slot_id;
+        node.slot_ref.tuple_id = 0;
+        node.use_vectorized = true;
+        node.is_nullable = true;
+        return node;
+    }
+
+    static TExpr _create_agg_expr(const std::string& name, const std::vector<TExprNode>& children) {
+        TFunction fn;
+        fn.name.function_name = name;
+        fn.binary_type = TFunctionBinaryType::BUILTIN;
+        for (const auto& child : children) {
+            fn.arg_types.emplace_back(child.type);
+        }
+        fn.ret_type = TypeDescriptor(TYPE_BIGINT).to_thrift();
+        fn.has_var_args = false;
+        fn.__set_aggregate_fn(TAggregateFunction());
+        fn.aggregate_fn.intermediate_type = TypeDescriptor(TYPE_BIGINT).to_thrift();
+
+        TExprNode node;
+        node.node_type = TExprNodeType::AGG_EXPR;
+        node.type = fn.ret_type;
+        node.num_children = children.size();
+        node.__set_fn(fn);
+        node.__set_agg_expr(TAggregateExpr());
+        node.agg_expr.is_merge_agg = false;
+        node.use_vectorized = true;
+        node.has_nullable_child = !children.empty();
+        node.is_nullable = !children.empty();
+
+        TExpr expr;
+        expr.nodes.emplace_back(node);
+        expr.nodes.insert(expr.nodes.end(), children.begin(), children.end());
+        return expr;
+    }
+
+    TPlanNode _create_plan_node(bool need_finalize) {
+        TPlanNode tnode;
+        tnode.node_id = 1;
+        tnode.node_type = TPlanNodeType::AGGREGATION_NODE;
+        tnode.num_children = 1;
+        tnode.limit = -1;
+        tnode.row_tuples = {1};
+        tnode.nullable_tuples = {false};
+
+        TAggregationNode agg_node;
+        agg_node.__set_grouping_exprs({TExpr()});
+        agg_node.grouping_exprs[0].nodes.emplace_back(_create_slot_ref(TYPE_INT, 0));
+        agg_node.aggregate_functions.emplace_back(_create_agg_expr("sum", {_create_slot_ref(TYPE_INT, 1)}));
+        agg_node.aggregate_functions.emplace_back(_create_agg_expr("count", {}));
+        agg_node.intermediate_tuple_id = 1;
+        agg_node.output_tuple_id = 1;
+        agg_node.need_finalize = need_finalize;
+        tnode.__set_agg_node(agg_node);
+        return tnode;
+    }
+
+    std::vector<vectorized::ChunkPtr> _create_chunks() const {
+        auto append = [](vectorized::Column* column, const std::optional<int32_t>& datum) {
+            if (datum.has_value()) {
+                column->append_datum(vectorized::Datum(datum.value()));
+            } else {
+                (void)column->append_nulls(1);
+            }
+        };
+        std::vector<vectorized::ChunkPtr> chunks;
+        for (size_t offset = 0; offset < _rows.size(); offset += kChunkSize) {
+            auto key_column = vectorized::ColumnHelper::create_column(TypeDescriptor(TYPE_INT), true);
+            auto value_column = vectorized::ColumnHelper::create_column(TypeDescriptor(TYPE_INT), true);
+            for (size_t i = offset; i < std::min(_rows.size(), offset + kChunkSize); i++) {
+                append(key_column.get(), _rows[i].first);
+                append(value_column.get(), _rows[i].second);
+            }
+            auto chunk = std::make_shared<vectorized::Chunk>();
+            chunk->append_column(key_column, 0);
+            chunk->append_column(value_column, 1);
+            chunks.emplace_back(std::move(chunk));
+        }
+        return chunks;
+    }
+
+    AggResult _aggregate(bool need_finalize, bool enable_spilling) {
+        AggResult result;
+        auto state = _create_runtime_state(enable_spilling);
+        auto tnode = _create_plan_node(need_finalize);
+        auto aggregator_factory = std::make_shared<AggregatorFactory>(tnode);
+        AggregateBlockingSinkOperatorFactory sink_factory(0, tnode.node_id, aggregator_factory);
+        AggregateBlockingSourceOperatorFactory source_factory(1, tnode.node_id, aggregator_factory);
+        auto sink = sink_factory.create(1, 0);
+        auto source = source_factory.create(1, 0);
+        EXPECT_OK(sink->prepare(state.get()));
+        EXPECT_OK(source->prepare(state.get()));
+
+        for (const auto& chunk : _create_chunks()) {
+            EXPECT_OK(sink->push_chunk(state.get(), chunk));
+        }
+        EXPECT_OK(sink->set_finishing(state.get()));
+
+        while (!source->is_finished()) {
+            EXPECT_TRUE(source->has_output());
+            ASSIGN_OR_ABORT(auto chunk, source->pull_chunk(state.get()));
+            for (size_t i = 0; i < chunk->num_rows(); i++) {
+                result.rows.emplace_back(chunk->debug_row(i));
+            }
+        }
+        EXPECT_OK(source->set_finished(state.get()));
+
+        // The aggregator adds its counters to the profile of the sink operator.
+        if (auto* spill_count = sink->unique_metrics()->get_counter("SpillCount")) {
+            result.spill_count = spill_count->value();
+            result.spilled_rows = sink->unique_metrics()->get_counter("SpilledRows")->value();
+            result.spilled_bytes = sink->unique_metrics()->get_counter("SpilledBytes")->value();
+        }
+        sink->close(state.get());
+        source->close(state.get());
+
+        std::sort(result.rows.begin(), result.rows.end());
+        return result;
+    }
+
+    static constexpr size_t kChunkSize = 64;
+
+    ObjectPool _pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+    Rows _rows;
+
+    std::string _old_scratch_dirs;
+    double _old_spill_mem_limit_threshold = 0;
+    int64_t _old_spill_operator_min_bytes = 0;
+};
+
+TEST_F(AggregateBlockingOperatorTest, test_spill_and_merge) {
+    for (bool need_finalize : {true, false}) {
+        SCOPED_TRACE(need_finalize ? "finalize" : "serialize");
+        auto expected = _aggregate(need_finalize, false);
+        ASSERT_FALSE(expected.spill_count.has_value());
+        // 700 keys plus the null key.
+        ASSERT_EQ(701, static_cast<int64_t>(expected.rows.size()));
+
+        auto actual = _aggregate(need_finalize, true);
+        ASSERT_TRUE(actual.spill_count.has_value());
+        // The hash map is spilled after every input chunk, so the groups are merged from several spills.
+        ASSERT_GT(actual.spill_count.value(), 1);
+        ASSERT_GT(actual.spilled_rows, static_cast<int64_t>(expected.rows.size()));
+        ASSERT_GT(actual.spilled_bytes, 0);
+        ASSERT_EQ(expected.rows, actual.rows);
+    }
+}
+
+} // namespace starrocks::pipeline
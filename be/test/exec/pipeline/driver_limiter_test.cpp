@@ -0,0 +1,55 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#include "exec/pipeline/driver_limiter.h"
+
+#include <gtest/gtest.h>
+
+namespace starrocks::pipeline {
+
+TEST(DriverLimiterTest, test_try_acquire) {
+    DriverLimiter limiter(10);
+    auto token1 = limiter.try_acquire(6);
+    ASSERT_TRUE(token1.ok());
+    ASSERT_EQ(6, limiter.num_total_drivers());
+    // The drivers are acquired as long as the limit is not reached before acquiring.
+    auto token2 = limiter.try_acquire(6);
+    ASSERT_TRUE(token2.ok());
+    ASSERT_EQ(12, limiter.num_total_drivers());
+    ASSERT_FALSE(limiter.try_acquire(1).ok());
+    ASSERT_EQ(12, limiter.num_total_drivers());
+
+    token1.value().reset();
+    ASSERT_EQ(6, limiter.num_total_drivers());
+    token2.value().reset();
+    ASSERT_EQ(0, limiter.num_total_drivers());
+}
+
+TEST(DriverLimiterTest, test_adjust_dop_by_load) {
+    DriverLimiter limiter(100);
+    ASSERT_EQ(16, limiter.adjust_dop_by_load(16));
+    ASSERT_EQ(1, limiter.adjust_dop_by_load(1));
+
+    // Keep the dop until half of the drivers are used.
+    auto token1 = limiter.try_acquire(50);
+    ASSERT_EQ(16, limiter.adjust_dop_by_load(16));
+
+    // 25 free drivers.
+    auto token2 = limiter.try_acquire(25);
+    ASSERT_EQ(8, limiter.adjust_dop_by_load(16));
+
+    // 5 free drivers.
+    auto token3 = limiter.try_acquire(20);
+    ASSERT_EQ(1, limiter.adjust_dop_by_load(16));
+    ASSERT_EQ(2, limiter.adjust_dop_by_load(20));
+
+    // Overloaded.
+    auto token4 = limiter.try_acquire(10);
+    ASSERT_EQ(1, limiter.adjust_dop_by_load(16));
+
+    token4.value().reset();
+    token3.value().reset();
+    token2.value().reset();
+    ASSERT_EQ(16, limiter.adjust_dop_by_load(16));
+}
+
+} // namespace starrocks::pipeline
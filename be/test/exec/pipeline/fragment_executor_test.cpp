@@ -0,0 +1,69 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#include "exec/pipeline/fragment_executor.h"
+
+#include <gtest/gtest.h>
+
+namespace starrocks::pipeline {
+
+static TExecPlanFragmentParams create_request(const std::vector<TPlanNode>& nodes) {
+    TExecPlanFragmentParams request;
+    request.__set_backend_num(0);
+    request.__set_pipeline_dop(16);
+    request.__isset.params = true;
+    request.params.__set_sender_id(0);
+    request.fragment.plan.nodes = nodes;
+    return request;
+}
+
+static TPlanNode create_exchange_node(TPartitionType::type partition_type) {
+    TPlanNode node;
+    node.node_type = TPlanNodeType::EXCHANGE_NODE;
+    node.__isset.exchange_node = true;
+    node.exchange_node.__set_partition_type(partition_type);
+    return node;
+}
+
+// The dop of a fragment with a pipeline level shuffle receiver is not adapted to the load, since the senders split
+// the rows by the dop FE requested.
+TEST(FragmentExecutorTest, test_has_pipeline_level_shuffle_receiver) {
+    TPlanNode scan_node;
+    scan_node.node_type = TPlanNodeType::OLAP_SCAN_NODE;
+
+    {
+        auto request = create_request({scan_node});
+        UnifiedExecPlanFragmentParams params(request, request);
+        ASSERT_FALSE(params.has_pipeline_level_shuffle_receiver());
+    }
+    {
+        auto request = create_request({create_exchange_node(TPartitionType::UNPARTITIONED)});
+        UnifiedExecPlanFragmentParams params(request, request);
+        ASSERT_FALSE(params.has_pipeline_level_shuffle_receiver());
+    }
+    {
+        auto request = create_request({create_exchange_node(TPartitionType::RANDOM)});
+        UnifiedExecPlanFragmentParams params(request, request);
+        ASSERT_FALSE(params.has_pipeline_level_shuffle_receiver());
+    }
+    {
+        auto request = create_request({create_exchange_node(TPartitionType::UNPARTITIONED),
+                                       create_exchange_node(TPartitionType::HASH_PARTITIONED)});
+        UnifiedExecPlanFragmentParams params(request, request);
+        ASSERT_TRUE(params.has_pipeline_level_shuffle_receiver());
+    }
+    {
+        auto request = create_request({create_exchange_node(TPartitionType::BUCKET_SHUFFLE_HASH_PARTITIONED)});
+        UnifiedExecPlanFragmentParams params(request, request);
+        ASSERT_TRUE(params.has_pipeline_level_shuffle_receiver());
+    }
+    {
+        // The partition type of the senders is unknown.
+        TPlanNode exchange_node;
+        exchange_node.node_type = TPlanNodeType::EXCHANGE_NODE;
+        auto request = create_request({exchange_node});
+        UnifiedExecPlanFragmentParams params(request, request);
+        ASSERT_TRUE(params.has_pipeline_level_shuffle_receiver());
+    }
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,253 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#include <gtest/gtest.h>
+
+#include <optional>
+
+#include "column/column_helper.h"
+#include "exec/pipeline/hashjoin/hash_join_build_operator.h"
+#include "exec/pipeline/hashjoin/hash_join_probe_operator.h"
+#include "exec/pipeline/query_context.h"
+#include "exprs/vectorized/column_ref.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/runtime_state.h"
+#include "testutil/assert.h"
+#include "util/hash_util.hpp"
+
+namespace starrocks::pipeline {
+
+// Drives HashJoinBuildOperator and HashJoinProbeOperator of a broadcast join in the same order as the fragment
+// executor does: the operators of all the drivers are created first, the build pipeline before the probe pipeline,
+// and then prepared and run. The partitioned build must produce the same result as the single hash table.
+class HashJoinOperatorTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        _query_ctx.init_mem_tracker(-1, nullptr);
+        TUniqueId fragment_id;
+        TQueryOptions query_options;
+        query_options.batch_size = kChunkSize;
+        TQueryGlobals query_globals;
+        _runtime_state = std::make_shared<RuntimeState>(fragment_id, query_options, query_globals, nullptr);
+        _runtime_state->init_mem_trackers(_query_ctx.mem_tracker());
+        _runtime_state->set_query_ctx(&_query_ctx);
+
+        // Tuple 0 is the probe side with slots 0 and 1, tuple 1 is the build side with slots 2 and 3, the first slot
+        // of each side is the join key.
+        TDescriptorTableBuilder desc_builder;
+        for (int i = 0; i < 2; i++) {
+            TTupleDescriptorBuilder tuple_builder;
+            tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).column_name("k").nullable(true).build());
+            tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).column_name("v").nullable(true).build());
+            tuple_builder.build(&desc_builder);
+        }
+        DescriptorTbl* tbl = nullptr;
+        ASSERT_OK(DescriptorTbl::create(&_pool, desc_builder.desc_tbl(), &tbl, config::vector_chunk_size));
+        _probe_row_desc = std::make_unique<RowDescriptor>(*tbl, std::vector<TTupleId>{0}, std::vector<bool>{true});
+        _build_row_desc = std::make_unique<RowDescriptor>(*tbl, std::vector<TTupleId>{1}, std::vector<bool>{true});
+        _row_desc = std::make_unique<RowDescriptor>(*tbl, std::vector<TTupleId>{0, 1}, std::vector<bool>{true, true});
+
+        _probe_expr_ctxs.push_back(
+                _pool.add(new ExprContext(_pool.add(new vectorized::ColumnRef(TypeDescriptor(TYPE_INT), 0)))));
+        _build_expr_ctxs.push_back(
+                _pool.add(new ExprContext(_pool.add(new vectorized::ColumnRef(TypeDescriptor(TYPE_INT), 2)))));
+
+        for (int32_t i = 0; i < 600; i++) {
+            _probe_rows.emplace_back(i % 7 == 0 ? std::nullopt : std::optional<int32_t>(i % 300 - 50), i);
+        }
+    }
+
+protected:
+    using Rows = std::vector<std::pair<std::optional<int32_t>, int32_t>>;
+
+    static std::vector<vectorized::ChunkPtr> _create_chunks(const Rows& rows, SlotId key_slot, SlotId value_slot) {
+        std::vector<vectorized::ChunkPtr> chunks;
+        for (size_t offset = 0; offset < rows.size(); offset += kChunkSize) {
+            auto key_column = vectorized::ColumnHelper::create_column(TypeDescriptor(TYPE_INT), true);
+            auto value_column = vectorized::ColumnHelper::create_column(TypeDescriptor(TYPE_INT), true);
+            for (size_t i = offset; i < std::min(rows.size(), offset + kChunkSize); i++) {
+                if (rows[i].first.has_value()) {
+                    key_column->append_datum(vectorized::Datum(rows[i].first.value()));
+                } else {
+                    (void)key_column->append_nulls(1);
+                }
+                value_column->append_datum(vectorized::Datum(rows[i].second));
+            }
+            auto chunk = std::make_shared<vectorized::Chunk>();
+            chunk->append_column(key_column, key_slot);
+            chunk->append_column(value_column, value_slot);
+            chunks.emplace_back(std::move(chunk));
+        }
+        return chunks;
+    }
+
+    // Split |chunk| by the join keys in the same way as the local shuffle of the build side.
+    std::vector<vectorized::ChunkPtr> _shuffle_build_chunk(const vectorized::ChunkPtr& chunk, size_t num_partitions) {
+        size_t num_rows = chunk->num_rows();
+        std::vector<uint32_t> hash_values(num_rows, HashUtil::FNV_SEED);
+        for (auto* expr_ctx : _build_expr_ctxs) {
+            auto column = expr_ctx->evaluate(chunk.get()).value();
+            column->fnv_hash(hash_values.data(), 0, num_rows);
+        }
+        std::vector<uint32_t> partition_ids(num_rows);
+        Shuffler shuffler(_runtime_state->func_version() <= 3, false, TPartitionType::HASH_PARTITIONED, num_partitions,
+                          1);
+        shuffler.local_exchange_shuffle(partition_ids, hash_values, num_rows);
+
+        std::vector<vectorized::ChunkPtr> partitions(num_partitions);
+        for (size_t i = 0; i < num_partitions; i++) {
+            std::vector<uint32_t> indexes;
+            for (uint32_t row = 0; row < num_rows; row++) {
+                if (partition_ids[row] == i) {
+                    indexes.push_back(row);
+                }
+            }
+            if (!indexes.empty()) {
+                partitions[i] = chunk->clone_empty_with_slot(indexes.size());
+                partitions[i]->append_selective(*chunk, indexes.data(), 0, indexes.size());
+            }
+        }
+        return partitions;
+    }
+
+    std::vector<std::string> _join(TJoinOp::type join_type, const Rows& build_rows, bool partitioned_build) {
+        THashJoinNode hash_join_node;
+        hash_join_node.join_op = join_type;
+        hash_join_node.is_push_down = false;
+        hash_join_node.__set_distribution_mode(TJoinDistributionMode::BROADCAST);
+        std::vector<bool> is_null_safes{false};
+        std::list<vectorized::RuntimeFilterBuildDescriptor*> runtime_filters;
+        vectorized::HashJoinerParam param(&_pool, hash_join_node, kPlanNodeId, TPlanNodeType::HASH_JOIN_NODE,
+                                          is_null_safes, _build_expr_ctxs, _probe_expr_ctxs, {}, {}, *_build_row_desc,
+                                          *_probe_row_desc, *_row_desc, TPlanNodeType::EXCHANGE_NODE,
+                                          TPlanNodeType::OLAP_SCAN_NODE, true, runtime_filters, {},
+                                          TJoinDistributionMode::BROADCAST);
+        int num_build_partitions = partitioned_build ? kDop : 1;
+        auto joiner_factory = std::make_shared<HashJoinerFactory>(param, kDop, num_build_partitions);
+
+        RuntimeFilterHub runtime_filter_hub;
+        runtime_filter_hub.add_holder(kPlanNodeId);
+        auto build_factory = std::make_shared<HashJoinBuildOperatorFactory>(
+                1, kPlanNodeId, joiner_factory,
+                std::make_unique<PartialRuntimeFilterMerger>(&_pool, 1024000, num_build_partitions),
+                TJoinDistributionMode::BROADCAST);
+        build_factory->init_runtime_filter(&runtime_filter_hub, {1}, {}, *_build_row_desc, nullptr, {}, {});
+        auto probe_factory = std::make_shared<HashJoinProbeOperatorFactory>(2, kPlanNodeId, joiner_factory);
+        EXPECT_OK(build_factory->prepare(_runtime_state.get()));
+        EXPECT_OK(probe_factory->prepare(_runtime_state.get()));
+
+        // The build pipeline is created before the probe pipeline, so the build operators are created before the
+        // probers of other partitions are registered.
+        std::vector<OperatorPtr> build_ops;
+        std::vector<OperatorPtr> probe_ops;
+        for (int i = 0; i < num_build_partitions; i++) {
+            build_ops.emplace_back(build_factory->create(num_build_partitions, i));
+        }
+        for (int i = 0; i < kDop; i++) {
+            probe_ops.emplace_back(probe_factory->create(kDop, i));
+        }
+        for (int i = 0; i < num_build_partitions; i++) {
+            EXPECT_EQ(static_cast<size_t>(kDop - 1), joiner_factory->get_read_only_probers(i).size());
+        }
+        for (auto& op : build_ops) {
+            EXPECT_OK(op->prepare(_runtime_state.get()));
+        }
+        for (auto& op : probe_ops) {
+            EXPECT_OK(op->prepare(_runtime_state.get()));
+        }
+
+        for (const auto& chunk : _create_chunks(build_rows, 2, 3)) {
+            auto partitions = _shuffle_build_chunk(chunk, num_build_partitions);
+            for (int i = 0; i < num_build_partitions; i++) {
+                if (partitions[i] != nullptr) {
+                    EXPECT_OK(build_ops[i]->push_chunk(_runtime_state.get(), partitions[i]));
+                }
+            }
+        }
+        for (auto& op : build_ops) {
+            EXPECT_OK(op->set_finishing(_runtime_state.get()));
+        }
+
+        std::vector<std::string> result;
+        auto pull = [&](Operator* op) {
+            while (op->has_output()) {
+                auto chunk = op->pull_chunk(_runtime_state.get()).value();
+                for (size_t i = 0; chunk != nullptr && i < chunk->num_rows(); i++) {
+                    result.emplace_back(chunk->debug_row(i));
+                }
+            }
+        };
+        auto probe_chunks = _create_chunks(_probe_rows, 0, 1);
+        for (int i = 0; i < kDop; i++) {
+            auto* op = probe_ops[i].get();
+            EXPECT_TRUE(op->is_ready());
+            for (size_t j = i; j < probe_chunks.size() && !op->is_finished(); j += kDop) {
+                EXPECT_TRUE(op->need_input());
+                EXPECT_OK(op->push_chunk(_runtime_state.get(), probe_chunks[j]));
+                pull(op);
+            }
+            EXPECT_OK(op->set_finishing(_runtime_state.get()));
+            pull(op);
+            EXPECT_TRUE(op->is_finished());
+            EXPECT_OK(op->set_finished(_runtime_state.get()));
+        }
+
+        for (auto& op : probe_ops) {
+            op->close(_runtime_state.get());
+        }
+        for (auto& op : build_ops) {
+            op->close(_runtime_state.get());
+        }
+        probe_factory->close(_runtime_state.get());
+        build_factory->close(_runtime_state.get());
+
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    void _check_partitioned_build(const Rows& build_rows) {
+        for (auto join_type :
+             {TJoinOp::INNER_JOIN, TJoinOp::LEFT_OUTER_JOIN, TJoinOp::LEFT_SEMI_JOIN, TJoinOp::LEFT_ANTI_JOIN}) {
+            SCOPED_TRACE(to_string(join_type));
+            auto expected = _join(join_type, build_rows, false);
+            auto actual = _join(join_type, build_rows, true);
+            ASSERT_EQ(expected, actual);
+        }
+    }
+
+    static constexpr size_t kChunkSize = 64;
+    static constexpr int kDop = 4;
+    static constexpr TPlanNodeId kPlanNodeId = 1;
+
+    ObjectPool _pool;
+    QueryContext _query_ctx;
+    std::shared_ptr<RuntimeState> _runtime_state;
+    std::unique_ptr<RowDescriptor> _probe_row_desc;
+    std::unique_ptr<RowDescriptor> _build_row_desc;
+    std::unique_ptr<RowDescriptor> _row_desc;
+    std::vector<ExprContext*> _probe_expr_ctxs;
+    std::vector<ExprContext*> _build_expr_ctxs;
+    Rows _probe_rows;
+};
+
+TEST_F(HashJoinOperatorTest, test_partitioned_build_with_null_keys) {
+    Rows build_rows;
+    for (int32_t i = 0; i < 500; i++) {
+        build_rows.emplace_back(i % 11 == 0 ? std::nullopt : std::optional<int32_t>(i % 200), 1000 + i);
+    }
+    _check_partitioned_build(build_rows);
+}
+
+TEST_F(HashJoinOperatorTest, test_partitioned_build_with_empty_partitions) {
+    // All the rows fall into at most two partitions.
+    Rows build_rows;
+    for (int32_t i = 0; i < 100; i++) {
+        build_rows.emplace_back(i % 3 == 0 ? std::nullopt : std::optional<int32_t>(7), 1000 + i);
+    }
+    _check_partitioned_build(build_rows);
+}
+
+TEST_F(HashJoinOperatorTest, test_partitioned_build_with_empty_build_side) {
+    _check_partitioned_build({});
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,55 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#include "exec/pipeline/exchange/heavy_hitter_sampler.h"
+
+#include <gtest/gtest.h>
+
+namespace starrocks::pipeline {
+
+TEST(HeavyHitterSamplerTest, test_detect_hot_keys) {
+    HeavyHitterSampler sampler(2, 100, 0.2);
+    // Half of the rows are key 7, and the others are distinct.
+    std::vector<uint32_t> hash_values(150);
+    for (uint32_t i = 0; i < hash_values.size(); i++) {
+        hash_values[i] = i % 4 == 0 ? 7 : 1000 + i;
+    }
+    sampler.sample(hash_values, hash_values.size());
+    // The first window is not finished.
+    ASSERT_FALSE(sampler.has_hot_keys());
+
+    // The window is finished by the first 25 samples of the second chunk, 51 of the 100 samples are key 7.
+    sampler.sample(hash_values, hash_values.size());
+    ASSERT_TRUE(sampler.has_hot_keys());
+    ASSERT_EQ(1, sampler.num_hot_keys());
+    ASSERT_TRUE(sampler.is_hot(7));
+    ASSERT_FALSE(sampler.is_hot(1000));
+}
+
+TEST(HeavyHitterSamplerTest, test_hot_keys_change) {
+    HeavyHitterSampler sampler(1, 100, 0.3);
+    std::vector<uint32_t> hash_values(100);
+    for (uint32_t i = 0; i < hash_values.size(); i++) {
+        hash_values[i] = i % 2 == 0 ? 1 : (i % 3 == 0 ? 2 : i);
+    }
+    sampler.sample(hash_values, hash_values.size());
+    ASSERT_EQ(1, sampler.num_hot_keys());
+    ASSERT_TRUE(sampler.is_hot(1));
+
+    // Evenly distributed keys, more than the number of counters.
+    for (uint32_t i = 0; i < hash_values.size(); i++) {
+        hash_values[i] = i;
+    }
+    sampler.sample(hash_values, hash_values.size());
+    ASSERT_FALSE(sampler.has_hot_keys());
+
+    for (uint32_t i = 0; i < hash_values.size(); i++) {
+        hash_values[i] = i % 2;
+    }
+    sampler.sample(hash_values, hash_values.size());
+    ASSERT_EQ(2, sampler.num_hot_keys());
+    ASSERT_TRUE(sampler.is_hot(0));
+    ASSERT_TRUE(sampler.is_hot(1));
+    ASSERT_FALSE(sampler.is_hot(2));
+}
+
+} // namespace starrocks::pipeline
@@ -151,6 +151,100 @@ PARALLEL_TEST(QuerySharedDriverQueueTest, test_take_close) {
     consumer_thread->join();
 }
 
+PARALLEL_TEST(WorkStealingDriverQueueTest, test_local_queue) {
+    WorkStealingDriverQueue queue(2);
+
+    // Prepare drivers.
+    QueryContext query_context;
+    auto driver1 = std::make_shared<PipelineDriver>(_gen_operators(), &query_context, nullptr, -1);
+    _set_driver_level(driver1.get(), 1);
+    driver1->set_last_worker_id(1);
+    auto driver2 = std::make_shared<PipelineDriver>(_gen_operators(), &query_context, nullptr, -1);
+    _set_driver_level(driver2.get(), 1);
+    driver2->set_last_worker_id(0);
+    auto driver3 = std::make_shared<PipelineDriver>(_gen_operators(), &query_context, nullptr, -1);
+    _set_driver_level(driver3.get(), 1);
+    // The worker id is mapped to the local queues in modulo.
+    driver3->set_last_worker_id(3);
+
+    queue.put_back(driver1.get());
+    queue.put_back(std::vector<DriverRawPtr>{driver2.get(), driver3.get()});
+    ASSERT_EQ(3, queue.size());
+
+    // Each worker takes the drivers last run by it first.
+    auto maybe_driver = queue.take(0);
+    ASSERT_TRUE(maybe_driver.ok());
+    ASSERT_EQ(driver2.get(), maybe_driver.value());
+    maybe_driver = queue.take(1);
+    ASSERT_TRUE(maybe_driver.ok());
+    ASSERT_EQ(driver1.get(), maybe_driver.value());
+
+    // Worker 0 steals the driver from the local queue of worker 1.
+    maybe_driver = queue.take(0);
+    ASSERT_TRUE(maybe_driver.ok());
+    ASSERT_EQ(driver3.get(), maybe_driver.value());
+    ASSERT_FALSE(driver3->is_in_ready_queue());
+    ASSERT_EQ(1, queue.num_steals());
+    ASSERT_EQ(0, queue.size());
+}
+
+PARALLEL_TEST(WorkStealingDriverQueueTest, test_cancel) {
+    WorkStealingDriverQueue queue(2);
+
+    std::vector<std::shared_ptr<PipelineDriver>> drivers;
+    for (int i = 0; i < 3; i++) {
+        drivers.emplace_back(std::make_shared<PipelineDriver>(_gen_operators(), nullptr, nullptr, -1));
+        _set_driver_level(drivers.back().get(), 1);
+        drivers.back()->set_last_worker_id(0);
+        queue.put_back(drivers.back().get());
+    }
+
+    // The cancelled driver is taken first.
+    queue.cancel(drivers[2].get());
+    std::vector<DriverRawPtr> out_drivers = {drivers[2].get(), drivers[0].get(), drivers[1].get()};
+    for (auto* out_driver : out_drivers) {
+        auto maybe_driver = queue.take(0);
+        ASSERT_TRUE(maybe_driver.ok());
+        ASSERT_EQ(out_driver, maybe_driver.value());
+    }
+    ASSERT_EQ(0, queue.size());
+}
+
+PARALLEL_TEST(WorkStealingDriverQueueTest, test_take_block) {
+    WorkStealingDriverQueue queue(4);
+
+    QueryContext query_context;
+    auto driver1 = std::make_shared<PipelineDriver>(_gen_operators(), &query_context, nullptr, -1);
+    _set_driver_level(driver1.get(), 1);
+    driver1->set_last_worker_id(2);
+
+    // The idle worker is woken up to steal the driver put to the local queue of another worker.
+    auto consumer_thread = std::make_shared<std::thread>([&queue, &driver1] {
+        auto maybe_driver = queue.take(0);
+        ASSERT_TRUE(maybe_driver.ok());
+        ASSERT_EQ(driver1.get(), maybe_driver.value());
+    });
+
+    sleep(1);
+    queue.put_back(driver1.get());
+
+    consumer_thread->join();
+}
+
+PARALLEL_TEST(WorkStealingDriverQueueTest, test_take_close) {
+    WorkStealingDriverQueue queue(4);
+
+    auto consumer_thread = std::make_shared<std::thread>([&queue] {
+        auto maybe_driver = queue.take(1);
+        ASSERT_TRUE(maybe_driver.status().is_cancelled());
+    });
+
+    sleep(1);
+    queue.close();
+
+    consumer_thread->join();
+}
+
 class WorkGroupDriverQueueTest : public ::testing::Test {
 public:
     void SetUp() override {
@@ -243,7 +337,7 @@ TEST_F(WorkGroupDriverQueueTest, test_basic) {
 
     // Take drivers from queue.
     for (auto* out_driver : out_drivers) {
-        auto maybe_driver = queue.take();
+        auto maybe_driver = queue.take(0);
         ASSERT_TRUE(maybe_driver.ok());
         ASSERT_EQ(out_driver, maybe_driver.value());
     }
@@ -0,0 +1,56 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#include "exec/pipeline/pipeline_observer.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+namespace starrocks::pipeline {
+
+TEST(PipelineObserverTest, test_notify) {
+    PipelineObserver observer1;
+    PipelineObserver observer2;
+    Observable observable;
+    observable.add_observer(&observer1);
+    observable.add_observer(&observer2);
+
+    // The observer is signalled at first, so the blocked driver is checked at least once.
+    ASSERT_TRUE(observer1.consume_event());
+    ASSERT_FALSE(observer1.consume_event());
+    ASSERT_TRUE(observer2.consume_event());
+
+    observable.notify_observers();
+    observable.notify_observers();
+    ASSERT_TRUE(observer1.consume_event());
+    ASSERT_FALSE(observer1.consume_event());
+    ASSERT_TRUE(observer2.consume_event());
+
+    observable.remove_observers();
+    observable.notify_observers();
+    ASSERT_FALSE(observer1.consume_event());
+    ASSERT_FALSE(observer2.consume_event());
+}
+
+TEST(PipelineObserverTest, test_concurrent_notify) {
+    PipelineObserver observer;
+    Observable observable;
+    observable.add_observer(&observer);
+    ASSERT_TRUE(observer.consume_event());
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&observable] {
+            for (int j = 0; j < 1000; j++) {
+                observable.notify_observers();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_TRUE(observer.consume_event());
+    ASSERT_FALSE(observer.consume_event());
+}
+
+} // namespace starrocks::pipeline
@@ -11,6 +11,8 @@
 #include "column/nullable_column.h"
 #include "column/vectorized_fwd.h"
 #include "exec/vectorized/aggregate/agg_hash_set.h"
+#include "exec/vectorized/aggregate/agg_hash_variant.h"
+#include "runtime/runtime_state.h"
 #include "runtime/mem_pool.h"
 #include "runtime/primitive_type.h"
 
@@ -259,5 +261,33 @@ TEST(HashMapTest, TwoLevelConvert) {
     }
 }
 
+TEST(HashMapTest, Reserve) {
+    TQueryOptions query_options;
+    query_options.batch_size = 64;
+    RuntimeState state(TUniqueId(), query_options, TQueryGlobals(), nullptr);
+
+    AggHashMapVariant map_variant;
+    map_variant.init(&state, AggHashMapVariant::Type::phase2_int32);
+    map_variant.reserve(10000);
+    size_t capacity = map_variant.capacity();
+    ASSERT_GE(capacity * 7 / 8, 10000);
+    for (int32_t i = 0; i < 10000; i++) {
+        map_variant.phase2_int32->hash_map.emplace(i, nullptr);
+    }
+    // No rehashing for the reserved keys.
+    ASSERT_EQ(capacity, map_variant.capacity());
+
+    AggHashSetVariant set_variant;
+    set_variant.init(&state, AggHashSetVariant::Type::phase1_slice_two_level);
+    set_variant.reserve(10000);
+    ASSERT_GE(set_variant.capacity() * 7 / 8, 10000);
+
+    // The fixed size hash table of small keys is never rehashed.
+    set_variant.init(&state, AggHashSetVariant::Type::phase1_uint8);
+    capacity = set_variant.capacity();
+    set_variant.reserve(10000);
+    ASSERT_EQ(capacity, set_variant.capacity());
+}
+
 } // namespace vectorized
 } // namespace starrocks
@@ -16,9 +16,12 @@
 #include "exec/vectorized/sorting/sorting.h"
 #include "exprs/vectorized/column_ref.h"
 #include "fmt/core.h"
+#include "fs/fs.h"
+#include "runtime/mem_tracker.h"
 #include "runtime/runtime_state.h"
 #include "runtime/types.h"
 #include "testutil/assert.h"
+#include "util/defer_op.h"
 #include "util/json.h"
 
 namespace starrocks::vectorized {
@@ -316,6 +319,57 @@ TEST_F(ChunksSorterTest, full_sort_incremental) {
     clear_sort_exprs(sort_exprs);
 }
 
+TEST_F(ChunksSorterTest, full_sort_spill) {
+    auto old_scratch_dirs = config::query_scratch_dirs;
+    auto old_spill_mem_limit_threshold = config::spill_mem_limit_threshold;
+    auto old_spill_operator_min_bytes = config::spill_operator_min_bytes;
+    DeferOp restore_config([&] {
+        config::query_scratch_dirs = old_scratch_dirs;
+        config::spill_mem_limit_threshold = old_spill_mem_limit_threshold;
+        config::spill_operator_min_bytes = old_spill_operator_min_bytes;
+    });
+    config::query_scratch_dirs = "./ut_dir/chunks_sorter_test";
+    ASSERT_OK(FileSystem::Default()->create_dir_recursive(config::query_scratch_dirs));
+    // Spill on every update.
+    config::spill_mem_limit_threshold = 0;
+    config::spill_operator_min_bytes = 0;
+
+    TUniqueId fragment_id;
+    TQueryOptions query_options;
+    query_options.batch_size = config::vector_chunk_size;
+    query_options.enable_spilling = true;
+    TQueryGlobals query_globals;
+    auto runtime_state = std::make_shared<RuntimeState>(fragment_id, query_options, query_globals, nullptr);
+    runtime_state->init_mem_trackers(std::make_shared<MemTracker>(1L << 30));
+
+    std::vector<bool> is_asc{false, true};
+    std::vector<bool> is_null_first{true, true};
+    std::vector<ExprContext*> sort_exprs;
+    sort_exprs.push_back(new ExprContext(_expr_region.get()));
+    sort_exprs.push_back(new ExprContext(_expr_cust_key.get()));
+
+    DeferOp clear_exprs([&] { clear_sort_exprs(sort_exprs); });
+
+    ChunksSorterFullSort sorter(runtime_state.get(), &sort_exprs, &is_asc, &is_null_first, "");
+    RuntimeProfile profile("full_sort_spill");
+    sorter.setup_runtime(&profile);
+    ASSERT_OK(sorter.update(runtime_state.get(), _chunk_1));
+    ASSERT_OK(sorter.update(runtime_state.get(), _chunk_2));
+    ASSERT_OK(sorter.update(runtime_state.get(), _chunk_3));
+    ASSERT_OK(sorter.done(runtime_state.get()));
+    ASSERT_TRUE(sorter.has_spilled());
+    ASSERT_EQ(16, sorter.get_output_rows());
+
+    ChunkPtr page_1 = consume_page_from_sorter(sorter);
+    ASSERT_EQ(16, page_1->num_rows());
+    std::vector<int32_t> permutation{69, 70, 71, 2, 4, 6, 12, 16, 24, 41, 49, 52, 54, 55, 56, 58};
+    std::vector<int32_t> result;
+    for (size_t i = 0; i < page_1->num_rows(); ++i) {
+        result.push_back(page_1->get(i).get(0).get_int32());
+    }
+    EXPECT_EQ(permutation, result);
+}
+
 // NOTE: this test case runs too slow
 // TEST_F(ChunksSorterTest, full_sort_chunk_overflow) {
 //     std::vector<bool> is_asc{true};
@@ -0,0 +1,306 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#include "exec/vectorized/hash_joiner.h"
+
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <thread>
+
+#include "column/column_helper.h"
+#include "column/column_viewer.h"
+#include "column/nullable_column.h"
+#include "common/config.h"
+#include "exprs/vectorized/column_ref.h"
+#include "exprs/vectorized/runtime_filter_bank.h"
+#include "fs/fs.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/runtime_state.h"
+#include "testutil/assert.h"
+
+namespace starrocks::vectorized {
+
+// Runs a hash join in the same order as HashJoinBuildOperator and HashJoinProbeOperator do, with and without
+// spilling, and compares the results.
+class HashJoinerTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        _old_scratch_dirs = config::query_scratch_dirs;
+        _old_spill_mem_limit_threshold = config::spill_mem_limit_threshold;
+        _old_spill_operator_min_bytes = config::spill_operator_min_bytes;
+        config::query_scratch_dirs = "./ut_dir/hash_joiner_test";
+        ASSERT_OK(FileSystem::Default()->create_dir_recursive(config::query_scratch_dirs));
+        // Every spillable operator spills as soon as it holds any data.
+        config::spill_mem_limit_threshold = 0;
+        config::spill_operator_min_bytes = 0;
+
+        // Tuple 0 is the probe side with slots 0 and 1, tuple 1 is the build side with slots 2 and 3, the first slot
+        // of each side is the join key.
+        TDescriptorTableBuilder desc_builder;
+        for (int i = 0; i < 2; i++) {
+            TTupleDescriptorBuilder tuple_builder;
+            tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).column_name("k").nullable(true).build());
+            tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).column_name("v").nullable(true).build());
+            tuple_builder.build(&desc_builder);
+        }
+        DescriptorTbl* tbl = nullptr;
+        ASSERT_OK(DescriptorTbl::create(&_pool, desc_builder.desc_tbl(), &tbl, config::vector_chunk_size));
+        _probe_row_desc = std::make_unique<RowDescriptor>(*tbl, std::vector<TTupleId>{0}, std::vector<bool>{true});
+        _build_row_desc = std::make_unique<RowDescriptor>(*tbl, std::vector<TTupleId>{1}, std::vector<bool>{true});
+        _row_desc = std::make_unique<RowDescriptor>(*tbl, std::vector<TTupleId>{0, 1}, std::vector<bool>{true, true});
+
+        _probe_expr_ctxs.push_back(_pool.add(new ExprContext(_pool.add(new ColumnRef(TypeDescriptor(TYPE_INT), 0)))));
+        _build_expr_ctxs.push_back(_pool.add(new ExprContext(_pool.add(new ColumnRef(TypeDescriptor(TYPE_INT), 2)))));
+
+        // Null keys on both sides, probe keys without build rows, build keys without probe rows, and a hot build key
+        // whose rows can't be split by repartitioning.
+        for (int32_t i = 0; i < 600; i++) {
+            std::optional<int32_t> key = i % 7 == 0 ? std::nullopt : std::optional<int32_t>(i % 300 + kMinProbeKey);
+            _probe_rows.emplace_back(key, i);
+        }
+        for (int32_t i = 0; i < 500; i++) {
+            std::optional<int32_t> key = i < 400 ? std::optional<int32_t>(i % 200) : std::optional<int32_t>(7);
+            _build_rows.emplace_back(i % 11 == 0 ? std::nullopt : key, 1000 + i);
+        }
+    }
+
+    void TearDown() override {
+        config::query_scratch_dirs = _old_scratch_dirs;
+        config::spill_mem_limit_threshold = _old_spill_mem_limit_threshold;
+        config::spill_operator_min_bytes = _old_spill_operator_min_bytes;
+    }
+
+protected:
+    using Rows = std::vector<std::pair<std::optional<int32_t>, int32_t>>;
+
+    struct JoinResult {
+        std::vector<std::string> rows;
+        std::shared_ptr<RuntimeProfile> build_profile;
+        std::shared_ptr<RuntimeProfile> probe_profile;
+        // The runtime bloom filter of the build side, nullptr if it isn't built.
+        RuntimeBloomFilter<TYPE_INT>* bloom_filter = nullptr;
+        // The probe keys passing the runtime in-filter, empty if it isn't built.
+        std::vector<int32_t> in_filter_keys;
+    };
+
+    std::shared_ptr<RuntimeState> _create_runtime_state(bool enable_spilling) {
+        TUniqueId fragment_id;
+        TQueryOptions query_options;
+        query_options.batch_size = kChunkSize;
+        query_options.__set_enable_spilling(enable_spilling);
+        TQueryGlobals query_globals;
+        auto state = std::make_shared<RuntimeState>(fragment_id, query_options, query_globals, nullptr);
+        state->init_mem_trackers(std::make_shared<MemTracker>(MemTracker::QUERY, 1L << 40, "query"));
+        return state;
+    }
+
+    static std::vector<ChunkPtr> _create_chunks(const Rows& rows, SlotId key_slot, SlotId value_slot) {
+        std::vector<ChunkPtr> chunks;
+        for (size_t offset = 0; offset < rows.size(); offset += kChunkSize) {
+            auto key_column = ColumnHelper::create_column(TypeDescriptor(TYPE_INT), true);
+            auto value_column = ColumnHelper::create_column(TypeDescriptor(TYPE_INT), true);
+            for (size_t i = offset; i < std::min(rows.size(), offset + kChunkSize); i++) {
+                if (rows[i].first.has_value()) {
+                    key_column->append_datum(Datum(rows[i].first.value()));
+                } else {
+                    (void)key_column->append_nulls(1);
+                }
+                value_column->append_datum(Datum(rows[i].second));
+            }
+            auto chunk = std::make_shared<Chunk>();
+            chunk->append_column(key_column, key_slot);
+            chunk->append_column(value_column, value_slot);
+            chunks.emplace_back(std::move(chunk));
+        }
+        return chunks;
+    }
+
+    RuntimeFilterBuildDescriptor* _create_runtime_filter() {
+        TExprNode slot_ref;
+        slot_ref.node_type = TExprNodeType::SLOT_REF;
+        slot_ref.type = TypeDescriptor(TYPE_INT).to_thrift();
+        slot_ref.num_children = 0;
+        slot_ref.__set_slot_ref(TSlotRef());
+        slot_ref.slot_ref.slot_id = 2;
+        slot_ref.slot_ref.tuple_id = 1;
+        slot_ref.use_vectorized = true;
+        slot_ref.is_nullable = true;
+        TExpr build_expr;
+        build_expr.nodes.emplace_back(slot_ref);
+        TExpr probe_expr = build_expr;
+        probe_expr.nodes[0].slot_ref.slot_id = 0;
+        probe_expr.nodes[0].slot_ref.tuple_id = 0;
+
+        TRuntimeFilterDescription desc;
+        desc.__set_filter_id(1);
+        desc.__set_build_expr(build_expr);
+        desc.__set_expr_order(0);
+        desc.__set_plan_node_id_to_target_expr({{0, probe_expr}});
+        desc.__set_has_remote_targets(false);
+        auto* rf_desc = _pool.add(new RuntimeFilterBuildDescriptor());
+        EXPECT_OK(rf_desc->init(&_pool, desc));
+        return rf_desc;
+    }
+
+    // The filter built by the spilled build side, or otherwise the filter built from the key column of the hash table
+    // as PartialRuntimeFilterMerger does.
+    RuntimeBloomFilter<TYPE_INT>* _get_bloom_filter(const pipeline::RuntimeBloomFilterBuildParam& param) {
+        JoinRuntimeFilter* filter = param.filter;
+        if (filter == nullptr) {
+            filter = RuntimeFilterHelper::create_runtime_bloom_filter(&_pool, TYPE_INT);
+            filter->init(param.column->size());
+            EXPECT_OK(RuntimeFilterHelper::fill_runtime_bloom_filter(param.column, TYPE_INT, filter,
+                                                                     kHashJoinKeyColumnOffset, param.eq_null));
+        }
+        return down_cast<RuntimeBloomFilter<TYPE_INT>*>(filter);
+    }
+
+    static std::vector<int32_t> _get_passed_keys(ExprContext* in_filter) {
+        auto key_column = ColumnHelper::create_column(TypeDescriptor(TYPE_INT), true);
+        for (int32_t key = kMinProbeKey; key <= kMaxProbeKey; key++) {
+            key_column->append_datum(Datum(key));
+        }
+        Chunk chunk;
+        chunk.append_column(key_column, 0);
+        ASSIGN_OR_ABORT(auto result, in_filter->evaluate(&chunk));
+        ColumnViewer<TYPE_BOOLEAN> viewer(result);
+        std::vector<int32_t> keys;
+        for (int32_t key = kMinProbeKey; key <= kMaxProbeKey; key++) {
+            size_t row = key - kMinProbeKey;
+            if (!viewer.is_null(row) && viewer.value(row)) {
+                keys.emplace_back(key);
+            }
+        }
+        return keys;
+    }
+
+    JoinResult _join(TJoinOp::type join_type, bool enable_spilling) {
+        JoinResult result;
+        auto state = _create_runtime_state(enable_spilling);
+        result.build_profile = std::make_shared<RuntimeProfile>("build");
+        result.probe_profile = std::make_shared<RuntimeProfile>("probe");
+
+        THashJoinNode hash_join_node;
+        hash_join_node.join_op = join_type;
+        hash_join_node.is_push_down = true;
+        hash_join_node.__set_distribution_mode(TJoinDistributionMode::PARTITIONED);
+        std::vector<bool> is_null_safes{false};
+        std::list<RuntimeFilterBuildDescriptor*> runtime_filters{_create_runtime_filter()};
+        HashJoinerParam param(&_pool, hash_join_node, 1, TPlanNodeType::HASH_JOIN_NODE, is_null_safes,
+                              _build_expr_ctxs, _probe_expr_ctxs, {}, {}, *_build_row_desc, *_probe_row_desc,
+                              *_row_desc, TPlanNodeType::OLAP_SCAN_NODE, TPlanNodeType::OLAP_SCAN_NODE, true,
+                              runtime_filters, {}, TJoinDistributionMode::PARTITIONED);
+        param._is_buildable = true;
+        std::vector<HashJoinerPtr> read_only_join_probers;
+        auto joiner = std::make_shared<HashJoiner>(param, read_only_join_probers);
+        EXPECT_OK(joiner->prepare_builder(state.get(), result.build_profile.get()));
+        EXPECT_OK(joiner->prepare_prober(state.get(), result.probe_profile.get()));
+
+        for (const auto& chunk : _create_chunks(_build_rows, 2, 3)) {
+            EXPECT_OK(joiner->append_chunk_to_ht(state.get(), chunk));
+        }
+        EXPECT_OK(joiner->build_ht(state.get()));
+        EXPECT_OK(joiner->create_runtime_filters(state.get()));
+        const auto& bloom_filter_params = joiner->get_runtime_bloom_filter_build_params();
+        EXPECT_EQ(1, bloom_filter_params.size());
+        if (bloom_filter_params[0].has_value()) {
+            result.bloom_filter = _get_bloom_filter(bloom_filter_params[0].value());
+        }
+        const auto& in_filters = joiner->get_runtime_in_filters();
+        if (!in_filters.empty() && in_filters[0] != nullptr) {
+            result.in_filter_keys = _get_passed_keys(in_filters[0]);
+        }
+        joiner->enter_probe_phase();
+
+        auto collect = [&](const ChunkPtr& chunk) {
+            for (size_t i = 0; chunk != nullptr && i < chunk->num_rows(); i++) {
+                result.rows.emplace_back(chunk->debug_row(i));
+            }
+        };
+        for (auto& chunk : _create_chunks(_probe_rows, 0, 1)) {
+            if (joiner->is_done()) {
+                break;
+            }
+            EXPECT_OK(joiner->push_chunk(state.get(), std::move(chunk)));
+            while (joiner->has_probe_input()) {
+                ASSIGN_OR_ABORT(auto output, joiner->pull_chunk(state.get()));
+                collect(output);
+            }
+        }
+        joiner->enter_post_probe_phase();
+        while (!joiner->is_done()) {
+            // The spilled partitions may be restored in the background.
+            if (!joiner->has_output()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                continue;
+            }
+            ASSIGN_OR_ABORT(auto output, joiner->pull_chunk(state.get()));
+            collect(output);
+        }
+        joiner->close(state.get());
+
+        std::sort(result.rows.begin(), result.rows.end());
+        return result;
+    }
+
+    static constexpr size_t kChunkSize = 64;
+    static constexpr int32_t kMinProbeKey = -50;
+    static constexpr int32_t kMaxProbeKey = 249;
+
+    ObjectPool _pool;
+    std::unique_ptr<RowDescriptor> _probe_row_desc;
+    std::unique_ptr<RowDescriptor> _build_row_desc;
+    std::unique_ptr<RowDescriptor> _row_desc;
+    std::vector<ExprContext*> _probe_expr_ctxs;
+    std::vector<ExprContext*> _build_expr_ctxs;
+    Rows _probe_rows;
+    Rows _build_rows;
+
+    std::string _old_scratch_dirs;
+    double _old_spill_mem_limit_threshold = 0;
+    int64_t _old_spill_operator_min_bytes = 0;
+};
+
+TEST_F(HashJoinerTest, test_spill_restore_and_repartition) {
+    for (auto join_type : {TJoinOp::INNER_JOIN, TJoinOp::LEFT_OUTER_JOIN, TJoinOp::LEFT_SEMI_JOIN,
+                           TJoinOp::LEFT_ANTI_JOIN, TJoinOp::RIGHT_OUTER_JOIN, TJoinOp::RIGHT_SEMI_JOIN,
+                           TJoinOp::RIGHT_ANTI_JOIN, TJoinOp::FULL_OUTER_JOIN}) {
+        SCOPED_TRACE(to_string(join_type));
+        auto expected = _join(join_type, false);
+        ASSERT_EQ(nullptr, expected.build_profile->get_counter("SpillCount"));
+        ASSERT_FALSE(expected.rows.empty());
+
+        auto actual = _join(join_type, true);
+        auto* spill_count = actual.build_profile->get_counter("SpillCount");
+        ASSERT_NE(nullptr, spill_count);
+        ASSERT_GT(spill_count->value(), 0);
+        ASSERT_GT(actual.build_profile->get_counter("SpilledBuildRows")->value(), 0);
+        ASSERT_GT(actual.probe_profile->get_counter("SpilledProbeRows")->value(), 0);
+        ASSERT_GT(actual.probe_profile->get_counter("SpillRepartitionCount")->value(), 0);
+        ASSERT_EQ(expected.rows, actual.rows);
+    }
+}
+
+TEST_F(HashJoinerTest, test_runtime_filters_after_spill) {
+    auto in_memory = _join(TJoinOp::INNER_JOIN, false);
+    ASSERT_NE(nullptr, in_memory.bloom_filter);
+    // The build keys are 0 to 199.
+    ASSERT_EQ(200, in_memory.in_filter_keys.size());
+
+    // The hash table only contains part of the build side once it has spilled, but the filters are still built from
+    // all the build rows.
+    auto spilled = _join(TJoinOp::INNER_JOIN, true);
+    ASSERT_GT(spilled.build_profile->get_counter("SpillCount")->value(), 0);
+    ASSERT_NE(nullptr, spilled.bloom_filter);
+    ASSERT_EQ(in_memory.bloom_filter->min_value(), spilled.bloom_filter->min_value());
+    ASSERT_EQ(in_memory.bloom_filter->max_value(), spilled.bloom_filter->max_value());
+    for (const auto& [key, value] : _build_rows) {
+        if (key.has_value()) {
+            ASSERT_TRUE(spilled.bloom_filter->test_data(key.value()));
+        }
+    }
+    ASSERT_EQ(in_memory.in_filter_keys, spilled.in_filter_keys);
+    ASSERT_EQ(in_memory.rows, spilled.rows);
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,147 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#include "exec/vectorized/spill/spill_file.h"
+
+#include <gtest/gtest.h>
+
+#include "column/chunk.h"
+#include "column/column_helper.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "common/config.h"
+#include "fs/fs.h"
+#include "runtime/runtime_state.h"
+#include "testutil/assert.h"
+
+namespace starrocks::vectorized {
+
+class SpillFileTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        config::query_scratch_dirs = "./ut_dir/spill_file_test";
+        ASSERT_OK(FileSystem::Default()->create_dir_recursive(config::query_scratch_dirs));
+
+        TUniqueId fragment_id;
+        TQueryOptions query_options;
+        query_options.batch_size = config::vector_chunk_size;
+        TQueryGlobals query_globals;
+        _runtime_state = std::make_shared<RuntimeState>(fragment_id, query_options, query_globals, nullptr);
+        _runtime_state->init_instance_mem_tracker();
+    }
+
+protected:
+    // Build a chunk with an int column [begin, end) and a nullable varchar column.
+    static ChunkPtr _build_chunk(int32_t begin, int32_t end) {
+        auto int_column = ColumnHelper::create_column(TypeDescriptor(TYPE_INT), false);
+        auto str_column = ColumnHelper::create_column(TypeDescriptor::create_varchar_type(32), true);
+        for (int32_t i = begin; i < end; i++) {
+            int_column->append_datum(Datum(i));
+            if (i % 3 == 0) {
+                (void)str_column->append_nulls(1);
+            } else {
+                std::string s = std::to_string(i);
+                str_column->append_datum(Datum(Slice(s)));
+            }
+        }
+        auto chunk = std::make_shared<Chunk>();
+        chunk->append_column(int_column, 0);
+        chunk->append_column(str_column, 1);
+        return chunk;
+    }
+
+    std::shared_ptr<RuntimeState> _runtime_state;
+};
+
+TEST_F(SpillFileTest, test_append_and_read) {
+    ASSIGN_OR_ABORT(auto file, SpillFile::create(_runtime_state.get(), "test"));
+    auto chunk1 = _build_chunk(0, 100);
+    auto chunk2 = _build_chunk(100, 150);
+    ASSERT_OK(file->append(*chunk1));
+    ASSERT_OK(file->append(*chunk2));
+    ASSERT_OK(file->finish());
+    ASSERT_EQ(150, file->num_rows());
+    ASSERT_EQ(2, file->num_chunks());
+    ASSERT_FALSE(file->append(*chunk1).ok());
+
+    for (int round = 0; round < 2; round++) {
+        ASSIGN_OR_ABORT(auto res1, file->read_next());
+        ASSERT_EQ(100, res1->num_rows());
+        for (size_t i = 0; i < res1->num_rows(); i++) {
+            ASSERT_EQ(chunk1->debug_row(i), res1->debug_row(i));
+        }
+        ASSIGN_OR_ABORT(auto res2, file->read_next());
+        ASSERT_EQ(50, res2->num_rows());
+        for (size_t i = 0; i < res2->num_rows(); i++) {
+            ASSERT_EQ(chunk2->debug_row(i), res2->debug_row(i));
+        }
+        ASSERT_TRUE(file->read_next().status().is_end_of_file());
+        file->rewind();
+    }
+
+    auto path = file->path();
+    ASSERT_OK(FileSystem::Default()->path_exists(path));
+    file.reset();
+    ASSERT_TRUE(FileSystem::Default()->path_exists(path).is_not_found());
+}
+
+TEST_F(SpillFileTest, test_different_layout) {
+    ASSIGN_OR_ABORT(auto file, SpillFile::create(_runtime_state.get(), "test"));
+    auto chunk1 = _build_chunk(0, 10);
+    // Same types but the int column becomes nullable.
+    auto chunk2 = _build_chunk(10, 20);
+    auto& int_column = chunk2->get_column_by_index(0);
+    int_column = NullableColumn::create(int_column, NullColumn::create(int_column->size(), 0));
+    ASSERT_OK(file->append(*chunk1));
+    ASSERT_OK(file->append(*chunk2));
+    ASSERT_OK(file->finish());
+
+    ASSIGN_OR_ABORT(auto res1, file->read_next());
+    ASSERT_FALSE(res1->get_column_by_index(0)->is_nullable());
+    ASSIGN_OR_ABORT(auto res2, file->read_next());
+    ASSERT_TRUE(res2->get_column_by_index(0)->is_nullable());
+    ASSERT_EQ(chunk2->debug_row(3), res2->debug_row(3));
+}
+
+TEST_F(SpillFileTest, test_partitioned_writer) {
+    PartitionedSpillWriter writer(_runtime_state.get(), "test", 2);
+    ASSERT_EQ(4, writer.num_partitions());
+    for (int i = 0; i < 10; i++) {
+        auto chunk = _build_chunk(i * 100, (i + 1) * 100);
+        ASSERT_OK(writer.append(*chunk, {chunk->get_column_by_index(0)}));
+    }
+    ASSERT_OK(writer.finish());
+    ASSERT_EQ(1000, writer.spilled_rows());
+
+    // Every key is spilled exactly once, and rows of one partition have the same partition index.
+    std::vector<int> counts(1000, 0);
+    size_t total_rows = 0;
+    for (size_t p = 0; p < writer.num_partitions(); p++) {
+        auto& partition = writer.partition(p);
+        if (partition == nullptr) {
+            continue;
+        }
+        while (true) {
+            auto chunk_or = partition->read_next();
+            if (chunk_or.status().is_end_of_file()) {
+                break;
+            }
+            ASSERT_OK(chunk_or.status());
+            auto& chunk = chunk_or.value();
+            std::vector<uint32_t> partition_index;
+            PartitionedSpillWriter::compute_partition_index({chunk->get_column_by_index(0)}, chunk->num_rows(), 2,
+                                                            0, &partition_index);
+            auto* keys = down_cast<Int32Column*>(chunk->get_column_by_index(0).get());
+            for (size_t i = 0; i < chunk->num_rows(); i++) {
+                ASSERT_EQ(p, partition_index[i]);
+                counts[keys->get_data()[i]]++;
+            }
+            total_rows += chunk->num_rows();
+        }
+    }
+    ASSERT_EQ(1000, total_rows);
+    for (auto count : counts) {
+        ASSERT_EQ(1, count);
+    }
+}
+
+} // namespace starrocks::vectorized
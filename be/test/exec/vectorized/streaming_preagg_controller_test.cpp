@@ -0,0 +1,64 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#include "exec/vectorized/aggregate/streaming_preagg_controller.h"
+
+#include <gtest/gtest.h>
+
+namespace starrocks::vectorized {
+
+TEST(StreamingPreaggControllerTest, SwitchByReductionRatio) {
+    // Window of 4 chunks, pass through at most 4 windows.
+    StreamingPreaggController controller(4096, 2.0, 4 * 4096);
+    for (int i = 0; i < 4; i++) {
+        ASSERT_TRUE(controller.should_aggregate());
+        // Every key appears 4 times.
+        ASSERT_FALSE(controller.update(1024, 256));
+    }
+    ASSERT_DOUBLE_EQ(4.0, controller.reduction_ratio());
+
+    // Almost unique keys, switch to passing through after the window.
+    for (int i = 0; i < 3; i++) {
+        ASSERT_FALSE(controller.update(1024, 1000));
+    }
+    ASSERT_TRUE(controller.update(1024, 1000));
+    ASSERT_FALSE(controller.should_aggregate());
+    ASSERT_EQ(1, controller.num_switches());
+
+    // Probe the locality after passing through a window.
+    for (int i = 0; i < 3; i++) {
+        ASSERT_FALSE(controller.update(1024, 1024));
+    }
+    ASSERT_TRUE(controller.update(1024, 1024));
+    ASSERT_TRUE(controller.should_aggregate());
+    ASSERT_EQ(4096, controller.num_bypassed_rows());
+
+    // Failed probing doubles the rows to pass through.
+    ASSERT_TRUE(controller.update(4096, 4096));
+    ASSERT_FALSE(controller.should_aggregate());
+    ASSERT_FALSE(controller.update(4096, 4096));
+    ASSERT_TRUE(controller.update(4096, 4096));
+    ASSERT_TRUE(controller.should_aggregate());
+
+    // The locality is improved, keep aggregating.
+    ASSERT_FALSE(controller.update(4096, 0));
+    ASSERT_TRUE(controller.should_aggregate());
+    ASSERT_EQ(4, controller.num_switches());
+    ASSERT_EQ(3 * 4096, controller.num_bypassed_rows());
+}
+
+TEST(StreamingPreaggControllerTest, MaxBypassRows) {
+    StreamingPreaggController controller(100, 2.0, 300);
+    ASSERT_TRUE(controller.update(100, 100));
+    // 100, 200, 300, 300 rows are passed through between probings.
+    for (size_t bypass_rows : {100, 200, 300, 300}) {
+        ASSERT_FALSE(controller.should_aggregate());
+        for (size_t i = 0; i + 1 < bypass_rows / 100; i++) {
+            ASSERT_FALSE(controller.update(100, 100));
+        }
+        ASSERT_TRUE(controller.update(100, 100));
+        ASSERT_TRUE(controller.should_aggregate());
+        ASSERT_TRUE(controller.update(100, 100));
+    }
+}
+
+} // namespace starrocks::vectorized
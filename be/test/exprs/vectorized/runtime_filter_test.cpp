@@ -10,6 +10,7 @@
 #include "column/column_helper.h"
 #include "exprs/vectorized/runtime_filter_bank.h"
 #include "simd/simd.h"
+#include "testutil/assert.h"
 
 namespace starrocks {
 namespace vectorized {
@@ -182,6 +183,8 @@ TEST_F(RuntimeFilterTest, TestJoinRuntimeFilterSerialize) {
     std::vector<uint8_t> buffer(max_size, 0);
     size_t actual_size = RuntimeFilterHelper::serialize_runtime_filter(rf0, buffer.data());
     buffer.resize(actual_size);
+    // The filters not partitioned by bucket keep the format of the BEs without bucket local runtime filters.
+    EXPECT_EQ(RF_VERSION_V2, buffer[0]);
 
     JoinRuntimeFilter* rf1 = nullptr;
     ObjectPool pool;
@@ -593,5 +596,112 @@ TEST_F(RuntimeFilterTest, TestGlobalRuntimeFilterMinMax) {
     EXPECT_EQ(global->max_value(), 33);
 }
 
+TEST_F(RuntimeFilterTest, TestRuntimeFilterSampleStats) {
+    RuntimeFilterSampleStats stats;
+    EXPECT_EQ(1.0, stats.keep_ratio());
+    stats.update(1000, 100, 2000, 4000);
+    stats.update(1000, 300, 2000, 4000);
+    EXPECT_DOUBLE_EQ(0.2, stats.keep_ratio());
+    EXPECT_DOUBLE_EQ(0.4, stats.rank());
+
+    // The stats are halved at the end of window, the recent samples weigh more.
+    stats.update(2000, 2000, 4000, 4000);
+    EXPECT_EQ(2000, stats.input_rows);
+    EXPECT_EQ(1200, stats.output_rows);
+    EXPECT_EQ(4000, stats.eval_ns);
+    EXPECT_DOUBLE_EQ(0.6, stats.keep_ratio());
+}
+
+TEST_F(RuntimeFilterTest, TestBucketLocalRuntimeFilter) {
+    static constexpr size_t num_buckets = 6;
+    auto values = Int32Column::create();
+    for (int32_t i = 0; i < 1000; i++) {
+        values->append(i * 2);
+    }
+    std::vector<uint32_t> buckets(values->size(), 0);
+    values->crc32_hash(buckets.data(), 0, values->size());
+    // buckets [0, 3) are built by the first instance, and [3, 6) by the second.
+    auto build0 = Int32Column::create();
+    auto build1 = Int32Column::create();
+    for (size_t i = 0; i < values->size(); i++) {
+        auto* build = (buckets[i] % num_buckets) < 3 ? build0.get() : build1.get();
+        build->append(values->get_data()[i]);
+    }
+
+    ObjectPool pool;
+    std::vector<std::string> serialized_rfs;
+    for (const auto& build : {build0, build1}) {
+        JoinRuntimeFilter* rf = RuntimeFilterHelper::create_runtime_bloom_filter(&pool, TYPE_INT);
+        rf->set_join_mode(TRuntimeFilterBuildJoinMode::COLOCATE);
+        ASSERT_OK(RuntimeFilterHelper::fill_runtime_bloom_filter_by_bucket({build}, TYPE_INT, rf, 0, false,
+                                                                           num_buckets));
+        ASSERT_TRUE(rf->is_partitioned_by_bucket());
+        ASSERT_EQ(build->size(), rf->size());
+        std::string data(RuntimeFilterHelper::max_runtime_filter_serialized_size(rf), 0);
+        data.resize(RuntimeFilterHelper::serialize_runtime_filter(rf, (uint8_t*)data.data()));
+        ASSERT_EQ(RF_VERSION_V3, (uint8_t)data[0]);
+        serialized_rfs.emplace_back(std::move(data));
+    }
+
+    RuntimeBloomFilter<TYPE_INT> grf;
+    JoinRuntimeFilter* rf0 = nullptr;
+    for (const auto& data : serialized_rfs) {
+        JoinRuntimeFilter* rf = nullptr;
+        RuntimeFilterHelper::deserialize_runtime_filter(&pool, &rf, (const uint8_t*)data.data(), data.size());
+        ASSERT_TRUE(rf != nullptr);
+        rf0 = rf0 == nullptr ? rf : rf0;
+        grf.concat(rf);
+    }
+    ASSERT_TRUE(grf.is_partitioned_by_bucket());
+    ASSERT_EQ(values->size(), grf.size());
+    ASSERT_EQ(std::vector<uint8_t>({1, 1, 1, 0, 0, 0}), rf0->built_buckets());
+
+    auto evaluate = [](JoinRuntimeFilter* rf, Column* column) {
+        JoinRuntimeFilter::RunningContext running_ctx;
+        running_ctx.selection.assign(column->size(), 1);
+        running_ctx.use_merged_selection = false;
+        rf->evaluate(column, &running_ctx);
+        return SIMD::count_nonzero(running_ctx.selection.data(), column->size());
+    };
+    ASSERT_EQ(values->size(), evaluate(&grf, values.get()));
+    auto negative_values = Int32Column::create();
+    for (int32_t i = 0; i < 1000; i++) {
+        negative_values->append(i * 2 + 1);
+    }
+    ASSERT_LE(evaluate(&grf, negative_values.get()), 100);
+
+    // only ship the buckets of the first instance, the other buckets pass all rows.
+    std::string full(RuntimeFilterHelper::max_runtime_filter_serialized_size(&grf), 0);
+    full.resize(RuntimeFilterHelper::serialize_runtime_filter(&grf, (uint8_t*)full.data()));
+    grf.set_shipped_buckets({1, 1, 1, 0, 0, 0});
+    std::string trimmed(RuntimeFilterHelper::max_runtime_filter_serialized_size(&grf), 0);
+    trimmed.resize(RuntimeFilterHelper::serialize_runtime_filter(&grf, (uint8_t*)trimmed.data()));
+    ASSERT_LT(trimmed.size(), full.size());
+
+    JoinRuntimeFilter* local_rf = nullptr;
+    RuntimeFilterHelper::deserialize_runtime_filter(&pool, &local_rf, (const uint8_t*)trimmed.data(), trimmed.size());
+    ASSERT_TRUE(local_rf != nullptr);
+    ASSERT_EQ(build0->size(), evaluate(local_rf, build0.get()));
+    ASSERT_EQ(build1->size(), evaluate(local_rf, build1.get()));
+}
+
+TEST_F(RuntimeFilterTest, TestSelectRuntimeFilters) {
+    std::map<int32_t, RuntimeFilterSampleStats> stats;
+    // Selective but expensive.
+    stats[1] = {1000, 10, 100000};
+    // Less selective but cheap.
+    stats[2] = {1000, 200, 1000};
+    // Keep most of rows.
+    stats[3] = {1000, 900, 100};
+    // Not sampled yet.
+    stats[4] = {0, 0, 0};
+    stats[5] = {1000, 400, 5000};
+
+    EXPECT_EQ(std::vector<int32_t>({2, 5, 1}), select_runtime_filters(stats, 0.5, 3));
+    EXPECT_EQ(std::vector<int32_t>({2, 5}), select_runtime_filters(stats, 0.5, 2));
+    EXPECT_EQ(std::vector<int32_t>({3, 2, 5, 1}), select_runtime_filters(stats, 1.0, 5));
+    EXPECT_TRUE(select_runtime_filters(stats, 0.005, 3).empty());
+}
+
 } // namespace vectorized
 } // namespace starrocks
@@ -0,0 +1,141 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#include "fs/block_cache.h"
+
+#include <gtest/gtest.h>
+
+#include "fs/fs.h"
+#include "testutil/assert.h"
+
+namespace starrocks {
+
+class BlockCacheTest : public ::testing::Test {
+protected:
+    static constexpr int64_t kBlockSize = 1024;
+
+    void SetUp() override {
+        auto fs = FileSystem::Default();
+        (void)fs->delete_dir_recursive(_root);
+        ASSERT_OK(fs->create_dir_recursive(_root));
+        // 2.5 blocks
+        _content.resize(kBlockSize * 5 / 2);
+        for (size_t i = 0; i < _content.size(); i++) {
+            _content[i] = static_cast<char>('a' + i % 26);
+        }
+        ASSIGN_OR_ABORT(auto wf, fs->new_writable_file(_data_file));
+        ASSERT_OK(wf->append(_content));
+        ASSERT_OK(wf->close());
+    }
+
+    void TearDown() override {
+        _cache.shutdown();
+        (void)FileSystem::Default()->delete_dir_recursive(_root);
+    }
+
+    std::unique_ptr<BlockCacheInputStream> _open() {
+        auto file = *FileSystem::Default()->new_random_access_file(_data_file);
+        return std::make_unique<BlockCacheInputStream>(file->stream(), _data_file, &_cache);
+    }
+
+    std::string _read_at(io::SeekableInputStream* stream, int64_t offset, int64_t count) {
+        std::string buff(count, '\0');
+        auto st = stream->read_at_fully(offset, buff.data(), count);
+        CHECK(st.ok()) << st;
+        return buff;
+    }
+
+    std::string _root = "./ut_dir/block_cache_test";
+    std::string _cache_dir = _root + "/cache";
+    std::string _data_file = _root + "/data";
+    std::string _content;
+    BlockCache _cache;
+};
+
+TEST_F(BlockCacheTest, test_read_through) {
+    ASSERT_OK(_cache.init(_cache_dir, 1024 * 1024, kBlockSize, 1));
+    auto stream = _open();
+
+    // Cross the boundary of the first two blocks.
+    ASSERT_EQ(_content.substr(1000, 100), _read_at(stream.get(), 1000, 100));
+    ASSERT_EQ(0, stream->hit_bytes());
+    ASSERT_EQ(100, stream->miss_bytes());
+    _cache.wait_for_populating();
+    ASSERT_EQ(2, _cache.num_blocks());
+
+    ASSERT_EQ(_content.substr(1000, 100), _read_at(stream.get(), 1000, 100));
+    ASSERT_EQ(100, stream->hit_bytes());
+    // The last block is shorter than the block size.
+    ASSERT_EQ(_content.substr(2048), _read_at(stream.get(), 2048, _content.size() - 2048));
+    ASSERT_EQ(_content.size() - 2048 + 100, stream->miss_bytes());
+    _cache.wait_for_populating();
+    ASSERT_EQ(3, _cache.num_blocks());
+
+    // Sequential read and read beyond the end of file.
+    ASSERT_OK(stream->seek(0));
+    std::string buff(_content.size() + 10, '\0');
+    ASSIGN_OR_ABORT(auto nread, stream->read(buff.data(), buff.size()));
+    ASSERT_EQ(_content.size(), nread);
+    buff.resize(nread);
+    ASSERT_EQ(_content, buff);
+    ASSERT_FALSE(stream->read_at_fully(2000, buff.data(), 1000).ok());
+
+    ASSIGN_OR_ABORT(auto stats, stream->get_numeric_statistics());
+    ASSERT_EQ(2, stats->size());
+    ASSERT_EQ("BlockCacheHitBytes", stats->name(0));
+    ASSERT_EQ(stream->hit_bytes(), stats->value(0));
+    ASSERT_EQ("BlockCacheMissBytes", stats->name(1));
+    ASSERT_EQ(stream->miss_bytes(), stats->value(1));
+}
+
+TEST_F(BlockCacheTest, test_evict) {
+    // Room for about two blocks.
+    ASSERT_OK(_cache.init(_cache_dir, 2 * kBlockSize + 512, kBlockSize, 1));
+    auto stream = _open();
+    for (int64_t offset = 0; offset < 3 * kBlockSize; offset += kBlockSize) {
+        (void)_read_at(stream.get(), offset, 10);
+        _cache.wait_for_populating();
+    }
+    ASSERT_EQ(2, _cache.num_blocks());
+    ASSERT_LE(_cache.size(), _cache.capacity());
+
+    // The first block has been evicted.
+    int64_t miss_bytes = stream->miss_bytes();
+    ASSERT_EQ(_content.substr(0, 10), _read_at(stream.get(), 0, 10));
+    ASSERT_EQ(miss_bytes + 10, stream->miss_bytes());
+    ASSERT_EQ(_content.substr(2048, 10), _read_at(stream.get(), 2048, 10));
+    ASSERT_EQ(miss_bytes + 10, stream->miss_bytes());
+}
+
+TEST_F(BlockCacheTest, test_reload) {
+    ASSERT_OK(_cache.init(_cache_dir, 1024 * 1024, kBlockSize, 1));
+    {
+        auto stream = _open();
+        (void)_read_at(stream.get(), 0, _content.size());
+        _cache.wait_for_populating();
+    }
+    ASSERT_EQ(3, _cache.num_blocks());
+    int64_t size = _cache.size();
+    _cache.shutdown();
+    ASSERT_EQ(0, _cache.num_blocks());
+
+    // A partially written file and a file of unknown name.
+    ASSIGN_OR_ABORT(auto wf, FileSystem::Default()->new_writable_file(_cache_dir + "/0123456789abcdef_0.tmp"));
+    ASSERT_OK(wf->append("xx"));
+    ASSERT_OK(wf->close());
+
+    ASSERT_OK(_cache.init(_cache_dir, 1024 * 1024, kBlockSize, 1));
+    ASSERT_EQ(3, _cache.num_blocks());
+    ASSERT_EQ(size, _cache.size());
+    ASSERT_TRUE(FileSystem::Default()->path_exists(_cache_dir + "/0123456789abcdef_0.tmp").is_not_found());
+
+    auto stream = _open();
+    ASSERT_EQ(_content, _read_at(stream.get(), 0, _content.size()));
+    ASSERT_EQ(_content.size(), stream->hit_bytes());
+    ASSERT_EQ(0, stream->miss_bytes());
+
+    // Blocks of another file with the same name are not mixed up.
+    std::string buff(10, '\0');
+    ASSERT_TRUE(_cache.read(_data_file + "_other", 0, 0, buff.data(), buff.size()).is_not_found());
+}
+
+} // namespace starrocks
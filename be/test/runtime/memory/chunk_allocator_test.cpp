@@ -23,11 +23,22 @@
 
 #include <gtest/gtest.h>
 
+#include <sched.h>
+
 #include "common/config.h"
 #include "runtime/memory/chunk.h"
+#include "util/cpu_info.h"
+#include "util/defer_op.h"
 
 namespace starrocks {
 
+class CpuTestUtil {
+public:
+    static void init_fake_numa(int max_num_numa_nodes, const std::vector<int>& core_to_numa_node) {
+        CpuInfo::_init_fake_numa_for_test(max_num_numa_nodes, core_to_numa_node);
+    }
+};
+
 TEST(ChunkAllocatorTest, Normal) {
     config::use_mmap_allocate_chunk = true;
     for (size_t size = 4096; size <= 1024 * 1024; size <<= 1) {
@@ -38,4 +49,50 @@ TEST(ChunkAllocatorTest, Normal) {
         ChunkAllocator::instance()->free(chunk);
     }
 }
+
+TEST(ChunkAllocatorTest, numa_aware) {
+    CpuInfo::init();
+    const int num_cores = CpuInfo::get_max_num_cores();
+    if (num_cores < 3) {
+        GTEST_SKIP() << "not enough cores";
+    }
+    const int num_numa_nodes = CpuInfo::get_max_num_numa_nodes();
+    std::vector<int> core_to_numa_node(num_cores);
+    std::vector<int> fake_core_to_numa_node(num_cores);
+    for (int i = 0; i < num_cores; ++i) {
+        core_to_numa_node[i] = CpuInfo::get_numa_node_of_core(i);
+        fake_core_to_numa_node[i] = i % 2;
+    }
+    cpu_set_t cpu_set;
+    ASSERT_EQ(0, sched_getaffinity(0, sizeof(cpu_set), &cpu_set));
+    CpuTestUtil::init_fake_numa(2, fake_core_to_numa_node);
+    config::enable_numa_aware_execution = true;
+    DeferOp restore([&]() {
+        config::enable_numa_aware_execution = false;
+        CpuTestUtil::init_fake_numa(num_numa_nodes, core_to_numa_node);
+        sched_setaffinity(0, sizeof(cpu_set), &cpu_set);
+    });
+    if (!CpuInfo::bind_current_thread_to_numa_node(0)) {
+        GTEST_SKIP() << "cannot bind thread to the cores of fake NUMA node";
+    }
+    ASSERT_EQ(0, CpuInfo::get_numa_node_of_core(CpuInfo::get_current_core()));
+
+    ChunkAllocator allocator(nullptr, 1024 * 1024);
+    Chunk remote_chunk;
+    Chunk local_chunk;
+    ASSERT_TRUE(allocator.allocate(4096, &remote_chunk));
+    ASSERT_TRUE(allocator.allocate(4096, &local_chunk));
+    // Return the chunks to the arenas of a remote core and a local core.
+    remote_chunk.core_id = 1;
+    local_chunk.core_id = 2;
+    allocator.free(remote_chunk);
+    allocator.free(local_chunk);
+
+    Chunk chunk;
+    ASSERT_TRUE(allocator.allocate(4096, &chunk));
+    ASSERT_EQ(local_chunk.data, chunk.data);
+    ASSERT_EQ(0, CpuInfo::get_numa_node_of_core(chunk.core_id));
+    allocator.free(chunk);
+}
+
 } // namespace starrocks
@@ -0,0 +1,131 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#include "serde/encoded_column_serde.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+
+#include "column/binary_column.h"
+#include "column/const_column.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "serde/column_array_serde.h"
+#include "testutil/parallel_test.h"
+
+namespace starrocks::serde {
+
+namespace {
+
+// Serialize |c1| and deserialize it into |c2|, return the serialized size.
+size_t serde_column(const vectorized::Column& c1, vectorized::Column* c2) {
+    std::vector<uint8_t> buffer(EncodedColumnSerde::max_serialized_size(c1));
+    auto p1 = EncodedColumnSerde::serialize(c1, buffer.data());
+    EXPECT_TRUE(p1 != nullptr);
+    auto p2 = EncodedColumnSerde::deserialize(buffer.data(), c2);
+    EXPECT_EQ(p1, p2);
+    EXPECT_LE(static_cast<size_t>(p1 - buffer.data()), buffer.size());
+
+    EXPECT_EQ(c1.size(), c2->size());
+    for (size_t i = 0; i < c1.size(); i++) {
+        EXPECT_EQ(0, c1.compare_at(i, i, *c2, 1)) << "row " << i;
+    }
+    return p1 - buffer.data();
+}
+
+} // namespace
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(EncodedColumnSerdeTest, bit_packed_column) {
+    auto c1 = vectorized::Int32Column::create();
+    for (int i = 0; i < 1000; i++) {
+        c1->append(-300 + i % 200);
+    }
+    auto c2 = vectorized::Int32Column::create();
+    // 8 bits per value.
+    ASSERT_EQ(1 + 13 + 1000, serde_column(*c1, c2.get()));
+
+    auto c3 = vectorized::Int64Column::create();
+    for (int i = 0; i < 1000; i++) {
+        c3->append(i % 2 == 0 ? std::numeric_limits<int64_t>::min() : std::numeric_limits<int64_t>::max());
+    }
+    // falls back to plain.
+    auto c4 = vectorized::Int64Column::create();
+    ASSERT_EQ(1 + ColumnArraySerde::max_serialized_size(*c3), serde_column(*c3, c4.get()));
+
+    auto c5 = vectorized::Int16Column::create();
+    for (int i = 0; i < 100; i++) {
+        c5->append(7);
+    }
+    // all the values are the same.
+    auto c6 = vectorized::Int16Column::create();
+    ASSERT_EQ(1 + 13, serde_column(*c5, c6.get()));
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(EncodedColumnSerdeTest, dict_binary_column) {
+    auto c1 = vectorized::BinaryColumn::create();
+    for (int i = 0; i < 1000; i++) {
+        c1->append(Slice("value_" + std::to_string(i % 10)));
+    }
+    auto c2 = vectorized::BinaryColumn::create();
+    size_t size = serde_column(*c1, c2.get());
+    ASSERT_LT(size, ColumnArraySerde::max_serialized_size(*c1) / 10);
+
+    auto c3 = vectorized::BinaryColumn::create();
+    for (int i = 0; i < 1000; i++) {
+        c3->append(Slice("value_" + std::to_string(i)));
+    }
+    // falls back to plain.
+    auto c4 = vectorized::BinaryColumn::create();
+    ASSERT_EQ(1 + ColumnArraySerde::max_serialized_size(*c3), serde_column(*c3, c4.get()));
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(EncodedColumnSerdeTest, nullable_column) {
+    // no null.
+    auto c1 = vectorized::NullableColumn::create(vectorized::Int32Column::create(), vectorized::NullColumn::create());
+    for (int i = 0; i < 1000; i++) {
+        c1->append_datum(vectorized::Datum(i));
+    }
+    auto c2 = vectorized::NullableColumn::create(vectorized::Int32Column::create(), vectorized::NullColumn::create());
+    ASSERT_EQ(1 + 1 + 1 + 13 + 1250, serde_column(*c1, c2.get()));
+    ASSERT_FALSE(c2->has_null());
+
+    // long runs of nulls.
+    auto c3 = vectorized::NullableColumn::create(vectorized::Int32Column::create(), vectorized::NullColumn::create());
+    for (int i = 0; i < 1000; i++) {
+        if (i / 100 % 2 == 0) {
+            c3->append_nulls(1);
+        } else {
+            c3->append_datum(vectorized::Datum(i));
+        }
+    }
+    auto c4 = vectorized::NullableColumn::create(vectorized::Int32Column::create(), vectorized::NullColumn::create());
+    size_t size = serde_column(*c3, c4.get());
+    ASSERT_LT(size, ColumnArraySerde::max_serialized_size(*c3) / 2);
+    ASSERT_TRUE(c4->has_null());
+
+    // random nulls.
+    auto c5 = vectorized::NullableColumn::create(vectorized::BinaryColumn::create(), vectorized::NullColumn::create());
+    for (int i = 0; i < 1000; i++) {
+        if (i % 3 == 0) {
+            c5->append_nulls(1);
+        } else {
+            c5->append_datum(vectorized::Datum(Slice(std::to_string(i))));
+        }
+    }
+    auto c6 = vectorized::NullableColumn::create(vectorized::BinaryColumn::create(), vectorized::NullColumn::create());
+    serde_column(*c5, c6.get());
+}
+
+// NOLINTNEXTLINE
+PARALLEL_TEST(EncodedColumnSerdeTest, const_column) {
+    auto data = vectorized::Int32Column::create();
+    data->append(10);
+    auto c1 = vectorized::ConstColumn::create(data, 100);
+    auto c2 = vectorized::ConstColumn::create(vectorized::Int32Column::create(), 0);
+    ASSERT_EQ(1 + ColumnArraySerde::max_serialized_size(*c1), serde_column(*c1, c2.get()));
+}
+
+} // namespace starrocks::serde
@@ -0,0 +1,131 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "column/binary_column.h"
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "runtime/types.h"
+#include "serde/protobuf_serde.h"
+
+namespace starrocks::serde {
+
+// Compare the bytes on the wire and the CPU per row of the serialized chunks of exchange, with the columns
+// serialized by ColumnArraySerde (plain) and by EncodedColumnSerde (encoded).
+
+static constexpr size_t kNumRows = 4096;
+
+enum DataSet {
+    // BIGINT keys in a narrow range.
+    kNarrowInts = 0,
+    // VARCHAR of 100 distinct values.
+    kLowCardStrings = 1,
+    // VARCHAR of distinct values.
+    kHighCardStrings = 2,
+    // nullable INT with long runs of nulls.
+    kNullableInts = 3,
+};
+
+static vectorized::ColumnPtr make_column(DataSet data_set, TypeDescriptor* type, bool* is_null) {
+    std::mt19937 rng(0);
+    *is_null = false;
+    switch (data_set) {
+    case kNarrowInts: {
+        *type = TypeDescriptor(TYPE_BIGINT);
+        auto column = vectorized::Int64Column::create();
+        for (size_t i = 0; i < kNumRows; i++) {
+            column->append(1000000 + rng() % 10000);
+        }
+        return column;
+    }
+    case kLowCardStrings:
+    case kHighCardStrings: {
+        *type = TypeDescriptor::create_varchar_type(64);
+        auto column = vectorized::BinaryColumn::create();
+        const size_t cardinality = data_set == kLowCardStrings ? 100 : kNumRows * 100;
+        for (size_t i = 0; i < kNumRows; i++) {
+            column->append(Slice("shipping_mode_" + std::to_string(rng() % cardinality)));
+        }
+        return column;
+    }
+    case kNullableInts: {
+        *type = TypeDescriptor(TYPE_INT);
+        *is_null = true;
+        auto column =
+                vectorized::NullableColumn::create(vectorized::Int32Column::create(), vectorized::NullColumn::create());
+        for (size_t i = 0; i < kNumRows; i++) {
+            if (i / 256 % 4 == 0) {
+                column->append_nulls(1);
+            } else {
+                column->append_datum(vectorized::Datum(static_cast<int32_t>(rng() % 100000)));
+            }
+        }
+        return column;
+    }
+    }
+    return nullptr;
+}
+
+struct BenchData {
+    vectorized::ChunkPtr chunk;
+    ProtobufChunkMeta meta;
+};
+
+static BenchData make_bench_data(DataSet data_set) {
+    BenchData data;
+    TypeDescriptor type;
+    bool is_null = false;
+    auto column = make_column(data_set, &type, &is_null);
+    data.chunk = std::make_shared<vectorized::Chunk>();
+    data.chunk->append_column(column, 0);
+    data.meta.slot_id_to_index[0] = 0;
+    data.meta.types.emplace_back(type);
+    data.meta.is_nulls.emplace_back(is_null);
+    data.meta.is_consts.emplace_back(false);
+    return data;
+}
+
+static void BM_serialize(benchmark::State& state) {
+    auto data = make_bench_data(static_cast<DataSet>(state.range(0)));
+    const bool encode = state.range(1);
+    size_t bytes = 0;
+    for (auto _ : state) {
+        auto res = ProtobufChunkSerde::serialize_without_meta(*data.chunk, encode);
+        bytes = res->serialized_size();
+        benchmark::DoNotOptimize(res);
+    }
+    state.counters["bytes_per_row"] = static_cast<double>(bytes) / kNumRows;
+    state.SetItemsProcessed(state.iterations() * kNumRows);
+}
+
+static void BM_deserialize(benchmark::State& state) {
+    auto data = make_bench_data(static_cast<DataSet>(state.range(0)));
+    const bool encode = state.range(1);
+    auto res = ProtobufChunkSerde::serialize_without_meta(*data.chunk, encode);
+    ProtobufChunkDeserializer deserializer(data.meta);
+    for (auto _ : state) {
+        auto chunk = deserializer.deserialize(res->data());
+        benchmark::DoNotOptimize(chunk);
+    }
+    state.counters["bytes_per_row"] = static_cast<double>(res->serialized_size()) / kNumRows;
+    state.SetItemsProcessed(state.iterations() * kNumRows);
+}
+
+// Args: data set, whether to encode columns.
+static void CustomArgs(benchmark::internal::Benchmark* b) {
+    for (int data_set = kNarrowInts; data_set <= kNullableInts; data_set++) {
+        for (int encode = 0; encode <= 1; encode++) {
+            b->Args({data_set, encode});
+        }
+    }
+}
+
+BENCHMARK(BM_serialize)->Apply(CustomArgs);
+BENCHMARK(BM_deserialize)->Apply(CustomArgs);
+
+} // namespace starrocks::serde
+
+BENCHMARK_MAIN();
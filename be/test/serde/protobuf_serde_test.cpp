@@ -83,4 +83,35 @@ PARALLEL_TEST(ProtobufChunkSerde, test_serde) {
     }
 }
 
+// NOLINTNEXTLINE
+PARALLEL_TEST(ProtobufChunkSerde, test_serde_encoded) {
+    auto chunk = std::make_unique<vectorized::Chunk>(make_columns(2), make_schema(2));
+
+    StatusOr<ChunkPB> res = serde::ProtobufChunkSerde::serialize_without_meta(*chunk, true);
+    ASSERT_TRUE(res.ok()) << res.status();
+    const std::string& serialized_data = res->data();
+    ASSERT_LT(serialized_data.size(), serde::ProtobufChunkSerde::max_serialized_size(*chunk));
+    ASSERT_EQ(serialized_data.size(), res->serialized_size());
+
+    ProtobufChunkMeta meta;
+    meta.slot_id_to_index[0] = 0;
+    meta.slot_id_to_index[1] = 1;
+    meta.is_nulls.resize(2, false);
+    meta.is_consts.resize(2, false);
+    meta.types.resize(2);
+    meta.types[0] = TypeDescriptor(PrimitiveType::TYPE_INT);
+    meta.types[1] = TypeDescriptor(PrimitiveType::TYPE_INT);
+
+    ProtobufChunkDeserializer deserializer(meta);
+    auto chunk_or = deserializer.deserialize(serialized_data);
+    ASSERT_TRUE(chunk_or.ok()) << chunk_or.status();
+    vectorized::Chunk& new_chunk = *chunk_or;
+    ASSERT_EQ(new_chunk.num_rows(), chunk->num_rows());
+    for (size_t i = 0; i < chunk->columns().size(); ++i) {
+        for (size_t j = 0; j < chunk->columns()[i]->size(); ++j) {
+            ASSERT_EQ(chunk->columns()[i]->get(j).get_int32(), new_chunk.columns()[i]->get(j).get_int32());
+        }
+    }
+}
+
 } // namespace starrocks::serde
@@ -375,6 +375,57 @@ TEST_P(ConjunctiveTestFixture, test_parse_conjuncts) {
     }
 }
 
+// translate the runtime filter arrived after the conjuncts are parsed into storage predicates
+// NOLINTNEXTLINE
+TEST_F(ConjunctiveTestFixture, test_runtime_filter_range_pruner) {
+    MemTracker mem_tracker;
+    TupleDescriptor* tuple_desc = _create_tuple_desc(TYPE_INT);
+    std::vector<std::string> key_column_names = {"c1"};
+    SlotDescriptor* slot = tuple_desc->slots()[0];
+    std::vector<ExprContext*> conjunct_ctxs;
+    auto tablet_schema = TabletSchema::create(&mem_tracker, create_tablet_schema(TYPE_INT));
+
+    auto* desc = _pool.add(new RuntimeFilterProbeDescriptor());
+    ASSERT_OK(desc->init(1, _pool.add(new ExprContext(_pool.add(new ColumnRef(slot))))));
+    auto* runtime_filters = _pool.add(new RuntimeFilterProbeCollector());
+    runtime_filters->add_descriptor(desc);
+
+    OlapScanConjunctsManager cm;
+    cm.conjunct_ctxs_ptr = &conjunct_ctxs;
+    cm.tuple_desc = tuple_desc;
+    cm.obj_pool = &_pool;
+    cm.key_column_names = &key_column_names;
+    cm.runtime_filters = runtime_filters;
+    cm.runtime_state = nullptr;
+    ASSERT_OK(cm.parse_conjuncts(true, 1));
+    ASSERT_TRUE(cm.get_normalized_runtime_filters().empty());
+
+    RuntimeFilterRangePruner pruner(cm, *tablet_schema);
+    ASSERT_FALSE(pruner.empty());
+    ASSIGN_OR_ABORT(auto preds, pruner.arrived_predicates());
+    ASSERT_TRUE(preds->empty());
+
+    RuntimeBloomFilter<TYPE_INT> bf;
+    bf.init(10);
+    for (int32_t v : {10, 15, 20}) {
+        bf.insert(&v);
+    }
+    desc->set_runtime_filter(&bf);
+
+    ASSIGN_OR_ABORT(preds, pruner.arrived_predicates());
+    ASSERT_EQ(1, preds->size());
+    ASSERT_EQ(1, preds->count(0));
+    const auto& col_preds = preds->at(0);
+    ASSERT_EQ(2, col_preds.size());
+    ASSERT_EQ(PredicateType::kGE, col_preds[0]->type());
+    ASSERT_EQ(PredicateType::kLE, col_preds[1]->type());
+    ASSERT_TRUE(col_preds[0]->is_index_filter_only());
+
+    // The arrived runtime filter is translated only once.
+    ASSIGN_OR_ABORT(preds, pruner.arrived_predicates());
+    ASSERT_EQ(2, preds->at(0).size());
+}
+
 INSTANTIATE_TEST_SUITE_P(ConjunctiveTest, ConjunctiveTestFixture,
                          testing::Combine(testing::Values(TExprOpcode::LT, TExprOpcode::LE, TExprOpcode::GT,
                                                           TExprOpcode::GE, TExprOpcode::EQ, TExprOpcode::NE),
@@ -23,7 +23,10 @@
 
 #include <gtest/gtest.h>
 
+#include "fs/fs.h"
 #include "runtime/mem_tracker.h"
+#include "storage/page_disk_cache.h"
+#include "testutil/assert.h"
 
 namespace starrocks {
 
@@ -94,4 +97,79 @@ TEST_F(StoragePageCacheTest, normal) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(StoragePageCacheTest, disk_cache) {
+    std::string dir = "./ut_dir/page_disk_cache_test";
+    (void)FileSystem::Default()->delete_dir_recursive(dir);
+    auto page_of = [](int i) { return std::string(1024, static_cast<char>('a' + i % 26)); };
+    auto insert_page = [&](StoragePageCache* cache, int i) {
+        auto page = page_of(i);
+        char* buf = new char[page.size()];
+        memcpy(buf, page.data(), page.size());
+        PageCacheHandle handle;
+        cache->insert(StoragePageCache::CacheKey("abc", i), Slice(buf, page.size()), &handle, false);
+    };
+
+    {
+        StoragePageCache cache(_mem_tracker.get(), kNumShards * 2048);
+        ASSERT_OK(cache.init_disk_cache(dir, 1024 * 1024, 16 * 1024));
+        // put too many page to evict pages into disk
+        for (int i = 0; i < 10 * kNumShards; ++i) {
+            insert_page(&cache, i);
+        }
+        cache.disk_cache()->wait_for_writing();
+        ASSERT_GT(cache.disk_cache()->num_pages(), 0);
+        ASSERT_GT(cache.disk_cache()->num_regions(), 1);
+
+        // Every page is found either in memory or on disk.
+        for (int i = 0; i < 10 * kNumShards; ++i) {
+            // Loading a page evicts another one, which is written asynchronously.
+            cache.disk_cache()->wait_for_writing();
+            PageCacheHandle handle;
+            ASSERT_TRUE(cache.lookup(StoragePageCache::CacheKey("abc", i), &handle));
+            ASSERT_EQ(page_of(i), handle.data().to_string());
+        }
+        ASSERT_GT(cache.disk_cache()->hit_count(), 0);
+
+        PageCacheHandle handle;
+        ASSERT_FALSE(cache.lookup(StoragePageCache::CacheKey("abc", 10 * kNumShards), &handle));
+        cache.shutdown_disk_cache();
+    }
+
+    // The pages on disk survive restart.
+    {
+        StoragePageCache cache(_mem_tracker.get(), kNumShards * 2048);
+        ASSERT_OK(cache.init_disk_cache(dir, 1024 * 1024, 16 * 1024));
+        ASSERT_GT(cache.disk_cache()->num_pages(), 0);
+        int hits = 0;
+        for (int i = 0; i < 10 * kNumShards; ++i) {
+            PageCacheHandle handle;
+            if (cache.lookup(StoragePageCache::CacheKey("abc", i), &handle)) {
+                ASSERT_EQ(page_of(i), handle.data().to_string());
+                hits++;
+            }
+        }
+        ASSERT_EQ(hits, cache.disk_cache()->hit_count());
+        ASSERT_GT(hits, 0);
+    }
+
+    // Capacity is bounded by evicting the oldest regions.
+    {
+        PageDiskCache disk_cache;
+        ASSERT_OK(disk_cache.init(dir, 64 * 1024, 16 * 1024));
+        ASSERT_LE(disk_cache.size(), disk_cache.capacity());
+        for (int i = 0; i < 200; ++i) {
+            auto page = page_of(i);
+            disk_cache.write(StoragePageCache::CacheKey("bcd", i).encode(), Slice(page));
+            disk_cache.wait_for_writing();
+        }
+        ASSERT_LE(disk_cache.size(), disk_cache.capacity() + 16 * 1024);
+        ASSERT_TRUE(disk_cache.read(StoragePageCache::CacheKey("bcd", 0).encode()).status().is_not_found());
+        ASSIGN_OR_ABORT(auto page, disk_cache.read(StoragePageCache::CacheKey("bcd", 199).encode()));
+        std::unique_ptr<char[]> guard(page.data);
+        ASSERT_EQ(page_of(199), page.to_string());
+    }
+    (void)FileSystem::Default()->delete_dir_recursive(dir);
+}
+
 } // namespace starrocks
@@ -6,8 +6,10 @@
 
 #include <cstdlib>
 
+#include "common/config.h"
 #include "fs/fs_memory.h"
 #include "fs/fs_util.h"
+#include "gutil/strings/substitute.h"
 #include "storage/chunk_helper.h"
 #include "storage/rowset/rowset.h"
 #include "storage/rowset/rowset_factory.h"
@@ -20,6 +22,7 @@
 #include "testutil/assert.h"
 #include "testutil/parallel_test.h"
 #include "util/coding.h"
+#include "util/defer_op.h"
 #include "util/faststring.h"
 
 namespace starrocks {
@@ -306,6 +309,62 @@ PARALLEL_TEST(PersistentIndexTest, test_mutable_flush_to_immutable) {
     ASSERT_TRUE(idx_loaded->check_not_exist(10, check_not_exist_key_slices.data(), sizeof(Key)).ok());
 }
 
+PARALLEL_TEST(PersistentIndexTest, test_immutable_index_bloom_filter) {
+    const std::string kPersistentIndexDir = "./PersistentIndexTest_test_immutable_index_bloom_filter";
+    ASSIGN_OR_ABORT(auto fs, FileSystem::CreateSharedFromString("posix://"));
+    bool created;
+    ASSERT_OK(fs->create_dir_if_missing(kPersistentIndexDir, &created));
+    using Key = uint64_t;
+    const int N = 100000;
+    // keys in [0, N) are flushed to L1, keys in [N, 2N) are not
+    vector<Key> keys(2 * N);
+    vector<IndexValue> values(N);
+    vector<Slice> key_slices;
+    key_slices.reserve(2 * N);
+    for (int i = 0; i < 2 * N; i++) {
+        keys[i] = i;
+        key_slices.emplace_back((uint8_t*)(&keys[i]), sizeof(Key));
+    }
+    for (int i = 0; i < N; i++) {
+        values[i] = i * 3;
+    }
+
+    const bool old_enable = config::enable_persistent_index_bloom_filter;
+    DeferOp defer([&]() { config::enable_persistent_index_bloom_filter = old_enable; });
+    for (bool enable : {true, false}) {
+        config::enable_persistent_index_bloom_filter = enable;
+        ASSIGN_OR_ABORT(auto idx, MutableIndex::create(sizeof(Key), kPersistentIndexDir));
+        ASSERT_OK(idx->insert(N, key_slices.data(), values.data()));
+        EditVersion version(enable ? 1 : 2, 0);
+        ASSERT_OK(idx->flush_to_immutable_index(kPersistentIndexDir, version));
+
+        ASSIGN_OR_ABORT(auto rf, fs->new_random_access_file(
+                                         strings::Substitute("$0/index.l1.$1.0", kPersistentIndexDir, version.major())));
+        ASSIGN_OR_ABORT(auto idx_loaded, ImmutableIndex::load(std::move(rf)));
+        if (enable) {
+            ASSERT_GT(idx_loaded->memory_usage(), 0);
+        } else {
+            ASSERT_EQ(0, idx_loaded->memory_usage());
+        }
+
+        KeysInfo keys_info;
+        for (int i = 0; i < 2 * N; i++) {
+            keys_info.key_idxes.emplace_back(i);
+            keys_info.hashes.emplace_back(key_index_hash(&keys[i], sizeof(Key)));
+        }
+        vector<IndexValue> get_values(2 * N, NullIndexValue);
+        size_t num_found = 0;
+        ASSERT_OK(idx_loaded->get(2 * N, key_slices.data(), keys_info, get_values.data(), &num_found, sizeof(Key)));
+        ASSERT_EQ(N, num_found);
+        for (int i = 0; i < 2 * N; i++) {
+            ASSERT_EQ(i < N ? values[i] : NullIndexValue, get_values[i]);
+        }
+        ASSERT_TRUE(idx_loaded->check_not_exist(N, key_slices.data(), sizeof(Key)).is_already_exist());
+        ASSERT_OK(idx_loaded->check_not_exist(N, key_slices.data() + N, sizeof(Key)));
+    }
+    ASSERT_TRUE(fs::remove_all(kPersistentIndexDir).ok());
+}
+
 TabletSharedPtr create_tablet(int64_t tablet_id, int32_t schema_hash) {
     TCreateTabletReq request;
     request.tablet_id = tablet_id;
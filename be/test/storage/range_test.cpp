@@ -4,6 +4,10 @@
 
 #include <gtest/gtest.h>
 
+#include <limits>
+
+#include "storage/rowset/rowid_range_option.h"
+
 namespace starrocks::vectorized {
 
 inline std::string to_bitmap_string(const uint8_t* bitmap, size_t n) {
@@ -166,4 +170,26 @@ TEST(SparseRangeIteratorTest, convert_to_bitmap) {
     ASSERT_EQ("111111111100000000011001", to_bitmap_string(bitmap.data(), 24));
 }
 
+TEST(SplittableRowidRangeTest, claim_and_split) {
+    SplittableRowidRange range(100, 1100);
+    ASSERT_EQ(1000, range.num_unclaimed_rows());
+    ASSERT_EQ(200, range.claim(200));
+    ASSERT_EQ(900, range.num_unclaimed_rows());
+
+    // The split point is aligned to 64 rows.
+    ASSERT_FALSE(range.can_split(500, 64));
+    ASSERT_TRUE(range.can_split(100, 64));
+    Range taken = range.split(100, 64);
+    ASSERT_EQ(640, taken.begin());
+    ASSERT_EQ(1100, taken.end());
+    ASSERT_EQ(440, range.num_unclaimed_rows());
+
+    // The rows taken over are not claimed by the reader.
+    ASSERT_EQ(600, range.claim(600));
+    ASSERT_EQ(640, range.claim(700));
+    ASSERT_EQ(0, range.num_unclaimed_rows());
+    ASSERT_TRUE(range.split(1, 1).empty());
+    ASSERT_EQ(640, range.claim(std::numeric_limits<rowid_t>::max()));
+}
+
 } // namespace starrocks::vectorized
@@ -317,6 +317,69 @@ TEST_F(RowsetMergerTest, vertical_merge) {
     }
 }
 
+TEST_F(RowsetMergerTest, vertical_merge_with_memory_limit) {
+    config::vertical_compaction_max_columns_per_group = 1;
+    // chunks of each column group are shrunk to fit in the memory limit
+    int64_t old_memory_limit = config::compaction_memory_limit_per_worker;
+    config::compaction_memory_limit_per_worker = 64 * 1024;
+
+    srand(GetCurrentTimeMicros());
+    create_tablet(rand(), rand());
+    const int max_segments = 8;
+    const int num_segment = 2 + rand() % max_segments;
+    const int N = 100000 + rand() % 100000;
+    MergeConfig cfg;
+    cfg.chunk_size = 1000 + rand() % 2000;
+    cfg.algorithm = VERTICAL_COMPACTION;
+    vector<uint32_t> rssids(N);
+    vector<vector<int64_t>> segments(num_segment);
+    for (int i = 0; i < N; i++) {
+        rssids[i] = rand() % num_segment;
+        segments[rssids[i]].push_back(i);
+    }
+    vector<RowsetSharedPtr> rowsets(num_segment * 2);
+    for (int i = 0; i < num_segment; i++) {
+        auto rs = create_rowset(_tablet, segments[i]);
+        ASSERT_TRUE(_tablet->rowset_commit(i + 2, rs).ok());
+        rowsets[i] = rs;
+    }
+
+    std::vector<int64_t> pks;
+    for (int i = 0; i < num_segment; i++) {
+        vectorized::Int64Column deletes;
+        deletes.append_numbers(segments[i].data(), sizeof(int64_t) * segments[i].size() / 2);
+        auto rs = create_rowset(_tablet, {}, &deletes);
+        ASSERT_TRUE(_tablet->rowset_commit(i + 2 + num_segment, rs).ok());
+        rowsets[i + num_segment] = rs;
+        pks.insert(pks.end(), segments[i].begin() + segments[i].size() / 2, segments[i].end());
+    }
+    std::sort(pks.begin(), pks.end());
+
+    int64_t version = num_segment * 2 + 1;
+    EXPECT_EQ(pks.size(), read_tablet(_tablet, version));
+    TestRowsetWriter writer;
+    Schema schema = ChunkHelper::convert_schema_to_format_v2(_tablet->tablet_schema());
+    ASSERT_TRUE(PrimaryKeyEncoder::create_column(schema, &writer.all_pks).ok());
+    writer.non_key_columns.emplace_back(std::move(vectorized::Int16Column::create_mutable()));
+    writer.non_key_columns.emplace_back(std::move(vectorized::Int32Column::create_mutable()));
+    auto st = vectorized::compaction_merge_rowsets(*_tablet, version, rowsets, &writer, cfg);
+    config::compaction_memory_limit_per_worker = old_memory_limit;
+    ASSERT_TRUE(st.ok()) << st;
+
+    ASSERT_EQ(pks.size(), writer.all_pks->size());
+    ASSERT_EQ(2, writer.non_key_columns.size());
+    ASSERT_EQ(pks.size(), writer.non_key_columns[0]->size());
+    ASSERT_EQ(pks.size(), writer.non_key_columns[1]->size());
+    const int64_t* raw_pk_array = reinterpret_cast<const int64_t*>(writer.all_pks->raw_data());
+    const int16_t* raw_k2_array = reinterpret_cast<const int16_t*>(writer.non_key_columns[0]->raw_data());
+    const int32_t* raw_k3_array = reinterpret_cast<const int32_t*>(writer.non_key_columns[1]->raw_data());
+    for (int64_t i = 0; i < pks.size(); i++) {
+        ASSERT_EQ(pks[i], raw_pk_array[i]);
+        ASSERT_EQ(pks[i] % 100 + 1, raw_k2_array[i]);
+        ASSERT_EQ(pks[i] % 1000 + 2, raw_k3_array[i]);
+    }
+}
+
 TEST_F(RowsetMergerTest, horizontal_merge_seq) {
     config::vertical_compaction_max_columns_per_group = 5;
 
@@ -6,8 +6,11 @@
 
 #include <functional>
 #include <iostream>
+#include <map>
+#include <thread>
 
 #include "column/datum_tuple.h"
+#include "common/config.h"
 #include "fs/fs_memory.h"
 #include "runtime/mem_pool.h"
 #include "runtime/mem_tracker.h"
@@ -19,12 +22,14 @@
 #include "storage/rowset/rowset_options.h"
 #include "storage/storage_engine.h"
 #include "storage/tablet_manager.h"
+#include "storage/tablet_meta_manager.h"
 #include "storage/tablet_reader.h"
 #include "storage/tablet_reader_params.h"
 #include "storage/tablet_schema.h"
 #include "storage/union_iterator.h"
 #include "storage/update_manager.h"
 #include "testutil/assert.h"
+#include "util/defer_op.h"
 
 namespace starrocks {
 
@@ -136,7 +141,12 @@ public:
         auto& cols = chunk->columns();
         for (size_t i = 0; i < keys.size(); i++) {
             cols[0]->append_datum(vectorized::Datum(keys[i]));
-            cols[1]->append_datum(vectorized::Datum((int16_t)(keys[i] % 100 + 3)));
+            // the updated value column is either v1 or v2
+            if (column_indexes[1] == 1) {
+                cols[1]->append_datum(vectorized::Datum((int16_t)(keys[i] % 100 + 3)));
+            } else {
+                cols[1]->append_datum(vectorized::Datum((int32_t)(keys[i] % 1000 + 4)));
+            }
         }
         CHECK_OK(writer->flush_chunk(*chunk));
         RowsetSharedPtr partial_rowset = *writer->build();
@@ -196,6 +206,32 @@ static ssize_t read_tablet(const TabletSharedPtr& tablet, int64_t version) {
     return read_until_eof(iter);
 }
 
+// read the values of columns v1 and v2 of each key
+static Status read_tablet_values(const TabletSharedPtr& tablet, int64_t version,
+                                 std::map<int64_t, std::pair<int16_t, int32_t>>* values) {
+    vectorized::Schema schema = ChunkHelper::convert_schema_to_format_v2(tablet->tablet_schema());
+    vectorized::TabletReader reader(tablet, Version(0, version), schema);
+    auto iter = create_tablet_iterator(reader, schema);
+    if (iter == nullptr) {
+        return Status::InternalError("create tablet iterator failed");
+    }
+    auto chunk = ChunkHelper::new_chunk(iter->schema(), 100);
+    while (true) {
+        auto st = iter->get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        RETURN_IF_ERROR(st);
+        for (size_t i = 0; i < chunk->num_rows(); i++) {
+            (*values)[chunk->get_column_by_index(0)->get(i).get_int64()] = {
+                    chunk->get_column_by_index(1)->get(i).get_int16(),
+                    chunk->get_column_by_index(2)->get(i).get_int32()};
+        }
+        chunk->reset();
+    }
+    return Status::OK();
+}
+
 TEST_F(RowsetUpdateStateTest, prepare_partial_update_states) {
     const int N = 100;
     _tablet = create_tablet(rand(), rand());
@@ -326,4 +362,121 @@ TEST_F(RowsetUpdateStateTest, check_conflict) {
     manager->index_cache().release(index_entry);
 }
 
+
+TEST_F(RowsetUpdateStateTest, column_mode_partial_update) {
+    auto orig_enable = config::enable_column_mode_partial_update;
+    auto orig_percent = config::column_mode_partial_update_max_column_percent;
+    config::enable_column_mode_partial_update = true;
+    config::column_mode_partial_update_max_column_percent = 50;
+    DeferOp unset_config([&] {
+        config::enable_column_mode_partial_update = orig_enable;
+        config::column_mode_partial_update_max_column_percent = orig_percent;
+    });
+
+    const int N = 100;
+    _tablet = create_tablet(rand(), rand());
+    std::vector<int64_t> keys(N);
+    for (int i = 0; i < N; i++) {
+        keys[i] = i;
+    }
+    ASSERT_OK(_tablet->rowset_commit(2, create_rowset(_tablet, keys)));
+    ASSERT_EQ(N, read_tablet(_tablet, 2));
+
+    // update v1 of half of the keys
+    std::vector<int64_t> partial_keys;
+    for (int i = 0; i < N; i += 2) {
+        partial_keys.push_back(i);
+    }
+    std::vector<int32_t> column_indexes = {0, 1};
+    std::shared_ptr<TabletSchema> partial_schema = TabletSchema::create(_tablet->tablet_schema(), column_indexes);
+    RowsetSharedPtr partial_rowset = create_partial_rowset(_tablet, partial_keys, column_indexes, partial_schema);
+    ASSERT_OK(_tablet->rowset_commit(3, partial_rowset));
+    ASSERT_EQ(3, _tablet->updates()->max_version());
+
+    // the updated values are written into a delta column file of the segment of the full rowset
+    DeltaColumnGroupList dcgs;
+    ASSERT_OK(TabletMetaManager::get_delta_column_groups(_tablet->data_dir()->get_meta(), _tablet->tablet_id(), 0,
+                                                         INT64_MAX, &dcgs));
+    ASSERT_EQ(1, dcgs.size());
+    ASSERT_EQ(3, dcgs[0]->version());
+    ASSERT_EQ((int64_t)partial_keys.size(), dcgs[0]->num_rows());
+    // the partial rowset is rewritten into an empty rowset, and its segment files are removed
+    ASSERT_EQ(0, partial_rowset->num_segments());
+    ASSERT_EQ(0, partial_rowset->num_rows());
+    ASSERT_FALSE(partial_rowset->rowset_meta()->get_meta_pb().has_txn_meta());
+    auto segment_path = Rowset::segment_file_path(_tablet->schema_hash_path(), partial_rowset->rowset_id(), 0);
+    ASSERT_TRUE(FileSystem::Default()->path_exists(segment_path).is_not_found());
+
+    auto check_values = [&](int64_t version) {
+        std::map<int64_t, std::pair<int16_t, int32_t>> values;
+        ASSERT_OK(read_tablet_values(_tablet, version, &values));
+        ASSERT_EQ(N, values.size());
+        for (int i = 0; i < N; i++) {
+            ASSERT_EQ((int16_t)(i % 2 == 0 ? i % 100 + 3 : i % 100 + 1), values[i].first) << "key: " << i;
+        }
+    };
+    check_values(3);
+
+    // the delta column file is merged into the output rowset by compaction
+    ASSERT_OK(_tablet->updates()->compaction(_compaction_mem_tracker.get()));
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    ASSERT_EQ(1, _tablet->updates()->num_rowsets());
+    check_values(3);
+}
+
+// A row-mode partial update prepared before a column-mode partial update is applied must read the values updated
+// by the latter again, even though the rows are not moved.
+TEST_F(RowsetUpdateStateTest, row_mode_after_column_mode_partial_update) {
+    auto orig_enable = config::enable_column_mode_partial_update;
+    auto orig_percent = config::column_mode_partial_update_max_column_percent;
+    config::column_mode_partial_update_max_column_percent = 50;
+    DeferOp unset_config([&] {
+        config::enable_column_mode_partial_update = orig_enable;
+        config::column_mode_partial_update_max_column_percent = orig_percent;
+    });
+
+    const int N = 100;
+    _tablet = create_tablet(rand(), rand());
+    std::vector<int64_t> keys(N);
+    for (int i = 0; i < N; i++) {
+        keys[i] = i;
+    }
+    ASSERT_OK(_tablet->rowset_commit(2, create_rowset(_tablet, keys)));
+
+    // prepare the update of v2 of all the keys in row mode, which reads v1 at version 2
+    config::enable_column_mode_partial_update = false;
+    std::vector<int32_t> row_mode_column_indexes = {0, 2};
+    auto row_mode_schema = TabletSchema::create(_tablet->tablet_schema(), row_mode_column_indexes);
+    RowsetSharedPtr row_mode_rowset = create_partial_rowset(_tablet, keys, row_mode_column_indexes, row_mode_schema);
+    auto manager = StorageEngine::instance()->update_manager();
+    ASSERT_OK(manager->on_rowset_finished(_tablet.get(), row_mode_rowset.get()));
+
+    // update v1 of half of the keys in column mode
+    config::enable_column_mode_partial_update = true;
+    std::vector<int64_t> column_mode_keys;
+    for (int i = 0; i < N; i += 2) {
+        column_mode_keys.push_back(i);
+    }
+    std::vector<int32_t> column_mode_column_indexes = {0, 1};
+    auto column_mode_schema = TabletSchema::create(_tablet->tablet_schema(), column_mode_column_indexes);
+    ASSERT_OK(_tablet->rowset_commit(3, create_partial_rowset(_tablet, column_mode_keys, column_mode_column_indexes,
+                                                              column_mode_schema)));
+    DeltaColumnGroupList dcgs;
+    ASSERT_OK(TabletMetaManager::get_delta_column_groups(_tablet->data_dir()->get_meta(), _tablet->tablet_id(), 0,
+                                                         INT64_MAX, &dcgs));
+    ASSERT_EQ(1, dcgs.size());
+
+    // apply the row-mode update prepared before
+    ASSERT_OK(_tablet->rowset_commit(4, row_mode_rowset));
+    ASSERT_EQ(4, _tablet->updates()->max_version());
+
+    std::map<int64_t, std::pair<int16_t, int32_t>> values;
+    ASSERT_OK(read_tablet_values(_tablet, 4, &values));
+    ASSERT_EQ(N, values.size());
+    for (int i = 0; i < N; i++) {
+        ASSERT_EQ((int16_t)(i % 2 == 0 ? i % 100 + 3 : i % 100 + 1), values[i].first) << "key: " << i;
+        ASSERT_EQ((int32_t)(i % 1000 + 4), values[i].second) << "key: " << i;
+    }
+}
+
 } // namespace starrocks
@@ -0,0 +1,133 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Inc.
+
+#include "storage/size_tiered_compaction_policy.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "common/config.h"
+#include "storage/compaction_context.h"
+#include "storage/rowset/rowset.h"
+#include "storage/tablet.h"
+#include "storage/tablet_schema_helper.h"
+#include "util/time.h"
+
+namespace starrocks {
+
+class SizeTieredCompactionPolicyTest : public testing::Test {
+public:
+    void SetUp() override {
+        TabletSharedPtr tablet = std::make_shared<Tablet>();
+        TabletMetaSharedPtr tablet_meta = std::make_shared<TabletMeta>();
+        tablet_meta->set_tablet_id(100);
+        tablet_meta->set_compaction_policy(CompactionPolicyPB::SIZE_TIERED);
+        tablet->set_tablet_meta(tablet_meta);
+        _compaction_context = std::make_unique<CompactionContext>();
+        _compaction_context->tablet = tablet;
+        create_tablet_schema(&_tablet_schema);
+        _base_time = UnixSeconds() - 100 * 60;
+    }
+
+protected:
+    void add_rowset(int64_t start_version, int64_t end_version, int64_t size) {
+        RowsetMetaSharedPtr rowset_meta = std::make_shared<RowsetMeta>();
+        rowset_meta->set_start_version(start_version);
+        rowset_meta->set_end_version(end_version);
+        rowset_meta->set_creation_time(_base_time + start_version);
+        rowset_meta->set_segments_overlap(NONOVERLAPPING);
+        rowset_meta->set_num_segments(1);
+        rowset_meta->set_total_disk_size(size);
+        rowset_meta->set_empty(false);
+        RowsetSharedPtr rowset = std::make_shared<Rowset>(&_tablet_schema, "./rowset" + std::to_string(start_version),
+                                                          rowset_meta);
+        int level = start_version == 0 ? 2 : (start_version == end_version ? 0 : 1);
+        _compaction_context->rowset_levels[level].insert(rowset.get());
+        _rowsets.emplace_back(std::move(rowset));
+    }
+
+    std::unique_ptr<CompactionContext> _compaction_context;
+    TabletSchema _tablet_schema;
+    std::vector<RowsetSharedPtr> _rowsets;
+    int64_t _base_time = 0;
+};
+
+TEST_F(SizeTieredCompactionPolicyTest, test_level_of) {
+    const int64_t min_level_size = config::size_tiered_min_level_size;
+    const int64_t multiple = config::size_tiered_level_multiple;
+    ASSERT_EQ(0, SizeTieredCompactionPolicy::level_of(0));
+    ASSERT_EQ(0, SizeTieredCompactionPolicy::level_of(min_level_size - 1));
+    ASSERT_EQ(1, SizeTieredCompactionPolicy::level_of(min_level_size));
+    ASSERT_EQ(1, SizeTieredCompactionPolicy::level_of(min_level_size * multiple - 1));
+    ASSERT_EQ(2, SizeTieredCompactionPolicy::level_of(min_level_size * multiple));
+}
+
+TEST_F(SizeTieredCompactionPolicyTest, test_compact_rowsets_of_similar_size) {
+    // a large base rowset, 3 middle rowsets and 6 small rowsets
+    add_rowset(0, 9, 100 * 1024 * 1024);
+    for (int i = 10; i < 13; i++) {
+        add_rowset(i, i, 5 * 1024 * 1024);
+    }
+    for (int i = 13; i < 19; i++) {
+        add_rowset(i, i, 200 * 1024);
+    }
+    SizeTieredCompactionPolicy policy(_compaction_context.get());
+    ASSERT_TRUE(policy.need_compaction());
+    // neither the base rowset nor the middle rowsets have enough rowsets of the same level
+    ASSERT_EQ(0, _compaction_context->base_score);
+    // only the small rowsets are merged, the score is the multiple of size_tiered_min_level_rowsets
+    ASSERT_DOUBLE_EQ(6.0 / config::size_tiered_min_level_rowsets, _compaction_context->cumulative_score);
+}
+
+TEST_F(SizeTieredCompactionPolicyTest, test_skip_compacting_rowsets) {
+    add_rowset(0, 9, 100 * 1024 * 1024);
+    for (int i = 10; i < 16; i++) {
+        add_rowset(i, i, 200 * 1024);
+    }
+    {
+        SizeTieredCompactionPolicy policy(_compaction_context.get());
+        ASSERT_TRUE(policy.need_compaction());
+    }
+    // the rowset of version 12 is being compacted, the left runs are too short
+    _compaction_context->compacting_rowsets.insert(_rowsets[3].get());
+    SizeTieredCompactionPolicy policy(_compaction_context.get());
+    ASSERT_FALSE(policy.need_compaction());
+    ASSERT_EQ(0, _compaction_context->cumulative_score);
+}
+
+TEST_F(SizeTieredCompactionPolicyTest, test_base_compaction) {
+    // all the rowsets are small, including the base rowset
+    add_rowset(0, 9, 200 * 1024);
+    for (int i = 10; i < 14; i++) {
+        add_rowset(i, i, 200 * 1024);
+    }
+    SizeTieredCompactionPolicy policy(_compaction_context.get());
+    ASSERT_TRUE(policy.need_compaction());
+    ASSERT_DOUBLE_EQ(5.0 / config::size_tiered_min_level_rowsets, _compaction_context->base_score);
+    // all the rowsets are picked by base compaction
+    ASSERT_EQ(0, _compaction_context->cumulative_score);
+}
+
+TEST_F(SizeTieredCompactionPolicyTest, test_skip_recent_rowsets) {
+    add_rowset(0, 9, 100 * 1024 * 1024);
+    for (int i = 10; i < 16; i++) {
+        add_rowset(i, i, 200 * 1024);
+    }
+    _rowsets[3]->rowset_meta()->set_creation_time(UnixSeconds());
+    SizeTieredCompactionPolicy policy(_compaction_context.get());
+    ASSERT_FALSE(policy.need_compaction());
+}
+
+TEST_F(SizeTieredCompactionPolicyTest, test_delete_version) {
+    add_rowset(0, 9, 100 * 1024 * 1024);
+    for (int i = 10; i < 16; i++) {
+        add_rowset(i, i, 200 * 1024);
+    }
+    // the delete predicate of version 12 can only be compacted by base compaction
+    DeletePredicatePB delete_predicate;
+    _compaction_context->tablet->tablet_meta()->add_delete_predicate(delete_predicate, 12);
+    SizeTieredCompactionPolicy policy(_compaction_context.get());
+    ASSERT_FALSE(policy.need_compaction());
+}
+
+} // namespace starrocks
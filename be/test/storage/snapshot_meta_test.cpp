@@ -84,6 +84,11 @@ public:
         for (uint32_t seg_id = 1; seg_id <= 7; seg_id++) {
             del_vec.emplace(seg_id, DelVector());
         }
+
+        auto& dcgs = _snapshot_meta.delta_column_groups();
+        dcgs[2].emplace_back(std::make_shared<DeltaColumnGroup>(6, std::vector<uint32_t>{1}, "a_0_6.cols", 10));
+        dcgs[2].emplace_back(std::make_shared<DeltaColumnGroup>(7, std::vector<uint32_t>{1, 2}, "a_0_7.cols", 20));
+        dcgs[5].emplace_back(std::make_shared<DeltaColumnGroup>(9, std::vector<uint32_t>{2}, "b_0_9.cols", 30));
     }
 
 protected:
@@ -117,6 +122,15 @@ TEST_F(SnapshotMetaTest, test_serialize_and_parse) {
     ASSERT_EQ(_snapshot_meta.rowset_metas()[0].rowset_seg_id(), meta.rowset_metas()[0].rowset_seg_id());
     ASSERT_EQ(_snapshot_meta.rowset_metas()[1].rowset_seg_id(), meta.rowset_metas()[1].rowset_seg_id());
     ASSERT_EQ(_snapshot_meta.rowset_metas()[2].rowset_seg_id(), meta.rowset_metas()[2].rowset_seg_id());
+    ASSERT_EQ(_snapshot_meta.delta_column_groups().size(), meta.delta_column_groups().size());
+    for (const auto& [segment_id, dcgs] : _snapshot_meta.delta_column_groups()) {
+        ASSERT_EQ(1, meta.delta_column_groups().count(segment_id));
+        const auto& parsed_dcgs = meta.delta_column_groups().at(segment_id);
+        ASSERT_EQ(dcgs.size(), parsed_dcgs.size());
+        for (size_t i = 0; i < dcgs.size(); i++) {
+            ASSERT_EQ(dcgs[i]->to_string(), parsed_dcgs[i]->to_string());
+        }
+    }
 }
 
 } // namespace starrocks
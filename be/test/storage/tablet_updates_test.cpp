@@ -2059,6 +2059,83 @@ TEST_F(TabletUpdatesTest, load_snapshot_full_with_persistent_index) {
     test_load_snapshot_full(true);
 }
 
+// NOLINTNEXTLINE
+TEST_F(TabletUpdatesTest, load_snapshot_full_with_delta_column_groups) {
+    auto orig_enable = config::enable_column_mode_partial_update;
+    auto orig_percent = config::column_mode_partial_update_max_column_percent;
+    config::enable_column_mode_partial_update = true;
+    config::column_mode_partial_update_max_column_percent = 50;
+    DeferOp unset_config([&] {
+        config::enable_column_mode_partial_update = orig_enable;
+        config::column_mode_partial_update_max_column_percent = orig_percent;
+    });
+
+    srand(GetCurrentTimeMicros());
+    auto tablet0 = create_tablet(rand(), rand());
+    auto tablet1 = create_tablet(rand(), rand());
+
+    DeferOp defer([&]() {
+        auto tablet_mgr = StorageEngine::instance()->tablet_manager();
+        (void)tablet_mgr->drop_tablet(tablet0->tablet_id());
+        (void)tablet_mgr->drop_tablet(tablet1->tablet_id());
+        (void)fs::remove_all(tablet0->schema_hash_path());
+        (void)fs::remove_all(tablet1->schema_hash_path());
+    });
+
+    std::vector<int64_t> keys0{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    ASSERT_TRUE(tablet0->rowset_commit(2, create_rowset(tablet0, keys0)).ok());
+    // update v1 of the even keys, the values go to a delta column file of the segment of version 2
+    std::vector<int64_t> partial_keys{0, 2, 4, 6, 8};
+    std::vector<int32_t> column_indexes = {0, 1};
+    auto partial_schema = TabletSchema::create(tablet0->tablet_schema(), column_indexes);
+    ASSERT_TRUE(tablet0->rowset_commit(3, create_partial_rowset(tablet0, partial_keys, column_indexes, partial_schema))
+                        .ok());
+    ASSERT_EQ(3, tablet0->updates()->max_version());
+
+    // the rowset of version 3 is empty after apply, an incremental snapshot switches to full snapshot
+    std::vector<RowsetSharedPtr> inc_rowsets;
+    ASSERT_OK(tablet0->updates()->get_rowsets_for_incremental_snapshot({3}, inc_rowsets));
+    ASSERT_TRUE(inc_rowsets.empty());
+
+    std::vector<int64_t> keys1{0, 1, 2, 3};
+    ASSERT_TRUE(tablet1->rowset_commit(2, create_rowset(tablet1, keys1)).ok());
+
+    auto st = full_clone(tablet0, 3, tablet1);
+    ASSERT_TRUE(st.ok()) << st;
+    ASSERT_EQ(3, tablet1->updates()->max_version());
+
+    auto check_values = [&](const TabletSharedPtr& tablet) {
+        vectorized::Schema schema = ChunkHelper::convert_schema_to_format_v2(tablet->tablet_schema());
+        vectorized::TabletReader reader(tablet, Version(0, 3), schema);
+        auto iter = create_tablet_iterator(reader, schema);
+        ASSERT_TRUE(iter != nullptr);
+        auto chunk = ChunkHelper::new_chunk(iter->schema(), 100);
+        size_t count = 0;
+        while (true) {
+            auto res = iter->get_next(chunk.get());
+            if (res.is_end_of_file()) {
+                break;
+            }
+            ASSERT_TRUE(res.ok()) << res;
+            for (size_t i = 0; i < chunk->num_rows(); i++) {
+                auto key = chunk->get_column_by_index(0)->get(i).get_int64();
+                auto v1 = chunk->get_column_by_index(1)->get(i).get_int16();
+                ASSERT_EQ((int16_t)(key % 2 == 0 ? key % 100 + 3 : key % 100 + 1), v1) << "key: " << key;
+            }
+            count += chunk->num_rows();
+            chunk->reset();
+        }
+        ASSERT_EQ(keys0.size(), count);
+    };
+    check_values(tablet0);
+    check_values(tablet1);
+
+    // Ensure that the delta column groups are persisted.
+    auto tablet2 = load_same_tablet_from_store(_tablet_meta_mem_tracker.get(), tablet1);
+    ASSERT_EQ(3, tablet2->updates()->max_version());
+    check_values(tablet2);
+}
+
 // NOLINTNEXTLINE
 void TabletUpdatesTest::test_load_snapshot_full_file_not_exist(bool enable_persistent_index) {
     srand(GetCurrentTimeMicros());
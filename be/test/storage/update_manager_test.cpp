@@ -4,6 +4,8 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+
 #include "fs/fs_util.h"
 #include "runtime/mem_tracker.h"
 #include "storage/chunk_helper.h"
@@ -146,6 +148,38 @@ TEST_F(UpdateManagerTest, testDelVec) {
     ASSERT_EQ(5, tmp->version());
 }
 
+TEST_F(UpdateManagerTest, testParallelApply) {
+    // run serially before the thread pools are created
+    std::vector<size_t> results(100, 0);
+    auto task = [&](size_t i) {
+        results[i] = i * 2;
+        return Status::OK();
+    };
+    ASSERT_OK(_update_manager->parallel_apply(results.size(), task));
+    for (size_t i = 0; i < results.size(); i++) {
+        ASSERT_EQ(i * 2, results[i]);
+    }
+
+    ASSERT_OK(_update_manager->init());
+    std::vector<std::atomic<int>> counts(1000);
+    ASSERT_OK(_update_manager->parallel_apply(counts.size(), [&](size_t i) {
+        counts[i]++;
+        return Status::OK();
+    }));
+    for (auto& count : counts) {
+        ASSERT_EQ(1, count.load());
+    }
+
+    // the error of any task is returned after all the tasks finished
+    std::atomic<int> finished{0};
+    auto st = _update_manager->parallel_apply(100, [&](size_t i) {
+        finished++;
+        return i == 50 ? Status::InvalidArgument("task failed") : Status::OK();
+    });
+    ASSERT_TRUE(st.is_invalid_argument());
+    ASSERT_EQ(100, finished.load());
+}
+
 TEST_F(UpdateManagerTest, testExpireEntry) {
     srand(time(NULL));
     create_tablet(rand(), rand());
@@ -4,9 +4,14 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <thread>
+
 #include "fs/fs.h"
 #include "fs/fs_memory.h"
 #include "io/string_input_stream.h"
+#include "testutil/assert.h"
+#include "util/threadpool.h"
 
 namespace starrocks {
 
@@ -119,4 +124,99 @@ TEST_F(BufferedStreamTest, Large2) {
     }
 }
 
+TEST_F(BufferedStreamTest, SharedBufferPrefetch) {
+    std::string test_str;
+    test_str.resize(1000);
+    for (int i = 0; i < test_str.size(); ++i) {
+        test_str[i] = i % 128;
+    }
+    RandomAccessFile file(std::make_shared<io::StringInputStream>(test_str), "string-file");
+
+    std::unique_ptr<ThreadPool> pool;
+    ASSERT_OK(ThreadPoolBuilder("prefetch").set_max_threads(2).build(&pool));
+
+    SharedBufferedInputStream stream(&file);
+    stream.set_coalesce_options({.max_dist_size = 10, .max_buffer_size = 100});
+    // At most two buffers are fetched ahead.
+    stream.set_prefetch_options(pool.get(), 150);
+    // Coalesced into [0, 60), [100, 180), [300, 400), [500, 900)
+    std::vector<SharedBufferedInputStream::IORange> ranges{
+            {.offset = 0, .size = 20},  {.offset = 25, .size = 35},  {.offset = 100, .size = 50},
+            {.offset = 155, .size = 25}, {.offset = 300, .size = 100}, {.offset = 500, .size = 400}};
+    ASSERT_OK(stream.set_io_ranges(ranges));
+    ASSERT_EQ(2, stream.prefetch_count());
+
+    for (const auto& r : ranges) {
+        const uint8_t* buf = nullptr;
+        size_t nbytes = r.size;
+        ASSERT_OK(stream.get_bytes(&buf, r.offset, &nbytes, false));
+        ASSERT_EQ(test_str.substr(r.offset, r.size), std::string_view(reinterpret_cast<const char*>(buf), r.size));
+    }
+    ASSERT_EQ(4, stream.prefetch_count());
+
+    // Buffers are released and fetched again.
+    stream.release();
+    ASSERT_OK(stream.set_io_ranges(ranges));
+    stream.release_to_offset(200);
+    const uint8_t* buf = nullptr;
+    size_t nbytes = 100;
+    ASSERT_OK(stream.get_bytes(&buf, 300, &nbytes, false));
+    ASSERT_EQ(test_str.substr(300, 100), std::string_view(reinterpret_cast<const char*>(buf), 100));
+}
+
+TEST_F(BufferedStreamTest, SharedBufferPrefetchNotSupported) {
+    std::string test_str(100, 'x');
+    // A stream which cannot be read concurrently.
+    class NotSupportedStream : public io::SeekableInputStreamWrapper {
+    public:
+        explicit NotSupportedStream(io::SeekableInputStream* stream)
+                : io::SeekableInputStreamWrapper(stream, kDontTakeOwnership) {}
+        Status pread_fully(int64_t offset, void* out, int64_t count) override {
+            return Status::NotSupported("pread_fully");
+        }
+    };
+    io::StringInputStream string_stream(test_str);
+    RandomAccessFile file(std::make_shared<NotSupportedStream>(&string_stream), "string-file");
+
+    std::unique_ptr<ThreadPool> pool;
+    ASSERT_OK(ThreadPoolBuilder("prefetch").set_max_threads(1).build(&pool));
+    SharedBufferedInputStream stream(&file);
+    stream.set_prefetch_options(pool.get(), 1024);
+    ASSERT_OK(stream.set_io_ranges({{.offset = 10, .size = 20}}));
+
+    const uint8_t* buf = nullptr;
+    size_t nbytes = 20;
+    ASSERT_OK(stream.get_bytes(&buf, 10, &nbytes, false));
+    ASSERT_EQ(test_str.substr(10, 20), std::string_view(reinterpret_cast<const char*>(buf), 20));
+}
+
+TEST_F(BufferedStreamTest, SharedBufferPrefetchDropped) {
+    std::string test_str(1000, 'x');
+    RandomAccessFile file(std::make_shared<io::StringInputStream>(test_str), "string-file");
+
+    std::unique_ptr<ThreadPool> pool;
+    ASSERT_OK(ThreadPoolBuilder("prefetch").set_max_threads(1).build(&pool));
+    // Keep the only thread busy, so that the prefetch tasks stay in the queue.
+    ASSERT_OK(pool->submit_func([]() { std::this_thread::sleep_for(std::chrono::milliseconds(100)); }));
+
+    SharedBufferedInputStream stream(&file);
+    stream.set_coalesce_options({.max_dist_size = 10, .max_buffer_size = 100});
+    stream.set_prefetch_options(pool.get(), 1024);
+    std::vector<SharedBufferedInputStream::IORange> ranges{{.offset = 0, .size = 100},
+                                                           {.offset = 300, .size = 100},
+                                                           {.offset = 600, .size = 100}};
+    ASSERT_OK(stream.set_io_ranges(ranges));
+    ASSERT_EQ(3, stream.prefetch_count());
+    // The queued prefetch tasks are dropped without being run.
+    pool->shutdown();
+
+    // Buffers are read synchronously.
+    const uint8_t* buf = nullptr;
+    size_t nbytes = 100;
+    ASSERT_OK(stream.get_bytes(&buf, 0, &nbytes, false));
+    ASSERT_EQ(test_str.substr(0, 100), std::string_view(reinterpret_cast<const char*>(buf), 100));
+    // The left dropped tasks are waited on release.
+    stream.release();
+}
+
 } // namespace starrocks
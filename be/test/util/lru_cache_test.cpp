@@ -286,6 +286,73 @@ TEST_F(CacheTest, HeavyEntries) {
     ASSERT_LE(cached_weight, kCacheSize + kCacheSize / 10);
 }
 
+TEST_F(CacheTest, TwoQueueScanResistance) {
+    auto lookup_LRUCache = [](LRUCache& cache, const CacheKey& key) {
+        uint32_t hash = key.hash(key.data(), key.size(), 0);
+        auto* handle = cache.lookup(key, hash);
+        cache.release(handle);
+        return handle != nullptr;
+    };
+    std::vector<std::string> keys;
+    for (int i = 0; i < 1100; i++) {
+        keys.emplace_back(std::to_string(i));
+    }
+
+    for (auto policy : {CacheEvictionPolicy::LRU, CacheEvictionPolicy::TWO_Q}) {
+        LRUCache cache;
+        cache.set_capacity(100);
+        cache.set_eviction_policy(policy);
+        // Hot entries which are accessed twice.
+        for (int i = 0; i < 10; i++) {
+            insert_LRUCache(cache, CacheKey(keys[i]), 1, CachePriority::NORMAL);
+            ASSERT_TRUE(lookup_LRUCache(cache, CacheKey(keys[i])));
+        }
+        // A large scan which accesses every entry only once.
+        for (int i = 100; i < 1100; i++) {
+            insert_LRUCache(cache, CacheKey(keys[i]), 1, CachePriority::NORMAL);
+        }
+        ASSERT_EQ(100, cache.get_usage());
+        int hits = 0;
+        for (int i = 0; i < 10; i++) {
+            hits += lookup_LRUCache(cache, CacheKey(keys[i]));
+        }
+        ASSERT_EQ(policy == CacheEvictionPolicy::LRU ? 0 : 10, hits);
+    }
+
+    // The protected segment is limited, the demoted entries are evicted by new entries.
+    LRUCache cache;
+    cache.set_capacity(100);
+    cache.set_eviction_policy(CacheEvictionPolicy::TWO_Q);
+    for (int i = 0; i < 100; i++) {
+        insert_LRUCache(cache, CacheKey(keys[i]), 1, CachePriority::NORMAL);
+        ASSERT_TRUE(lookup_LRUCache(cache, CacheKey(keys[i])));
+    }
+    ASSERT_EQ(80, cache.get_protected_usage());
+    for (int i = 100; i < 130; i++) {
+        insert_LRUCache(cache, CacheKey(keys[i]), 1, CachePriority::NORMAL);
+    }
+    ASSERT_EQ(100, cache.get_usage());
+    ASSERT_EQ(80, cache.get_protected_usage());
+    ASSERT_FALSE(lookup_LRUCache(cache, CacheKey(keys[0])));
+    ASSERT_TRUE(lookup_LRUCache(cache, CacheKey(keys[99])));
+    ASSERT_EQ(100 + 2, cache.get_lookup_count());
+}
+
+TEST_F(CacheTest, HitCount) {
+    ASSERT_EQ(-1, Lookup(100));
+    Insert(100, 101, 1);
+    ASSERT_EQ(101, Lookup(100));
+    ASSERT_EQ(2, _cache->get_lookup_count());
+    ASSERT_EQ(1, _cache->get_hit_count());
+
+    CacheEvictionPolicy policy;
+    ASSERT_TRUE(parse_cache_eviction_policy("2Q", &policy));
+    ASSERT_EQ(CacheEvictionPolicy::TWO_Q, policy);
+    ASSERT_TRUE(parse_cache_eviction_policy("lru", &policy));
+    ASSERT_EQ(CacheEvictionPolicy::LRU, policy);
+    ASSERT_FALSE(parse_cache_eviction_policy("lfu", &policy));
+}
+
 TEST_F(CacheTest, NewId) {
     uint64_t a = _cache->new_id();
     uint64_t b = _cache->new_id();
@@ -287,6 +287,7 @@ public class SchemaChangeJobV2 extends AlterJobV2 {
                             createReplicaTask.setBaseTablet(
                                     partitionIndexTabletMap.get(partitionId, shadowIdxId).get(shadowTabletId),
                                     originSchemaHash);
+                            createReplicaTask.setCompactionPolicy(tbl.getCompactionPolicy());
                             if (this.storageFormat != null) {
                                 createReplicaTask.setStorageFormat(this.storageFormat);
                             }
@@ -62,6 +62,7 @@ import com.starrocks.task.AgentBatchTask;
 import com.starrocks.task.AgentTask;
 import com.starrocks.task.AgentTaskExecutor;
 import com.starrocks.task.DropReplicaTask;
+import com.starrocks.thrift.TCompactionPolicy;
 import com.starrocks.thrift.TOlapTable;
 import com.starrocks.thrift.TStorageFormat;
 import com.starrocks.thrift.TStorageMedium;
@@ -1844,6 +1845,21 @@ public class OlapTable extends Table implements GsonPostProcessable {
         return tableProperty.getStorageFormat();
     }
 
+    public void setCompactionPolicy(TCompactionPolicy compactionPolicy) {
+        if (tableProperty == null) {
+            tableProperty = new TableProperty(new HashMap<>());
+        }
+        tableProperty.modifyTableProperties(PropertyAnalyzer.PROPERTIES_COMPACTION_POLICY, compactionPolicy.name());
+        tableProperty.buildCompactionPolicy();
+    }
+
+    public TCompactionPolicy getCompactionPolicy() {
+        if (tableProperty == null) {
+            return TCompactionPolicy.DEFAULT;
+        }
+        return tableProperty.getCompactionPolicy();
+    }
+
     // should call this when create materialized view
     public void addRelatedMaterializedView(long mvId) {
         relatedMaterializedViews.add(mvId);
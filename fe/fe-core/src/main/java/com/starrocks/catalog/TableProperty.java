@@ -31,6 +31,7 @@ import com.starrocks.lake.StorageInfo;
 import com.starrocks.persist.OperationType;
 import com.starrocks.persist.gson.GsonPostProcessable;
 import com.starrocks.persist.gson.GsonUtils;
+import com.starrocks.thrift.TCompactionPolicy;
 import com.starrocks.thrift.TStorageFormat;
 
 import java.io.DataInput;
@@ -69,6 +70,8 @@ public class TableProperty implements Writable, GsonPostProcessable {
      */
     private TStorageFormat storageFormat = TStorageFormat.DEFAULT;
 
+    private TCompactionPolicy compactionPolicy = TCompactionPolicy.DEFAULT;
+
     // 1. This table has been deleted. if hasDelete is false, the BE segment must don't have deleteConditions.
     //    If hasDelete is true, the BE segment maybe have deleteConditions because compaction.
     // 2. Before checkpoint, we relay delete job journal log to persist.
@@ -141,6 +144,12 @@ public class TableProperty implements Writable, GsonPostProcessable {
         return this;
     }
 
+    public TableProperty buildCompactionPolicy() {
+        compactionPolicy = TCompactionPolicy.valueOf(properties.getOrDefault(
+                PropertyAnalyzer.PROPERTIES_COMPACTION_POLICY, TCompactionPolicy.DEFAULT.name()));
+        return this;
+    }
+
     public TableProperty buildEnablePersistentIndex() {
         enablePersistentIndex = Boolean.parseBoolean(
                 properties.getOrDefault(PropertyAnalyzer.PROPERTIES_ENABLE_PERSISTENT_INDEX, "false"));
@@ -179,6 +188,10 @@ public class TableProperty implements Writable, GsonPostProcessable {
         return storageFormat;
     }
 
+    public TCompactionPolicy getCompactionPolicy() {
+        return compactionPolicy;
+    }
+
     public boolean hasDelete() {
         return hasDelete;
     }
@@ -219,5 +232,6 @@ public class TableProperty implements Writable, GsonPostProcessable {
         buildInMemory();
         buildStorageFormat();
         buildEnablePersistentIndex();
+        buildCompactionPolicy();
     }
 }
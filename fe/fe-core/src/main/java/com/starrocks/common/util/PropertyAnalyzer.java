@@ -28,11 +28,13 @@ import com.starrocks.analysis.DateLiteral;
 import com.starrocks.catalog.AggregateType;
 import com.starrocks.catalog.Column;
 import com.starrocks.catalog.DataProperty;
+import com.starrocks.catalog.KeysType;
 import com.starrocks.catalog.Partition;
 import com.starrocks.catalog.Type;
 import com.starrocks.common.AnalysisException;
 import com.starrocks.common.Config;
 import com.starrocks.server.GlobalStateMgr;
+import com.starrocks.thrift.TCompactionPolicy;
 import com.starrocks.thrift.TStorageFormat;
 import com.starrocks.thrift.TStorageMedium;
 import com.starrocks.thrift.TStorageType;
@@ -87,6 +89,10 @@ public class PropertyAnalyzer {
 
     public static final String PROPERTIES_TABLET_TYPE = "tablet_type";
 
+    // compaction policy of the tablets, "default" or "size_tiered". Not supported by primary key tables, whose
+    // tablets are compacted by their own policy.
+    public static final String PROPERTIES_COMPACTION_POLICY = "compaction_policy";
+
     public static final String PROPERTIES_STRICT_RANGE = "strict_range";
     public static final String PROPERTIES_USE_TEMP_PARTITION_NAME = "use_temp_partition_name";
 
@@ -275,6 +281,27 @@ public class PropertyAnalyzer {
         return tTabletType;
     }
 
+    public static TCompactionPolicy analyzeCompactionPolicy(Map<String, String> properties, KeysType keysType)
+            throws AnalysisException {
+        TCompactionPolicy compactionPolicy = TCompactionPolicy.DEFAULT;
+        if (properties != null && properties.containsKey(PROPERTIES_COMPACTION_POLICY)) {
+            if (keysType == KeysType.PRIMARY_KEYS) {
+                throw new AnalysisException("Property " + PROPERTIES_COMPACTION_POLICY +
+                        " is not supported by primary key tables");
+            }
+            String policy = properties.get(PROPERTIES_COMPACTION_POLICY);
+            if (policy.equalsIgnoreCase("default")) {
+                compactionPolicy = TCompactionPolicy.DEFAULT;
+            } else if (policy.equalsIgnoreCase("size_tiered")) {
+                compactionPolicy = TCompactionPolicy.SIZE_TIERED;
+            } else {
+                throw new AnalysisException("Invalid compaction policy: " + policy);
+            }
+            properties.remove(PROPERTIES_COMPACTION_POLICY);
+        }
+        return compactionPolicy;
+    }
+
     public static Long analyzeVersionInfo(Map<String, String> properties) throws AnalysisException {
         Long versionInfo = Partition.PARTITION_INIT_VERSION;
         if (properties != null && properties.containsKey(PROPERTIES_VERSION_INFO)) {
@@ -176,6 +176,9 @@ public class AggregationNode extends PlanNode {
             msg.agg_node.setStreaming_preaggregation_mode(TStreamingPreaggregationMode.AUTO);
         }
         msg.agg_node.setAgg_func_set_version(3);
+        if (cardinality > 0) {
+            msg.agg_node.setEstimated_ndv(cardinality);
+        }
     }
 
     protected String getDisplayLabelDetail() {
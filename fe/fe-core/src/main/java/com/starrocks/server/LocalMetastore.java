@@ -190,6 +190,7 @@ import com.starrocks.task.AgentTask;
 import com.starrocks.task.AgentTaskExecutor;
 import com.starrocks.task.AgentTaskQueue;
 import com.starrocks.task.CreateReplicaTask;
+import com.starrocks.thrift.TCompactionPolicy;
 import com.starrocks.thrift.TStatusCode;
 import com.starrocks.thrift.TStorageFormat;
 import com.starrocks.thrift.TStorageMedium;
@@ -1723,6 +1724,7 @@ public class LocalMetastore implements ConnectorMetadata {
                             table.getPartitionInfo().getIsInMemory(partition.getId()),
                             table.enablePersistentIndex(),
                             table.getPartitionInfo().getTabletType(partition.getId()));
+                    task.setCompactionPolicy(table.getCompactionPolicy());
                     tasks.add(task);
                 }
             }
@@ -1996,6 +1998,16 @@ public class LocalMetastore implements ConnectorMetadata {
             throw new DdlException(e.getMessage());
         }
 
+        try {
+            TCompactionPolicy compactionPolicy = PropertyAnalyzer.analyzeCompactionPolicy(properties,
+                    olapTable.getKeysType());
+            if (compactionPolicy != TCompactionPolicy.DEFAULT) {
+                olapTable.setCompactionPolicy(compactionPolicy);
+            }
+        } catch (AnalysisException e) {
+            throw new DdlException(e.getMessage());
+        }
+
         if (partitionInfo.getType() == PartitionType.UNPARTITIONED) {
             // if this is an unpartitioned table, we should analyze data property and replication num here.
             // if this is a partitioned table, there properties are already analyzed in RangePartitionDesc analyze phase.
@@ -28,6 +28,7 @@ import com.starrocks.catalog.KeysType;
 import com.starrocks.common.MarkedCountDownLatch;
 import com.starrocks.common.Status;
 import com.starrocks.thrift.TColumn;
+import com.starrocks.thrift.TCompactionPolicy;
 import com.starrocks.thrift.TCreateTabletReq;
 import com.starrocks.thrift.TOlapTableIndex;
 import com.starrocks.thrift.TStatusCode;
@@ -83,6 +84,8 @@ public class CreateReplicaTask extends AgentTask {
 
     private TStorageFormat storageFormat = null;
 
+    private TCompactionPolicy compactionPolicy = null;
+
     // true if this task is created by recover request(See comment of Config.recover_with_empty_tablet)
     private boolean isRecoverTask = false;
 
@@ -119,6 +122,10 @@ public class CreateReplicaTask extends AgentTask {
         this.tabletType = tabletType;
     }
 
+    public void setCompactionPolicy(TCompactionPolicy compactionPolicy) {
+        this.compactionPolicy = compactionPolicy;
+    }
+
     public void setIsRecoverTask(boolean isRecoverTask) {
         this.isRecoverTask = isRecoverTask;
     }
@@ -225,6 +232,10 @@ public class CreateReplicaTask extends AgentTask {
             createTabletReq.setStorage_format(storageFormat);
         }
 
+        if (compactionPolicy != null) {
+            createTabletReq.setCompaction_policy(compactionPolicy);
+        }
+
         createTabletReq.setTablet_type(tabletType);
         return createTabletReq;
     }
@@ -28,9 +28,11 @@ import com.starrocks.analysis.DateLiteral;
 import com.starrocks.catalog.AggregateType;
 import com.starrocks.catalog.Column;
 import com.starrocks.catalog.DataProperty;
+import com.starrocks.catalog.KeysType;
 import com.starrocks.catalog.Type;
 import com.starrocks.common.util.PropertyAnalyzer;
 import com.starrocks.common.util.TimeUtils;
+import com.starrocks.thrift.TCompactionPolicy;
 import com.starrocks.thrift.TStorageMedium;
 import org.junit.Assert;
 import org.junit.Test;
@@ -179,4 +181,41 @@ public class PropertyAnalyzerTest {
         Assert.assertTrue(dataProperty.getCooldownTimeMs() >= start + 600 * 1000L &&
                 dataProperty.getCooldownTimeMs() <= end + 600 * 1000L);
     }
+
+    @Test
+    public void testCompactionPolicy() throws AnalysisException {
+        Assert.assertEquals(TCompactionPolicy.DEFAULT,
+                PropertyAnalyzer.analyzeCompactionPolicy(Maps.newHashMap(), KeysType.DUP_KEYS));
+
+        Map<String, String> properties = Maps.newHashMap();
+        properties.put(PropertyAnalyzer.PROPERTIES_COMPACTION_POLICY, "size_tiered");
+        Assert.assertEquals(TCompactionPolicy.SIZE_TIERED,
+                PropertyAnalyzer.analyzeCompactionPolicy(properties, KeysType.UNIQUE_KEYS));
+        Assert.assertFalse(properties.containsKey(PropertyAnalyzer.PROPERTIES_COMPACTION_POLICY));
+
+        properties.put(PropertyAnalyzer.PROPERTIES_COMPACTION_POLICY, "default");
+        Assert.assertEquals(TCompactionPolicy.DEFAULT,
+                PropertyAnalyzer.analyzeCompactionPolicy(properties, KeysType.AGG_KEYS));
+    }
+
+    @Test
+    public void testCompactionPolicyError() {
+        Map<String, String> properties = Maps.newHashMap();
+        properties.put(PropertyAnalyzer.PROPERTIES_COMPACTION_POLICY, "leveled");
+        try {
+            PropertyAnalyzer.analyzeCompactionPolicy(properties, KeysType.DUP_KEYS);
+            Assert.fail();
+        } catch (AnalysisException e) {
+            Assert.assertTrue(e.getMessage().contains("Invalid compaction policy"));
+        }
+
+        // primary key tablets ignore the policy, so the property is rejected
+        properties.put(PropertyAnalyzer.PROPERTIES_COMPACTION_POLICY, "size_tiered");
+        try {
+            PropertyAnalyzer.analyzeCompactionPolicy(properties, KeysType.PRIMARY_KEYS);
+            Assert.fail();
+        } catch (AnalysisException e) {
+            Assert.assertTrue(e.getMessage().contains("not supported by primary key tables"));
+        }
+    }
 }
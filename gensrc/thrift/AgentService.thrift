@@ -56,6 +56,12 @@ enum TTabletType {
     TABLET_TYPE_LAKE = 2
 }
 
+enum TCompactionPolicy {
+    DEFAULT,
+    // merge rowsets of similar size, see SizeTieredCompactionPolicy of BE
+    SIZE_TIERED
+}
+
 struct TCreateTabletReq {
     1: required Types.TTabletId tablet_id
     2: required TTabletSchema tablet_schema
@@ -76,6 +82,7 @@ struct TCreateTabletReq {
     13: optional TStorageFormat storage_format
     14: optional TTabletType tablet_type
     15: optional bool enable_persistent_index
+    16: optional TCompactionPolicy compaction_policy
 }
 
 struct TDropTabletReq {
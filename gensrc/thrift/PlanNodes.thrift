@@ -557,6 +557,9 @@ struct TAggregationNode {
   23: optional string sql_aggregate_functions
 
   24: optional i32 agg_func_set_version = 1
+
+  // Estimated number of groups, used to pre-size the hash table
+  25: optional i64 estimated_ndv
 }
 
 struct TRepeatNode {